@@ -0,0 +1,91 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Finds block structure in a flat model and solves it by decomposition.
+// Answer is checked against solving flat model.
+//
+// blockDetect [mps file [type [maximum blocks [threads]]]]
+//   type 1 looks for linking rows (Dantzig-Wolfe), 2 for linking columns (Benders)
+
+#include "ClpSimplex.hpp"
+#include "ClpBlockStructure.hpp"
+#include "CoinStructuredModel.hpp"
+#include "CoinTime.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+int main(int argc, const char *argv[])
+{
+#if COIN_BIG_INDEX<2
+     ClpSimplex model;
+     int status;
+#if defined(NETLIBDIR)
+     status = model.readMps((argc < 2) ? NETLIBDIR "/czprob.mps" : argv[1], true);
+#else
+     if (argc < 2) {
+          fprintf(stderr, "Do not know where to find netlib MPS files.\n");
+          return 1;
+     }
+     status = model.readMps(argv[1], true);
+#endif
+     if (status)
+          return status;
+     int type = argc > 2 ? atoi(argv[2]) : 1;
+     int maximumBlocks = argc > 3 ? atoi(argv[3]) : 50;
+     double time1 = CoinCpuTime();
+     ClpBlockStructure structure;
+     int numberBlocks = structure.findStructure(&model, type, maximumBlocks);
+     printf("%d blocks found in %.2f seconds\n", numberBlocks, CoinCpuTime() - time1);
+     if (!numberBlocks) {
+          printf("No useful structure\n");
+          return 0;
+     }
+     const int * rowBlock = structure.rowBlock();
+     const int * columnBlock = structure.columnBlock();
+     for (int iBlock = 0; iBlock < numberBlocks; iBlock++) {
+          int numberRows = 0;
+          int numberColumns = 0;
+          for (int i = 0; i < model.numberRows(); i++) {
+               if (rowBlock[i] == iBlock)
+                    numberRows++;
+          }
+          for (int i = 0; i < model.numberColumns(); i++) {
+               if (columnBlock[i] == iBlock)
+                    numberColumns++;
+          }
+          printf("Block %d has %d rows and %d columns\n", iBlock, numberRows, numberColumns);
+     }
+     int n = structure.numberLinkingRows();
+     printf("%d linking rows", n);
+     for (int i = 0; i < CoinMin(n, 10); i++)
+          printf(" %s", model.getRowName(structure.linkingRows()[i]).c_str());
+     printf(n > 10 ? " ...\n" : "\n");
+     n = structure.numberLinkingColumns();
+     printf("%d linking columns", n);
+     for (int i = 0; i < CoinMin(n, 10); i++)
+          printf(" %s", model.getColumnName(structure.linkingColumns()[i]).c_str());
+     printf(n > 10 ? " ...\n" : "\n");
+     CoinStructuredModel structured;
+     structure.createStructuredModel(&model, structured);
+     ClpSimplex solver;
+     if (argc > 4)
+          solver.setNumberThreads(atoi(argv[4]));
+     time1 = CoinCpuTime();
+     solver.solve(&structured);
+     printf("Decomposition - objective %g took %.2f seconds\n",
+            solver.objectiveValue(), CoinCpuTime() - time1);
+     time1 = CoinCpuTime();
+     model.dual();
+     printf("Flat model - objective %g took %.2f seconds\n",
+            model.objectiveValue(), CoinCpuTime() - time1);
+     if (fabs(model.objectiveValue() - solver.objectiveValue()) >
+               1.0e-5 * (1.0 + fabs(model.objectiveValue()))) {
+          printf("** objectives differ\n");
+          return 1;
+     }
+#else
+     printf("blockDetect not available with COIN_BIG_INDEX=2\n");
+#endif
+     return 0;
+}
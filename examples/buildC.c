@@ -0,0 +1,158 @@
+/* Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+   This code is licensed under the terms of the Eclipse Public License (EPL).
+*/
+
+/* This example shows ways of building a model with the "C" interface
+   without copying large arrays more than needed.  A transportation
+   problem is loaded by borrowing column ordered arrays, by handing over
+   row ordered arrays and by adding rows in one go from a Clp_Build.
+
+   buildC [sources [sinks]]
+*/
+
+#include "Clp_C_Interface.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+static double cost(int i, int j)
+{
+     return (double) ((7 * i + 13 * j) % 17 + 1);
+}
+
+static double solve(Clp_Simplex * model, const char * what)
+{
+     double value;
+     Clp_setLogLevel(model, 0);
+     Clp_dual(model, 0);
+     value = Clp_objectiveValue(model);
+     printf("%s - status %d objective %g\n", what, Clp_status(model), value);
+     return value;
+}
+
+int main(int argc, const char *argv[])
+{
+     int numberSources = argc > 1 ? atoi(argv[1]) : 200;
+     int numberSinks = argc > 2 ? atoi(argv[2]) : 300;
+     int numberRows = numberSources + numberSinks;
+     int numberColumns = numberSources * numberSinks;
+     CoinBigIndex numberElements = 2 * numberColumns;
+     int i, j, k;
+     double value1, value2, value3;
+     double * rowLower = (double *) malloc(numberRows * sizeof(double));
+     double * rowUpper = (double *) malloc(numberRows * sizeof(double));
+     double * objective = (double *) malloc(numberColumns * sizeof(double));
+     /* supply rows then demand rows */
+     for (i = 0; i < numberSources; i++) {
+          rowLower[i] = -1.0e30;
+          rowUpper[i] = 3 * numberSinks;
+     }
+     for (j = 0; j < numberSinks; j++) {
+          rowLower[numberSources + j] = 2 * numberSources;
+          rowUpper[numberSources + j] = 1.0e30;
+     }
+     for (i = 0; i < numberSources; i++)
+          for (j = 0; j < numberSinks; j++)
+               objective[i * numberSinks + j] = cost(i, j);
+     {
+          /* 1 - borrow caller's column ordered arrays */
+          Clp_Simplex * model = Clp_newModel();
+          CoinBigIndex * start = (CoinBigIndex *) malloc((numberColumns + 1) * sizeof(CoinBigIndex));
+          int * row = (int *) malloc(numberElements * sizeof(int));
+          double * element = (double *) malloc(numberElements * sizeof(double));
+          for (k = 0; k < numberColumns; k++) {
+               start[k] = 2 * k;
+               row[2 * k] = k / numberSinks;
+               row[2 * k + 1] = numberSources + k % numberSinks;
+               element[2 * k] = 1.0;
+               element[2 * k + 1] = 1.0;
+          }
+          start[numberColumns] = numberElements;
+          Clp_assignProblem(model, numberColumns, numberRows, 1,
+                            start, row, element, NULL, NULL, objective,
+                            rowLower, rowUpper, 2);
+          value1 = solve(model, "Borrowed column arrays");
+          /* arrays must stay valid until model has gone */
+          Clp_deleteModel(model);
+          free(start);
+          free(row);
+          free(element);
+     }
+     {
+          /* 2 - hand over row ordered arrays */
+          Clp_Simplex * model = Clp_newModel();
+          CoinBigIndex * start = Clp_newBigIndexArray(numberRows + 1);
+          int * column = Clp_newIntArray(numberElements);
+          double * element = Clp_newDoubleArray(numberElements);
+          CoinBigIndex put = 0;
+          for (i = 0; i < numberSources; i++) {
+               start[i] = put;
+               for (j = 0; j < numberSinks; j++) {
+                    column[put] = i * numberSinks + j;
+                    element[put++] = 1.0;
+               }
+          }
+          for (j = 0; j < numberSinks; j++) {
+               start[numberSources + j] = put;
+               for (i = 0; i < numberSources; i++) {
+                    column[put] = i * numberSinks + j;
+                    element[put++] = 1.0;
+               }
+          }
+          start[numberRows] = put;
+          Clp_assignProblem(model, numberColumns, numberRows, 0,
+                            start, column, element, NULL, NULL, NULL,
+                            NULL, NULL, 1);
+          /* now owned by model */
+          start = NULL;
+          column = NULL;
+          element = NULL;
+          Clp_chgObjCoefficients(model, objective);
+          Clp_chgRowLower(model, rowLower);
+          Clp_chgRowUpper(model, rowUpper);
+          value2 = solve(model, "Adopted row arrays");
+          Clp_deleteModel(model);
+     }
+     {
+          /* 3 - columns with no elements then all rows at once */
+          Clp_Simplex * model = Clp_newModel();
+          Clp_Build * build = ClpBuild_new(0);
+          int maximumLength = numberSources > numberSinks ? numberSources : numberSinks;
+          CoinBigIndex * start = (CoinBigIndex *) calloc(numberColumns + 1, sizeof(CoinBigIndex));
+          int * column = (int *) malloc(maximumLength * sizeof(int));
+          double * element = (double *) malloc(maximumLength * sizeof(double));
+          Clp_loadProblem(model, numberColumns, 0, start, column, element,
+                          NULL, NULL, objective, NULL, NULL);
+          for (i = 0; i < maximumLength; i++)
+               element[i] = 1.0;
+          for (i = 0; i < numberSources; i++) {
+               for (j = 0; j < numberSinks; j++)
+                    column[j] = i * numberSinks + j;
+               ClpBuild_addRow(build, numberSinks, column, element,
+                               rowLower[i], rowUpper[i]);
+          }
+          for (j = 0; j < numberSinks; j++) {
+               for (i = 0; i < numberSources; i++)
+                    column[i] = i * numberSinks + j;
+               ClpBuild_addRow(build, numberSources, column, element,
+                               rowLower[numberSources + j],
+                               rowUpper[numberSources + j]);
+          }
+          Clp_addRowsFromBuild(model, build, 0);
+          ClpBuild_delete(build);
+          value3 = solve(model, "Rows from build");
+          Clp_deleteModel(model);
+          free(start);
+          free(column);
+          free(element);
+     }
+     free(rowLower);
+     free(rowUpper);
+     free(objective);
+     if (fabs(value1 - value2) > 1.0e-6 * (1.0 + fabs(value1)) ||
+               fabs(value1 - value3) > 1.0e-6 * (1.0 + fabs(value1))) {
+          printf("** objectives differ\n");
+          return 1;
+     }
+     return 0;
+}
@@ -0,0 +1,213 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Column generation with ClpDynamicMatrix and a ClpPricingOracle.
+// Jobs (sets) are assigned to machines (static rows) with overtime allowed.
+// The oracle knows all options for each job but only passes back the
+// best one for each job which prices out.  The pool of gub columns is
+// kept small so old columns get thrown out and may be regenerated.
+// Answer is checked against solving full model.
+//
+// columnGeneration [jobs [options machines]]
+
+#include "ClpSimplex.hpp"
+#include "ClpDynamicMatrix.hpp"
+#include "ClpPricingOracle.hpp"
+#include "ClpPrimalColumnSteepest.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+// Oracle which prices out stored options (a real one might do shortest path)
+class JobOracle : public ClpPricingOracle {
+public:
+     JobOracle(int numberJobs, int numberOptions, const int * machine,
+               const double * work, const double * cost)
+          : numberJobs_(numberJobs), numberOptions_(numberOptions),
+            machine_(machine), work_(work), cost_(cost) {}
+     virtual int generateColumns(const ClpDynamicMatrix * ,
+                                 const double * duals, const double * setDuals,
+                                 double tolerance, int maximumColumns) {
+          for (int iJob = 0; iJob < numberJobs_; iJob++) {
+               int best = -1;
+               double bestDj = -tolerance;
+               for (int k = iJob * numberOptions_; k < (iJob + 1) * numberOptions_; k++) {
+                    double dj = cost_[k] - duals[machine_[k]] * work_[k] - setDuals[iJob];
+                    if (dj < bestDj) {
+                         bestDj = dj;
+                         best = k;
+                    }
+               }
+               if (best >= 0) {
+                    addColumn(1, machine_ + best, work_ + best, cost_[best], iJob);
+                    if (numberColumns() == maximumColumns)
+                         break;
+               }
+          }
+          return numberColumns();
+     }
+     virtual ClpPricingOracle * clone() const {
+          return new JobOracle(*this);
+     }
+private:
+     int numberJobs_;
+     int numberOptions_;
+     const int * machine_;
+     const double * work_;
+     const double * cost_;
+};
+
+int main(int argc, const char *argv[])
+{
+     int numberJobs = argc > 1 ? atoi(argv[1]) : 2000;
+     int numberOptions = argc > 2 ? atoi(argv[2]) : 20;
+     int numberMachines = argc > 3 ? atoi(argv[3]) : 20;
+     int numberColumns = numberJobs * numberOptions;
+     int * machine = new int[numberColumns];
+     double * work = new double[numberColumns];
+     double * cost = new double[numberColumns];
+     CoinSeedRandom(1234567);
+     double totalWork = 0.0;
+     for (int i = 0; i < numberColumns; i++) {
+          machine[i] = static_cast<int>(CoinDrand48() * numberMachines);
+          work[i] = 1.0 + floor(10.0 * CoinDrand48());
+          cost[i] = floor(100.0 * CoinDrand48());
+          totalWork += work[i] / numberOptions;
+     }
+     double capacity = 0.9 * totalWork / numberMachines;
+     double overtimeCost = 200.0;
+     // Full model - machines, then one row per job
+     double time1 = CoinGetTimeOfDay();
+     double fullObjective;
+     {
+          int numberRows = numberMachines + numberJobs;
+          int numberTotal = numberColumns + numberMachines;
+          CoinBigIndex * start = new CoinBigIndex[numberTotal+1];
+          int * row = new int[2*numberColumns+numberMachines];
+          double * element = new double[2*numberColumns+numberMachines];
+          double * objective = new double[numberTotal];
+          double * rowLower = new double[numberRows];
+          double * rowUpper = new double[numberRows];
+          CoinBigIndex n = 0;
+          int i;
+          for (i = 0; i < numberMachines; i++) {
+               start[i] = n;
+               row[n] = i;
+               element[n++] = -1.0;
+               objective[i] = overtimeCost;
+               rowLower[i] = -COIN_DBL_MAX;
+               rowUpper[i] = capacity;
+          }
+          for (i = 0; i < numberColumns; i++) {
+               start[i+numberMachines] = n;
+               row[n] = machine[i];
+               element[n++] = work[i];
+               row[n] = numberMachines + i / numberOptions;
+               element[n++] = 1.0;
+               objective[i+numberMachines] = cost[i];
+          }
+          start[numberTotal] = n;
+          for (i = numberMachines; i < numberRows; i++) {
+               rowLower[i] = 1.0;
+               rowUpper[i] = 1.0;
+          }
+          ClpSimplex full;
+          full.loadProblem(numberTotal, numberRows, start, row, element,
+                           NULL, NULL, objective, rowLower, rowUpper);
+          full.setLogLevel(0);
+          full.dual();
+          fullObjective = full.objectiveValue();
+          delete [] start;
+          delete [] row;
+          delete [] element;
+          delete [] objective;
+          delete [] rowLower;
+          delete [] rowUpper;
+     }
+     printf("Full model with %d columns - objective %g took %.2f seconds\n",
+            numberColumns, fullObjective, CoinGetTimeOfDay() - time1);
+     // Model with machine rows and overtime only
+     time1 = CoinGetTimeOfDay();
+     ClpSimplex model;
+     {
+          CoinBigIndex * start = new CoinBigIndex[numberMachines+1];
+          int * row = new int[numberMachines];
+          double * element = new double[numberMachines];
+          double * objective = new double[numberMachines];
+          double * rowUpper = new double[numberMachines];
+          for (int i = 0; i < numberMachines; i++) {
+               start[i] = i;
+               row[i] = i;
+               element[i] = -1.0;
+               objective[i] = overtimeCost;
+               rowUpper[i] = capacity;
+          }
+          start[numberMachines] = numberMachines;
+          model.loadProblem(numberMachines, numberMachines, start, row, element,
+                            NULL, NULL, objective, NULL, rowUpper);
+          delete [] start;
+          delete [] row;
+          delete [] element;
+          delete [] objective;
+          delete [] rowUpper;
+     }
+     // start with first option for each job
+     CoinBigIndex * starts = new CoinBigIndex[numberJobs+1];
+     CoinBigIndex * startColumn = new CoinBigIndex[numberJobs+1];
+     int * row = new int[numberJobs];
+     double * element = new double[numberJobs];
+     double * cost2 = new double[numberJobs];
+     double * lower = new double[numberJobs];
+     double * upper = new double[numberJobs];
+     for (int iJob = 0; iJob < numberJobs; iJob++) {
+          int k = iJob * numberOptions;
+          starts[iJob] = iJob;
+          startColumn[iJob] = iJob;
+          row[iJob] = machine[k];
+          element[iJob] = work[k];
+          cost2[iJob] = cost[k];
+          lower[iJob] = 1.0;
+          upper[iJob] = 1.0;
+     }
+     starts[numberJobs] = numberJobs;
+     startColumn[numberJobs] = numberJobs;
+     ClpDynamicMatrix * newMatrix = new ClpDynamicMatrix(&model, numberJobs,
+               numberJobs, starts, lower, upper,
+               startColumn, row, element, cost2);
+     JobOracle oracle(numberJobs, numberOptions, machine, work, cost);
+     newMatrix->setPricingOracle(&oracle);
+     // pool of at most three columns per job
+     newMatrix->setPoolSize(3 * numberJobs, 3 * numberJobs);
+     newMatrix->setMaximumAge(100);
+     model.replaceMatrix(newMatrix, true);
+     newMatrix->switchOffCheck();
+     newMatrix->setRefreshFrequency(1000);
+     model.setSpecialOptions(4);    // exactly to bound
+     model.scaling(0);
+     ClpPrimalColumnSteepest steepest(5);
+     model.setPrimalColumnPivotAlgorithm(steepest);
+     model.setLogLevel(1);
+     model.primal();
+     printf("Column generation - objective %g, %d columns generated, %d thrown out, pool %d - took %.2f seconds\n",
+            model.objectiveValue(), newMatrix->numberGenerated(),
+            newMatrix->numberEvicted(), newMatrix->numberGubColumns(),
+            CoinGetTimeOfDay() - time1);
+     int returnCode = 0;
+     if (fabs(model.objectiveValue() - fullObjective) > 1.0e-5 * (1.0 + fabs(fullObjective))) {
+          printf("** objectives differ\n");
+          returnCode = 1;
+     }
+     delete [] starts;
+     delete [] startColumn;
+     delete [] row;
+     delete [] element;
+     delete [] cost2;
+     delete [] lower;
+     delete [] upper;
+     delete [] machine;
+     delete [] work;
+     delete [] cost;
+     return returnCode;
+}
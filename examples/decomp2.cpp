@@ -27,6 +27,9 @@ int main(int argc, const char *argv[])
           exit(10);
      // Get default solver - could change stuff
      ClpSimplex solver;
+     // Optional second parameter is number of threads for sub problems
+     if (argc > 2)
+          solver.setNumberThreads(atoi(argv[2]));
      /*
        This driver does a simple Dantzig Wolfe decomposition
      */
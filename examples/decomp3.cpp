@@ -47,11 +47,23 @@ int main(int argc, const char *argv[])
      ClpSimplex solver;
      // change factorization frequency from 200
      solver.setFactorizationFrequency(100 + model.numberRows() / 50);
+     // Optional third parameter is number of threads for sub problems
+     if (argc > 3)
+          solver.setNumberThreads(atoi(argv[3]));
      /*
        This driver does a simple Dantzig Wolfe decomposition
+       (or Benders if second parameter negative)
      */
+     ClpSolve options;
+     options.setIndependentOption(2, 100);
+     // Benders - fourth parameter 1 for single cut, fifth to go back to
+     // master after that many sub problems
+     if (argc > 4)
+          options.setBendersCutType(atoi(argv[4]));
+     if (argc > 5)
+          options.setBendersAsynchronous(atoi(argv[5]));
      double time1 = CoinCpuTime() ;
-     solver.solve(&model);
+     solver.solve(&model, options);
      std::cout << "model took " << CoinCpuTime() - time1 << " seconds" << std::endl;
      // Double check
      solver.primal(1);
@@ -0,0 +1,212 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Times primal simplex with partial pricing on a ClpGubMatrix using one
+// thread and then more threads (pricing of sets is split over threads).
+// Gub rows are found as in testGub2.cpp - rows of +1 over contiguous
+// columns which do not overlap.
+//
+// gubPricing                     - generated assignment model with 100000 sets
+// gubPricing sets [options rows] - generated with that many sets
+// gubPricing file.mps            - gub rows taken from an mps file
+// A last argument of -threads=n sets number of threads for second solve.
+
+#include "ClpSimplex.hpp"
+#include "ClpGubMatrix.hpp"
+#include "ClpPrimalColumnSteepest.hpp"
+#include "ClpThreadPool.hpp"
+#include "CoinSort.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinTime.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+// Assignment of jobs to machines - each job has a convexity (gub) row
+static void generate(ClpSimplex &model, int numberSets, int numberOptions,
+                     int numberMachines)
+{
+     int numberColumns = numberSets * numberOptions;
+     int numberRows = numberMachines + numberSets;
+     CoinBigIndex * start = new CoinBigIndex[numberColumns+1];
+     int * row = new int[2*numberColumns];
+     double * element = new double[2*numberColumns];
+     double * cost = new double[numberColumns];
+     double * columnLower = new double[numberColumns];
+     double * columnUpper = new double[numberColumns];
+     double * rowLower = new double[numberRows];
+     double * rowUpper = new double[numberRows];
+     CoinSeedRandom(1234567);
+     double totalWork = 0.0;
+     CoinBigIndex numberElements = 0;
+     int iColumn = 0;
+     for (int iSet = 0; iSet < numberSets; iSet++) {
+          double work = 1.0 + floor(10.0 * CoinDrand48());
+          totalWork += work;
+          for (int k = 0; k < numberOptions; k++) {
+               start[iColumn] = numberElements;
+               int iMachine = static_cast<int>(CoinDrand48() * numberMachines);
+               row[numberElements] = iMachine;
+               element[numberElements++] = work * (0.8 + 0.4 * CoinDrand48());
+               row[numberElements] = numberMachines + iSet;
+               element[numberElements++] = 1.0;
+               cost[iColumn] = floor(100.0 * CoinDrand48());
+               columnLower[iColumn] = 0.0;
+               columnUpper[iColumn] = 1.0;
+               iColumn++;
+          }
+     }
+     start[numberColumns] = numberElements;
+     for (int iRow = 0; iRow < numberMachines; iRow++) {
+          rowLower[iRow] = -COIN_DBL_MAX;
+          rowUpper[iRow] = 1.1 * totalWork / numberMachines;
+     }
+     for (int iRow = numberMachines; iRow < numberRows; iRow++) {
+          rowLower[iRow] = 1.0;
+          rowUpper[iRow] = 1.0;
+     }
+     model.loadProblem(numberColumns, numberRows, start, row, element,
+                       columnLower, columnUpper, cost, rowLower, rowUpper);
+     delete [] start;
+     delete [] row;
+     delete [] element;
+     delete [] cost;
+     delete [] columnLower;
+     delete [] columnUpper;
+     delete [] rowLower;
+     delete [] rowUpper;
+}
+
+int main(int argc, const char *argv[])
+{
+     ClpSimplex  model;
+     int numberThreads = CoinMin(ClpThreadPool::hardwareThreads(), 8);
+     if (argc > 1 && !strncmp(argv[argc-1], "-threads=", 9)) {
+          numberThreads = atoi(argv[argc-1] + 9);
+          argc--;
+     }
+     if (argc > 1 && !atoi(argv[1])) {
+          if (model.readMps(argv[1])) {
+               printf("errors on input\n");
+               exit(77);
+          }
+     } else {
+          int numberSets = argc > 1 ? atoi(argv[1]) : 100000;
+          int numberOptions = argc > 2 ? atoi(argv[2]) : 10;
+          int numberMachines = argc > 3 ? atoi(argv[3]) : 50;
+          generate(model, numberSets, numberOptions, numberMachines);
+     }
+     // find gub
+     int numberRows = model.numberRows();
+     int numberColumns = model.numberColumns();
+     int * gubStart = new int[numberRows];
+     int * gubEnd = new int[numberRows];
+     double * lower = new double[numberRows];
+     double * upper = new double[numberRows];
+     int * which = new int[numberRows];
+     int * mark = new int[numberColumns];
+     int iRow, iColumn;
+     for (iColumn = 0; iColumn < numberColumns; iColumn++)
+          mark[iColumn] = -1;
+     CoinPackedMatrix rowCopy = *model.matrix();
+     rowCopy.reverseOrdering();
+     const int * column = rowCopy.getIndices();
+     const int * rowLength = rowCopy.getVectorLengths();
+     const CoinBigIndex * rowStart = rowCopy.getVectorStarts();
+     const double * element = rowCopy.getElements();
+     const double * rowLower = model.rowLower();
+     const double * rowUpper = model.rowUpper();
+     int numberGub = 0;
+     int numberNonGub = 0;
+     for (iRow = 0; iRow < numberRows; iRow++) {
+          bool gubRow = rowLength[iRow] > 0;
+          int first = numberColumns + 1;
+          int last = -1;
+          for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++) {
+               int iColumn = column[j];
+               if (element[j] != 1.0 || mark[iColumn] >= 0) {
+                    gubRow = false;
+                    break;
+               }
+               last = CoinMax(last, iColumn);
+               first = CoinMin(first, iColumn);
+          }
+          if (gubRow && last - first + 1 == rowLength[iRow]) {
+               for (CoinBigIndex j = rowStart[iRow]; j < rowStart[iRow] + rowLength[iRow]; j++)
+                    mark[column[j]] = iRow;
+               gubStart[numberGub] = first;
+               gubEnd[numberGub] = last + 1;
+               lower[numberGub] = rowLower[iRow];
+               upper[numberGub++] = rowUpper[iRow];
+          } else {
+               which[numberNonGub++] = iRow;
+          }
+     }
+     if (!numberGub || !numberNonGub) {
+          printf("** %d gub rows and %d others - nothing to do\n", numberGub, numberNonGub);
+          exit(0);
+     }
+     printf("** %d gub rows, %d other rows and %d columns\n",
+            numberGub, numberNonGub, numberColumns);
+     // sets must be in order
+     int * temp = new int[numberGub];
+     CoinIotaN(temp, numberGub, 0);
+     CoinSort_2(gubStart, gubStart + numberGub, temp);
+     int * temp2 = new int[numberGub];
+     double * temp3 = new double[2*numberGub];
+     for (int i = 0; i < numberGub; i++) {
+          temp2[i] = gubEnd[temp[i]];
+          temp3[i] = lower[temp[i]];
+          temp3[i+numberGub] = upper[temp[i]];
+     }
+     memcpy(gubEnd, temp2, numberGub * sizeof(int));
+     memcpy(lower, temp3, numberGub * sizeof(double));
+     memcpy(upper, temp3 + numberGub, numberGub * sizeof(double));
+     delete [] temp;
+     delete [] temp2;
+     delete [] temp3;
+     // keep non gub rows and all columns
+     CoinIotaN(mark, numberColumns, 0);
+     ClpSimplex base(&model, numberNonGub, which, numberColumns, mark);
+     double objective[2] = {0.0, 0.0};
+     for (int iPass = 0; iPass < 2; iPass++) {
+          int threads = iPass ? numberThreads : 1;
+          ClpSimplex model2(base);
+          ClpPackedMatrix * packed = new ClpPackedMatrix(*model2.matrix());
+          ClpGubMatrix * gubMatrix = new ClpGubMatrix(packed, numberGub,
+                    gubStart, gubEnd, lower, upper);
+          // gub matrix has taken over packed matrix
+          packed->setMatrixNull();
+          delete packed;
+          model2.replaceMatrix(gubMatrix, true);
+          model2.setNumberThreads(threads);
+          // For now scaling off
+          model2.scaling(0);
+          // Do partial dantzig
+          ClpPrimalColumnSteepest dantzig(5);
+          model2.setPrimalColumnPivotAlgorithm(dantzig);
+          model2.messageHandler()->setLogLevel(1);
+          model2.setMaximumIterations(4000000);
+          double time1 = CoinGetTimeOfDay();
+          model2.primal();
+          objective[iPass] = model2.objectiveValue();
+          printf("%d thread%s - status %d objective %.10g iterations %d took %.2f seconds\n",
+                 threads, threads > 1 ? "s" : "", model2.status(), objective[iPass],
+                 model2.numberIterations(), CoinGetTimeOfDay() - time1);
+          if (numberThreads < 2)
+               break;
+     }
+     if (numberThreads > 1 &&
+               fabs(objective[0] - objective[1]) > 1.0e-7 * (1.0 + fabs(objective[0]))) {
+          printf("** objectives differ\n");
+          return 1;
+     }
+     delete [] gubStart;
+     delete [] gubEnd;
+     delete [] lower;
+     delete [] upper;
+     delete [] which;
+     delete [] mark;
+     return 0;
+}
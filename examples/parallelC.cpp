@@ -0,0 +1,112 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+// Stress test for the "C" interface - solves independent models on
+// several threads at once and checks each answer against a serial solve.
+//
+// parallelC [threads [repeats [mps file ...]]]
+
+#include "Clp_C_Interface.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <thread>
+
+typedef struct {
+     int status;
+     int iterations;
+     double objective;
+     int messages;
+} Result;
+
+/* Call back function - counts messages (data is per model) */
+static void callBack(Clp_Simplex * model, int messageNumber,
+                     int nDouble, const double * vDouble,
+                     int nInt, const int * vInt,
+                     int nString, char ** vString)
+{
+     int * count = reinterpret_cast<int *>(Clp_getUserPointer(model));
+     (*count)++;
+}
+
+static Result solve(const char * fileName)
+{
+     Result result;
+     result.status = -1;
+     result.iterations = 0;
+     result.objective = 0.0;
+     result.messages = 0;
+     Clp_Simplex * model = Clp_newModel();
+     Clp_setLogLevel(model, 0);
+     if (!Clp_readMps(model, fileName, 1, 0)) {
+          Clp_setUserPointer(model, &result.messages);
+          Clp_registerCallBack(model, callBack);
+          Clp_setLogLevel(model, 1);
+          Clp_initialSolve(model);
+          result.status = Clp_status(model);
+          result.iterations = Clp_numberIterations(model);
+          result.objective = Clp_objectiveValue(model);
+          Clp_clearCallBack(model);
+     }
+     Clp_deleteModel(model);
+     return result;
+}
+
+int main(int argc, const char *argv[])
+{
+     int numberThreads = argc > 1 ? atoi(argv[1]) : 4;
+     int numberRepeats = argc > 2 ? atoi(argv[2]) : 4;
+     std::vector<const char *> files;
+     for (int i = 3; i < argc; i++)
+          files.push_back(argv[i]);
+     if (files.empty()) {
+#if defined(SAMPLEDIR)
+          files.push_back(SAMPLEDIR "/p0033.mps");
+          files.push_back(SAMPLEDIR "/exmip1.mps");
+#else
+          fprintf(stderr, "Do not know where to find sample MPS files.\n");
+          return 1;
+#endif
+     }
+     int numberFiles = static_cast<int>(files.size());
+     // serial answers
+     std::vector<Result> serial(numberFiles);
+     for (int i = 0; i < numberFiles; i++) {
+          serial[i] = solve(files[i]);
+          if (serial[i].status < 0) {
+               fprintf(stderr, "Bad readMps %s\n", files[i]);
+               return 1;
+          }
+          printf("%s status %d objective %.10g iterations %d messages %d\n",
+                 files[i], serial[i].status, serial[i].objective,
+                 serial[i].iterations, serial[i].messages);
+     }
+     // same solves many times on threads
+     int numberSolves = numberFiles * numberRepeats * numberThreads;
+     std::vector<Result> parallel(numberSolves);
+     std::vector<std::thread> threads;
+     for (int iThread = 0; iThread < numberThreads; iThread++) {
+          threads.push_back(std::thread([&, iThread]() {
+               for (int i = iThread; i < numberSolves; i += numberThreads)
+                    parallel[i] = solve(files[i % numberFiles]);
+          }));
+     }
+     for (int iThread = 0; iThread < numberThreads; iThread++)
+          threads[iThread].join();
+     int numberBad = 0;
+     for (int i = 0; i < numberSolves; i++) {
+          const Result & a = serial[i % numberFiles];
+          const Result & b = parallel[i];
+          if (a.status != b.status || a.iterations != b.iterations ||
+                    a.objective != b.objective || a.messages != b.messages) {
+               printf("** solve %d of %s gave status %d objective %.10g iterations %d messages %d\n",
+                      i, files[i % numberFiles], b.status, b.objective,
+                      b.iterations, b.messages);
+               numberBad++;
+          }
+     }
+     printf("%d solves on %d threads - %d differed from serial\n",
+            numberSolves, numberThreads, numberBad);
+     return numberBad ? 1 : 0;
+}
@@ -4,8 +4,8 @@
 #  where default_buildtype ($1) is one of:
 #  1 - build Abc serial but no inherit code (default when built)
 #  2 - build Abc serial and inherit code
-#  3 - build Abc cilk parallel but no inherit code
-#  4 - build Abc cilk parallel and inherit code
+#  3 - build Abc parallel (thread pool) but no inherit code
+#  4 - build Abc parallel (thread pool) and inherit code
 
 AC_DEFUN([AC_CLP_ABOCA],
 [
@@ -15,8 +15,8 @@ AC_DEFUN([AC_CLP_ABOCA],
       [Enables build of the Aboca solver;
        1 - build Abc serial but no inherit code (default when built);
        2 - build Abc serial and inherit code;
-       3 - build Abc cilk parallel but no inherit code;
-       4 - build Abc cilk parallel and inherit code])],
+       3 - build Abc parallel (thread pool) but no inherit code;
+       4 - build Abc parallel (thread pool) and inherit code])],
       [use_aboca=$enableval],
       [use_aboca=no])
   if test "$use_aboca" = yes ; then
@@ -16,8 +16,10 @@
   0 - off
   1 - build Abc serial but no inherit code
   2 - build Abc serial and inherit code
-  3 - build Abc cilk parallel but no inherit code
-  4 - build Abc cilk parallel and inherit code
+  3 - build Abc parallel (thread pool) but no inherit code
+  4 - build Abc parallel (thread pool) and inherit code
+  For 3 and 4 define HAS_CILK if compiler has Cilk and it will
+  also be used for fine grained parallelism
  */
 #ifdef CLP_HAS_ABC
 #if CLP_HAS_ABC == 1
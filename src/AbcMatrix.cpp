@@ -60,6 +60,9 @@ AbcMatrix::AbcMatrix()
   , minimumObjectsScan_(-1)
   , minimumGoodReducedCosts_(-1)
 {
+#if ABC_PARALLEL == 2
+  CoinAbcMemset0(blockTime_, NUMBER_COLUMN_BLOCKS);
+#endif
 }
 
 //-------------------------------------------------------------------
@@ -84,6 +87,9 @@ AbcMatrix::AbcMatrix(const AbcMatrix &rhs)
 #endif
   numberColumnBlocks_ = rhs.numberColumnBlocks_;
   CoinAbcMemcpy(startColumnBlock_, rhs.startColumnBlock_, numberColumnBlocks_ + 1);
+#if ABC_PARALLEL == 2
+  CoinAbcMemset0(blockTime_, NUMBER_COLUMN_BLOCKS);
+#endif
   numberRowBlocks_ = rhs.numberRowBlocks_;
   if (numberRowBlocks_) {
     assert(model_);
@@ -131,6 +137,9 @@ AbcMatrix::AbcMatrix(const CoinPackedMatrix &rhs)
   numberColumnBlocks_ = 1;
   startColumnBlock_[0] = 0;
   startColumnBlock_[1] = 0;
+#if ABC_PARALLEL == 2
+  CoinAbcMemset0(blockTime_, NUMBER_COLUMN_BLOCKS);
+#endif
   numberRowBlocks_ = 0;
   startFraction_ = 0;
   endFraction_ = 1.0;
@@ -170,6 +179,9 @@ AbcMatrix::AbcMatrix(const AbcMatrix &wholeMatrix,
   numberColumnBlocks_ = 1;
   startColumnBlock_[0] = 0;
   startColumnBlock_[1] = 0;
+#if ABC_PARALLEL == 2
+  CoinAbcMemset0(blockTime_, NUMBER_COLUMN_BLOCKS);
+#endif
   numberRowBlocks_ = 0;
   startFraction_ = 0;
   endFraction_ = 1.0;
@@ -232,6 +244,9 @@ AbcMatrix::operator=(const AbcMatrix &rhs)
 #endif
     numberColumnBlocks_ = rhs.numberColumnBlocks_;
     CoinAbcMemcpy(startColumnBlock_, rhs.startColumnBlock_, numberColumnBlocks_ + 1);
+#if ABC_PARALLEL == 2
+    CoinAbcMemset0(blockTime_, NUMBER_COLUMN_BLOCKS);
+#endif
     numberRowBlocks_ = rhs.numberRowBlocks_;
     if (numberRowBlocks_) {
       assert(model_);
@@ -1820,6 +1835,8 @@ void AbcMatrix::rebalance() const
      each real column is 5+2*nel
      each basic slack is 0
      each real slack is 3
+     If blocks have been timed then work in each old block is
+     scaled by measured time per unit of work
    */
 #if ABC_PARALLEL
   int howOften = CoinMax(model_->factorization()->maximumPivots(), 200);
@@ -1829,39 +1846,86 @@ void AbcMatrix::rebalance() const
       const CoinBigIndex *COIN_RESTRICT columnStart = matrix_->getVectorStarts() - maximumRows;
       const unsigned char *COIN_RESTRICT internalStatus = model_->internalStatus();
       int numberRows = model_->numberRows();
-      int total = 0;
+      // old blocks and estimated work in each
+      int numberOld = 1;
+      int oldStart[NUMBER_COLUMN_BLOCKS + 1];
+      double oldWork[NUMBER_COLUMN_BLOCKS];
+      double factor[NUMBER_COLUMN_BLOCKS];
+      oldStart[0] = 0;
+      oldStart[1] = numberTotal;
+#if ABC_PARALLEL == 2
+      double totalTime = 0.0;
+      if (numberColumnBlocks_ > 1 && startColumnBlock_[numberColumnBlocks_] == numberTotal) {
+        for (int iBlock = 0; iBlock < numberColumnBlocks_; iBlock++)
+          totalTime += blockTime_[iBlock];
+        if (totalTime > 0.0) {
+          numberOld = numberColumnBlocks_;
+          CoinAbcMemcpy(oldStart, startColumnBlock_, numberOld + 1);
+        }
+      }
+#endif
+      CoinAbcMemset0(oldWork, numberOld);
+      double total = 0.0;
       for (int iSequence = 0; iSequence < numberRows; iSequence++) {
         unsigned char iStatus = internalStatus[iSequence] & 7;
         if (iStatus < 4)
-          total += 3;
+          total += 3.0;
       }
-      int totalSlacks = total;
+      double totalSlacks = total;
+      oldWork[0] = total;
+      int iOld = 0;
       CoinBigIndex end = columnStart[maximumRows];
       for (int iSequence = maximumRows; iSequence < numberTotal; iSequence++) {
         CoinBigIndex start = end;
         end = columnStart[iSequence + 1];
+        while (iSequence >= oldStart[iOld + 1])
+          iOld++;
         unsigned char iStatus = internalStatus[iSequence] & 7;
         if (iStatus < 4)
-          total += 5 + 2 * (end - start);
+          oldWork[iOld] += 5 + 2 * (end - start);
         else
-          total += 1;
+          oldWork[iOld] += 1.0;
+      }
+      total = 0.0;
+      for (iOld = 0; iOld < numberOld; iOld++)
+        total += oldWork[iOld];
+      for (iOld = 0; iOld < numberOld; iOld++)
+        factor[iOld] = 1.0;
+#if ABC_PARALLEL == 2
+      if (numberOld > 1) {
+        // time per unit of work relative to average (damped)
+        for (iOld = 0; iOld < numberOld; iOld++) {
+          if (oldWork[iOld] > 0.0 && blockTime_[iOld] > 0.0) {
+            double relative = (blockTime_[iOld] / totalTime) / (oldWork[iOld] / total);
+            factor[iOld] = CoinMin(CoinMax(relative, 0.25), 4.0);
+          }
+        }
+        total = 0.0;
+        for (iOld = 0; iOld < numberOld; iOld++)
+          total += factor[iOld] * oldWork[iOld];
       }
-      int chunk = (total + numberCpus - 1) / numberCpus;
-      total = totalSlacks;
+      CoinAbcMemset0(blockTime_, NUMBER_COLUMN_BLOCKS);
+#endif
+      double chunk = total / numberCpus;
+      // slacks are in block 0
+      total = factor[0] * totalSlacks;
       int iCpu = 0;
+      iOld = 0;
       startColumnBlock_[0] = 0;
       end = columnStart[maximumRows];
       for (int iSequence = maximumRows; iSequence < numberTotal; iSequence++) {
         CoinBigIndex start = end;
         end = columnStart[iSequence + 1];
+        while (iSequence >= oldStart[iOld + 1])
+          iOld++;
         unsigned char iStatus = internalStatus[iSequence] & 7;
         if (iStatus < 4)
-          total += 5 + 2 * (end - start);
+          total += factor[iOld] * (5 + 2 * (end - start));
         else
-          total += 1;
-        if (total > chunk) {
+          total += factor[iOld];
+        if (total > chunk && iCpu < numberCpus - 1) {
           iCpu++;
-          total = 0;
+          total = 0.0;
           startColumnBlock_[iCpu] = iSequence;
         }
       }
@@ -218,8 +218,17 @@ public:
     const CoinIndexedVector &update,
     CoinPartitionedVector &tableauRow,
     CoinPartitionedVector &candidateList) const;
-  /// rebalance for parallel
+  /** rebalance for parallel.
+      Blocks are sized on estimated work per column, scaled by
+      measured time per unit of work in each block if available */
   void rebalance() const;
+#if ABC_PARALLEL == 2
+  /// Adds time spent in a column block (used by rebalance)
+  inline void addBlockTime(int iBlock, double time) const
+  {
+    blockTime_[iBlock] += time;
+  }
+#endif
   /// Get sequenceIn when Dantzig
   int pivotColumnDantzig(const CoinIndexedVector &updates,
     CoinPartitionedVector &spare) const;
@@ -468,6 +477,10 @@ protected:
   int blockStart_[NUMBER_ROW_BLOCKS + 1];
   /// Number of actual column blocks
   mutable int numberColumnBlocks_;
+#if ABC_PARALLEL == 2
+  /// Time spent in each column block since last rebalance
+  mutable double blockTime_[NUMBER_COLUMN_BLOCKS];
+#endif
   /// Number of actual row blocks
   int numberRowBlocks_;
   //#define COUNT_COPY
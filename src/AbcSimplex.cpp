@@ -31,6 +31,9 @@
 #include "CoinAbcHelperFunctions.hpp"
 #include "CoinModel.hpp"
 #include "CoinLpIO.hpp"
+#if ABC_PARALLEL == 2
+#include "ClpThreadPool.hpp"
+#endif
 #include <cfloat>
 
 #include <string>
@@ -259,6 +262,9 @@ void AbcSimplex::gutsOfDelete(int type)
     delete abcBaseModel_;
     delete clpModel_;
     delete abcNonLinearCost_;
+#if ABC_PARALLEL == 2
+    delete abcThreadPool_;
+#endif
   }
   CoinAbcMemset0(reinterpret_cast< char * >(&scaleToExternal_),
     reinterpret_cast< char * >(&usefulArray_[0]) - reinterpret_cast< char * >(&scaleToExternal_));
@@ -6305,6 +6311,19 @@ int AbcSimplex::whichThread() const
   return whichThread;
 }
 #endif
+#if ABC_PARALLEL == 2
+// Thread pool for overlapped steps
+ClpThreadPool *AbcSimplex::abcThreadPool()
+{
+  if (!parallelMode_)
+    return NULL;
+  if (!abcThreadPool_)
+    abcThreadPool_ = new ClpThreadPool(parallelMode_);
+  else if (abcThreadPool_->numberThreads() != parallelMode_)
+    abcThreadPool_->setNumberThreads(parallelMode_);
+  return abcThreadPool_;
+}
+#endif
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
@@ -29,6 +29,7 @@ class CoinWarmStartBasis;
 class ClpDisasterHandler;
 class AbcSimplexProgress;
 class AbcMatrix;
+class ClpThreadPool;
 class AbcTolerancesEtc;
 
 /** This solves LPs using the simplex method
@@ -897,6 +898,11 @@ public:
   {
     return parallelMode_ + 1;
   }
+#if ABC_PARALLEL == 2
+  /** Thread pool for overlapped steps (created with parallelMode
+      threads on first use).  NULL if parallelMode is zero */
+  ClpThreadPool *abcThreadPool();
+#endif
 #if ABC_PARALLEL == 1
   /// set stop start
   inline void setStopStart(int value)
@@ -1411,6 +1417,10 @@ protected:
       analysis.  If it doesn't work it can easily be replaced.
   */
   AbcNonLinearCost *abcNonLinearCost_;
+#if ABC_PARALLEL == 2
+  /// Persistent threads for overlapped steps
+  ClpThreadPool *abcThreadPool_;
+#endif
   /// Useful arrays (all of row+column+2 length)
   /* has secondary offset and counts so row goes first then column
      Probably back to CoinPartitionedVector as AbcMatrix has slacks
@@ -103,6 +103,9 @@
 #include "AbcDualRowSteepest.hpp"
 #include "ClpMessage.hpp"
 #include "ClpLinearObjective.hpp"
+#if ABC_PARALLEL == 2
+#include "ClpThreadPool.hpp"
+#endif
 class ClpSimplex;
 #include <cfloat>
 #include <cassert>
@@ -2354,17 +2357,15 @@ int AbcSimplex::gutsOfSolution(int type)
       startParallelStuff(1);
 #else
       whichArray[0] = 1;
-      CoinThreadInfo info;
-      info.status = 1;
-      info.stuff[0] = whichArray[1];
-      info.stuff[1] = whichArray[2];
-      int n = cilk_spawn computeDualsAndCheck(dual, whichArray + 1);
+      int n = 0;
+      ClpTaskGroup tasks(abcThreadPool());
+      tasks.spawn([dual, &whichArray, &n] { n = computeDualsAndCheck(dual, whichArray + 1); });
 #endif
       numberRefinements = computePrimalsAndCheck(dual, whichArray + 3);
 #if ABC_PARALLEL == 1
       numberRefinements += stopParallelStuff(1);
 #else
-      cilk_sync;
+      tasks.sync();
       numberRefinements += n;
 #endif
     }
@@ -337,6 +337,11 @@ void AbcSimplexFactorization::synchronize(const ClpFactorization *otherFactoriza
   goLongThreshold_ = otherFactorization->goOslThreshold();
   //forceOtherFactorization(otherFactorization->typeOfFactorization());
   goDenseOrSmall(model->numberRows());
+#ifndef ABC_USE_COIN_FACTORIZATION
+  // -2 to -100 is percentage density at which to go dense
+  if (goDenseThreshold_ < -1)
+    setDenseDensity(-0.01 * goDenseThreshold_);
+#endif
   maximumPivots(static_cast< int >(otherFactorization->maximumPivots() * 1.2));
 #ifdef ABC_USE_COIN_FACTORIZATION
   // redo region sizes
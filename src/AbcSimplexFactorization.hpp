@@ -414,6 +414,15 @@ public:
   /// So we can temporarily switch off dense
   void setDenseThreshold(int number);
   int getDenseThreshold() const;
+#ifndef ABC_USE_COIN_FACTORIZATION
+  /** Sets density at which CoinAbcFactorization goes over to dense
+      (0.0 means size dependent default).  goDenseOrSmall creates a new
+      factorization so call after that. */
+  inline void setDenseDensity(double value)
+  {
+    coinAbcFactorization_->setDenseDensity(value);
+  }
+#endif
   /// If nonzero force use of 1,dense 2,small 3,long
   void forceOtherFactorization(int which);
   /// Go over to dense code
@@ -15,6 +15,10 @@
 #include "AbcDualRowDantzig.hpp"
 #include "ClpMessage.hpp"
 #include "ClpLinearObjective.hpp"
+#if ABC_PARALLEL == 2
+#include "ClpThreadPool.hpp"
+#include "CoinTime.hpp"
+#endif
 #include <cfloat>
 #include <cassert>
 #include <string>
@@ -907,7 +911,9 @@ int cilk_conflict = 0;
 #ifdef EARLY_FACTORIZE
 static int doEarlyFactorization(AbcSimplexDual *dual)
 {
-  int returnCode = cilk_spawn dual->whileIteratingParallel(123456789);
+  int returnCode;
+  ClpTaskGroup tasks(dual->abcThreadPool());
+  tasks.spawn([dual, &returnCode] { returnCode = dual->whileIteratingParallel(123456789); });
   CoinIndexedVector &vector = *dual->usefulArray(ABC_NUMBER_USEFUL - 1);
   int status = dual->earlyFactorization()->factorize(dual, vector);
 #if 0
@@ -926,7 +932,7 @@ static int doEarlyFactorization(AbcSimplexDual *dual)
     printf("bad early factorization in doEarly - switch off\n");
     vector.setNumElements(-1);
   }
-  cilk_sync;
+  tasks.sync();
   return returnCode;
 }
 #endif
@@ -1120,10 +1126,13 @@ void AbcSimplexDual::createDualPricingVectorCilk()
     abcFactorization_->updateColumnTranspose(usefulArray_[arrayForBtran_]);
 #if MOVE_REPLACE_PART1A > 0
   } else {
-    cilk_spawn abcFactorization_->checkReplacePart1a(&usefulArray_[arrayForReplaceColumn_], pivotRow_);
+    ClpTaskGroup tasks(abcThreadPool());
+    tasks.spawn([this] {
+      abcFactorization_->checkReplacePart1a(&usefulArray_[arrayForReplaceColumn_], pivotRow_);
+    });
     usefulArray_[arrayForBtran_].createOneUnpackedElement(pivotRow_, -directionOut_);
     abcFactorization_->updateColumnTransposeCpu(usefulArray_[arrayForBtran_], 1);
-    cilk_sync;
+    tasks.sync();
   }
 #endif
   sequenceIn_ = -1;
@@ -1155,25 +1164,27 @@ int AbcSimplexDual::getTableauColumnFlipAndStartReplaceCilk()
   // move checking stuff down into called functions
   // threads 2 and 3 are available
   int numberFlipped;
-  //cilk
   getTableauColumnPart1Cilk();
+  ClpTaskGroup tasks(abcThreadPool());
 #if MOVE_REPLACE_PART1A <= 0
-  cilk_spawn getTableauColumnPart2();
+  tasks.spawn([this] { getTableauColumnPart2(); });
 #if MOVE_REPLACE_PART1A == 0
-  cilk_spawn checkReplacePart1();
+  tasks.spawn([this] { checkReplacePart1(); });
 #endif
   numberFlipped = flipBounds();
-  cilk_sync;
+  tasks.sync();
 #else
   if (abcFactorization_->usingFT()) {
-    cilk_spawn getTableauColumnPart2();
-    ftAlpha_ = cilk_spawn abcFactorization_->checkReplacePart1b(&usefulArray_[arrayForReplaceColumn_], pivotRow_);
+    tasks.spawn([this] { getTableauColumnPart2(); });
+    tasks.spawn([this] {
+      ftAlpha_ = abcFactorization_->checkReplacePart1b(&usefulArray_[arrayForReplaceColumn_], pivotRow_);
+    });
     numberFlipped = flipBounds();
-    cilk_sync;
+    tasks.sync();
   } else {
-    cilk_spawn getTableauColumnPart2();
+    tasks.spawn([this] { getTableauColumnPart2(); });
     numberFlipped = flipBounds();
-    cilk_sync;
+    tasks.sync();
   }
 #endif
   //usefulArray_[arrayForTableauRow_].compact();
@@ -1372,11 +1383,12 @@ int AbcSimplexDual::whileIteratingParallel(int numberIterations)
       else if (abcFactorization_->pivots() < 5)
         acceptablePivot_ *= 1.0e1;
     }
+    // weights update overlaps rest of iteration up to sync below
+    ClpTaskGroup weightsTask(abcThreadPool());
 #ifdef MOVE_UPDATE_WEIGHTS
     // copy btran across
     usefulArray_[5].copy(usefulArray_[arrayForBtran_]);
-    cilk_spawn abcDualRowPivot_->updateWeightsOnly(usefulArray_[5]);
-    ;
+    weightsTask.spawn([this] { abcDualRowPivot_->updateWeightsOnly(usefulArray_[5]); });
 #endif
     dualColumn1();
     acceptablePivot_ = saveAcceptable;
@@ -1388,8 +1400,7 @@ int AbcSimplexDual::whileIteratingParallel(int numberIterations)
     }
     if (!stateOfIteration_) {
 #ifndef MOVE_UPDATE_WEIGHTS
-      cilk_spawn abcDualRowPivot_->updateWeightsOnly(usefulArray_[arrayForBtran_]);
-      ;
+      weightsTask.spawn([this] { abcDualRowPivot_->updateWeightsOnly(usefulArray_[arrayForBtran_]); });
 #endif
       // get sequenceIn_
       dualPivotColumn();
@@ -1404,7 +1415,7 @@ int AbcSimplexDual::whileIteratingParallel(int numberIterations)
         stateOfIteration_ = 2;
       }
     }
-    cilk_sync;
+    weightsTask.sync();
     // Check event
     {
       int status = eventHandler_->event(ClpEventHandler::endOfIteration);
@@ -1493,12 +1504,13 @@ int AbcSimplexDual::whileIteratingParallel(int numberIterations)
       // can do these in parallel
       // No idea why I need this - but otherwise runs not repeatable (try again??)
       //usefulArray_[3].compact();
-      cilk_spawn updateDualsInDual();
+      ClpTaskGroup tasks(abcThreadPool());
+      tasks.spawn([this] { updateDualsInDual(); });
       int lastSequenceOut;
       int lastDirectionOut;
       if (firstFree_ < 0) {
         // can do in parallel
-        cilk_spawn replaceColumnPart3();
+        tasks.spawn([this] { replaceColumnPart3(); });
         updatePrimalSolution();
         swapPrimalStuff();
         // dualRow will go to virtual row pivot choice algorithm
@@ -1507,10 +1519,10 @@ int AbcSimplexDual::whileIteratingParallel(int numberIterations)
         lastSequenceOut = sequenceOut_;
         lastDirectionOut = directionOut_;
         dualPivotRow();
-        cilk_sync;
+        tasks.sync();
       } else {
         // be more careful as dualPivotRow may do update
-        cilk_spawn replaceColumnPart3();
+        tasks.spawn([this] { replaceColumnPart3(); });
         updatePrimalSolution();
         swapPrimalStuff();
         // dualRow will go to virtual row pivot choice algorithm
@@ -1518,7 +1530,7 @@ int AbcSimplexDual::whileIteratingParallel(int numberIterations)
         // use Btran array and clear inside dualPivotRow (if used)
         lastSequenceOut = sequenceOut_;
         lastDirectionOut = directionOut_;
-        cilk_sync;
+        tasks.sync();
         dualPivotRow();
       }
       lastPivotRow_ = pivotRow_;
@@ -1529,7 +1541,7 @@ int AbcSimplexDual::whileIteratingParallel(int numberIterations)
         createDualPricingVectorCilk();
         swapDualStuff(lastSequenceOut, lastDirectionOut);
       }
-      cilk_sync;
+      tasks.sync();
     } else {
       // after moving dual in values pass
       dualPivotRow();
@@ -1633,15 +1645,18 @@ double parallelDual4(AbcSimplexDual *dual)
 #if ABC_PARALLEL
     if (numberBlocks > 1) {
 #if ABC_PARALLEL == 2
+      ClpTaskGroup tasks(dual->abcThreadPool());
       for (int i = 0; i < numberBlocks; i++) {
         info[i].stuff[1] = i;
         info[i].stuff[2] = -1;
         info[i].result = upperTheta;
-        info[i].result = cilk_spawn
-                           matrix->dualColumn1Row(info[i].stuff[1], COIN_DBL_MAX, info[i].stuff[2],
-                             update, tableauRow, candidateList);
+        CoinThreadInfo *thisInfo = info + i;
+        tasks.spawn([matrix, thisInfo, &update, &tableauRow, &candidateList] {
+          thisInfo->result = matrix->dualColumn1Row(thisInfo->stuff[1], COIN_DBL_MAX, thisInfo->stuff[2],
+            update, tableauRow, candidateList);
+        });
       }
-      cilk_sync;
+      tasks.sync();
 #else
       // parallel 1
       for (int i = 0; i < numberBlocks; i++) {
@@ -1683,16 +1698,21 @@ double parallelDual4(AbcSimplexDual *dual)
 #if ABC_PARALLEL
     if (numberBlocks > 1) {
 #if ABC_PARALLEL == 2
-      // do by column
+      // do by column (timing each block so rebalance can even out)
+      ClpTaskGroup tasks(dual->abcThreadPool());
       for (int i = 0; i < numberBlocks; i++) {
         info[i].stuff[1] = i;
         info[i].result = upperTheta;
-        cilk_spawn
-          matrix->dualColumn1Part(info[i].stuff[1], info[i].stuff[2],
-            info[i].result,
+        CoinThreadInfo *thisInfo = info + i;
+        tasks.spawn([matrix, thisInfo, &update, &tableauRow, &candidateList] {
+          double startTime = CoinGetTimeOfDay();
+          matrix->dualColumn1Part(thisInfo->stuff[1], thisInfo->stuff[2],
+            thisInfo->result,
             update, tableauRow, candidateList);
+          matrix->addBlockTime(thisInfo->stuff[1], CoinGetTimeOfDay() - startTime);
+        });
       }
-      cilk_sync;
+      tasks.sync();
 #else
       // parallel 1
       // do by column
@@ -1867,7 +1887,9 @@ void parallelDual5(AbcSimplexFactorization *factorization,
    2 Left Lower Transpose Unit
    3 Left Upper Transpose NonUnit
 */
-static void CoinAbcDtrsmFactor(int m, int n, double *COIN_RESTRICT a, int lda)
+// b is rows of a (default is columns after a)
+static void CoinAbcDtrsmFactor(int m, int n, double *COIN_RESTRICT a, int lda,
+  double *COIN_RESTRICT b = NULL)
 {
   assert((m & (BLOCKING8 - 1)) == 0 && (n & (BLOCKING8 - 1)) == 0);
   assert(m == BLOCKING8);
@@ -1876,7 +1898,7 @@ static void CoinAbcDtrsmFactor(int m, int n, double *COIN_RESTRICT a, int lda)
      is at aBlocked+j*m+i*BLOCKING8
   */
   double *COIN_RESTRICT aBase2 = a;
-  double *COIN_RESTRICT bBase2 = aBase2 + lda * BLOCKING8;
+  double *COIN_RESTRICT bBase2 = b ? b : aBase2 + lda * BLOCKING8;
   for (int jj = 0; jj < n; jj += BLOCKING8) {
     double *COIN_RESTRICT bBase = bBase2;
     for (int j = jj; j < jj + BLOCKING8; j++) {
@@ -2488,6 +2510,23 @@ static int CoinAbcDgetrf2(int m, int n, double *COIN_RESTRICT a, int *ipiv)
   return 0;
 }
 
+/* Blocked right looking LU with partial pivoting.
+   Columns are factorized in panels of ABC_DENSE_PANEL (multiple of
+   BLOCKING8).  Inside a panel each BLOCKING8 strip only updates rest
+   of panel, then rest of matrix is updated once with k=panel width
+   so it is only passed through once per panel. */
+#ifndef ABC_DENSE_PANEL
+#define ABC_DENSE_PANEL 64
+#endif
+static int abcDensePanel = ABC_DENSE_PANEL;
+int CoinAbcDensePanel()
+{
+  return abcDensePanel;
+}
+void CoinAbcSetDensePanel(int width)
+{
+  abcDensePanel = CoinMax(width & ~(BLOCKING8 - 1), BLOCKING8);
+}
 int CoinAbcDgetrf(int m, int n, double *COIN_RESTRICT a, int lda, int *ipiv
 #if ABC_PARALLEL == 2
   ,
@@ -2500,33 +2539,66 @@ int CoinAbcDgetrf(int m, int n, double *COIN_RESTRICT a, int lda, int *ipiv
   if (m < BLOCKING8) {
     return CoinAbcDgetrf2(m, n, a, ipiv);
   } else {
-    for (int j = 0; j < n; j += BLOCKING8) {
-      int start = j;
-      int newSize = CoinMin(BLOCKING8, n - j);
-      int end = j + newSize;
-      int returnCode = CoinAbcDgetrf2(m - start, newSize, a + (start * lda + start * BLOCKING8),
-        ipiv + start);
-      if (!returnCode) {
-        // adjust
-        for (int k = start; k < end; k++)
-          ipiv[k] += start;
-        // swap 0<start
-        CoinAbcDlaswp(start, a, lda, start, end, ipiv);
-        if (end < n) {
-          // swap >=end
-          CoinAbcDlaswp(n - end, a + end * lda, lda, start, end, ipiv);
-          CoinAbcDtrsmFactor(newSize, n - end, a + (start * lda + start * BLOCKING8), lda);
-          CoinAbcDgemm(n - end, n - end, newSize,
-            a + start * lda + end * BLOCKING8, lda,
-            a + end * lda + start * BLOCKING8, a + end * lda + end * BLOCKING8
+    // small ones go a strip at a time
+    int panel = (n >= 4 * abcDensePanel) ? abcDensePanel : BLOCKING8;
+    for (int jPanel = 0; jPanel < n; jPanel += panel) {
+      int endPanel = CoinMin(jPanel + panel, n);
+      for (int j = jPanel; j < endPanel; j += BLOCKING8) {
+        int start = j;
+        int newSize = CoinMin(BLOCKING8, n - j);
+        int end = j + newSize;
+        int returnCode = CoinAbcDgetrf2(m - start, newSize, a + (start * lda + start * BLOCKING8),
+          ipiv + start);
+        if (!returnCode) {
+          // adjust
+          for (int k = start; k < end; k++)
+            ipiv[k] += start;
+          // swap 0<start
+          CoinAbcDlaswp(start, a, lda, start, end, ipiv);
+          if (end < endPanel) {
+            // swap rest of panel
+            CoinAbcDlaswp(endPanel - end, a + end * lda, lda, start, end, ipiv);
+            CoinAbcDtrsmFactor(newSize, endPanel - end, a + (start * lda + start * BLOCKING8), lda);
+            CoinAbcDgemm(n - end, endPanel - end, newSize,
+              a + start * lda + end * BLOCKING8, lda,
+              a + end * lda + start * BLOCKING8, a + end * lda + end * BLOCKING8
 #if ABC_PARALLEL == 2
-            ,
-            parallelMode
+              ,
+              parallelMode
 #endif
-          );
+            );
+          }
+        } else {
+          return returnCode;
+        }
+      }
+      if (endPanel < n) {
+        // swaps (all before any update) and U for rows of panel
+        double *COIN_RESTRICT aRest = a + endPanel * lda;
+        CoinAbcDlaswp(n - endPanel, aRest, lda, jPanel, endPanel, ipiv);
+        for (int j = jPanel; j < endPanel; j += BLOCKING8) {
+          int end = j + BLOCKING8;
+          CoinAbcDtrsmFactor(BLOCKING8, n - endPanel, a + (j * lda + j * BLOCKING8), lda,
+            aRest + j * BLOCKING8);
+          if (end < endPanel)
+            CoinAbcDgemm(endPanel - end, n - endPanel, BLOCKING8,
+              a + j * lda + end * BLOCKING8, lda,
+              aRest + j * BLOCKING8, aRest + end * BLOCKING8
+#if ABC_PARALLEL == 2
+              ,
+              0
+#endif
+            );
         }
-      } else {
-        return returnCode;
+        // update rest of matrix
+        CoinAbcDgemm(n - endPanel, n - endPanel, endPanel - jPanel,
+          a + jPanel * lda + endPanel * BLOCKING8, lda,
+          aRest + jPanel * BLOCKING8, aRest + endPanel * BLOCKING8
+#if ABC_PARALLEL == 2
+          ,
+          parallelMode
+#endif
+        );
       }
     }
   }
@@ -1558,6 +1558,19 @@ void establishParams(std::vector< CbcOrClpParam > &parameters)
     "Decide whether to use A Basic Optimization Code (Accelerated?) \
 and whether to try going parallel!");
   parameters.push_back(paramAboca);
+#endif
+#if defined(COIN_HAS_CLP) && CLP_MULTIPLE_FACTORIZATIONS > 0
+  {
+    CbcOrClpParam p("adaptive!Solves", "Whether to choose hyper-sparse solves by type of solve",
+      0, 3, CLP_PARAM_INT_ADAPTIVESOLVES, 1);
+    p.setLonghelp(
+      "0 - off, 1 - just collect statistics of each type of FTRAN and BTRAN, \
+2 - also choose between sparse and hyper-sparse on statistics of that type, \
+3 - also time solves and switch off hyper-sparse where slower.  \
+With 3 the path taken can depend on timing.  If on, statistics are printed after solve.");
+    p.setIntValue(0);
+    parameters.push_back(p);
+  }
 #endif
   {
     CbcOrClpParam p("allC!ommands", "Whether to print less used commands",
@@ -1959,9 +1972,11 @@ Dantzig Wolfe if primal, Benders if dual \
 #if CLP_MULTIPLE_FACTORIZATIONS > 0
   {
     CbcOrClpParam p("dense!Threshold", "Threshold for using dense factorization",
-      -1, 10000, CBC_PARAM_INT_DENSE, 1);
+      -100, 10000, CBC_PARAM_INT_DENSE, 1);
     p.setLonghelp(
-      "If processed problem <= this use dense factorization");
+      "If processed problem <= this use dense factorization. \
+For the Abc factorization a value from -2 to -100 instead gives the percentage density \
+of the remaining matrix at which to go over to dense code (-1 leaves default).");
     p.setIntValue(-1);
     parameters.push_back(p);
   }
@@ -2746,6 +2761,12 @@ This needs to be set before the import of model - so -keepnames off -import xxxx
     CbcOrClpParam p("KKT", "Whether to use KKT factorization in barrier",
       "off", CLP_PARAM_STR_KKT, 7, 1);
     p.append("on");
+    p.append("par!allel");
+    p.setLonghelp(
+      "If on the augmented (KKT) system is factorized instead of normal equations - \
+this is always done for quadratic objectives.  parallel uses a regularized LDL' \
+factorization where independent parts of the elimination tree can be done on \
+threads (if model has numberThreads greater than one).");
     parameters.push_back(p);
   }
 #endif
@@ -3680,6 +3701,18 @@ of the objective value at the root node then the search will terminate.  See 'al
 way of using absolute value rather than fraction.");
     parameters.push_back(p);
   }
+#endif
+#ifdef COIN_HAS_CLP
+  {
+    CbcOrClpParam p("restoreB!asis", "Import basis from binary file",
+      CLP_PARAM_ACTION_RESTOREBASIS, 3);
+    p.setLonghelp(
+      "This will read a basis file written by saveBasis from the given file name.  It will use\
+ the default directory given by 'directory'.  A name of '$' will use the previous value for the\
+ name.  This is initialized to 'default.bbas'.  The basis must be for a model with the same\
+ matrix structure.");
+    parameters.push_back(p);
+  }
 #endif
   {
     CbcOrClpParam p("restoreS!olution", "reads solution from file",
@@ -3818,6 +3851,19 @@ See option cuts for more information on the possible values.");
     p.setLonghelp(HEURISTICS_LONGHELP);
     parameters.push_back(p);
   }
+#endif
+#ifdef COIN_HAS_CLP
+  {
+    CbcOrClpParam p("saveB!asis", "Export basis as binary file",
+      CLP_PARAM_ACTION_SAVEBASIS);
+    p.setLonghelp(
+      "This will write a compact binary basis file (two bits per variable) to the given file\
+ name.  It is much faster and smaller than basisOut for large models.  As for basisOut, primal\
+ and dual values are also saved if outputFormat is more than 1.  It will use the default\
+ directory given by 'directory'.  A name of '$' will use the previous value for the name.  This\
+ is initialized to 'default.bbas'.");
+    parameters.push_back(p);
+  }
 #endif
   {
     CbcOrClpParam p("saveM!odel", "Save model to binary file",
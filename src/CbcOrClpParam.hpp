@@ -112,6 +112,7 @@ enum CbcOrClpParameterType
   CLP_PARAM_INT_MORESPECIALOPTIONS,
   CLP_PARAM_INT_DECOMPOSE_BLOCKS,
   CLP_PARAM_INT_VECTOR_MODE,
+  CLP_PARAM_INT_ADAPTIVESOLVES,
 
   CBC_PARAM_INT_STRONGBRANCHING = 151,
   CBC_PARAM_INT_CUTDEPTH,
@@ -292,6 +293,8 @@ enum CbcOrClpParameterType
   CLP_PARAM_ACTION_GMPL_SOLUTION,
   CLP_PARAM_ACTION_RESTORESOL,
   CLP_PARAM_ACTION_GUESS,
+  CLP_PARAM_ACTION_SAVEBASIS,
+  CLP_PARAM_ACTION_RESTOREBASIS,
 
   CBC_PARAM_ACTION_BAB = 501,
   CBC_PARAM_ACTION_MIPLIB,
@@ -0,0 +1,911 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinPragma.hpp"
+#include "CoinFinite.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "CoinModel.hpp"
+#include "CoinStructuredModel.hpp"
+#include "ClpModel.hpp"
+#include "ClpMessage.hpp"
+#include "ClpBlockStructure.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+/* Hypergraph used for finding blocks.  Vertices are split into parts
+   by recursive bisection of the heaviest part. */
+class ClpHypergraph {
+
+public:
+  ClpHypergraph(int numberVertices, int numberNets,
+    const CoinBigIndex *vertexStart, const int *vertexLength, const int *vertexNet,
+    const CoinBigIndex *netStart, const int *netLength, const int *netVertex,
+    int maximumNetSize);
+  ~ClpHypergraph();
+  /// Puts part of each vertex in part and returns number of parts
+  int partition(int maximumParts, double imbalance, double maximumCut, int *part);
+
+private:
+  /// Tries to split part iPart (vertices in which) - returns true if done
+  bool bisect(int iPart, int newPart, int *which, int numberWhich,
+    double imbalance, double maximumCut);
+  /// Puts components of which into component, returns number
+  int components(const int *which, int numberWhich, int *component);
+  /// Fiduccia-Mattheyses passes on which
+  void refine(const int *which, int numberWhich, const double *maximumWeight);
+  /// Gain of moving vertex to other side
+  int gain(int iVertex) const;
+  /// Bucket handling
+  void addToBucket(int iVertex);
+  void removeFromBucket(int iVertex);
+  void changeGain(int iVertex, int change);
+  /// Number of nets which are cut
+  int numberCut(const int *which, int numberWhich) const;
+  /// Whether net is in current bisection
+  inline bool active(int iNet) const
+  {
+    return netMark_[iNet] == stamp_;
+  }
+
+  int numberVertices_;
+  int numberNets_;
+  const CoinBigIndex *vertexStart_;
+  const int *vertexLength_;
+  const int *vertexNet_;
+  const CoinBigIndex *netStart_;
+  const int *netLength_;
+  const int *netVertex_;
+  int maximumNetSize_;
+  /// Part of each vertex
+  int *part_;
+  /// Weight of each vertex
+  double *weight_;
+  /// Side of each vertex in bisection
+  char *side_;
+  /// Locked in this pass
+  char *locked_;
+  /// Gain of each vertex
+  int *gain_;
+  /// Bucket links
+  int *next_;
+  int *previous_;
+  /// Bucket heads (2 sides)
+  int *bucket_[2];
+  /// Highest bucket which may be occupied
+  int highest_[2];
+  /// Offset so gain of -maximumGain_ is bucket 0
+  int maximumGain_;
+  /// Count on each side for each net
+  int *count_;
+  /// Marks active nets
+  int *netMark_;
+  int stamp_;
+  /// Weight on each side
+  double sideWeight_[2];
+};
+
+ClpHypergraph::ClpHypergraph(int numberVertices, int numberNets,
+  const CoinBigIndex *vertexStart, const int *vertexLength, const int *vertexNet,
+  const CoinBigIndex *netStart, const int *netLength, const int *netVertex,
+  int maximumNetSize)
+  : numberVertices_(numberVertices)
+  , numberNets_(numberNets)
+  , vertexStart_(vertexStart)
+  , vertexLength_(vertexLength)
+  , vertexNet_(vertexNet)
+  , netStart_(netStart)
+  , netLength_(netLength)
+  , netVertex_(netVertex)
+  , maximumNetSize_(maximumNetSize)
+  , maximumGain_(0)
+  , stamp_(0)
+{
+  part_ = new int[numberVertices_];
+  weight_ = new double[numberVertices_];
+  side_ = new char[numberVertices_];
+  locked_ = new char[numberVertices_];
+  gain_ = new int[numberVertices_];
+  next_ = new int[numberVertices_];
+  previous_ = new int[numberVertices_];
+  int maximumLength = 0;
+  for (int i = 0; i < numberVertices_; i++) {
+    // work is roughly elements
+    weight_[i] = vertexLength_[i] + 1.0;
+    maximumLength = CoinMax(maximumLength, vertexLength_[i]);
+  }
+  bucket_[0] = new int[2 * (2 * maximumLength + 1)];
+  bucket_[1] = bucket_[0] + 2 * maximumLength + 1;
+  count_ = new int[2 * numberNets_];
+  netMark_ = new int[numberNets_];
+  CoinZeroN(netMark_, numberNets_);
+  highest_[0] = highest_[1] = -1;
+  sideWeight_[0] = sideWeight_[1] = 0.0;
+}
+
+ClpHypergraph::~ClpHypergraph()
+{
+  delete[] part_;
+  delete[] weight_;
+  delete[] side_;
+  delete[] locked_;
+  delete[] gain_;
+  delete[] next_;
+  delete[] previous_;
+  delete[] bucket_[0];
+  delete[] count_;
+  delete[] netMark_;
+}
+
+int ClpHypergraph::partition(int maximumParts, double imbalance,
+  double maximumCut, int *part)
+{
+  int numberParts = 1;
+  int *which = new int[numberVertices_];
+  double *partWeight = new double[maximumParts];
+  char *canSplit = new char[maximumParts];
+  partWeight[0] = 0.0;
+  for (int i = 0; i < numberVertices_; i++) {
+    part_[i] = 0;
+    partWeight[0] += weight_[i];
+  }
+  canSplit[0] = 1;
+  while (numberParts < maximumParts) {
+    // split heaviest
+    int iPart = -1;
+    double largest = 0.0;
+    for (int j = 0; j < numberParts; j++) {
+      if (canSplit[j] && partWeight[j] > largest) {
+        largest = partWeight[j];
+        iPart = j;
+      }
+    }
+    if (iPart < 0)
+      break;
+    int numberWhich = 0;
+    for (int i = 0; i < numberVertices_; i++) {
+      if (part_[i] == iPart)
+        which[numberWhich++] = i;
+    }
+    if (numberWhich > 1 && bisect(iPart, numberParts, which, numberWhich, imbalance, maximumCut)) {
+      partWeight[iPart] = sideWeight_[0];
+      partWeight[numberParts] = sideWeight_[1];
+      canSplit[numberParts] = 1;
+      numberParts++;
+    } else {
+      canSplit[iPart] = 0;
+    }
+  }
+  CoinMemcpyN(part_, numberVertices_, part);
+  delete[] which;
+  delete[] partWeight;
+  delete[] canSplit;
+  return numberParts;
+}
+
+bool ClpHypergraph::bisect(int iPart, int newPart, int *which, int numberWhich,
+  double imbalance, double maximumCut)
+{
+  // mark nets wholly in this part
+  stamp_++;
+  int numberActive = 0;
+  for (int j = 0; j < numberWhich; j++) {
+    int iVertex = which[j];
+    for (CoinBigIndex k = vertexStart_[iVertex]; k < vertexStart_[iVertex] + vertexLength_[iVertex]; k++) {
+      int iNet = vertexNet_[k];
+      if (netMark_[iNet] == stamp_ || netMark_[iNet] == -stamp_)
+        continue;
+      bool inPart = netLength_[iNet] <= maximumNetSize_;
+      for (CoinBigIndex l = netStart_[iNet]; l < netStart_[iNet] + netLength_[iNet] && inPart; l++) {
+        if (part_[netVertex_[l]] != iPart)
+          inPart = false;
+      }
+      if (inPart) {
+        netMark_[iNet] = stamp_;
+        numberActive++;
+      } else {
+        netMark_[iNet] = -stamp_;
+      }
+    }
+  }
+  double totalWeight = 0.0;
+  double largestWeight = 0.0;
+  for (int j = 0; j < numberWhich; j++) {
+    totalWeight += weight_[which[j]];
+    largestWeight = CoinMax(largestWeight, weight_[which[j]]);
+  }
+  // initial split
+  int *component = new int[numberVertices_];
+  int numberComponents = components(which, numberWhich, component);
+  sideWeight_[0] = sideWeight_[1] = 0.0;
+  if (numberComponents > 1) {
+    // heaviest components first to lighter side
+    double *componentWeight = new double[numberComponents];
+    int *order = new int[numberComponents];
+    char *componentSide = new char[numberComponents];
+    for (int j = 0; j < numberComponents; j++) {
+      componentWeight[j] = 0.0;
+      order[j] = j;
+    }
+    for (int j = 0; j < numberWhich; j++)
+      componentWeight[component[which[j]]] -= weight_[which[j]];
+    CoinSort_2(componentWeight, componentWeight + numberComponents, order);
+    for (int j = 0; j < numberComponents; j++) {
+      int iSide = (sideWeight_[0] <= sideWeight_[1]) ? 0 : 1;
+      componentSide[order[j]] = static_cast< char >(iSide);
+      sideWeight_[iSide] -= componentWeight[j];
+    }
+    for (int j = 0; j < numberWhich; j++)
+      side_[which[j]] = componentSide[component[which[j]]];
+    delete[] componentWeight;
+    delete[] order;
+    delete[] componentSide;
+  } else {
+    // grow from far end of breadth first search
+    int *stack = component;
+    for (int j = 0; j < numberWhich; j++)
+      side_[which[j]] = 2;
+    int iStart = which[0];
+    for (int iGo = 0; iGo < 2; iGo++) {
+      // first go marks with 3 to find far vertex, second puts on side 0
+      char mark = static_cast< char >(iGo ? 0 : 3);
+      double target = iGo ? 0.5 * totalWeight : COIN_DBL_MAX;
+      int nStack = 1;
+      int iGet = 0;
+      stack[0] = iStart;
+      side_[iStart] = mark;
+      double weight = weight_[iStart];
+      while (iGet < nStack && weight < target) {
+        int iVertex = stack[iGet++];
+        for (CoinBigIndex k = vertexStart_[iVertex]; k < vertexStart_[iVertex] + vertexLength_[iVertex]; k++) {
+          int iNet = vertexNet_[k];
+          if (!active(iNet))
+            continue;
+          for (CoinBigIndex l = netStart_[iNet]; l < netStart_[iNet] + netLength_[iNet]; l++) {
+            int jVertex = netVertex_[l];
+            if (side_[jVertex] == 2 && weight < target) {
+              side_[jVertex] = mark;
+              stack[nStack++] = jVertex;
+              weight += weight_[jVertex];
+            }
+          }
+        }
+      }
+      if (!iGo) {
+        // last one found is far away - start again from there
+        iStart = stack[nStack - 1];
+        for (int j = 0; j < nStack; j++)
+          side_[stack[j]] = 2;
+      }
+    }
+    for (int j = 0; j < numberWhich; j++) {
+      int iVertex = which[j];
+      if (side_[iVertex] == 2)
+        side_[iVertex] = 1;
+      sideWeight_[static_cast< int >(side_[iVertex])] += weight_[iVertex];
+    }
+  }
+  delete[] component;
+  double maximumWeight[2];
+  maximumWeight[0] = CoinMax(0.5 * (1.0 + imbalance) * totalWeight,
+    0.5 * totalWeight + largestWeight);
+  maximumWeight[1] = maximumWeight[0];
+  refine(which, numberWhich, maximumWeight);
+  int nCut = numberCut(which, numberWhich);
+  bool split = sideWeight_[0] > 0.0 && sideWeight_[1] > 0.0 && nCut <= maximumCut * numberActive;
+  if (split) {
+    for (int j = 0; j < numberWhich; j++) {
+      int iVertex = which[j];
+      if (side_[iVertex])
+        part_[iVertex] = newPart;
+    }
+  }
+  return split;
+}
+
+int ClpHypergraph::components(const int *which, int numberWhich, int *component)
+{
+  for (int j = 0; j < numberWhich; j++)
+    component[which[j]] = -1;
+  int *stack = new int[numberWhich];
+  int numberComponents = 0;
+  for (int j = 0; j < numberWhich; j++) {
+    int iVertex = which[j];
+    if (component[iVertex] >= 0)
+      continue;
+    component[iVertex] = numberComponents;
+    int nStack = 1;
+    stack[0] = iVertex;
+    while (nStack) {
+      int kVertex = stack[--nStack];
+      for (CoinBigIndex k = vertexStart_[kVertex]; k < vertexStart_[kVertex] + vertexLength_[kVertex]; k++) {
+        int iNet = vertexNet_[k];
+        if (!active(iNet))
+          continue;
+        for (CoinBigIndex l = netStart_[iNet]; l < netStart_[iNet] + netLength_[iNet]; l++) {
+          int jVertex = netVertex_[l];
+          if (component[jVertex] < 0) {
+            component[jVertex] = numberComponents;
+            stack[nStack++] = jVertex;
+          }
+        }
+      }
+    }
+    numberComponents++;
+  }
+  delete[] stack;
+  return numberComponents;
+}
+
+int ClpHypergraph::gain(int iVertex) const
+{
+  int iSide = side_[iVertex];
+  int value = 0;
+  for (CoinBigIndex k = vertexStart_[iVertex]; k < vertexStart_[iVertex] + vertexLength_[iVertex]; k++) {
+    int iNet = vertexNet_[k];
+    if (!active(iNet))
+      continue;
+    if (count_[2 * iNet + iSide] == 1)
+      value++;
+    if (!count_[2 * iNet + 1 - iSide])
+      value--;
+  }
+  return value;
+}
+
+void ClpHypergraph::addToBucket(int iVertex)
+{
+  int iSide = side_[iVertex];
+  int iBucket = gain_[iVertex] + maximumGain_;
+  int *head = bucket_[iSide];
+  int iNext = head[iBucket];
+  next_[iVertex] = iNext;
+  previous_[iVertex] = -1;
+  if (iNext >= 0)
+    previous_[iNext] = iVertex;
+  head[iBucket] = iVertex;
+  highest_[iSide] = CoinMax(highest_[iSide], iBucket);
+}
+
+void ClpHypergraph::removeFromBucket(int iVertex)
+{
+  int iSide = side_[iVertex];
+  int iNext = next_[iVertex];
+  int iPrevious = previous_[iVertex];
+  if (iPrevious >= 0)
+    next_[iPrevious] = iNext;
+  else
+    bucket_[iSide][gain_[iVertex] + maximumGain_] = iNext;
+  if (iNext >= 0)
+    previous_[iNext] = iPrevious;
+}
+
+void ClpHypergraph::changeGain(int iVertex, int change)
+{
+  if (!locked_[iVertex]) {
+    removeFromBucket(iVertex);
+    gain_[iVertex] += change;
+    addToBucket(iVertex);
+  }
+}
+
+void ClpHypergraph::refine(const int *which, int numberWhich, const double *maximumWeight)
+{
+  maximumGain_ = 0;
+  for (int j = 0; j < numberWhich; j++) {
+    int iVertex = which[j];
+    int n = 0;
+    for (CoinBigIndex k = vertexStart_[iVertex]; k < vertexStart_[iVertex] + vertexLength_[iVertex]; k++) {
+      if (active(vertexNet_[k]))
+        n++;
+    }
+    maximumGain_ = CoinMax(maximumGain_, n);
+  }
+  if (!maximumGain_)
+    return;
+  int *moved = new int[numberWhich];
+  for (int iPass = 0; iPass < 10; iPass++) {
+    // counts and gains
+    for (int j = 0; j < numberWhich; j++) {
+      int iVertex = which[j];
+      for (CoinBigIndex k = vertexStart_[iVertex]; k < vertexStart_[iVertex] + vertexLength_[iVertex]; k++) {
+        int iNet = vertexNet_[k];
+        count_[2 * iNet] = 0;
+        count_[2 * iNet + 1] = 0;
+      }
+    }
+    for (int j = 0; j < numberWhich; j++) {
+      int iVertex = which[j];
+      int iSide = side_[iVertex];
+      for (CoinBigIndex k = vertexStart_[iVertex]; k < vertexStart_[iVertex] + vertexLength_[iVertex]; k++)
+        count_[2 * vertexNet_[k] + iSide]++;
+    }
+    for (int i = 0; i < 2 * maximumGain_ + 1; i++) {
+      bucket_[0][i] = -1;
+      bucket_[1][i] = -1;
+    }
+    highest_[0] = highest_[1] = -1;
+    for (int j = 0; j < numberWhich; j++) {
+      int iVertex = which[j];
+      locked_[iVertex] = 0;
+      gain_[iVertex] = gain(iVertex);
+      addToBucket(iVertex);
+    }
+    int numberMoved = 0;
+    int bestMoved = 0;
+    int cumulative = 0;
+    int bestCumulative = 0;
+    double bestBalance = fabs(sideWeight_[0] - sideWeight_[1]);
+    int sinceBest = 0;
+    while (numberMoved < numberWhich && sinceBest < 100) {
+      // best vertex which keeps balance
+      int iVertex = -1;
+      for (int iSide = 0; iSide < 2; iSide++) {
+        int *head = bucket_[iSide];
+        while (highest_[iSide] >= 0 && head[highest_[iSide]] < 0)
+          highest_[iSide]--;
+        if (highest_[iSide] < 0)
+          continue;
+        // look down bucket for one which fits
+        int jVertex = head[highest_[iSide]];
+        while (jVertex >= 0 && sideWeight_[1 - iSide] + weight_[jVertex] > maximumWeight[1 - iSide])
+          jVertex = next_[jVertex];
+        if (jVertex >= 0 && (iVertex < 0 || gain_[jVertex] > gain_[iVertex]
+                              || (gain_[jVertex] == gain_[iVertex] && sideWeight_[iSide] > sideWeight_[1 - iSide])))
+          iVertex = jVertex;
+      }
+      if (iVertex < 0)
+        break;
+      // move
+      int from = side_[iVertex];
+      int to = 1 - from;
+      cumulative += gain_[iVertex];
+      removeFromBucket(iVertex);
+      locked_[iVertex] = 1;
+      for (CoinBigIndex k = vertexStart_[iVertex]; k < vertexStart_[iVertex] + vertexLength_[iVertex]; k++) {
+        int iNet = vertexNet_[k];
+        if (!active(iNet))
+          continue;
+        CoinBigIndex start = netStart_[iNet];
+        CoinBigIndex end = start + netLength_[iNet];
+        int countTo = count_[2 * iNet + to];
+        if (!countTo) {
+          // net was not cut - others can now uncut it
+          for (CoinBigIndex l = start; l < end; l++) {
+            int jVertex = netVertex_[l];
+            if (jVertex != iVertex)
+              changeGain(jVertex, 1);
+          }
+        } else if (countTo == 1) {
+          // one on other side no longer uncuts by moving
+          for (CoinBigIndex l = start; l < end; l++) {
+            int jVertex = netVertex_[l];
+            if (side_[jVertex] == to) {
+              changeGain(jVertex, -1);
+              break;
+            }
+          }
+        }
+        count_[2 * iNet + from]--;
+        count_[2 * iNet + to]++;
+        int countFrom = count_[2 * iNet + from];
+        if (!countFrom) {
+          // all now on to side - moving any would cut
+          for (CoinBigIndex l = start; l < end; l++) {
+            int jVertex = netVertex_[l];
+            if (jVertex != iVertex)
+              changeGain(jVertex, -1);
+          }
+        } else if (countFrom == 1) {
+          // last one on from side can uncut
+          for (CoinBigIndex l = start; l < end; l++) {
+            int jVertex = netVertex_[l];
+            if (side_[jVertex] == from && jVertex != iVertex) {
+              changeGain(jVertex, 1);
+              break;
+            }
+          }
+        }
+      }
+      // side changed after gains as bucket depends on side
+      side_[iVertex] = static_cast< char >(to);
+      sideWeight_[from] -= weight_[iVertex];
+      sideWeight_[to] += weight_[iVertex];
+      moved[numberMoved++] = iVertex;
+      double balance = fabs(sideWeight_[0] - sideWeight_[1]);
+      if (cumulative > bestCumulative || (cumulative == bestCumulative && balance < bestBalance)) {
+        bestCumulative = cumulative;
+        bestBalance = balance;
+        bestMoved = numberMoved;
+        sinceBest = 0;
+      } else {
+        sinceBest++;
+      }
+    }
+    // go back to best
+    for (int j = numberMoved - 1; j >= bestMoved; j--) {
+      int iVertex = moved[j];
+      int from = side_[iVertex];
+      side_[iVertex] = static_cast< char >(1 - from);
+      sideWeight_[from] -= weight_[iVertex];
+      sideWeight_[1 - from] += weight_[iVertex];
+    }
+    if (!bestMoved)
+      break;
+  }
+  delete[] moved;
+}
+
+int ClpHypergraph::numberCut(const int *which, int numberWhich) const
+{
+  int nCut = 0;
+  for (int j = 0; j < numberWhich; j++) {
+    int iVertex = which[j];
+    for (CoinBigIndex k = vertexStart_[iVertex]; k < vertexStart_[iVertex] + vertexLength_[iVertex]; k++) {
+      int iNet = vertexNet_[k];
+      if (!active(iNet))
+        continue;
+      // only count once - from first vertex in net
+      if (netVertex_[netStart_[iNet]] != iVertex)
+        continue;
+      int iSide = side_[iVertex];
+      for (CoinBigIndex l = netStart_[iNet] + 1; l < netStart_[iNet] + netLength_[iNet]; l++) {
+        if (side_[netVertex_[l]] != iSide) {
+          nCut++;
+          break;
+        }
+      }
+    }
+  }
+  return nCut;
+}
+
+//-------------------------------------------------------------------
+// Default Constructor
+//-------------------------------------------------------------------
+ClpBlockStructure::ClpBlockStructure()
+  : type_(0)
+  , numberRows_(0)
+  , numberColumns_(0)
+  , numberBlocks_(0)
+  , rowBlock_(NULL)
+  , columnBlock_(NULL)
+  , numberLinkingRows_(0)
+  , linkingRows_(NULL)
+  , numberLinkingColumns_(0)
+  , linkingColumns_(NULL)
+  , imbalance_(0.1)
+  , maximumCutFraction_(0.05)
+  , maximumNetSize_(0)
+{
+}
+
+//-------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------
+ClpBlockStructure::ClpBlockStructure(const ClpBlockStructure &rhs)
+  : rowBlock_(NULL)
+  , columnBlock_(NULL)
+  , linkingRows_(NULL)
+  , linkingColumns_(NULL)
+{
+  gutsOfCopy(rhs);
+}
+
+//-------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------
+ClpBlockStructure::~ClpBlockStructure()
+{
+  gutsOfDelete();
+}
+
+//----------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------
+ClpBlockStructure &
+ClpBlockStructure::operator=(const ClpBlockStructure &rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+// Frees arrays
+void ClpBlockStructure::gutsOfDelete()
+{
+  delete[] rowBlock_;
+  delete[] columnBlock_;
+  delete[] linkingRows_;
+  delete[] linkingColumns_;
+  rowBlock_ = NULL;
+  columnBlock_ = NULL;
+  linkingRows_ = NULL;
+  linkingColumns_ = NULL;
+  numberBlocks_ = 0;
+  numberLinkingRows_ = 0;
+  numberLinkingColumns_ = 0;
+}
+// Puts every row and column in master (no structure)
+void ClpBlockStructure::allToMaster()
+{
+  delete[] linkingRows_;
+  delete[] linkingColumns_;
+  linkingRows_ = new int[numberRows_];
+  linkingColumns_ = new int[numberColumns_];
+  for (int i = 0; i < numberRows_; i++) {
+    rowBlock_[i] = -1;
+    linkingRows_[i] = i;
+  }
+  for (int i = 0; i < numberColumns_; i++) {
+    columnBlock_[i] = -1;
+    linkingColumns_[i] = i;
+  }
+  numberBlocks_ = 0;
+  numberLinkingRows_ = numberRows_;
+  numberLinkingColumns_ = numberColumns_;
+}
+// Copies results
+void ClpBlockStructure::gutsOfCopy(const ClpBlockStructure &rhs)
+{
+  type_ = rhs.type_;
+  numberRows_ = rhs.numberRows_;
+  numberColumns_ = rhs.numberColumns_;
+  numberBlocks_ = rhs.numberBlocks_;
+  rowBlock_ = CoinCopyOfArray(rhs.rowBlock_, numberRows_);
+  columnBlock_ = CoinCopyOfArray(rhs.columnBlock_, numberColumns_);
+  numberLinkingRows_ = rhs.numberLinkingRows_;
+  linkingRows_ = CoinCopyOfArray(rhs.linkingRows_, numberLinkingRows_);
+  numberLinkingColumns_ = rhs.numberLinkingColumns_;
+  linkingColumns_ = CoinCopyOfArray(rhs.linkingColumns_, numberLinkingColumns_);
+  imbalance_ = rhs.imbalance_;
+  maximumCutFraction_ = rhs.maximumCutFraction_;
+  maximumNetSize_ = rhs.maximumNetSize_;
+}
+// Finds structure
+int ClpBlockStructure::findStructure(const ClpModel *model, int type, int maximumBlocks)
+{
+  gutsOfDelete();
+  assert(type == 1 || type == 2);
+  type_ = type;
+  numberRows_ = model->numberRows();
+  numberColumns_ = model->numberColumns();
+  rowBlock_ = new int[numberRows_];
+  columnBlock_ = new int[numberColumns_];
+  const CoinPackedMatrix *matrix = model->matrix();
+  if (!matrix || maximumBlocks < 2 || !numberRows_ || !numberColumns_) {
+    allToMaster();
+    return 0;
+  }
+  CoinPackedMatrix columnCopy;
+  if (!matrix->isColOrdered()) {
+    columnCopy.reverseOrderedCopyOf(*matrix);
+    matrix = &columnCopy;
+  }
+  CoinPackedMatrix rowCopy;
+  rowCopy.reverseOrderedCopyOf(*matrix);
+  // vertices are columns for Dantzig-Wolfe and rows for Benders
+  const CoinPackedMatrix *vertexMatrix = (type == 1) ? matrix : &rowCopy;
+  const CoinPackedMatrix *netMatrix = (type == 1) ? &rowCopy : matrix;
+  int numberVertices = (type == 1) ? numberColumns_ : numberRows_;
+  int numberNets = (type == 1) ? numberRows_ : numberColumns_;
+  const CoinBigIndex *netStart = netMatrix->getVectorStarts();
+  const int *netLength = netMatrix->getVectorLengths();
+  const int *netVertex = netMatrix->getIndices();
+  int maximumNetSize = maximumNetSize_;
+  if (!maximumNetSize)
+    maximumNetSize = CoinMax(100, numberVertices / 20);
+  ClpHypergraph graph(numberVertices, numberNets,
+    vertexMatrix->getVectorStarts(), vertexMatrix->getVectorLengths(),
+    vertexMatrix->getIndices(), netStart, netLength, netVertex,
+    maximumNetSize);
+  int *vertexPart = (type == 1) ? columnBlock_ : rowBlock_;
+  int *netPart = (type == 1) ? rowBlock_ : columnBlock_;
+  int numberParts = graph.partition(maximumBlocks, imbalance_,
+    maximumCutFraction_, vertexPart);
+  // nets in more than one part (or none) go to master
+  for (int iNet = 0; iNet < numberNets; iNet++) {
+    int iPart = -1;
+    for (CoinBigIndex k = netStart[iNet]; k < netStart[iNet] + netLength[iNet]; k++) {
+      int jPart = vertexPart[netVertex[k]];
+      if (iPart < 0) {
+        iPart = jPart;
+      } else if (jPart != iPart) {
+        iPart = -1;
+        break;
+      }
+    }
+    netPart[iNet] = iPart;
+  }
+  // vertices only in master nets go to master
+  const CoinBigIndex *vertexStart = vertexMatrix->getVectorStarts();
+  const int *vertexLength = vertexMatrix->getVectorLengths();
+  const int *vertexNet = vertexMatrix->getIndices();
+  for (int iVertex = 0; iVertex < numberVertices; iVertex++) {
+    bool master = true;
+    for (CoinBigIndex k = vertexStart[iVertex]; k < vertexStart[iVertex] + vertexLength[iVertex]; k++) {
+      if (netPart[vertexNet[k]] >= 0) {
+        master = false;
+        break;
+      }
+    }
+    if (master)
+      vertexPart[iVertex] = -1;
+  }
+  // renumber without empty parts
+  int *newPart = new int[numberParts];
+  for (int i = 0; i < numberParts; i++)
+    newPart[i] = -1;
+  numberBlocks_ = 0;
+  for (int iVertex = 0; iVertex < numberVertices; iVertex++) {
+    int iPart = vertexPart[iVertex];
+    if (iPart >= 0 && newPart[iPart] < 0)
+      newPart[iPart] = numberBlocks_++;
+  }
+  for (int iVertex = 0; iVertex < numberVertices; iVertex++) {
+    int iPart = vertexPart[iVertex];
+    if (iPart >= 0)
+      vertexPart[iVertex] = newPart[iPart];
+  }
+  for (int iNet = 0; iNet < numberNets; iNet++) {
+    int iPart = netPart[iNet];
+    if (iPart >= 0)
+      netPart[iNet] = newPart[iPart];
+  }
+  delete[] newPart;
+  linkingRows_ = new int[numberRows_];
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    if (rowBlock_[iRow] < 0)
+      linkingRows_[numberLinkingRows_++] = iRow;
+  }
+  linkingColumns_ = new int[numberColumns_];
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (columnBlock_[iColumn] < 0)
+      linkingColumns_[numberLinkingColumns_++] = iColumn;
+  }
+  char generalPrint[200];
+  sprintf(generalPrint, "%s structure - %d blocks, %d linking rows and %d linking columns",
+    (type == 1) ? "Dantzig-Wolfe" : "Benders", numberBlocks_,
+    numberLinkingRows_, numberLinkingColumns_);
+  CoinMessages messages = model->messages();
+  model->messageHandler()->message(CLP_GENERAL, messages)
+    << generalPrint
+    << CoinMessageEol;
+  if (numberBlocks_ < 2)
+    allToMaster();
+  return numberBlocks_;
+}
+// Adds one block to structured model
+static void addStructuredBlock(const ClpModel *model, CoinStructuredModel &structured,
+  const CoinPackedMatrix &matrix, const std::string &rowName, const std::string &columnName,
+  int numberRows, const int *whichRow, int numberColumns, const int *whichColumn,
+  bool rowBounds, bool columnBounds)
+{
+  CoinPackedMatrix subMatrix(matrix, numberRows, whichRow, numberColumns, whichColumn);
+  double *rowLower = NULL;
+  double *rowUpper = NULL;
+  if (rowBounds) {
+    rowLower = new double[numberRows];
+    rowUpper = new double[numberRows];
+    const double *lower = model->rowLower();
+    const double *upper = model->rowUpper();
+    for (int i = 0; i < numberRows; i++) {
+      rowLower[i] = lower[whichRow[i]];
+      rowUpper[i] = upper[whichRow[i]];
+    }
+  }
+  double *columnLower = NULL;
+  double *columnUpper = NULL;
+  double *objective = NULL;
+  if (columnBounds) {
+    columnLower = new double[numberColumns];
+    columnUpper = new double[numberColumns];
+    objective = new double[numberColumns];
+    const double *lower = model->columnLower();
+    const double *upper = model->columnUpper();
+    const double *cost = model->objective();
+    for (int i = 0; i < numberColumns; i++) {
+      columnLower[i] = lower[whichColumn[i]];
+      columnUpper[i] = upper[whichColumn[i]];
+      objective[i] = cost[whichColumn[i]];
+    }
+  }
+  CoinModel *block = new CoinModel(numberRows, numberColumns, &subMatrix,
+    rowLower, rowUpper, columnLower, columnUpper, objective);
+  block->setOriginalIndices(whichRow, whichColumn);
+  structured.addBlock(rowName, columnName, block);
+  delete[] rowLower;
+  delete[] rowUpper;
+  delete[] columnLower;
+  delete[] columnUpper;
+  delete[] objective;
+}
+// Creates structured model
+int ClpBlockStructure::createStructuredModel(const ClpModel *model,
+  CoinStructuredModel &structured) const
+{
+  if (!numberBlocks_)
+    return 0;
+  assert(model->numberRows() == numberRows_ && model->numberColumns() == numberColumns_);
+  CoinPackedMatrix matrix(*model->matrix());
+  if (!matrix.isColOrdered())
+    matrix.reverseOrdering();
+  // rows and columns of each block in order (master last)
+  int *rowStart = new int[numberBlocks_ + 2];
+  int *columnStart = new int[numberBlocks_ + 2];
+  int *whichRow = new int[numberRows_];
+  int *whichColumn = new int[numberColumns_];
+  CoinZeroN(rowStart, numberBlocks_ + 2);
+  CoinZeroN(columnStart, numberBlocks_ + 2);
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    int iBlock = rowBlock_[iRow];
+    rowStart[(iBlock >= 0) ? iBlock + 1 : numberBlocks_ + 1]++;
+  }
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    int iBlock = columnBlock_[iColumn];
+    columnStart[(iBlock >= 0) ? iBlock + 1 : numberBlocks_ + 1]++;
+  }
+  for (int iBlock = 0; iBlock <= numberBlocks_; iBlock++) {
+    rowStart[iBlock + 1] += rowStart[iBlock];
+    columnStart[iBlock + 1] += columnStart[iBlock];
+  }
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    int iBlock = rowBlock_[iRow];
+    if (iBlock < 0)
+      iBlock = numberBlocks_;
+    whichRow[rowStart[iBlock]++] = iRow;
+  }
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    int iBlock = columnBlock_[iColumn];
+    if (iBlock < 0)
+      iBlock = numberBlocks_;
+    whichColumn[columnStart[iBlock]++] = iColumn;
+  }
+  for (int iBlock = numberBlocks_; iBlock > 0; iBlock--) {
+    rowStart[iBlock] = rowStart[iBlock - 1];
+    columnStart[iBlock] = columnStart[iBlock - 1];
+  }
+  rowStart[0] = 0;
+  columnStart[0] = 0;
+  structured.setObjectiveOffset(model->objectiveOffset());
+  structured.setOptimizationDirection(model->optimizationDirection());
+  std::string master = "master";
+  int numberMasterRows = numberRows_ - rowStart[numberBlocks_];
+  const int *masterRow = whichRow + rowStart[numberBlocks_];
+  int numberMasterColumns = numberColumns_ - columnStart[numberBlocks_];
+  const int *masterColumn = whichColumn + columnStart[numberBlocks_];
+  for (int iBlock = 0; iBlock < numberBlocks_; iBlock++) {
+    char name[20];
+    sprintf(name, "block_%d", iBlock);
+    std::string blockName = name;
+    int numberRows = rowStart[iBlock + 1] - rowStart[iBlock];
+    const int *row = whichRow + rowStart[iBlock];
+    int numberColumns = columnStart[iBlock + 1] - columnStart[iBlock];
+    const int *column = whichColumn + columnStart[iBlock];
+    // diagonal
+    addStructuredBlock(model, structured, matrix, blockName, blockName,
+      numberRows, row, numberColumns, column, true, true);
+    // coupling - always there (may be empty) so solve can decode
+    if (type_ == 1)
+      addStructuredBlock(model, structured, matrix, master, blockName,
+        numberMasterRows, masterRow, numberColumns, column, false, false);
+    else
+      addStructuredBlock(model, structured, matrix, blockName, master,
+        numberRows, row, numberMasterColumns, masterColumn, false, false);
+  }
+  // master (may have no columns for Dantzig-Wolfe or no rows for Benders)
+  addStructuredBlock(model, structured, matrix, master, master,
+    numberMasterRows, masterRow, numberMasterColumns, masterColumn, true, true);
+  delete[] rowStart;
+  delete[] columnStart;
+  delete[] whichRow;
+  delete[] whichColumn;
+  return numberBlocks_;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
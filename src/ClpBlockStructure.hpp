@@ -0,0 +1,178 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpBlockStructure_H
+#define ClpBlockStructure_H
+
+#include "CoinPragma.hpp"
+#include "ClpConfig.h"
+
+class ClpModel;
+class CoinStructuredModel;
+
+/** Finds bordered block diagonal structure in a flat model
+
+    The matrix is treated as a hypergraph and partitioned by recursive
+    bisection (Fiduccia-Mattheyses refinement).  For Dantzig-Wolfe the
+    vertices are columns and the nets rows, so rows which cross blocks
+    become linking (master) rows.  For Benders it is the other way round
+    and crossing columns become linking (master) columns.  Columns (rows)
+    which are only in linking rows (columns) also go to the master.
+
+    Very long nets are not used to guide the partitioning - they are
+    normally linking anyway.  If what is left falls apart into independent
+    pieces those are used as they are, otherwise a bisection is only
+    accepted if it cuts a small fraction of nets.
+
+    createStructuredModel then builds a CoinStructuredModel which
+    ClpSimplex::solve(CoinStructuredModel *) will pass to solveDW
+    or solveBenders.
+*/
+
+class CLPLIB_EXPORT ClpBlockStructure {
+
+public:
+  /**@name Find structure */
+  //@{
+  /** Finds structure.  type 1 looks for linking rows (Dantzig-Wolfe),
+         type 2 for linking columns (Benders).
+         Returns number of blocks.  If no useful structure is found
+         (fewer than two blocks) 0 is returned and every row and column
+         is left in master. */
+  int findStructure(const ClpModel *model, int type, int maximumBlocks = 50);
+  /** Adds blocks to an empty structured model.  findStructure must have
+         been called with same model.  Returns number of blocks. */
+  int createStructuredModel(const ClpModel *model,
+    CoinStructuredModel &structured) const;
+  //@}
+
+  /**@name Results */
+  //@{
+  /// Type of structure (1 Dantzig-Wolfe, 2 Benders)
+  inline int type() const
+  {
+    return type_;
+  }
+  /// Number of blocks (not counting master)
+  inline int numberBlocks() const
+  {
+    return numberBlocks_;
+  }
+  /// Block of each row (-1 if master)
+  inline const int *rowBlock() const
+  {
+    return rowBlock_;
+  }
+  /// Block of each column (-1 if master)
+  inline const int *columnBlock() const
+  {
+    return columnBlock_;
+  }
+  /// Number of rows in master
+  inline int numberLinkingRows() const
+  {
+    return numberLinkingRows_;
+  }
+  /// Rows in master
+  inline const int *linkingRows() const
+  {
+    return linkingRows_;
+  }
+  /// Number of columns in master
+  inline int numberLinkingColumns() const
+  {
+    return numberLinkingColumns_;
+  }
+  /// Columns in master
+  inline const int *linkingColumns() const
+  {
+    return linkingColumns_;
+  }
+  //@}
+
+  /**@name Parameters */
+  //@{
+  /// Largest half of a bisection may be this fraction above half (default 0.1)
+  inline double imbalance() const
+  {
+    return imbalance_;
+  }
+  inline void setImbalance(double value)
+  {
+    imbalance_ = value;
+  }
+  /// Bisection is rejected if it cuts more than this fraction of nets (default 0.05)
+  inline double maximumCutFraction() const
+  {
+    return maximumCutFraction_;
+  }
+  inline void setMaximumCutFraction(double value)
+  {
+    maximumCutFraction_ = value;
+  }
+  /** Nets longer than this are not used in partitioning.
+         0 (default) is max(100, 5% of vertices) */
+  inline int maximumNetSize() const
+  {
+    return maximumNetSize_;
+  }
+  inline void setMaximumNetSize(int value)
+  {
+    maximumNetSize_ = value;
+  }
+  //@}
+
+  /**@name Constructors, destructor */
+  //@{
+  /** Default constructor. */
+  ClpBlockStructure();
+  /** Destructor */
+  ~ClpBlockStructure();
+  /** The copy constructor. */
+  ClpBlockStructure(const ClpBlockStructure &);
+  /// Assignment
+  ClpBlockStructure &operator=(const ClpBlockStructure &);
+  //@}
+
+private:
+  /// Frees arrays
+  void gutsOfDelete();
+  /// Copies results
+  void gutsOfCopy(const ClpBlockStructure &rhs);
+  /// Puts every row and column in master (no structure)
+  void allToMaster();
+  /**@name Data members */
+  //@{
+  /// Type
+  int type_;
+  /// Number of rows when found
+  int numberRows_;
+  /// Number of columns when found
+  int numberColumns_;
+  /// Number of blocks
+  int numberBlocks_;
+  /// Block of each row
+  int *rowBlock_;
+  /// Block of each column
+  int *columnBlock_;
+  /// Number of master rows
+  int numberLinkingRows_;
+  /// Master rows
+  int *linkingRows_;
+  /// Number of master columns
+  int numberLinkingColumns_;
+  /// Master columns
+  int *linkingColumns_;
+  /// Imbalance allowed
+  double imbalance_;
+  /// Fraction of nets which may be cut
+  double maximumCutFraction_;
+  /// Longest net used
+  int maximumNetSize_;
+  //@}
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,773 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinSort.hpp"
+#include "CoinFinite.hpp"
+#include "ClpHelperFunctions.hpp"
+
+#include "ClpInterior.hpp"
+#include "ClpCholeskyKKT.hpp"
+#include "ClpQuadraticObjective.hpp"
+#include "ClpThreadPool.hpp"
+#include "ClpMessage.hpp"
+#include <algorithm>
+#include <cstdio>
+
+//#############################################################################
+// Constructors / Destructor / Assignment
+//#############################################################################
+
+//-------------------------------------------------------------------
+// Default Constructor
+//-------------------------------------------------------------------
+ClpCholeskyKKT::ClpCholeskyKKT()
+  : ClpCholeskyBase(-1)
+  , primalRegularization_(1.0e-10)
+  , dualRegularization_(1.0e-10)
+  , numberRefinements_(1)
+  , numberRegularized_(0)
+  , numberKKT_(0)
+  , kktStart_(NULL)
+  , kktRow_(NULL)
+  , kktElement_(NULL)
+  , kktPosition_(NULL)
+  , kktWork_(NULL)
+  , parent_(NULL)
+  , rowStart_(NULL)
+  , rowColumn_(NULL)
+  , rowPosition_(NULL)
+  , numberSubtrees_(0)
+  , numberLists_(0)
+  , listStart_(NULL)
+  , listColumn_(NULL)
+  , threadPool_(NULL)
+{
+  type_ = 22;
+  doKKT_ = true;
+}
+
+//-------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------
+ClpCholeskyKKT::ClpCholeskyKKT(const ClpCholeskyKKT &rhs)
+  : ClpCholeskyBase(rhs)
+{
+  gutsOfCopy(rhs);
+}
+
+//-------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------
+ClpCholeskyKKT::~ClpCholeskyKKT()
+{
+  gutsOfDelete();
+}
+
+//----------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------
+ClpCholeskyKKT &
+ClpCholeskyKKT::operator=(const ClpCholeskyKKT &rhs)
+{
+  if (this != &rhs) {
+    ClpCholeskyBase::operator=(rhs);
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+//-------------------------------------------------------------------
+// Clone
+//-------------------------------------------------------------------
+ClpCholeskyBase *ClpCholeskyKKT::clone() const
+{
+  return new ClpCholeskyKKT(*this);
+}
+// Frees arrays
+void ClpCholeskyKKT::gutsOfDelete()
+{
+  delete[] kktStart_;
+  delete[] kktRow_;
+  delete[] kktElement_;
+  delete[] kktPosition_;
+  delete[] kktWork_;
+  delete[] parent_;
+  delete[] rowStart_;
+  delete[] rowColumn_;
+  delete[] rowPosition_;
+  delete[] listStart_;
+  delete[] listColumn_;
+  delete threadPool_;
+  kktStart_ = NULL;
+  kktRow_ = NULL;
+  kktElement_ = NULL;
+  kktPosition_ = NULL;
+  kktWork_ = NULL;
+  parent_ = NULL;
+  rowStart_ = NULL;
+  rowColumn_ = NULL;
+  rowPosition_ = NULL;
+  listStart_ = NULL;
+  listColumn_ = NULL;
+  threadPool_ = NULL;
+}
+// Copies arrays (threads are not shared)
+void ClpCholeskyKKT::gutsOfCopy(const ClpCholeskyKKT &rhs)
+{
+  primalRegularization_ = rhs.primalRegularization_;
+  dualRegularization_ = rhs.dualRegularization_;
+  numberRefinements_ = rhs.numberRefinements_;
+  numberRegularized_ = rhs.numberRegularized_;
+  numberKKT_ = rhs.numberKKT_;
+  numberSubtrees_ = rhs.numberSubtrees_;
+  numberLists_ = rhs.numberLists_;
+  CoinBigIndex numberElements = rhs.kktStart_ ? rhs.kktStart_[numberRows_] : 0;
+  kktStart_ = ClpCopyOfArray(rhs.kktStart_, numberRows_ + 1);
+  kktRow_ = ClpCopyOfArray(rhs.kktRow_, numberElements);
+  kktElement_ = ClpCopyOfArray(rhs.kktElement_, numberElements);
+  kktPosition_ = ClpCopyOfArray(rhs.kktPosition_, numberKKT_);
+  kktWork_ = ClpCopyOfArray(rhs.kktWork_, numberKKT_);
+  parent_ = ClpCopyOfArray(rhs.parent_, numberRows_);
+  rowStart_ = ClpCopyOfArray(rhs.rowStart_, numberRows_ + 1);
+  rowColumn_ = ClpCopyOfArray(rhs.rowColumn_, sizeFactor_);
+  rowPosition_ = ClpCopyOfArray(rhs.rowPosition_, sizeFactor_);
+  listStart_ = ClpCopyOfArray(rhs.listStart_, numberLists_ + 1);
+  listColumn_ = ClpCopyOfArray(rhs.listColumn_, numberRows_);
+  threadPool_ = NULL;
+  if (rhs.threadPool_)
+    threadPool_ = new ClpThreadPool(rhs.threadPool_->numberThreads());
+}
+/* Generates KKT elements (original numbering, lower triangle).
+   Sequence of elements is always the same so symbolic
+   can save where each goes */
+CoinBigIndex
+ClpCholeskyKKT::generateKKT(const CoinWorkDouble *diagonal, int *rowOut,
+  int *columnOut, double *elementOut) const
+{
+  int numberRowsModel = model_->numberRows();
+  int numberColumns = model_->numberColumns();
+  int numberTotal = numberColumns + numberRowsModel;
+  const CoinBigIndex *columnStart = model_->clpMatrix()->getVectorStarts();
+  const int *columnLength = model_->clpMatrix()->getVectorLengths();
+  const int *row = model_->clpMatrix()->getIndices();
+  const double *element = model_->clpMatrix()->getElements();
+  CoinPackedMatrix *quadratic = NULL;
+  ClpQuadraticObjective *quadraticObj = (dynamic_cast< ClpQuadraticObjective * >(model_->objectiveAsObject()));
+  if (quadraticObj)
+    quadratic = quadraticObj->quadraticObjective();
+  const int *columnQuadratic = NULL;
+  const CoinBigIndex *columnQuadraticStart = NULL;
+  const int *columnQuadraticLength = NULL;
+  const double *quadraticElement = NULL;
+  if (quadratic) {
+    columnQuadratic = quadratic->getIndices();
+    columnQuadraticStart = quadratic->getVectorStarts();
+    columnQuadraticLength = quadratic->getVectorLengths();
+    quadraticElement = quadratic->getElements();
+  }
+  CoinBigIndex numberElements = 0;
+#define ADD_KKT(ROW, COLUMN, VALUE)      \
+  {                                      \
+    if (rowOut) {                        \
+      rowOut[numberElements] = ROW;      \
+      columnOut[numberElements] = COLUMN; \
+    }                                    \
+    if (elementOut)                      \
+      elementOut[numberElements] = VALUE; \
+    numberElements++;                    \
+  }
+  for (int iColumn = 0; iColumn < numberTotal; iColumn++) {
+    double value = 0.0;
+    bool fixed = false;
+    if (diagonal) {
+      value = diagonal[iColumn];
+      if (fabs(value) > 1.0e-100) {
+        value = 1.0 / value;
+      } else {
+        value = 1.0e100;
+        fixed = true;
+      }
+    }
+    if (iColumn < numberColumns) {
+      if (quadratic) {
+        for (CoinBigIndex j = columnQuadraticStart[iColumn];
+             j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
+          int jColumn = columnQuadratic[j];
+          if (jColumn > iColumn) {
+            ADD_KKT(jColumn, iColumn, -quadraticElement[j]);
+          } else if (jColumn == iColumn && !fixed) {
+            value += quadraticElement[j];
+          }
+        }
+      }
+      ADD_KKT(iColumn, iColumn, -value);
+      for (CoinBigIndex j = columnStart[iColumn];
+           j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+        ADD_KKT(row[j] + numberTotal, iColumn, element[j]);
+      }
+    } else {
+      // slack
+      ADD_KKT(iColumn, iColumn, -value);
+      ADD_KKT(iColumn - numberColumns + numberTotal, iColumn, -1.0);
+    }
+  }
+  // Finish diagonal (regularization added in factorize)
+  double delta2 = model_->delta();
+  delta2 *= delta2;
+  for (int iRow = 0; iRow < numberRowsModel; iRow++) {
+    ADD_KKT(iRow + numberTotal, iRow + numberTotal, delta2);
+  }
+#undef ADD_KKT
+  return numberElements;
+}
+/* Orders rows and saves pointer to model.
+   Pattern is as ClpCholeskyBase KKT so use approximate minimum degree
+   from there.  Quasi-definite so any order is stable. */
+int ClpCholeskyKKT::order(ClpInterior *model)
+{
+  gutsOfDelete();
+  model_ = model;
+  if (model_->numberRows() > 6)
+    return ClpCholeskyBase::order(model);
+  // too small to bother - natural order
+  if (preOrder(true, true, true))
+    return -1;
+  numberRowsDropped_ = 0;
+  delete[] choleskyStart_;
+  choleskyStart_ = NULL;
+  delete[] choleskyRow_;
+  choleskyRow_ = NULL;
+  permuteInverse_ = new CoinBigIndex[numberRows_];
+  permute_ = new CoinBigIndex[numberRows_];
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    permute_[iRow] = iRow;
+    permuteInverse_[iRow] = iRow;
+  }
+  return 0;
+}
+/* Does Symbolic factorization given permutation.
+   Gets permuted lower triangle of KKT matrix, elimination tree and
+   structure of L (by columns and by rows).  Then splits tree into
+   subtrees which can be done independently. */
+int ClpCholeskyKKT::symbolic()
+{
+  int numberRowsModel = model_->numberRows();
+  int numberColumns = model_->numberColumns();
+  int numberTotal = numberColumns + numberRowsModel;
+  assert(numberRows_ == numberTotal + numberRowsModel);
+  int numberThreads = model_->numberThreads();
+  // get structure in original numbering
+  numberKKT_ = generateKKT(NULL, NULL, NULL, NULL);
+  int *kktRow = new int[numberKKT_];
+  int *kktColumn = new int[numberKKT_];
+  generateKKT(NULL, kktRow, kktColumn, NULL);
+  // permute and make lower
+  kktStart_ = new CoinBigIndex[numberRows_ + 1];
+  int *count = new int[numberRows_];
+  CoinZeroN(count, numberRows_);
+  for (CoinBigIndex j = 0; j < numberKKT_; j++) {
+    int iRow = permuteInverse_[kktRow[j]];
+    int iColumn = permuteInverse_[kktColumn[j]];
+    if (iRow < iColumn) {
+      int temp = iRow;
+      iRow = iColumn;
+      iColumn = temp;
+    }
+    kktRow[j] = iRow;
+    kktColumn[j] = iColumn;
+    count[iColumn]++;
+  }
+  CoinBigIndex numberElements = 0;
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++) {
+    kktStart_[iColumn] = numberElements;
+    numberElements += count[iColumn];
+    count[iColumn] = static_cast< int >(kktStart_[iColumn]);
+  }
+  kktStart_[numberRows_] = numberElements;
+  kktRow_ = new int[numberElements];
+  for (CoinBigIndex j = 0; j < numberKKT_; j++)
+    kktRow_[count[kktColumn[j]]++] = kktRow[j];
+  // sort each column (diagonal first) and merge any duplicates
+  int *mark = new int[numberRows_];
+  for (int iRow = 0; iRow < numberRows_; iRow++)
+    mark[iRow] = -1;
+  CoinBigIndex put = 0;
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++) {
+    CoinBigIndex start = kktStart_[iColumn];
+    CoinBigIndex end = kktStart_[iColumn + 1];
+    std::sort(kktRow_ + start, kktRow_ + end);
+    kktStart_[iColumn] = put;
+    for (CoinBigIndex j = start; j < end; j++) {
+      int iRow = kktRow_[j];
+      if (mark[iRow] != iColumn) {
+        mark[iRow] = iColumn;
+        kktRow_[put++] = iRow;
+      }
+    }
+    assert(kktRow_[kktStart_[iColumn]] == iColumn);
+  }
+  kktStart_[numberRows_] = put;
+  // now find where each generated element goes
+  kktPosition_ = new CoinBigIndex[numberKKT_];
+  for (CoinBigIndex j = 0; j < numberKKT_; j++) {
+    int iColumn = kktColumn[j];
+    int iRow = kktRow[j];
+    CoinBigIndex k = std::lower_bound(kktRow_ + kktStart_[iColumn],
+                       kktRow_ + kktStart_[iColumn + 1], iRow)
+      - kktRow_;
+    assert(kktRow_[k] == iRow);
+    kktPosition_[j] = k;
+  }
+  numberElements = put;
+  kktElement_ = new double[numberElements];
+  kktWork_ = new double[numberKKT_];
+  delete[] kktColumn;
+  delete[] kktRow;
+  // row copy of KKT lower triangle (strictly lower part)
+  CoinBigIndex *kktRowStart = new CoinBigIndex[numberRows_ + 1];
+  int *kktRowColumn = new int[numberElements];
+  CoinZeroN(count, numberRows_);
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++) {
+    for (CoinBigIndex j = kktStart_[iColumn] + 1; j < kktStart_[iColumn + 1]; j++)
+      count[kktRow_[j]]++;
+  }
+  numberElements = 0;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    kktRowStart[iRow] = numberElements;
+    numberElements += count[iRow];
+    count[iRow] = static_cast< int >(kktRowStart[iRow]);
+  }
+  kktRowStart[numberRows_] = numberElements;
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++) {
+    for (CoinBigIndex j = kktStart_[iColumn] + 1; j < kktStart_[iColumn + 1]; j++)
+      kktRowColumn[count[kktRow_[j]]++] = iColumn;
+  }
+  // elimination tree (Liu) using path compression
+  parent_ = new int[numberRows_];
+  int *ancestor = new int[numberRows_];
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    parent_[iRow] = -1;
+    ancestor[iRow] = -1;
+    for (CoinBigIndex j = kktRowStart[iRow]; j < kktRowStart[iRow + 1]; j++) {
+      int i = kktRowColumn[j];
+      while (i >= 0 && i != iRow) {
+        int next = ancestor[i];
+        ancestor[i] = iRow;
+        if (next < 0) {
+          parent_[i] = iRow;
+          break;
+        }
+        i = next;
+      }
+    }
+  }
+  delete[] ancestor;
+  /* Structure of L - row iRow of L is union of paths in tree from
+     each column in row iRow of KKT up to iRow.
+     First pass counts, second fills in.  Doing rows in order means
+     rows in each column of L are in increasing order. */
+  int *columnCount = new int[numberRows_];
+  CoinZeroN(columnCount, numberRows_);
+  for (int iRow = 0; iRow < numberRows_; iRow++)
+    mark[iRow] = -1;
+  CoinBigIndex sizeL = 0;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    mark[iRow] = iRow;
+    for (CoinBigIndex j = kktRowStart[iRow]; j < kktRowStart[iRow + 1]; j++) {
+      for (int i = kktRowColumn[j]; mark[i] != iRow; i = parent_[i]) {
+        mark[i] = iRow;
+        columnCount[i]++;
+        sizeL++;
+      }
+    }
+  }
+  if (sizeL > COIN_INT_MAX) {
+    delete[] kktRowStart;
+    delete[] kktRowColumn;
+    delete[] columnCount;
+    delete[] count;
+    delete[] mark;
+    return -1;
+  }
+  sizeFactor_ = static_cast< int >(sizeL);
+  sizeIndex_ = sizeFactor_;
+  try {
+    choleskyStart_ = new CoinBigIndex[numberRows_ + 1];
+    choleskyRow_ = new CoinBigIndex[sizeFactor_];
+    sparseFactor_ = new longDouble[sizeFactor_];
+    rowStart_ = new CoinBigIndex[numberRows_ + 1];
+    rowColumn_ = new int[sizeFactor_];
+    rowPosition_ = new CoinBigIndex[sizeFactor_];
+  } catch (...) {
+    // no memory
+    delete[] kktRowStart;
+    delete[] kktRowColumn;
+    delete[] columnCount;
+    delete[] count;
+    delete[] mark;
+    return -1;
+  }
+  diagonal_ = new longDouble[numberRows_];
+  workDouble_ = new longDouble[numberRows_];
+  sizeL = 0;
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++) {
+    choleskyStart_[iColumn] = sizeL;
+    sizeL += columnCount[iColumn];
+    count[iColumn] = static_cast< int >(choleskyStart_[iColumn]);
+  }
+  choleskyStart_[numberRows_] = sizeL;
+  for (int iRow = 0; iRow < numberRows_; iRow++)
+    mark[iRow] = -1;
+  sizeL = 0;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    rowStart_[iRow] = sizeL;
+    mark[iRow] = iRow;
+    for (CoinBigIndex j = kktRowStart[iRow]; j < kktRowStart[iRow + 1]; j++) {
+      for (int i = kktRowColumn[j]; mark[i] != iRow; i = parent_[i]) {
+        mark[i] = iRow;
+        CoinBigIndex put = count[i]++;
+        choleskyRow_[put] = iRow;
+        rowColumn_[sizeL] = i;
+        rowPosition_[sizeL++] = put;
+      }
+    }
+  }
+  rowStart_[numberRows_] = sizeL;
+  delete[] kktRowStart;
+  delete[] kktRowColumn;
+  /* Split tree.  Work for a column is about square of count.
+     Keep splitting heaviest subtree (putting its root in top part)
+     until it is small enough or there are plenty of subtrees. */
+  int numberSlots = CoinMax(numberThreads, 1);
+  double *weight = new double[numberRows_];
+  double totalWeight = 0.0;
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++)
+    weight[iColumn] = 0.0;
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++) {
+    double value = columnCount[iColumn] + 1.0;
+    weight[iColumn] += value * value;
+    totalWeight += value * value;
+    if (parent_[iColumn] >= 0)
+      weight[parent_[iColumn]] += weight[iColumn];
+  }
+  // children lists
+  int *firstChild = new int[numberRows_];
+  int *nextSibling = new int[numberRows_];
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++)
+    firstChild[iColumn] = -1;
+  int *candidate = count; // reuse
+  int numberCandidates = 0;
+  for (int iColumn = numberRows_ - 1; iColumn >= 0; iColumn--) {
+    int iParent = parent_[iColumn];
+    if (iParent >= 0) {
+      nextSibling[iColumn] = firstChild[iParent];
+      firstChild[iParent] = iColumn;
+    } else {
+      candidate[numberCandidates++] = iColumn;
+    }
+  }
+  int *owner = mark; // reuse
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++)
+    owner[iColumn] = -1;
+  if (numberSlots > 1) {
+    double target = totalWeight / (4.0 * numberSlots);
+    int maximumCandidates = 32 * numberSlots;
+    while (numberCandidates < maximumCandidates) {
+      int iBest = -1;
+      double best = target;
+      for (int i = 0; i < numberCandidates; i++) {
+        if (weight[candidate[i]] > best) {
+          best = weight[candidate[i]];
+          iBest = i;
+        }
+      }
+      if (iBest < 0)
+        break;
+      int iColumn = candidate[iBest];
+      // root goes to top
+      owner[iColumn] = numberSlots;
+      candidate[iBest] = candidate[--numberCandidates];
+      for (int iChild = firstChild[iColumn]; iChild >= 0; iChild = nextSibling[iChild])
+        candidate[numberCandidates++] = iChild;
+    }
+  }
+  numberSubtrees_ = numberCandidates;
+  // largest first to least loaded slot
+  double *sortWeight = new double[numberCandidates];
+  for (int i = 0; i < numberCandidates; i++)
+    sortWeight[i] = -weight[candidate[i]];
+  CoinSort_2(sortWeight, sortWeight + numberCandidates, candidate);
+  double *load = new double[numberSlots];
+  CoinZeroN(load, numberSlots);
+  for (int i = 0; i < numberCandidates; i++) {
+    int iSlot = 0;
+    for (int j = 1; j < numberSlots; j++) {
+      if (load[j] < load[iSlot])
+        iSlot = j;
+    }
+    load[iSlot] -= sortWeight[i];
+    owner[candidate[i]] = iSlot;
+  }
+  // rest of subtree follows root (parent always later)
+  for (int iColumn = numberRows_ - 1; iColumn >= 0; iColumn--) {
+    if (owner[iColumn] < 0) {
+      assert(parent_[iColumn] > iColumn);
+      owner[iColumn] = owner[parent_[iColumn]];
+    }
+  }
+  // lists in increasing order (so children before parents)
+  numberLists_ = numberSlots + 1;
+  listStart_ = new int[numberLists_ + 1];
+  listColumn_ = new int[numberRows_];
+  CoinZeroN(listStart_, numberLists_ + 1);
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++)
+    listStart_[owner[iColumn] + 1]++;
+  for (int i = 0; i < numberLists_; i++)
+    listStart_[i + 1] += listStart_[i];
+  CoinMemcpyN(listStart_, numberLists_, count);
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++)
+    listColumn_[count[owner[iColumn]]++] = iColumn;
+  if (numberSlots > 1)
+    threadPool_ = new ClpThreadPool(numberSlots - 1);
+  delete[] load;
+  delete[] sortWeight;
+  delete[] firstChild;
+  delete[] nextSibling;
+  delete[] weight;
+  delete[] columnCount;
+  delete[] count;
+  delete[] mark;
+  char line[200];
+  sprintf(line, "KKT factor has %d elements - %d subtrees, %d columns at top",
+    sizeFactor_, numberSubtrees_,
+    listStart_[numberLists_] - listStart_[numberLists_ - 1]);
+  model_->messageHandler()->message(CLP_GENERAL2, *model_->messagesPointer())
+    << line << CoinMessageEol;
+  return 0;
+}
+/* Factorizes columns in list (left looking).
+   Column j of L is column j of KKT minus contributions from
+   columns k which have an element in row j.  All such k are
+   descendants of j so are in same subtree (or done already). */
+void ClpCholeskyKKT::factorizeColumns(const int *list, int first, int last,
+  longDouble *work, double tolerance, double replacement,
+  int &numberChanged)
+{
+  int numberTotal = model_->numberColumns() + model_->numberRows();
+  for (int iList = first; iList < last; iList++) {
+    int iColumn = list[iList];
+    CoinBigIndex start = choleskyStart_[iColumn];
+    CoinBigIndex end = choleskyStart_[iColumn + 1];
+    // scatter
+    for (CoinBigIndex j = start; j < end; j++)
+      work[choleskyRow_[j]] = 0.0;
+    CoinBigIndex kStart = kktStart_[iColumn];
+    CoinWorkDouble diagonalValue = kktElement_[kStart];
+    for (CoinBigIndex j = kStart + 1; j < kktStart_[iColumn + 1]; j++)
+      work[kktRow_[j]] = kktElement_[j];
+    // updates
+    for (CoinBigIndex j = rowStart_[iColumn]; j < rowStart_[iColumn + 1]; j++) {
+      int kColumn = rowColumn_[j];
+      CoinBigIndex position = rowPosition_[j];
+      CoinWorkDouble multiplier = sparseFactor_[position] * diagonal_[kColumn];
+      diagonalValue -= multiplier * sparseFactor_[position];
+      CoinBigIndex kEnd = choleskyStart_[kColumn + 1];
+      for (CoinBigIndex k = position + 1; k < kEnd; k++)
+        work[choleskyRow_[k]] -= multiplier * sparseFactor_[k];
+    }
+    // primal part should be negative, dual positive
+    bool primal = permute_[iColumn] < numberTotal;
+    if (primal) {
+      if (diagonalValue > -tolerance) {
+        diagonalValue = -replacement;
+        numberChanged++;
+      }
+    } else {
+      if (diagonalValue < tolerance) {
+        diagonalValue = replacement;
+        numberChanged++;
+      }
+    }
+    diagonal_[iColumn] = diagonalValue;
+    CoinWorkDouble multiplier = 1.0 / diagonalValue;
+    for (CoinBigIndex j = start; j < end; j++)
+      sparseFactor_[j] = work[choleskyRow_[j]] * multiplier;
+  }
+}
+/* Factorize - filling in rowsDropped and returning number dropped.
+   Nothing is dropped - pivots are regularized instead */
+int ClpCholeskyKKT::factorize(const CoinWorkDouble *diagonal, int *rowsDropped)
+{
+  int numberRowsModel = model_->numberRows();
+  int numberColumns = model_->numberColumns();
+  int numberTotal = numberColumns + numberRowsModel;
+  // values in same order as symbolic
+  generateKKT(diagonal, NULL, NULL, kktWork_);
+  CoinBigIndex numberElements = kktStart_[numberRows_];
+  CoinZeroN(kktElement_, numberElements);
+  for (CoinBigIndex j = 0; j < numberKKT_; j++)
+    kktElement_[kktPosition_[j]] += kktWork_[j];
+  // static regularization
+  double delta2 = model_->delta();
+  delta2 *= delta2;
+  CoinWorkDouble *primalR = model_->primalR();
+  CoinWorkDouble *dualR = model_->dualR();
+  double largest = 0.0;
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++) {
+    int iOriginal = permute_[iColumn];
+    CoinBigIndex j = kktStart_[iColumn];
+    double value = kktElement_[j];
+    double extra;
+    if (iOriginal < numberTotal) {
+      extra = -primalRegularization_;
+      if (primalR)
+        primalR[iOriginal] = primalRegularization_;
+      if (value > -1.0e90)
+        largest = CoinMax(largest, fabs(value));
+    } else {
+      extra = CoinMax(dualRegularization_ - delta2, 0.0);
+      if (dualR)
+        dualR[iOriginal - numberTotal] = extra;
+      largest = CoinMax(largest, fabs(value + extra));
+    }
+    kktElement_[j] = value + extra;
+  }
+  if (rowsDropped)
+    CoinZeroN(rowsDropped, numberRowsModel);
+  memset(rowsDropped_, 0, numberRows_);
+  numberRowsDropped_ = 0;
+  double tolerance = CoinMax(1.0e-30, 1.0e-20 * largest);
+  double replacement = CoinMax(1.0e-8, 1.0e-12 * largest);
+  numberRegularized_ = 0;
+  int numberSlots = numberLists_ - 1;
+  if (numberSlots > 1) {
+    longDouble *work = new longDouble[numberSlots * numberRows_];
+    int *numberChanged = new int[numberSlots];
+    CoinZeroN(numberChanged, numberSlots);
+    {
+      ClpTaskGroup tasks(threadPool_);
+      for (int iSlot = 0; iSlot < numberSlots; iSlot++) {
+        longDouble *workSlot = work + iSlot * numberRows_;
+        int *changed = numberChanged + iSlot;
+        int first = listStart_[iSlot];
+        int last = listStart_[iSlot + 1];
+        tasks.spawn([=]() {
+          factorizeColumns(listColumn_, first, last, workSlot,
+            tolerance, replacement, *changed);
+        });
+      }
+      tasks.sync();
+    }
+    for (int iSlot = 0; iSlot < numberSlots; iSlot++)
+      numberRegularized_ += numberChanged[iSlot];
+    delete[] numberChanged;
+    delete[] work;
+  } else {
+    factorizeColumns(listColumn_, 0, listStart_[numberSlots], workDouble_,
+      tolerance, replacement, numberRegularized_);
+  }
+  // top of tree
+  factorizeColumns(listColumn_, listStart_[numberSlots], numberRows_, workDouble_,
+    tolerance, replacement, numberRegularized_);
+  integerParameters_[20] = numberRegularized_;
+  largest = 0.0;
+  double smallest = COIN_DBL_MAX;
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++) {
+    double value = fabs(diagonal_[iColumn]);
+    if (value < 1.0e90) {
+      largest = CoinMax(largest, value);
+      smallest = CoinMin(smallest, value);
+    }
+  }
+  if (model_->messageHandler()->logLevel() > 1) {
+    char line[200];
+    sprintf(line, "KKT factorization - largest %g smallest %g - %d pivots regularized",
+      largest, smallest, numberRegularized_);
+    model_->messageHandler()->message(CLP_GENERAL2, *model_->messagesPointer())
+      << line << CoinMessageEol;
+  }
+  choleskyCondition_ = smallest < COIN_DBL_MAX ? largest / smallest : 1.0;
+  status_ = 0;
+  return 0;
+}
+// Solves using factorization (permuted region)
+void ClpCholeskyKKT::solvePermuted(CoinWorkDouble *region) const
+{
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++) {
+    CoinWorkDouble value = region[iColumn];
+    if (value) {
+      for (CoinBigIndex j = choleskyStart_[iColumn]; j < choleskyStart_[iColumn + 1]; j++)
+        region[choleskyRow_[j]] -= sparseFactor_[j] * value;
+    }
+  }
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++)
+    region[iColumn] /= diagonal_[iColumn];
+  for (int iColumn = numberRows_ - 1; iColumn >= 0; iColumn--) {
+    CoinWorkDouble value = region[iColumn];
+    for (CoinBigIndex j = choleskyStart_[iColumn]; j < choleskyStart_[iColumn + 1]; j++)
+      value -= sparseFactor_[j] * region[choleskyRow_[j]];
+    region[iColumn] = value;
+  }
+}
+// Multiplies by KKT matrix as factorized (permuted)
+void ClpCholeskyKKT::timesKKT(const CoinWorkDouble *x, CoinWorkDouble *y) const
+{
+  CoinZeroN(y, numberRows_);
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++) {
+    CoinBigIndex j = kktStart_[iColumn];
+    CoinWorkDouble value = x[iColumn];
+    CoinWorkDouble sum = kktElement_[j] * value;
+    for (j++; j < kktStart_[iColumn + 1]; j++) {
+      int iRow = kktRow_[j];
+      y[iRow] += kktElement_[j] * value;
+      sum += kktElement_[j] * x[iRow];
+    }
+    y[iColumn] += sum;
+  }
+}
+/* Uses factorization to solve.
+   Static regularization is known to model (primalR and dualR) so
+   refinement is against matrix as given to factorize.  That corrects
+   any pivots changed and also loss of accuracy from large diagonals. */
+void ClpCholeskyKKT::solve(CoinWorkDouble *region)
+{
+  CoinWorkDouble *work = new CoinWorkDouble[3 * numberRows_];
+  CoinWorkDouble *rhs = work + numberRows_;
+  CoinWorkDouble *residual = rhs + numberRows_;
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++)
+    rhs[iColumn] = region[permute_[iColumn]];
+  CoinMemcpyN(rhs, numberRows_, work);
+  solvePermuted(work);
+  for (int iPass = 0; iPass < numberRefinements_; iPass++) {
+    timesKKT(work, residual);
+    for (int iColumn = 0; iColumn < numberRows_; iColumn++)
+      residual[iColumn] = rhs[iColumn] - residual[iColumn];
+    solvePermuted(residual);
+    for (int iColumn = 0; iColumn < numberRows_; iColumn++)
+      work[iColumn] += residual[iColumn];
+  }
+  for (int iColumn = 0; iColumn < numberRows_; iColumn++)
+    region[permute_[iColumn]] = work[iColumn];
+  delete[] work;
+}
+/* Uses factorization to solve. - given as if KKT.
+   region1 is rows+columns, region2 is rows */
+void ClpCholeskyKKT::solveKKT(CoinWorkDouble *region1, CoinWorkDouble *region2, const CoinWorkDouble *diagonal,
+  CoinWorkDouble diagonalScaleFactor)
+{
+  int numberRowsModel = model_->numberRows();
+  int numberColumns = model_->numberColumns();
+  int numberTotal = numberColumns + numberRowsModel;
+  CoinWorkDouble *array = new CoinWorkDouble[numberRows_];
+  CoinMemcpyN(region1, numberTotal, array);
+  CoinMemcpyN(region2, numberRowsModel, array + numberTotal);
+  solve(array);
+  CoinMemcpyN(array + numberTotal, numberRowsModel, region2);
+  CoinMemcpyN(array, numberTotal, region1);
+  delete[] array;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
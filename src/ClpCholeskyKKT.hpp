@@ -0,0 +1,176 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpCholeskyKKT_H
+#define ClpCholeskyKKT_H
+
+#include "ClpCholeskyBase.hpp"
+class ClpThreadPool;
+
+/** Native KKT class for Clp barrier (mainly for quadratic objectives)
+
+    The augmented system
+
+      [ -(Q + D^-1) - rp       A'    ]
+      [       A            delta^2 + rd ]
+
+    (with slacks as in ClpCholeskyBase KKT) is made quasi-definite by
+    static regularization rp and rd, so any symmetric ordering is stable
+    and an LDL' factorization with 1x1 pivots can be used.  Ordering and
+    symbolic factorization (elimination tree, structure of L and a split
+    of the tree into independent subtrees) are done once.  Each
+    factorization only fills in numbers.  Subtrees are factorized on
+    threads if model has numberThreads() > 1, then the top of the tree
+    is done serially.  Static regularization is passed back to model in
+    primalR and dualR.  Any pivot which still has wrong sign or is tiny is
+    replaced (dynamic regularization) and that is removed from solutions
+    by iterative refinement (which also recovers accuracy lost to very
+    large diagonals near the end).
+*/
+class CLPLIB_EXPORT ClpCholeskyKKT : public ClpCholeskyBase {
+
+public:
+  /**@name Virtual methods that the derived classes provides  */
+  //@{
+  /** Orders rows and saves pointer to matrix.and model.
+      Returns non-zero if not enough memory */
+  virtual int order(ClpInterior *model);
+  /** Does Symbolic factorization given permutation.
+         This is called immediately after order.
+         returns non-zero if not enough memory */
+  virtual int symbolic();
+  /** Factorize - filling in rowsDropped and returning number dropped.
+         If return code negative then out of memory */
+  virtual int factorize(const CoinWorkDouble *diagonal, int *rowsDropped);
+  /** Uses factorization to solve (region is whole KKT system). */
+  virtual void solve(CoinWorkDouble *region);
+  /** Uses factorization to solve. - given as if KKT.
+      region1 is rows+columns, region2 is rows */
+  virtual void solveKKT(CoinWorkDouble *region1, CoinWorkDouble *region2, const CoinWorkDouble *diagonal,
+    CoinWorkDouble diagonalScaleFactor);
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Static regularization subtracted from primal diagonal (default 1.0e-10)
+  inline double primalRegularization() const
+  {
+    return primalRegularization_;
+  }
+  inline void setPrimalRegularization(double value)
+  {
+    primalRegularization_ = value;
+  }
+  /// Minimum of dual diagonal (default 1.0e-10)
+  inline double dualRegularization() const
+  {
+    return dualRegularization_;
+  }
+  inline void setDualRegularization(double value)
+  {
+    dualRegularization_ = value;
+  }
+  /// Number of refinement steps in solve (default 1)
+  inline int numberRefinements() const
+  {
+    return numberRefinements_;
+  }
+  inline void setNumberRefinements(int value)
+  {
+    numberRefinements_ = value;
+  }
+  /// Number of pivots changed in last factorization
+  inline int numberRegularized() const
+  {
+    return numberRegularized_;
+  }
+  /// Number of independent subtrees in last symbolic
+  inline int numberSubtrees() const
+  {
+    return numberSubtrees_;
+  }
+  //@}
+
+  /**@name Constructors, destructor */
+  //@{
+  /** Default constructor. */
+  ClpCholeskyKKT();
+  /** Destructor  */
+  virtual ~ClpCholeskyKKT();
+  /// Copy
+  ClpCholeskyKKT(const ClpCholeskyKKT &);
+  /// Assignment
+  ClpCholeskyKKT &operator=(const ClpCholeskyKKT &);
+  /// Clone
+  virtual ClpCholeskyBase *clone() const;
+  //@}
+
+private:
+  /**@name Private methods */
+  //@{
+  /** Generates KKT elements (original numbering, lower triangle).
+      Any of row, column and element may be NULL.  If diagonal
+      NULL just structure wanted.  Returns number of elements. */
+  CoinBigIndex generateKKT(const CoinWorkDouble *diagonal, int *row,
+    int *column, double *element) const;
+  /// Factorizes columns first to last-1 of list using work
+  void factorizeColumns(const int *list, int first, int last,
+    longDouble *work, double tolerance, double replacement,
+    int &numberChanged);
+  /// Solves using factorization (permuted region)
+  void solvePermuted(CoinWorkDouble *region) const;
+  /// Multiplies by unregularized KKT matrix (permuted)
+  void timesKKT(const CoinWorkDouble *x, CoinWorkDouble *y) const;
+  /// Frees arrays
+  void gutsOfDelete();
+  /// Copies arrays
+  void gutsOfCopy(const ClpCholeskyKKT &rhs);
+  //@}
+
+  /**@name Data members */
+  //@{
+  /// Static primal regularization
+  double primalRegularization_;
+  /// Static dual regularization
+  double dualRegularization_;
+  /// Number of refinements
+  int numberRefinements_;
+  /// Number of pivots changed
+  int numberRegularized_;
+  /// Number of elements in KKT matrix
+  CoinBigIndex numberKKT_;
+  /// Starts of permuted KKT lower triangle
+  CoinBigIndex *kktStart_;
+  /// Rows of permuted KKT lower triangle
+  int *kktRow_;
+  /// Elements of permuted KKT lower triangle
+  double *kktElement_;
+  /// Where each generated element goes
+  CoinBigIndex *kktPosition_;
+  /// Work array for generated elements
+  double *kktWork_;
+  /// Elimination tree
+  int *parent_;
+  /// Starts of rows of L
+  CoinBigIndex *rowStart_;
+  /// Columns in each row of L
+  int *rowColumn_;
+  /// Position in sparseFactor_ of each element in rows of L
+  CoinBigIndex *rowPosition_;
+  /// Number of independent subtrees
+  int numberSubtrees_;
+  /// Number of lists (one per thread plus one for top of tree)
+  int numberLists_;
+  /// Starts of lists of columns
+  int *listStart_;
+  /// Columns in order for each list
+  int *listColumn_;
+  /// Threads (or NULL)
+  ClpThreadPool *threadPool_;
+  //@}
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
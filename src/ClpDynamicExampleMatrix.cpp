@@ -104,6 +104,9 @@ ClpDynamicExampleMatrix::ClpDynamicExampleMatrix(ClpSimplex *model, int numberSe
   dynamicStatus_ = new unsigned char[2 * maximumGubColumns_];
   memset(dynamicStatus_, 0, maximumGubColumns_);
   id_ = new int[maximumGubColumns_];
+  delete[] lastUsed_;
+  lastUsed_ = new int[maximumGubColumns_];
+  CoinZeroN(lastUsed_, maximumGubColumns_);
   if (columnLower)
     columnLower_ = new double[maximumGubColumns_];
   else
@@ -679,6 +682,14 @@ void ClpDynamicExampleMatrix::packDown(const int *in, int numberToPack)
   }
   assert(put == numberGubColumns_);
 }
+// Resizes idGen_ when pool changes size
+void ClpDynamicExampleMatrix::resizePool(int, int newMaximum)
+{
+  int *idGen = new int[newMaximum];
+  CoinMemcpyN(idGen_, numberGubColumns_, idGen);
+  delete[] idGen_;
+  idGen_ = idGen;
+}
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
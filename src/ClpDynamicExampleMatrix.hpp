@@ -46,6 +46,8 @@ public:
          Entries at upper bound (really nonzero) never go out (at present).
      */
   virtual void packDown(const int *in, int numberToPack);
+  /// Resizes idGen_ when pool changes size
+  virtual void resizePool(int oldMaximum, int newMaximum);
   //@}
 
   /**@name Constructors, destructor */
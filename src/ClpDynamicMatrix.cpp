@@ -14,6 +14,7 @@
 #include "ClpNonLinearCost.hpp"
 // at end to get min/max!
 #include "ClpDynamicMatrix.hpp"
+#include "ClpPricingOracle.hpp"
 #include "ClpMessage.hpp"
 //#define CLP_DEBUG
 //#define CLP_DEBUG_PRINT
@@ -66,6 +67,12 @@ ClpDynamicMatrix::ClpDynamicMatrix()
   , dynamicStatus_(NULL)
   , columnLower_(NULL)
   , columnUpper_(NULL)
+  , lastUsed_(NULL)
+  , oracle_(NULL)
+  , maximumAge_(1000)
+  , maximumGenerated_(1000)
+  , numberGenerated_(0)
+  , numberEvicted_(0)
 {
   setType(15);
 }
@@ -117,6 +124,12 @@ ClpDynamicMatrix::ClpDynamicMatrix(const ClpDynamicMatrix &rhs)
   columnLower_ = ClpCopyOfArray(rhs.columnLower_, maximumGubColumns_);
   columnUpper_ = ClpCopyOfArray(rhs.columnUpper_, maximumGubColumns_);
   dynamicStatus_ = ClpCopyOfArray(rhs.dynamicStatus_, 2 * maximumGubColumns_);
+  lastUsed_ = ClpCopyOfArray(rhs.lastUsed_, maximumGubColumns_);
+  oracle_ = rhs.oracle_ ? rhs.oracle_->clone() : NULL;
+  maximumAge_ = rhs.maximumAge_;
+  maximumGenerated_ = rhs.maximumGenerated_;
+  numberGenerated_ = rhs.numberGenerated_;
+  numberEvicted_ = rhs.numberEvicted_;
 }
 
 /* This is the real constructor*/
@@ -154,6 +167,11 @@ ClpDynamicMatrix::ClpDynamicMatrix(ClpSimplex *model, int numberSets,
       next_[last] = -iSet - 1;
     }
     startSet_[numberSets_] = starts[numberSets_];
+  } else {
+    // columns will come from addColumn (or oracle)
+    for (iSet = 0; iSet < numberSets_; iSet++)
+      startSet_[iSet] = -1;
+    startSet_[numberSets_] = 0;
   }
   int numberColumns = model->numberColumns();
   int numberRows = model->numberRows();
@@ -223,6 +241,8 @@ ClpDynamicMatrix::ClpDynamicMatrix(ClpSimplex *model, int numberSets,
     id_[i] = -1;
   ClpPackedMatrix *originalMatrixA = dynamic_cast< ClpPackedMatrix * >(model->clpMatrix());
   assert(originalMatrixA);
+  // matrix is going to be changed so must not be shared
+  originalMatrixA->unshare();
   CoinPackedMatrix *originalMatrix = originalMatrixA->getPackedMatrix();
   originalMatrixA->setMatrixNull(); // so can be deleted safely
   // guess how much space needed
@@ -275,7 +295,16 @@ ClpDynamicMatrix::ClpDynamicMatrix(ClpSimplex *model, int numberSets,
     memset(dynamicStatus_, 0, numberGubColumns_); // for clarity
     for (i = 0; i < numberGubColumns_; i++)
       setDynamicStatus(i, atLowerBound);
+    // saved status as well
+    memcpy(dynamicStatus_ + numberGubColumns_, dynamicStatus_, numberGubColumns_);
   }
+  lastUsed_ = new int[maximumGubColumns_];
+  CoinZeroN(lastUsed_, maximumGubColumns_);
+  oracle_ = NULL;
+  maximumAge_ = 1000;
+  maximumGenerated_ = 1000;
+  numberGenerated_ = 0;
+  numberEvicted_ = 0;
   toIndex_ = new int[numberSets_];
   for (iSet = 0; iSet < numberSets_; iSet++)
     toIndex_[iSet] = -1;
@@ -288,6 +317,10 @@ ClpDynamicMatrix::ClpDynamicMatrix(ClpSimplex *model, int numberSets,
     } else {
       initialProblem();
     }
+  } else {
+    // all slacks are keys
+    for (iSet = 0; iSet < numberSets_; iSet++)
+      keyVariable_[iSet] = maximumGubColumns_ + iSet;
   }
   noCheck_ = -1;
   infeasibilityWeight_ = 0.0;
@@ -315,6 +348,8 @@ ClpDynamicMatrix::~ClpDynamicMatrix()
   delete[] dynamicStatus_;
   delete[] columnLower_;
   delete[] columnUpper_;
+  delete[] lastUsed_;
+  delete oracle_;
 }
 
 //----------------------------------------------------------------
@@ -342,6 +377,8 @@ ClpDynamicMatrix::operator=(const ClpDynamicMatrix &rhs)
     delete[] dynamicStatus_;
     delete[] columnLower_;
     delete[] columnUpper_;
+    delete[] lastUsed_;
+    delete oracle_;
     objectiveOffset_ = rhs.objectiveOffset_;
     numberSets_ = rhs.numberSets_;
     numberActiveSets_ = rhs.numberActiveSets_;
@@ -383,6 +420,12 @@ ClpDynamicMatrix::operator=(const ClpDynamicMatrix &rhs)
     columnLower_ = ClpCopyOfArray(rhs.columnLower_, maximumGubColumns_);
     columnUpper_ = ClpCopyOfArray(rhs.columnUpper_, maximumGubColumns_);
     dynamicStatus_ = ClpCopyOfArray(rhs.dynamicStatus_, 2 * maximumGubColumns_);
+    lastUsed_ = ClpCopyOfArray(rhs.lastUsed_, maximumGubColumns_);
+    oracle_ = rhs.oracle_ ? rhs.oracle_->clone() : NULL;
+    maximumAge_ = rhs.maximumAge_;
+    maximumGenerated_ = rhs.maximumGenerated_;
+    numberGenerated_ = rhs.numberGenerated_;
+    numberEvicted_ = rhs.numberEvicted_;
   }
   return *this;
 }
@@ -454,6 +497,7 @@ void ClpDynamicMatrix::partialPricing(ClpSimplex *model, double startFraction, d
 #endif
     int minSet = minimumObjectsScan_ < 0 ? 5 : minimumObjectsScan_;
     int minNeg = minimumGoodReducedCosts_ < 0 ? 5 : minimumGoodReducedCosts_;
+    int numberIterations = model->numberIterations();
     for (int iSet = startG2; iSet < endAll; iSet++) {
       if (numberWanted + minNeg < originalWanted_ && iSet > startG2 + minSet) {
         // give up
@@ -533,6 +577,8 @@ void ClpDynamicMatrix::partialPricing(ClpSimplex *model, double startFraction, d
             value = -value;
           if (value > tolerance) {
             numberWanted--;
+            // still useful so keep in pool
+            lastUsed_[iSequence] = numberIterations;
             if (value > bestDj) {
               // check flagged variable and correct dj
               if (!flagged(iSequence)) {
@@ -568,6 +614,9 @@ void ClpDynamicMatrix::partialPricing(ClpSimplex *model, double startFraction, d
       savedBestDj_ = bestDj;
       savedBestSequence_ = bestSequence;
       savedBestSet_ = bestSet;
+    } else if (oracle_ && !startG2 && bestSequence < 0) {
+      // whole pool priced out - ask for more
+      generateColumns(model, bestSequence);
     }
     // See if may be finished
     if (!startG2 && bestSequence < 0)
@@ -1344,7 +1393,8 @@ int ClpDynamicMatrix::refresh(ClpSimplex *model)
         }
       }
       if (toLowerBound) {
-        // throw out to lower bound
+        // throw out to lower bound (age counts from now)
+        lastUsed_[jColumn] = model->numberIterations();
         if (columnLower_) {
           setDynamicStatus(jColumn, atLowerBound);
           // treat solution as if exactly at a bound
@@ -1856,6 +1906,7 @@ void ClpDynamicMatrix::createVariable(ClpSimplex *model, int &bestSequence)
       row[numberElements] = gubRow;
       element[numberElements++] = 1.0;
       id_[firstAvailable_ - firstDynamic_] = bestSequence2;
+      lastUsed_[bestSequence2] = model->numberIterations();
       //printf("best %d\n",bestSequence2);
       model->solutionRegion()[firstAvailable_] = 0.0;
       model->clearFlagged(firstAvailable_);
@@ -2464,7 +2515,9 @@ int ClpDynamicMatrix::addColumn(CoinBigIndex numberEntries, const int *row, cons
             columnLower_ ? columnLower_[j] : 0.0,
             columnUpper_ ? columnUpper_[j] : 1.0e100);
         } else {
-          setDynamicStatus(j, status);
+          // leave alone if basic (may be regenerated by oracle)
+          if (getDynamicStatus(j) != inSmall && getDynamicStatus(j) != soloKey)
+            setDynamicStatus(j, status);
           return j;
         }
       }
@@ -2473,63 +2526,13 @@ int ClpDynamicMatrix::addColumn(CoinBigIndex numberEntries, const int *row, cons
   }
 
   if (numberGubColumns_ == maximumGubColumns_ || startColumn_[numberGubColumns_] + numberEntries > maximumElements_) {
-    CoinBigIndex j;
-    int i;
-    int put = 0;
-    int numberElements = 0;
-    CoinBigIndex start = 0;
     // compress - leave ones at ub and basic
-    int *which = new int[numberGubColumns_];
-    for (i = 0; i < numberGubColumns_; i++) {
-      CoinBigIndex end = startColumn_[i + 1];
-      // what about ubs if column generation?
-      if (getDynamicStatus(i) != atLowerBound) {
-        // keep in
-        for (j = start; j < end; j++) {
-          row_[numberElements] = row_[j];
-          element_[numberElements++] = element_[j];
-        }
-        startColumn_[put + 1] = numberElements;
-        cost_[put] = cost_[i];
-        if (columnLower_)
-          columnLower_[put] = columnLower_[i];
-        if (columnUpper_)
-          columnUpper_[put] = columnUpper_[i];
-        dynamicStatus_[put] = dynamicStatus_[i];
-        id_[put] = id_[i];
-        which[i] = put;
-        put++;
-      } else {
-        // out
-        which[i] = -1;
-      }
-      start = end;
-    }
-    // now redo startSet_ and next_
-    int *newNext = new int[maximumGubColumns_];
-    for (int jSet = 0; jSet < numberSets_; jSet++) {
-      int sequence = startSet_[jSet];
-      while (which[sequence] < 0) {
-        // out
-        assert(next_[sequence] >= 0);
-        sequence = next_[sequence];
-      }
-      startSet_[jSet] = which[sequence];
-      int last = which[sequence];
-      while (next_[sequence] >= 0) {
-        sequence = next_[sequence];
-        if (which[sequence] >= 0) {
-          // keep
-          newNext[last] = which[sequence];
-          last = which[sequence];
-        }
-      }
-      newNext[last] = -jSet - 1;
+    compressPool(1, numberEntries);
+    if (numberGubColumns_ == maximumGubColumns_ || startColumn_[numberGubColumns_] + numberEntries > maximumElements_) {
+      // all needed - so pool has to grow
+      setPoolSize(CoinMax(numberGubColumns_ + 1, 3 * maximumGubColumns_ / 2),
+        CoinMax(startColumn_[numberGubColumns_] + numberEntries, 3 * maximumElements_ / 2));
     }
-    delete[] next_;
-    next_ = newNext;
-    delete[] which;
-    abort();
   }
   CoinBigIndex start = startColumn_[numberGubColumns_];
   CoinMemcpyN(row, numberEntries, row_ + start);
@@ -2545,13 +2548,306 @@ int ClpDynamicMatrix::addColumn(CoinBigIndex numberEntries, const int *row, cons
   else
     assert(upper > 1.0e20);
   setDynamicStatus(numberGubColumns_, status);
-  // Do next_
+  // saved status must be sensible
+  dynamicStatus_[numberGubColumns_ + maximumGubColumns_] = static_cast< unsigned char >(atLowerBound);
+  lastUsed_[numberGubColumns_] = model_ ? model_->numberIterations() : 0;
+  // Do next_ (end of chain points back to set)
   j = startSet_[iSet];
   startSet_[iSet] = numberGubColumns_;
-  next_[numberGubColumns_] = j;
+  next_[numberGubColumns_] = j >= 0 ? j : -iSet - 1;
   numberGubColumns_++;
   return numberGubColumns_ - 1;
 }
+// Passes in a pricing oracle
+void ClpDynamicMatrix::setPricingOracle(const ClpPricingOracle *oracle)
+{
+  delete oracle_;
+  oracle_ = oracle ? oracle->clone() : NULL;
+}
+// Changes space for pool of gub columns
+void ClpDynamicMatrix::setPoolSize(int maximumColumns, CoinBigIndex maximumElements)
+{
+  maximumColumns = CoinMax(maximumColumns, numberGubColumns_);
+  CoinBigIndex numberElements = startColumn_[numberGubColumns_];
+  maximumElements = CoinMax(maximumElements, numberElements);
+  if (maximumColumns != maximumGubColumns_) {
+    int *next = new int[maximumColumns];
+    CoinMemcpyN(next_, numberGubColumns_, next);
+    delete[] next_;
+    next_ = next;
+    CoinBigIndex *startColumn = new CoinBigIndex[maximumColumns + 1];
+    CoinMemcpyN(startColumn_, numberGubColumns_ + 1, startColumn);
+    delete[] startColumn_;
+    startColumn_ = startColumn;
+    double *cost = new double[maximumColumns];
+    CoinMemcpyN(cost_, numberGubColumns_, cost);
+    delete[] cost_;
+    cost_ = cost;
+    if (columnLower_) {
+      double *columnLower = new double[maximumColumns];
+      CoinMemcpyN(columnLower_, numberGubColumns_, columnLower);
+      delete[] columnLower_;
+      columnLower_ = columnLower;
+    }
+    if (columnUpper_) {
+      double *columnUpper = new double[maximumColumns];
+      CoinMemcpyN(columnUpper_, numberGubColumns_, columnUpper);
+      delete[] columnUpper_;
+      columnUpper_ = columnUpper;
+    }
+    int *lastUsed = new int[maximumColumns];
+    CoinMemcpyN(lastUsed_, numberGubColumns_, lastUsed);
+    delete[] lastUsed_;
+    lastUsed_ = lastUsed;
+    // second half is saved status
+    unsigned char *dynamicStatus = new unsigned char[2 * maximumColumns];
+    CoinMemcpyN(dynamicStatus_, numberGubColumns_, dynamicStatus);
+    CoinMemcpyN(dynamicStatus_ + maximumGubColumns_, numberGubColumns_,
+      dynamicStatus + maximumColumns);
+    delete[] dynamicStatus_;
+    dynamicStatus_ = dynamicStatus;
+    // slack keys are coded as maximumGubColumns_ + set
+    for (int iSet = 0; iSet < numberSets_; iSet++) {
+      if (keyVariable_[iSet] >= maximumGubColumns_)
+        keyVariable_[iSet] += maximumColumns - maximumGubColumns_;
+    }
+    resizePool(maximumGubColumns_, maximumColumns);
+    maximumGubColumns_ = maximumColumns;
+  }
+  if (maximumElements != maximumElements_) {
+    int *row = new int[maximumElements];
+    CoinMemcpyN(row_, numberElements, row);
+    delete[] row_;
+    row_ = row;
+    double *element = new double[maximumElements];
+    CoinMemcpyN(element_, numberElements, element);
+    delete[] element_;
+    element_ = element;
+    maximumElements_ = maximumElements;
+  }
+}
+/* Makes room in pool by throwing out columns at lower bound which are not keys.
+   Returns number thrown out.
+*/
+int ClpDynamicMatrix::compressPool(int numberColumns, CoinBigIndex numberElements)
+{
+  int numberIterations = model_ ? model_->numberIterations() : 0;
+  int numberNow = numberGubColumns_;
+  // which[i] is 0 if must stay, -1 if may go
+  int *which = new int[numberNow];
+  int *candidate = new int[numberNow];
+  int *age = new int[numberNow];
+  int numberCandidates = 0;
+  int i;
+  for (i = 0; i < numberNow; i++) {
+    // keep if not at lower bound now or in saved status
+    if (getDynamicStatus(i) != atLowerBound || (dynamicStatus_[i + maximumGubColumns_] & 7) != atLowerBound)
+      which[i] = 0;
+    else
+      which[i] = -1;
+  }
+  for (int iSet = 0; iSet < numberSets_; iSet++) {
+    int key = keyVariable_[iSet];
+    if (key < maximumGubColumns_)
+      which[key] = 0;
+  }
+  // first ones which are too old
+  int freeColumns = maximumGubColumns_ - numberNow;
+  CoinBigIndex freeElements = maximumElements_ - startColumn_[numberNow];
+  int numberOut = 0;
+  for (i = 0; i < numberNow; i++) {
+    if (which[i]) {
+      if (numberIterations - lastUsed_[i] > maximumAge_) {
+        numberOut++;
+        freeColumns++;
+        freeElements += startColumn_[i + 1] - startColumn_[i];
+      } else {
+        which[i] = 0;
+        candidate[numberCandidates] = i;
+        age[numberCandidates++] = lastUsed_[i];
+      }
+    }
+  }
+  // then oldest - leaving a bit extra so not compressing every time
+  int wantedColumns = numberColumns + maximumGubColumns_ / 8;
+  CoinBigIndex wantedElements = numberElements + maximumElements_ / 8;
+  if (freeColumns < wantedColumns || freeElements < wantedElements) {
+    CoinSort_2(age, age + numberCandidates, candidate);
+    for (int k = 0; k < numberCandidates; k++) {
+      if (freeColumns >= wantedColumns && freeElements >= wantedElements)
+        break;
+      i = candidate[k];
+      which[i] = -1;
+      numberOut++;
+      freeColumns++;
+      freeElements += startColumn_[i + 1] - startColumn_[i];
+    }
+  }
+  delete[] candidate;
+  delete[] age;
+  if (!numberOut) {
+    delete[] which;
+    return 0;
+  }
+  // pack down
+  int put = 0;
+  CoinBigIndex numberElementsNow = 0;
+  CoinBigIndex start = 0;
+  for (i = 0; i < numberNow; i++) {
+    CoinBigIndex end = startColumn_[i + 1];
+    if (!which[i]) {
+      // keep in
+      for (CoinBigIndex j = start; j < end; j++) {
+        row_[numberElementsNow] = row_[j];
+        element_[numberElementsNow++] = element_[j];
+      }
+      startColumn_[put + 1] = numberElementsNow;
+      cost_[put] = cost_[i];
+      if (columnLower_)
+        columnLower_[put] = columnLower_[i];
+      if (columnUpper_)
+        columnUpper_[put] = columnUpper_[i];
+      dynamicStatus_[put] = dynamicStatus_[i];
+      dynamicStatus_[put + maximumGubColumns_] = dynamicStatus_[i + maximumGubColumns_];
+      lastUsed_[put] = lastUsed_[i];
+      which[i] = put;
+      put++;
+    }
+    start = end;
+  }
+  // now redo startSet_ and next_ (keeping order)
+  int *newNext = new int[maximumGubColumns_];
+  for (int iSet = 0; iSet < numberSets_; iSet++) {
+    int sequence = startSet_[iSet];
+    int first = -1;
+    int last = -1;
+    while (sequence >= 0) {
+      int iNew = which[sequence];
+      if (iNew >= 0) {
+        if (last >= 0)
+          newNext[last] = iNew;
+        else
+          first = iNew;
+        last = iNew;
+      }
+      sequence = next_[sequence];
+    }
+    if (last >= 0)
+      newNext[last] = -iSet - 1;
+    startSet_[iSet] = first;
+    int key = keyVariable_[iSet];
+    if (key < maximumGubColumns_)
+      keyVariable_[iSet] = which[key];
+  }
+  delete[] next_;
+  next_ = newNext;
+  // and ones in small problem
+  for (i = firstDynamic_; i < firstAvailable_; i++) {
+    int iBig = id_[i - firstDynamic_];
+    assert(which[iBig] >= 0);
+    id_[i - firstDynamic_] = which[iBig];
+  }
+  if (savedBestSequence_ >= 0 && model_) {
+    int structuralOffset = lastDynamic_ + model_->numberRows() + numberSets_;
+    int sequence = savedBestSequence_ - structuralOffset;
+    if (sequence >= 0 && sequence < numberNow) {
+      if (which[sequence] >= 0)
+        savedBestSequence_ = structuralOffset + which[sequence];
+      else
+        savedBestSequence_ = -1;
+    }
+  }
+  numberGubColumns_ = put;
+  numberEvicted_ += numberOut;
+  // let descendant know
+  packDown(which, numberNow);
+  delete[] which;
+  return numberOut;
+}
+// Dual of set row (dj modification) given duals
+double ClpDynamicMatrix::setDual(const double *duals, int iSet) const
+{
+  double djMod = 0.0;
+  int gubRow = toIndex_[iSet];
+  if (gubRow >= 0) {
+    djMod = duals[gubRow + numberStaticRows_];
+  } else {
+    int iBasic = keyVariable_[iSet];
+    if (iBasic < maximumGubColumns_) {
+      // dj of key without set
+      for (CoinBigIndex j = startColumn_[iBasic];
+           j < startColumn_[iBasic + 1]; j++) {
+        int jRow = row_[j];
+        djMod -= duals[jRow] * element_[j];
+      }
+      djMod += cost_[iBasic];
+    }
+  }
+  return djMod;
+}
+/* Asks oracle for columns and adds them to pool.  If any price out
+   bestSequence is set to best.  Returns number added.
+*/
+int ClpDynamicMatrix::generateColumns(ClpSimplex *model, int &bestSequence)
+{
+  const double *duals = model->dualRowSolution();
+  double tolerance = model->currentDualTolerance();
+  double *setDuals = new double[numberSets_];
+  int iSet;
+  for (iSet = 0; iSet < numberSets_; iSet++)
+    setDuals[iSet] = setDual(duals, iSet);
+  oracle_->clearBatch();
+  oracle_->generateColumns(this, duals, setDuals, tolerance,
+    maximumGenerated_ > 0 ? maximumGenerated_ : numberSets_);
+  int numberAdded = oracle_->numberColumns();
+  if (numberAdded) {
+    const CoinBigIndex *startBatch = oracle_->startColumn();
+    const int *rowBatch = oracle_->row();
+    const double *elementBatch = oracle_->element();
+    const double *costBatch = oracle_->cost();
+    const int *setBatch = oracle_->set();
+    const double *upperBatch = oracle_->columnUpper();
+    // make room for all in one go
+    if (numberGubColumns_ + numberAdded > maximumGubColumns_ || startColumn_[numberGubColumns_] + startBatch[numberAdded] > maximumElements_) {
+      compressPool(numberAdded, startBatch[numberAdded]);
+      if (numberGubColumns_ + numberAdded > maximumGubColumns_ || startColumn_[numberGubColumns_] + startBatch[numberAdded] > maximumElements_)
+        setPoolSize(CoinMax(numberGubColumns_ + numberAdded, 3 * maximumGubColumns_ / 2),
+          CoinMax(startColumn_[numberGubColumns_] + startBatch[numberAdded], 3 * maximumElements_ / 2));
+    }
+    int structuralOffset = lastDynamic_ + model->numberRows() + numberSets_;
+    double bestDj = tolerance;
+    int bestSet = -1;
+    for (int i = 0; i < numberAdded; i++) {
+      iSet = setBatch[i];
+      assert(iSet >= 0 && iSet < numberSets_);
+      CoinBigIndex start = startBatch[i];
+      CoinBigIndex end = startBatch[i + 1];
+      int sequence = addColumn(end - start, rowBatch + start, elementBatch + start,
+        costBatch[i], 0.0, columnUpper_ ? upperBatch[i] : 1.0e30, iSet, atLowerBound);
+      if (getDynamicStatus(sequence) != atLowerBound || flagged(sequence))
+        continue;
+      // at lower bound so wants negative dj
+      double value = costBatch[i] - setDuals[iSet];
+      for (CoinBigIndex j = start; j < end; j++)
+        value -= duals[rowBatch[j]] * elementBatch[j];
+      value = -value;
+      if (value > bestDj) {
+        bestDj = value;
+        bestSequence = structuralOffset + sequence;
+        bestSet = iSet;
+      }
+    }
+    if (bestSequence >= 0) {
+      savedBestGubDual_ = setDuals[bestSet];
+      savedBestDj_ = bestDj;
+      savedBestSequence_ = bestSequence;
+      savedBestSet_ = bestSet;
+    }
+    numberGenerated_ += numberAdded;
+  }
+  delete[] setDuals;
+  return numberAdded;
+}
 // Returns which set a variable is in
 int ClpDynamicMatrix::whichSet(int sequence) const
 {
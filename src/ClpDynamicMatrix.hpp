@@ -9,9 +9,11 @@
 
 #include "ClpPackedMatrix.hpp"
 class ClpSimplex;
+class ClpPricingOracle;
 /** This implements  a dynamic matrix when we have a limit on the number of
     "interesting rows". This version inherits from ClpPackedMatrix and knows that
-    the real matrix is gub.  A later version could use shortest path to generate columns.
+    the real matrix is gub.  Columns can be generated on demand by a ClpPricingOracle
+    (e.g. using shortest path) - the gub columns held here are then a bounded pool.
 
 */
 
@@ -105,6 +107,26 @@ public:
          Entries at upper bound (really nonzero) never go out (at present).
      */
   virtual void packDown(const int *, int) {}
+  /** Called by setPoolSize when space for gub columns changes (from
+         oldMaximum to newMaximum) so a descendant can resize its own arrays
+         of maximumGubColumns_.  First numberGubColumns() entries are in use.
+     */
+  virtual void resizePool(int, int) {}
+  /** Passes in a pricing oracle (a clone is taken - NULL removes).
+         When nothing in the pool prices out the oracle is asked for more columns.
+     */
+  void setPricingOracle(const ClpPricingOracle *oracle);
+  /** Makes room in pool for numberColumns columns with numberElements elements
+         by throwing out columns at lower bound which are not keys - first ones
+         unused for more than maximumAge() iterations and then oldest.
+         Returns number thrown out.
+     */
+  int compressPool(int numberColumns, CoinBigIndex numberElements);
+  /** Changes space for pool of gub columns (will not go below current number).
+         Also done by addColumn if pool is full.  Descendants which keep
+         their own arrays of maximumGubColumns_ resize them in resizePool.
+     */
+  void setPoolSize(int maximumColumns, CoinBigIndex maximumElements);
   /// Gets lower bound (to simplify coding)
   inline double columnLower(int sequence) const
   {
@@ -277,6 +299,11 @@ public:
   {
     return numberGubColumns_;
   }
+  /// space for gub columns in pool
+  inline int maximumGubColumns() const
+  {
+    return maximumGubColumns_;
+  }
   /// first free
   inline int firstAvailable() const
   {
@@ -320,6 +347,50 @@ public:
   }
   /// Returns which set a variable is in
   int whichSet(int sequence) const;
+  /// Pricing oracle (if any)
+  inline ClpPricingOracle *pricingOracle() const
+  {
+    return oracle_;
+  }
+  /// Iterations a column at lower bound can be unused before it may go out of pool
+  inline int maximumAge() const
+  {
+    return maximumAge_;
+  }
+  inline void setMaximumAge(int value)
+  {
+    maximumAge_ = value;
+  }
+  /// Maximum number of columns asked for in one call to oracle
+  inline int maximumGenerated() const
+  {
+    return maximumGenerated_;
+  }
+  inline void setMaximumGenerated(int value)
+  {
+    maximumGenerated_ = value;
+  }
+  /// Number of columns generated by oracle so far
+  inline int numberGenerated() const
+  {
+    return numberGenerated_;
+  }
+  /// Number of columns thrown out of pool so far
+  inline int numberEvicted() const
+  {
+    return numberEvicted_;
+  }
+  //@}
+
+protected:
+  /**@name Column generation */
+  //@{
+  /** Asks oracle for columns and adds them to pool.  If any price out
+         bestSequence is set to best (as partialPricing).  Returns number added.
+     */
+  int generateColumns(ClpSimplex *model, int &bestSequence);
+  /// Dual of set row (dj modification) given duals
+  double setDual(const double *duals, int iSet) const;
   //@}
 
 protected:
@@ -410,6 +481,18 @@ protected:
   double *columnLower_;
   /// Optional upper bounds on columns
   double *columnUpper_;
+  /// Iteration when gub column last used (entered small problem or priced out)
+  int *lastUsed_;
+  /// Pricing oracle
+  ClpPricingOracle *oracle_;
+  /// Iterations a column can be unused before it may go out of pool
+  int maximumAge_;
+  /// Maximum number of columns asked for in one call to oracle
+  int maximumGenerated_;
+  /// Number of columns generated by oracle
+  int numberGenerated_;
+  /// Number of columns thrown out of pool
+  int numberEvicted_;
   //@}
 };
 
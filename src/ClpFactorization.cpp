@@ -16,6 +16,7 @@
 #include "ClpSimplex.hpp"
 #include "ClpSimplexDual.hpp"
 #include "ClpMatrixBase.hpp"
+#include "ClpMessage.hpp"
 #ifndef SLIM_CLP
 #include "ClpNetworkBasis.hpp"
 #include "ClpNetworkMatrix.hpp"
@@ -1171,6 +1172,7 @@ ClpFactorization::ClpFactorization()
   goDenseThreshold_ = -1;
   goSmallThreshold_ = -1;
   doStatistics_ = true;
+  adaptiveSolves_ = 0;
   memset(&shortestAverage_, 0, 3 * (sizeof(double) + sizeof(int)));
 }
 
@@ -1194,6 +1196,9 @@ ClpFactorization::ClpFactorization(const ClpFactorization &rhs,
   goDenseThreshold_ = rhs.goDenseThreshold_;
   goSmallThreshold_ = rhs.goSmallThreshold_;
   doStatistics_ = rhs.doStatistics_;
+  adaptiveSolves_ = rhs.adaptiveSolves_;
+  for (int i = 0; i < 3; i++)
+    solveStatistics_[i] = rhs.solveStatistics_[i];
   int goDense = 0;
 #ifdef CLP_REUSE_ETAS
   model_ = rhs.model_;
@@ -1274,6 +1279,7 @@ ClpFactorization::ClpFactorization(const CoinFactorization &rhs)
   goDenseThreshold_ = -1;
   goSmallThreshold_ = -1;
   doStatistics_ = true;
+  adaptiveSolves_ = 0;
   assert(!coinFactorizationA_ || !coinFactorizationB_);
   memset(&shortestAverage_, 0, 3 * (sizeof(double) + sizeof(int)));
 }
@@ -1294,6 +1300,7 @@ ClpFactorization::ClpFactorization(const CoinOtherFactorization &rhs)
   goDenseThreshold_ = -1;
   goSmallThreshold_ = -1;
   doStatistics_ = true;
+  adaptiveSolves_ = 0;
 #ifdef CLP_FACTORIZATION_INSTRUMENT
   factorization_instrument(1);
 #endif
@@ -1338,6 +1345,9 @@ ClpFactorization::operator=(const ClpFactorization &rhs)
     goDenseThreshold_ = rhs.goDenseThreshold_;
     goSmallThreshold_ = rhs.goSmallThreshold_;
     doStatistics_ = rhs.doStatistics_;
+    adaptiveSolves_ = rhs.adaptiveSolves_;
+    for (int i = 0; i < 3; i++)
+      solveStatistics_[i] = rhs.solveStatistics_[i];
     memcpy(&shortestAverage_, &rhs.shortestAverage_, 3 * (sizeof(double) + sizeof(int)));
     if (rhs.coinFactorizationA_) {
       if (coinFactorizationA_)
@@ -2376,6 +2386,8 @@ scaledDense,scaledDense_2,scaledL,scaledR,scaledU\n");
 #endif
           // See if worth going sparse and when
           coinFactorizationA_->checkSparse();
+          if (adaptiveSolves_)
+            updateSolveModes();
 #ifndef SLIM_CLP
         }
 #endif
@@ -2717,6 +2729,188 @@ int ClpFactorization::replaceColumn(const ClpSimplex *model,
 #endif
 }
 
+ClpSolveStatistics::ClpSolveStatistics()
+  : numberSolves(0)
+  , numberSwitches(0)
+  , mode(0)
+  , numberToExplore(0)
+  , count(0.0)
+  , countInput(0.0)
+{
+  countAfter[0] = countAfter[1] = countAfter[2] = 0.0;
+  time[0] = time[1] = 0.0;
+  numberTimed[0] = numberTimed[1] = 0.0;
+}
+// Set adaptive choice of solves
+void ClpFactorization::setAdaptiveSolves(int value)
+{
+  adaptiveSolves_ = value;
+  if (value < 3) {
+    for (int i = 0; i < 3; i++) {
+      solveStatistics_[i].mode = 0;
+      solveStatistics_[i].numberToExplore = 0;
+    }
+  }
+}
+/* Sets up CoinFactorization for a type of solve.
+   CoinFactorization chooses between sparse and hyper-sparse using
+   averages over all solves, so put in ones for this type (or ones
+   which stop hyper-sparse) and put back afterwards */
+void ClpFactorization::startSolve(int type, double *save) const
+{
+  CoinFactorization *factorization = coinFactorizationA_;
+  ClpSolveStatistics &stats = solveStatistics_[type];
+  double *average[3];
+  if (type < 2) {
+    save[0] = factorization->ftranCountInput_;
+    save[1] = factorization->ftranCountAfterL_;
+    save[2] = factorization->ftranCountAfterR_;
+    save[3] = factorization->ftranCountAfterU_;
+    save[4] = factorization->numberFtranCounts_;
+    average[0] = &factorization->ftranAverageAfterL_;
+    average[1] = &factorization->ftranAverageAfterR_;
+    average[2] = &factorization->ftranAverageAfterU_;
+  } else {
+    save[0] = factorization->btranCountInput_;
+    save[1] = factorization->btranCountAfterU_;
+    save[2] = factorization->btranCountAfterR_;
+    save[3] = factorization->btranCountAfterL_;
+    save[4] = factorization->numberBtranCounts_;
+    average[0] = &factorization->btranAverageAfterU_;
+    average[1] = &factorization->btranAverageAfterR_;
+    average[2] = &factorization->btranAverageAfterL_;
+  }
+  for (int i = 0; i < 3; i++)
+    save[5 + i] = *average[i];
+  int mode = stats.numberToExplore ? 1 - stats.mode : stats.mode;
+  save[8] = mode;
+  if (mode) {
+    // large enough to stop hyper-sparse (without overflow)
+    double big = CoinMax(1.0, 1.0e9 / (factorization->numberRows() + 1.0));
+    for (int i = 0; i < 3; i++)
+      *average[i] = big;
+  } else if (adaptiveSolves_ > 1 && stats.count > 20.0) {
+    double before = CoinMax(stats.countInput, 1.0);
+    for (int i = 0; i < 3; i++) {
+      double after = CoinMax(stats.countAfter[i], 1.0);
+      *average[i] = CoinMax(after / before, 1.0);
+      before = after;
+    }
+  }
+  save[9] = adaptiveSolves_ > 2 ? CoinGetTimeOfDay() : 0.0;
+}
+// Updates statistics after a type of solve and restores averages
+void ClpFactorization::endSolve(int type, const double *save) const
+{
+  CoinFactorization *factorization = coinFactorizationA_;
+  ClpSolveStatistics &stats = solveStatistics_[type];
+  double *average[3];
+  double now[5];
+  if (type < 2) {
+    now[0] = factorization->ftranCountInput_;
+    now[1] = factorization->ftranCountAfterL_;
+    now[2] = factorization->ftranCountAfterR_;
+    now[3] = factorization->ftranCountAfterU_;
+    now[4] = factorization->numberFtranCounts_;
+    average[0] = &factorization->ftranAverageAfterL_;
+    average[1] = &factorization->ftranAverageAfterR_;
+    average[2] = &factorization->ftranAverageAfterU_;
+  } else {
+    now[0] = factorization->btranCountInput_;
+    now[1] = factorization->btranCountAfterU_;
+    now[2] = factorization->btranCountAfterR_;
+    now[3] = factorization->btranCountAfterL_;
+    now[4] = factorization->numberBtranCounts_;
+    average[0] = &factorization->btranAverageAfterU_;
+    average[1] = &factorization->btranAverageAfterR_;
+    average[2] = &factorization->btranAverageAfterL_;
+  }
+  for (int i = 0; i < 3; i++)
+    *average[i] = save[5 + i];
+  // number of solves (none if statistics were not being collected)
+  int number = static_cast< int >(now[4] - save[4]);
+  if (number > 0) {
+    stats.numberSolves += number;
+    stats.count += number;
+    stats.countInput += now[0] - save[0];
+    for (int i = 0; i < 3; i++)
+      stats.countAfter[i] += now[1 + i] - save[1 + i];
+    if (adaptiveSolves_ > 2) {
+      int mode = static_cast< int >(save[8]);
+      stats.time[mode] += CoinGetTimeOfDay() - save[9];
+      stats.numberTimed[mode] += number;
+    }
+    if (stats.numberToExplore)
+      stats.numberToExplore = CoinMax(stats.numberToExplore - number, 0);
+  }
+}
+/* Decays statistics and chooses modes.
+   Other mode is tried for a few solves when its timing is out of date.
+   Fewer are tried if it was much slower last time, so that exploring
+   costs little even when one mode is hopeless */
+void ClpFactorization::updateSolveModes()
+{
+  for (int i = 0; i < 3; i++) {
+    ClpSolveStatistics &stats = solveStatistics_[i];
+    stats.count *= 0.8;
+    stats.countInput *= 0.8;
+    for (int j = 0; j < 3; j++)
+      stats.countAfter[j] *= 0.8;
+    for (int j = 0; j < 2; j++) {
+      stats.time[j] *= 0.8;
+      stats.numberTimed[j] *= 0.8;
+    }
+    if (adaptiveSolves_ < 3)
+      continue;
+    int mode = stats.mode;
+    int other = 1 - mode;
+    stats.numberToExplore = 0;
+    if (stats.numberTimed[mode] < 1.0)
+      continue; // nothing to go on yet
+    double costMode = stats.time[mode] / stats.numberTimed[mode];
+    if (stats.numberTimed[other] < 1.0) {
+      stats.numberToExplore = 10;
+    } else {
+      double costOther = stats.time[other] / stats.numberTimed[other];
+      if (costOther < 0.9 * costMode) {
+        stats.mode = other;
+        stats.numberSwitches++;
+      } else if (stats.time[other] < 0.02 * stats.time[mode]) {
+        double ratio = costMode / CoinMax(costOther, 1.0e-12);
+        stats.numberToExplore = CoinMax(1, static_cast< int >(10.0 * ratio));
+      }
+    }
+  }
+}
+// Takes statistics of solves from another factorization
+void ClpFactorization::copySolveStatistics(const ClpFactorization &rhs)
+{
+  for (int i = 0; i < 3; i++)
+    solveStatistics_[i] = rhs.solveStatistics_[i];
+}
+// Print statistics of solves (using message handler of model)
+void ClpFactorization::printSolveStatistics(ClpSimplex *model) const
+{
+  const char *name[] = { "FTRAN column", "FTRAN other", "BTRAN row" };
+  char line[300];
+  for (int i = 0; i < 3; i++) {
+    const ClpSolveStatistics &stats = solveStatistics_[i];
+    if (!stats.numberSolves)
+      continue;
+    double count = CoinMax(stats.count, 1.0e-12);
+    int length = sprintf(line, "%s %d solves - average in %g, after stages %g %g %g - mode %d (%d switches)",
+      name[i], stats.numberSolves, stats.countInput / count,
+      stats.countAfter[0] / count, stats.countAfter[1] / count,
+      stats.countAfter[2] / count, stats.mode, stats.numberSwitches);
+    if (stats.numberTimed[0] || stats.numberTimed[1])
+      sprintf(line + length, " - time per solve %g %g",
+        stats.numberTimed[0] ? stats.time[0] / stats.numberTimed[0] : 0.0,
+        stats.numberTimed[1] ? stats.time[1] / stats.numberTimed[1] : 0.0);
+    model->messageHandler()->message(CLP_GENERAL, *model->messagesPointer())
+      << line << CoinMessageEol;
+  }
+}
+
 /* Updates one column (FTRAN) from region2
    number returned is negative if no room
    region1 starts as zero and is zero at end */
@@ -2736,10 +2930,15 @@ int ClpFactorization::updateColumnFT(CoinIndexedVector *regionSparse,
 #endif
     int returnCode;
     if (coinFactorizationA_) {
+      double save[10];
+      if (adaptiveSolves_)
+        startSolve(0, save);
       coinFactorizationA_->setCollectStatistics(true);
       returnCode = coinFactorizationA_->updateColumnFT(regionSparse,
         regionSparse2);
       coinFactorizationA_->setCollectStatistics(false);
+      if (adaptiveSolves_)
+        endSolve(0, save);
     } else {
 #ifdef CLP_REUSE_ETAS
       int tempInfo[2];
@@ -2818,11 +3017,16 @@ int ClpFactorization::updateColumn(CoinIndexedVector *regionSparse,
 #endif
     int returnCode;
     if (coinFactorizationA_) {
+      double save[10];
+      if (adaptiveSolves_)
+        startSolve(1, save);
       coinFactorizationA_->setCollectStatistics(doStatistics_);
       returnCode = coinFactorizationA_->updateColumn(regionSparse,
         regionSparse2,
         noPermute);
       coinFactorizationA_->setCollectStatistics(false);
+      if (adaptiveSolves_)
+        endSolve(1, save);
     } else {
       returnCode = coinFactorizationB_->updateColumn(regionSparse,
         regionSparse2,
@@ -2904,22 +3108,41 @@ int ClpFactorization::updateTwoColumnsFT(CoinIndexedVector *regionSparse1,
     factorization_instrument(-1);
 #endif
     if (coinFactorizationA_) {
-      coinFactorizationA_->setCollectStatistics(true);
-      if (coinFactorizationA_->spaceForForrestTomlin()) {
-        assert(regionSparse2->packedMode());
-        assert(!regionSparse3->packedMode());
-        returnCode = coinFactorizationA_->updateTwoColumnsFT(regionSparse1,
-          regionSparse2,
-          regionSparse3,
-          noPermuteRegion3);
-      } else {
+      if (adaptiveSolves_) {
+        /* do separately so second (e.g. weights) is set up and
+           counted as its own type of solve */
+        double save[10];
+        startSolve(0, save);
+        coinFactorizationA_->setCollectStatistics(true);
         returnCode = coinFactorizationA_->updateColumnFT(regionSparse1,
           regionSparse2);
+        coinFactorizationA_->setCollectStatistics(false);
+        endSolve(0, save);
+        startSolve(1, save);
+        coinFactorizationA_->setCollectStatistics(true);
         coinFactorizationA_->updateColumn(regionSparse1,
           regionSparse3,
           noPermuteRegion3);
+        coinFactorizationA_->setCollectStatistics(false);
+        endSolve(1, save);
+      } else {
+        coinFactorizationA_->setCollectStatistics(true);
+        if (coinFactorizationA_->spaceForForrestTomlin()) {
+          assert(regionSparse2->packedMode());
+          assert(!regionSparse3->packedMode());
+          returnCode = coinFactorizationA_->updateTwoColumnsFT(regionSparse1,
+            regionSparse2,
+            regionSparse3,
+            noPermuteRegion3);
+        } else {
+          returnCode = coinFactorizationA_->updateColumnFT(regionSparse1,
+            regionSparse2);
+          coinFactorizationA_->updateColumn(regionSparse1,
+            regionSparse3,
+            noPermuteRegion3);
+        }
+        coinFactorizationA_->setCollectStatistics(false);
       }
-      coinFactorizationA_->setCollectStatistics(false);
     } else {
 #if 0
                CoinSimpFactorization * fact =
@@ -3004,10 +3227,15 @@ int ClpFactorization::updateColumnTranspose(CoinIndexedVector *regionSparse,
     int returnCode;
 
     if (coinFactorizationA_) {
+      double save[10];
+      if (adaptiveSolves_)
+        startSolve(2, save);
       coinFactorizationA_->setCollectStatistics(doStatistics_);
       returnCode = coinFactorizationA_->updateColumnTranspose(regionSparse,
         regionSparse2);
       coinFactorizationA_->setCollectStatistics(false);
+      if (adaptiveSolves_)
+        endSolve(2, save);
     } else {
       returnCode = coinFactorizationB_->updateColumnTranspose(regionSparse,
         regionSparse2);
@@ -3079,6 +3307,9 @@ void ClpFactorization::updateTwoColumnsTranspose(CoinIndexedVector *regionSparse
     factorization_instrument(-1);
 #endif
     if (coinFactorizationA_) {
+      double save[10];
+      if (adaptiveSolves_)
+        startSolve(2, save);
       coinFactorizationA_->setCollectStatistics(doStatistics_);
 #if ABOCA_LITE_FACTORIZATION
       coinFactorizationA_->updateTwoColumnsTranspose(regionSparse,
@@ -3088,6 +3319,8 @@ void ClpFactorization::updateTwoColumnsTranspose(CoinIndexedVector *regionSparse
         regionSparse2, regionSparse3, 0);
 #endif
       coinFactorizationA_->setCollectStatistics(false);
+      if (adaptiveSolves_)
+        endSolve(2, save);
     } else {
       coinFactorizationB_->updateColumnTranspose(regionSparse,
         regionSparse2);
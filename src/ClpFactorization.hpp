@@ -27,6 +27,35 @@ class CoinOtherFactorization;
 #define CLP_FACTORIZATION_NEW_TIMING 1
 #endif
 
+/** Statistics kept by ClpFactorization for one type of solve.
+    Counts decay by 0.8 at each refactorization so recent behaviour
+    dominates.  Stages are L,R,U for FTRAN and U,R,L for BTRAN.
+*/
+class CLPLIB_EXPORT ClpSolveStatistics {
+
+public:
+  /// Default constructor - all zero
+  ClpSolveStatistics();
+  /// Number of solves (not decayed)
+  int numberSolves;
+  /// Number of times mode has changed
+  int numberSwitches;
+  /// Mode 0 - hyper-sparse allowed, 1 - not allowed
+  int mode;
+  /// Solves left to do in other mode while exploring
+  int numberToExplore;
+  /// Decayed count of solves
+  double count;
+  /// Decayed nonzeros in input
+  double countInput;
+  /// Decayed nonzeros after each stage
+  double countAfter[3];
+  /// Decayed wall clock time spent in each mode (if timing)
+  double time[2];
+  /// Decayed number of solves timed in each mode
+  double numberTimed[2];
+};
+
 /** This just implements CoinFactorization when an ClpMatrixBase object
     is passed.  If a network then has a dummy CoinFactorization and
     a genuine ClpNetworkBasis object
@@ -449,6 +478,32 @@ public:
   }
   /// Go over to dense or small code if small enough
   void goDenseOrSmall(int numberRows);
+  /** Adaptive choice of sparse or hyper-sparse solves in CoinFactorization
+      0 - off (CoinFactorization decides on all solves together)
+      1 - just collect statistics by type of solve
+      2 - also use density statistics of each type of solve
+      3 - also time solves and switch off hyper-sparse where slower
+          (results can then depend on timing)
+      If on, the two solves in updateTwoColumnsFT are done one after
+      the other and counted as types 0 and 1.
+  */
+  inline int adaptiveSolves() const
+  {
+    return adaptiveSolves_;
+  }
+  /// Set adaptive choice of solves (see adaptiveSolves)
+  void setAdaptiveSolves(int value);
+  /** Statistics for a type of solve -
+      0 FTRAN of column, 1 other FTRAN (e.g. weights), 2 BTRAN of row */
+  inline const ClpSolveStatistics &solveStatistics(int type) const
+  {
+    return solveStatistics_[type];
+  }
+  /** Takes statistics of solves from another factorization
+      (e.g. of presolved model which started with a copy of this) */
+  void copySolveStatistics(const ClpFactorization &rhs);
+  /// Print statistics of solves using message handler of model
+  void printSolveStatistics(ClpSimplex *model) const;
   /// Sets factorization
   void setFactorization(ClpFactorization &factorization);
   /// Return 1 if dense code
@@ -510,6 +565,20 @@ public:
   void getWeights(int *weights) const;
   //@}
 
+private:
+#ifdef CLP_MULTIPLE_FACTORIZATIONS
+  /**@name adaptive solves */
+  //@{
+  /** Sets up CoinFactorization for a type of solve.
+      save gets counts, averages and start time */
+  void startSolve(int type, double *save) const;
+  /// Updates statistics after a type of solve and restores averages
+  void endSolve(int type, const double *save) const;
+  /// Decays statistics and chooses modes - called at refactorization
+  void updateSolveModes();
+  //@}
+#endif
+
   ////////////////// data //////////////////
 private:
   /**@name data */
@@ -535,6 +604,10 @@ private:
   int goSmallThreshold_;
   /// Switch to dense if number rows <= this
   int goDenseThreshold_;
+  /// Adaptive choice of sparse or hyper-sparse solves
+  int adaptiveSolves_;
+  /// Statistics by type of solve
+  mutable ClpSolveStatistics solveStatistics_[3];
 #endif
 #ifdef CLP_FACTORIZATION_NEW_TIMING
   /// For guessing when to re-factorize
@@ -159,6 +159,8 @@ ClpGubDynamicMatrix::ClpGubDynamicMatrix(ClpSimplex *model, int numberSets,
     id_[i] = -1;
   ClpPackedMatrix *originalMatrixA = dynamic_cast< ClpPackedMatrix * >(model->clpMatrix());
   assert(originalMatrixA);
+  // matrix is going to be changed so must not be shared
+  originalMatrixA->unshare();
   CoinPackedMatrix *originalMatrix = originalMatrixA->getPackedMatrix();
   originalMatrixA->setMatrixNull(); // so can be deleted safely
   // guess how much space needed
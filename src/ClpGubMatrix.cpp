@@ -16,6 +16,44 @@
 #include "ClpGubMatrix.hpp"
 //#include "ClpGubDynamicMatrix.hpp"
 #include "ClpMessage.hpp"
+#include "ClpThreadPool.hpp"
+#include <vector>
+// Fewest gub columns in a block when pricing is split over threads
+#ifndef CLP_GUB_BLOCK
+#define CLP_GUB_BLOCK 20000
+#endif
+// A reduced cost which partialPricing on threads may want
+struct ClpGubPricingCandidate {
+  /// Column being looked at when found
+  int iteration;
+  /// Sequence (numberRows+numberColumns+set for gub slack)
+  int sequence;
+  /// Sets started in block before column being looked at
+  int setsBefore;
+  /// True if flagged
+  bool flagged;
+  /// Dual infeasibility (biased if free)
+  double value;
+  /// Dual on gub row
+  double djMod;
+};
+// A range of gub columns priced on a thread
+struct ClpGubPricingBlock {
+  /// First column
+  int first;
+  /// Last column plus one
+  int last;
+  /// Set of column before first (or -1)
+  int previousSet;
+  /// Sets started in block
+  int numberSets;
+  /// Last column looked at (may be before last-1 if stopped early)
+  int lastIteration;
+  /// Sets started in block before lastIteration
+  int setsBeforeLast;
+  /// Candidates in order found
+  std::vector< ClpGubPricingCandidate > candidates;
+};
 //#define CLP_DEBUG
 //#define CLP_DEBUG_PRINT
 //#############################################################################
@@ -1376,7 +1414,141 @@ void ClpGubMatrix::partialPricing(ClpSimplex *model, double startFraction, doubl
       int iSet = -1;
       double djMod = 0.0;
       double infeasibilityCost = model->infeasibilityCost();
-      if (rowScale) {
+      // unscaled serial code does not go past endG
+      int last = (rowScale && bestSequence < 0) ? endAll : endG;
+      int numberBlocks = 1;
+      if (model->numberThreads() > 1 && last - startG >= 2 * CLP_GUB_BLOCK && numberWanted) {
+        numberBlocks = CoinMin(model->numberThreads(),
+          ClpPricingThreadPool()->numberThreads() + 1);
+        numberBlocks = CoinMin(numberBlocks, (last - startG) / CLP_GUB_BLOCK);
+      }
+      if (numberBlocks > 1) {
+        /* sets are independent so price ranges of columns on threads.
+           Each block keeps all candidates in order and they are then
+           gone through as the serial code would so the give up rules
+           and choice are the same whatever the number of threads. */
+        int nBlocks = numberBlocks;
+        // endG must start a block if may go past it
+        if (startG < endG && endG < last)
+          nBlocks++;
+        ClpGubPricingBlock *blocks = new ClpGubPricingBlock[nBlocks];
+        int iBlock = 0;
+        for (int k = 0; k < numberBlocks; k++) {
+          int iStart = startG + static_cast< int >((static_cast< double >(last - startG) * k) / numberBlocks);
+          int iEnd = startG + static_cast< int >((static_cast< double >(last - startG) * (k + 1)) / numberBlocks);
+          if (iStart < endG && endG < iEnd && nBlocks > numberBlocks) {
+            blocks[iBlock].first = iStart;
+            blocks[iBlock++].last = endG;
+            iStart = endG;
+          }
+          blocks[iBlock].first = iStart;
+          blocks[iBlock++].last = iEnd;
+        }
+        nBlocks = iBlock;
+        {
+          ClpTaskGroup tasks(ClpPricingThreadPool());
+          for (iBlock = 0; iBlock < nBlocks; iBlock++) {
+            ClpGubPricingBlock *block = blocks + iBlock;
+            // serial code remembers set of previous column
+            block->previousSet = block->first > startG ? backward_[block->first - 1] : -1;
+            tasks.spawn([=] {
+              partialPricingBlock(model, *block, numberWanted, minSet, minNeg);
+            });
+          }
+          tasks.sync();
+        }
+        double bestDjMod = 0.0;
+        bool finished = false;
+        for (iBlock = 0; iBlock < nBlocks && !finished; iBlock++) {
+          const ClpGubPricingBlock &block = blocks[iBlock];
+          if (block.first == endG && bestSequence >= 0) {
+            if (numberWanted + minNeg < originalWanted_ && nSets > minSet)
+              numberWanted = 0; // give up
+            break;
+          }
+          int lastIteration = -1;
+          int numberCandidates = static_cast< int >(block.candidates.size());
+          for (int k = 0; k < numberCandidates; k++) {
+            const ClpGubPricingCandidate &candidate = block.candidates[k];
+            if (candidate.iteration != lastIteration) {
+              if (!numberWanted || (numberWanted + minNeg < originalWanted_ && nSets + candidate.setsBefore > minSet)) {
+                // give up (or got enough)
+                numberWanted = 0;
+                finished = true;
+                break;
+              }
+              lastIteration = candidate.iteration;
+            }
+            numberWanted--;
+            if (candidate.value > bestDj) {
+              // check flagged variable and correct dj
+              if (!candidate.flagged) {
+                bestDj = candidate.value;
+                bestSequence = candidate.sequence;
+                bestDjMod = candidate.djMod;
+              } else {
+                // just to make sure we don't exit before got something
+                numberWanted++;
+              }
+            }
+          }
+          if (finished || !numberWanted)
+            break;
+          // rest of block had no candidates but serial code may have given up
+          if (lastIteration != block.lastIteration && numberWanted + minNeg < originalWanted_
+            && nSets + block.setsBeforeLast > minSet) {
+            numberWanted = 0;
+            break;
+          }
+          nSets += block.numberSets;
+          if (iBlock == nBlocks - 1 && rowScale && last == endG && endG < endAll) {
+            // serial code would look at endG before stopping
+            if (numberWanted + minNeg < originalWanted_ && nSets > minSet)
+              numberWanted = 0;
+          }
+        }
+        delete[] blocks;
+        if (bestSequence != saveSequence) {
+          if (bestSequence < numberRows + numberColumns) {
+            // recompute dj (as in serial code)
+            if (rowScale) {
+              double value = bestDjMod;
+              for (j = startColumn[bestSequence];
+                   j < startColumn[bestSequence] + length[bestSequence]; j++) {
+                int jRow = row[j];
+                value -= duals[jRow] * element[j] * rowScale[jRow];
+              }
+              reducedCost[bestSequence] = cost[bestSequence] + value * columnScale[bestSequence];
+            } else {
+              double value = cost[bestSequence] - bestDjMod;
+              for (j = startColumn[bestSequence];
+                   j < startColumn[bestSequence] + length[bestSequence]; j++) {
+                int jRow = row[j];
+                value -= duals[jRow] * element[j];
+              }
+              reducedCost[bestSequence] = value;
+            }
+            gubSlackIn_ = -1;
+          } else {
+            // slack - make last column
+            gubSlackIn_ = bestSequence - numberRows - numberColumns;
+            bestSequence = numberColumns + 2 * numberRows;
+            reducedCost[bestSequence] = bestDjMod;
+            model->setStatus(bestSequence, getStatus(gubSlackIn_));
+            if (getStatus(gubSlackIn_) == ClpSimplex::atUpperBound)
+              model->solutionRegion()[bestSequence] = upper_[gubSlackIn_];
+            else
+              model->solutionRegion()[bestSequence] = lower_[gubSlackIn_];
+            model->lowerRegion()[bestSequence] = lower_[gubSlackIn_];
+            model->upperRegion()[bestSequence] = upper_[gubSlackIn_];
+            model->costRegion()[bestSequence] = 0.0;
+          }
+          if (rowScale) {
+            savedBestSequence_ = bestSequence;
+            savedBestDj_ = reducedCost[savedBestSequence_];
+          }
+        }
+      } else if (rowScale) {
         double bestDjMod = 0.0;
         // scaled
         for (iSequence = startG; iSequence < endAll; iSequence++) {
@@ -1776,6 +1948,136 @@ void ClpGubMatrix::partialPricing(ClpSimplex *model, double startFraction, doubl
     infeasibilityWeight_ = -1.0; // not optimal
   currentWanted_ = numberWanted;
 }
+/* Prices gub columns block.first to block.last-1 for partialPricing on
+   threads.  Only looks at model and this so blocks can run at same time.
+   Every candidate is saved (in order) so caller can go through them as
+   serial code would.  Stops early once serial code must have given up
+   whatever happened in earlier blocks. */
+void ClpGubMatrix::partialPricingBlock(const ClpSimplex *model, ClpGubPricingBlock &block,
+  int numberWanted, int minSet, int minNeg) const
+{
+  const double *COIN_RESTRICT element = matrix_->getElements();
+  const int *COIN_RESTRICT row = matrix_->getIndices();
+  const CoinBigIndex *COIN_RESTRICT startColumn = matrix_->getVectorStarts();
+  const int *COIN_RESTRICT length = matrix_->getVectorLengths();
+  const double *COIN_RESTRICT rowScale = model->rowScale();
+  const double *COIN_RESTRICT columnScale = model->columnScale();
+  double tolerance = model->currentDualTolerance();
+  const double *COIN_RESTRICT duals = model->dualRowSolution();
+  const double *COIN_RESTRICT cost = model->costRegion();
+  int numberColumns = model->numberColumns();
+  int numberRows = model->numberRows();
+  int sequenceOut = model->sequenceOut();
+  double infeasibilityCost = model->infeasibilityCost();
+  int nSets = 0;
+  // candidates which will certainly reduce number wanted
+  int numberFound = 0;
+  ClpGubPricingCandidate candidate;
+  block.candidates.clear();
+  block.lastIteration = block.first - 1;
+  block.setsBeforeLast = 0;
+  int iSet = block.previousSet;
+  double djMod = 0.0;
+  for (int iSequence = block.first; iSequence < block.last; iSequence++) {
+    block.lastIteration = iSequence;
+    block.setsBeforeLast = nSets;
+    if (numberWanted - numberFound + minNeg < originalWanted_ && nSets > minSet)
+      break; // serial code has given up by now
+    bool newSet = backward_[iSequence] != iSet;
+    // need pi on gub row of any set continued from previous block
+    if (newSet || iSequence == block.first) {
+      iSet = backward_[iSequence];
+      djMod = 0.0;
+      if (iSet >= 0) {
+        if (newSet)
+          nSets++;
+        int iBasic = keyVariable_[iSet];
+        if (iBasic >= numberColumns) {
+          djMod = -weight(iSet) * infeasibilityCost;
+        } else {
+          // get dj without - same order as serial code
+          assert(model->getStatus(iBasic) == ClpSimplex::basic);
+          if (rowScale) {
+            for (CoinBigIndex j = startColumn[iBasic];
+                 j < startColumn[iBasic] + length[iBasic]; j++) {
+              int jRow = row[j];
+              djMod -= duals[jRow] * element[j] * rowScale[jRow];
+            }
+            djMod += cost[iBasic] / columnScale[iBasic];
+          } else {
+            for (CoinBigIndex j = startColumn[iBasic];
+                 j < startColumn[iBasic] + length[iBasic]; j++) {
+              int jRow = row[j];
+              djMod -= duals[jRow] * element[j];
+            }
+            djMod += cost[iBasic];
+          }
+          // See if gub slack possible - dj is djMod
+          double value = 0.0;
+          if (getStatus(iSet) == ClpSimplex::atLowerBound)
+            value = -djMod;
+          else if (getStatus(iSet) == ClpSimplex::atUpperBound)
+            value = djMod;
+          if (newSet && value > tolerance) {
+            candidate.iteration = iSequence;
+            candidate.sequence = numberRows + numberColumns + iSet;
+            candidate.setsBefore = block.setsBeforeLast;
+            candidate.flagged = flagged(iSet);
+            candidate.value = value;
+            candidate.djMod = djMod;
+            block.candidates.push_back(candidate);
+            if (!candidate.flagged)
+              numberFound++;
+          }
+        }
+      }
+    }
+    if (iSequence == sequenceOut)
+      continue;
+    ClpSimplex::Status status = model->getStatus(iSequence);
+    if (status == ClpSimplex::basic || status == ClpSimplex::isFixed)
+      continue;
+    double value;
+    if (rowScale) {
+      value = -djMod;
+      for (CoinBigIndex j = startColumn[iSequence];
+           j < startColumn[iSequence] + length[iSequence]; j++) {
+        int jRow = row[j];
+        value -= duals[jRow] * element[j] * rowScale[jRow];
+      }
+      value = cost[iSequence] + value * columnScale[iSequence];
+    } else {
+      value = cost[iSequence] - djMod;
+      for (CoinBigIndex j = startColumn[iSequence];
+           j < startColumn[iSequence] + length[iSequence]; j++) {
+        int jRow = row[j];
+        value -= duals[jRow] * element[j];
+      }
+    }
+    if (status == ClpSimplex::atLowerBound) {
+      value = -value;
+    } else if (status != ClpSimplex::atUpperBound) {
+      // free or superbasic - we are going to bias towards free (but only if reasonable)
+      value = fabs(value);
+      if (value > FREE_ACCEPT * tolerance)
+        value *= FREE_BIAS;
+      else
+        value = 0.0;
+    }
+    if (value > tolerance) {
+      candidate.iteration = iSequence;
+      candidate.sequence = iSequence;
+      candidate.setsBefore = block.setsBeforeLast;
+      candidate.flagged = model->flagged(iSequence);
+      candidate.value = value;
+      candidate.djMod = djMod;
+      block.candidates.push_back(candidate);
+      if (!candidate.flagged)
+        numberFound++;
+    }
+  }
+  block.numberSets = nSets;
+}
 /* expands an updated column to allow for extra rows which the main
    solver does not know about and returns number added.
 */
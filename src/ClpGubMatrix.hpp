@@ -9,6 +9,7 @@
 
 #include "ClpPackedMatrix.hpp"
 class ClpSimplex;
+struct ClpGubPricingBlock;
 /** This implements Gub rows plus a ClpPackedMatrix.
 
     There will be a version using ClpPlusMinusOne matrix but
@@ -292,6 +293,17 @@ public:
   void switchOffCheck();
   //@}
 
+protected:
+  /**@name Pricing on threads */
+  //@{
+  /** Prices a block of gub columns and saves all candidates so that
+         partialPricing can choose as serial code would.  Does not change
+         this or model so blocks can be done on threads.
+         Used by partialPricing when model numberThreads() > 1. */
+  void partialPricingBlock(const ClpSimplex *model, ClpGubPricingBlock &block,
+    int numberWanted, int minSet, int minNeg) const;
+  //@}
+
 protected:
   /**@name Data members
         The data members are protected to allow access for derived classes. */
@@ -515,6 +515,21 @@ void ClpInterior::gutsOfDelete()
   wVec_ = NULL;
   delete cholesky_;
 }
+/* Rounds scale factors (and inverses which follow them) to powers of 2
+   so that scaling a matrix in place can be undone exactly */
+static void roundScaleFactors(double *scale, int number)
+{
+  double *inverse = scale + number;
+  for (int i = 0; i < number; i++) {
+    int exponent;
+    double fraction = frexp(scale[i], &exponent);
+    // fraction is in [0.5,1) - go to nearer power in log sense
+    if (fraction < 0.70710678118654752)
+      exponent--;
+    scale[i] = ldexp(1.0, exponent);
+    inverse[i] = ldexp(1.0, -exponent);
+  }
+}
 bool ClpInterior::createWorkingData()
 {
   bool goodMatrix = true;
@@ -541,8 +556,13 @@ bool ClpInterior::createWorkingData()
   memset(cost_ + numberColumns_, 0, numberRows_ * sizeof(CoinWorkDouble));
   // do scaling if needed
   if (scalingFlag_ > 0 && !rowScale_) {
-    if (matrix_->scale(this))
+    if (matrix_->scale(this)) {
       scalingFlag_ = -scalingFlag_; // not scaled after all
+    } else if (rowScale_ && (specialOptions_ & 0x10000000) != 0) {
+      // implicit scaling - matrix will be scaled in place so use powers of 2
+      roundScaleFactors(rowScale_, numberRows_);
+      roundScaleFactors(columnScale_, numberColumns_);
+    }
   }
   delete[] lower_;
   delete[] upper_;
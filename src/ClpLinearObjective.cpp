@@ -279,6 +279,14 @@ void ClpLinearObjective::reallyScale(const double *columnScale)
     objective_[iColumn] *= columnScale[iColumn];
   }
 }
+// Takes over objective
+void ClpLinearObjective::assignObjective(double *&objective, int numberColumns)
+{
+  delete[] objective_;
+  objective_ = objective;
+  numberColumns_ = numberColumns;
+  objective = NULL;
+}
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
@@ -51,6 +51,9 @@ public:
   virtual void deleteSome(int numberToDelete, const int *which);
   /// Scale objective
   virtual void reallyScale(const double *columnScale);
+  /** Takes over objective (allocated with new []) rather than copying.
+         On return objective is NULL. */
+  void assignObjective(double *&objective, int numberColumns);
 
   //@}
 
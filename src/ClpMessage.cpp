@@ -105,6 +105,7 @@ static Clp_message clp_us_english[] = {
   { CLP_CRUNCH_STATS, 61, 2, "Crunch %d (%d) rows, %d (%d) columns and %d (%d) elements" },
   { CLP_PARAMETRICS_STATS, 62, 1, "Theta %g - objective %g" },
   { CLP_PARAMETRICS_STATS2, 63, 2, "Theta %g - objective %g, %s in, %s out" },
+  { CLP_MATRIX_STRUCTURE, 66, 1, "Matrix has %d +1, %d -1 and %d other elements - %s" },
 #ifndef NO_FATHOM_PRINT
   { CLP_FATHOM_STATUS, 63, 2, "Fathoming node %d - %d nodes (%d iterations) - current depth %d" },
   { CLP_FATHOM_SOLUTION, 64, 1, "Fathoming node %d - solution of %g after %d nodes at depth %d" },
@@ -103,6 +103,7 @@ enum CLP_Message {
   CLP_CRUNCH_STATS,
   CLP_PARAMETRICS_STATS,
   CLP_PARAMETRICS_STATS2,
+  CLP_MATRIX_STRUCTURE,
 #ifndef NO_FATHOM_PRINT
   CLP_FATHOM_STATUS,
   CLP_FATHOM_SOLUTION,
@@ -42,6 +42,7 @@
 #include "ClpPackedMatrix.hpp"
 #ifndef SLIM_CLP
 #include "ClpPlusMinusOneMatrix.hpp"
+#include "ClpNetworkMatrix.hpp"
 #endif
 #ifndef CLP_NO_VECTOR
 #include "CoinPackedVector.hpp"
@@ -54,6 +55,7 @@
 #include "CoinMpsIO.hpp"
 #include "CoinFileIO.hpp"
 #include "CoinModel.hpp"
+#include "ClpMpsReader.hpp"
 #endif
 #include "ClpMessage.hpp"
 #include "CoinMessage.hpp"
@@ -121,6 +123,7 @@ ClpModel::ClpModel(bool emptyMessages)
   , maximumInternalRows_(-1)
   , savedRowScale_(NULL)
   , savedColumnScale_(NULL)
+  , importedScaling_(NULL)
 {
   intParam_[ClpMaxNumIteration] = 2147483647;
   intParam_[ClpMaxNumIterationHotStart] = 9999999;
@@ -157,6 +160,7 @@ ClpModel::~ClpModel()
     handler_ = NULL;
   }
   gutsOfDelete(0);
+  delete importedScaling_;
 }
 // Does most of deletion (0 = all, 1 = most)
 void ClpModel::gutsOfDelete(int type)
@@ -271,7 +275,6 @@ void ClpModel::gutsOfLoadModel(int numberRows, int numberColumns,
 
   CoinZeroN(dual_, numberRows_);
   CoinZeroN(reducedCost_, numberColumns_);
-  int iRow, iColumn;
 
   rowLower_ = ClpCopyOfArray(rowlb, numberRows_, -COIN_DBL_MAX);
   rowUpper_ = ClpCopyOfArray(rowub, numberRows_, COIN_DBL_MAX);
@@ -281,7 +284,12 @@ void ClpModel::gutsOfLoadModel(int numberRows, int numberColumns,
   rowObjective_ = ClpCopyOfArray(rowObjective, numberRows_);
   columnLower_ = ClpCopyOfArray(collb, numberColumns_, 0.0);
   columnUpper_ = ClpCopyOfArray(colub, numberColumns_, COIN_DBL_MAX);
-  // set default solution and clean bounds
+  gutsOfCleanBounds();
+}
+// Sets default solution and cleans infinite bounds
+void ClpModel::gutsOfCleanBounds()
+{
+  int iRow, iColumn;
   for (iRow = 0; iRow < numberRows_; iRow++) {
     if (rowLower_[iRow] > 0.0) {
       rowActivity_[iRow] = rowLower_[iRow];
@@ -336,6 +344,8 @@ void ClpModel::loadProblem(const ClpMatrixBase &matrix,
     matrix_ = new ClpPackedMatrix(matrix2);
   }
   matrix_->setDimensions(numberRows_, numberColumns_);
+  if ((specialOptions_ & 0x04000000) != 0)
+    convertMatrixStructure();
 }
 void ClpModel::loadProblem(const CoinPackedMatrix &matrix,
   const double *collb, const double *colub,
@@ -361,6 +371,62 @@ void ClpModel::loadProblem(const CoinPackedMatrix &matrix,
     matrix_ = new ClpPackedMatrix(matrix2);
   }
   matrix_->setDimensions(numberRows_, numberColumns_);
+  if ((specialOptions_ & 0x04000000) != 0)
+    convertMatrixStructure();
+}
+/* Takes over matrix and arrays instead of copying them - on return all
+   pointers are NULL.  Arrays must have been allocated with new [] */
+void ClpModel::assignProblem(CoinPackedMatrix *&matrix,
+  double *&collb, double *&colub,
+  double *&obj,
+  double *&rowlb, double *&rowub)
+{
+  ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(matrix_);
+  bool special = (clpMatrix) ? clpMatrix->wantsSpecialColumnCopy() : false;
+  // load defaults and then replace by arrays given
+  gutsOfLoadModel(matrix->getNumRows(), matrix->getNumCols(),
+    NULL, NULL, NULL, NULL, NULL);
+  if (obj)
+    static_cast< ClpLinearObjective * >(objective_)->assignObjective(obj, numberColumns_);
+  if (collb) {
+    delete[] columnLower_;
+    columnLower_ = collb;
+  }
+  if (colub) {
+    delete[] columnUpper_;
+    columnUpper_ = colub;
+  }
+  if (rowlb) {
+    delete[] rowLower_;
+    rowLower_ = rowlb;
+  }
+  if (rowub) {
+    delete[] rowUpper_;
+    rowUpper_ = rowub;
+  }
+  gutsOfCleanBounds();
+  collb = NULL;
+  colub = NULL;
+  rowlb = NULL;
+  rowub = NULL;
+  if (matrix->isColOrdered()) {
+    matrix_ = new ClpPackedMatrix(matrix);
+    if (special) {
+      clpMatrix = static_cast< ClpPackedMatrix * >(matrix_);
+      clpMatrix->makeSpecialColumnCopy();
+    }
+  } else {
+    CoinPackedMatrix *matrix2 = new CoinPackedMatrix();
+    matrix2->setExtraGap(0.0);
+    matrix2->setExtraMajor(0.0);
+    matrix2->reverseOrderedCopyOf(*matrix);
+    delete matrix;
+    matrix_ = new ClpPackedMatrix(matrix2);
+  }
+  matrix = NULL;
+  matrix_->setDimensions(numberRows_, numberColumns_);
+  if ((specialOptions_ & 0x04000000) != 0)
+    convertMatrixStructure();
 }
 void ClpModel::loadProblem(
   const int numcols, const int numrows,
@@ -378,6 +444,8 @@ void ClpModel::loadProblem(
     value, index, start, NULL);
   matrix_ = new ClpPackedMatrix(matrix);
   matrix_->setDimensions(numberRows_, numberColumns_);
+  if ((specialOptions_ & 0x04000000) != 0)
+    convertMatrixStructure();
 }
 void ClpModel::loadProblem(
   const int numcols, const int numrows,
@@ -398,6 +466,8 @@ void ClpModel::loadProblem(
   CoinPackedMatrix matrix(true, numrows, numcols, numberElements,
     value, index, start, length);
   matrix_ = new ClpPackedMatrix(matrix);
+  if ((specialOptions_ & 0x04000000) != 0)
+    convertMatrixStructure();
 }
 #ifndef SLIM_NOIO
 // This loads a model from a coinModel object - returns number of errors
@@ -492,6 +562,8 @@ int ClpModel::loadProblem(CoinModel &modelObject, bool tryPlusMinusOne)
         << CoinMessageEol;
   }
   matrix_->setDimensions(numberRows_, numberColumns_);
+  if ((specialOptions_ & 0x04000000) != 0)
+    convertMatrixStructure();
   return numberErrors;
 }
 #endif
@@ -677,6 +749,7 @@ ClpModel::ClpModel(const ClpModel &rhs, int scalingMode)
   , maximumInternalRows_(-1)
   , savedRowScale_(NULL)
   , savedColumnScale_(NULL)
+  , importedScaling_(NULL)
 {
   gutsOfCopy(rhs);
   if (scalingMode >= 0 && matrix_ && matrix_->allElementsInRange(this, smallElement_, 1.0e20)) {
@@ -734,6 +807,11 @@ void ClpModel::gutsOfCopy(const ClpModel &rhs, int trueCopy)
     eventHandler_ = rhs.eventHandler_->clone();
     messages_ = rhs.messages_;
     coinMessages_ = rhs.coinMessages_;
+    delete importedScaling_;
+    if (rhs.importedScaling_)
+      importedScaling_ = new ClpScaleFactors(*rhs.importedScaling_);
+    else
+      importedScaling_ = NULL;
   } else {
     if (!eventHandler_ && rhs.eventHandler_)
       eventHandler_ = rhs.eventHandler_->clone();
@@ -1220,6 +1298,7 @@ ClpModel::cleanMatrix(double threshold)
 {
   ClpPackedMatrix *matrix = (dynamic_cast< ClpPackedMatrix * >(matrix_));
   if (matrix) {
+    matrix->unshare();
     return matrix->getPackedMatrix()->cleanMatrix(threshold);
   } else {
     return -1;
@@ -1679,6 +1758,8 @@ void ClpModel::deleteRowsAndColumns(int numberRows, const int *whichRows,
 #endif
     // possible matrix is not full
     ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(matrix_);
+    if (clpMatrix)
+      clpMatrix->unshare();
     CoinPackedMatrix *matrix = clpMatrix ? clpMatrix->matrix() : NULL;
     if (matrix_->getNumCols() < numberColumns_) {
       assert(matrix);
@@ -1815,6 +1896,9 @@ void ClpModel::addRows(int number, const double *rowLower,
 #endif
     if (rowStarts) {
       // Make sure matrix has correct number of columns
+      ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(matrix_);
+      if (clpMatrix)
+        clpMatrix->unshare();
       matrix_->getPackedMatrix()->reserve(numberColumns_, 0, true);
       matrix_->appendMatrix(number, 0, rowStarts, columns, elements);
     }
@@ -2878,6 +2962,39 @@ int ClpModel::readMps(const char *fileName,
         << fileName << CoinMessageEol;
       return -1;
     }
+    if (numberThreads_ > 1) {
+      /* Try threaded reader - if file has anything it does not
+         handle then CoinMpsIO is used (which also gives messages) */
+      double time1 = CoinCpuTime();
+      ClpMpsReader reader;
+      reader.setNumberThreads(numberThreads_);
+      reader.setSmallElementValue(CoinMax(smallElement_, reader.smallElementValue()));
+      if (!reader.readMps(name.c_str(), keepNames)) {
+        delete[] integerType_;
+        integerType_ = NULL;
+        reader.loadIntoModel(*this);
+#ifndef CLP_NO_STD
+        if (keepNames) {
+          rowNames_.swap(reader.rowNames());
+          columnNames_.swap(reader.columnNames());
+          size_t maxLength = 0;
+          for (int iRow = 0; iRow < numberRows_; iRow++)
+            maxLength = CoinMax(maxLength, rowNames_[iRow].length());
+          for (int iColumn = 0; iColumn < numberColumns_; iColumn++)
+            maxLength = CoinMax(maxLength, columnNames_[iColumn].length());
+          lengthNames_ = static_cast< int >(maxLength);
+        } else {
+          rowNames_ = std::vector< std::string >();
+          columnNames_ = std::vector< std::string >();
+          lengthNames_ = 0;
+        }
+#endif
+        handler_->message(CLP_IMPORT_RESULT, messages_)
+          << fileName
+          << CoinCpuTime() - time1 << CoinMessageEol;
+        return 0;
+      }
+    }
   }
   CoinMpsIO m;
   m.passInMessageHandler(handler_);
@@ -3252,6 +3369,93 @@ void ClpModel::replaceMatrix(ClpMatrixBase *matrix, bool deleteCurrent)
   matrix_ = matrix;
   whatsChanged_ = 0; // Too big a change
 }
+/* Looks at a ClpPackedMatrix to see if all elements are +-1 and
+   if so whether at most one +1 and one -1 in each column. */
+int ClpModel::convertMatrixStructure(int allowed)
+{
+#ifndef SLIM_CLP
+#ifndef NO_RTTI
+  ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(matrix_);
+#else
+  ClpPackedMatrix *clpMatrix = NULL;
+  if (matrix_ && matrix_->type() == 1)
+    clpMatrix = static_cast< ClpPackedMatrix * >(matrix_);
+#endif
+  if (!clpMatrix || !clpMatrix->isColOrdered() || !numberColumns_)
+    return 0;
+  const CoinPackedMatrix *matrix = clpMatrix->matrix();
+  const CoinBigIndex *columnStart = matrix->getVectorStarts();
+  const int *columnLength = matrix->getVectorLengths();
+  const double *element = matrix->getElements();
+  CoinBigIndex numberPlus = 0;
+  CoinBigIndex numberMinus = 0;
+  CoinBigIndex numberOther = 0;
+  bool network = true;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    int nPlus = 0;
+    int nMinus = 0;
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      // same tolerance as matrix constructors
+      double value = element[j];
+      if (fabs(value - 1.0) < 1.0e-10)
+        nPlus++;
+      else if (fabs(value + 1.0) < 1.0e-10)
+        nMinus++;
+      else
+        numberOther++;
+    }
+    numberPlus += nPlus;
+    numberMinus += nMinus;
+    if (nPlus > 1 || nMinus > 1)
+      network = false;
+  }
+  CoinBigIndex numberElements = numberPlus + numberMinus + numberOther;
+  int found = 0;
+  if (!numberOther) {
+    found = network ? 2 : 1;
+    if (found == 2 && (allowed & 2) == 0)
+      found = 1;
+  }
+  // bytes for packed matrix (ignoring any extra copies)
+  double bytesBefore = static_cast< double >(numberElements) * (sizeof(double) + sizeof(int))
+    + static_cast< double >(numberColumns_) * (sizeof(CoinBigIndex) + sizeof(int));
+  char line[100];
+  ClpMatrixBase *newMatrix = NULL;
+  if (found == 2) {
+    ClpNetworkMatrix *networkMatrix = new ClpNetworkMatrix(*matrix);
+    // can not trust number of rows from largest index
+    networkMatrix->setDimensions(numberRows_, numberColumns_);
+    newMatrix = networkMatrix;
+    double bytesAfter = 2.0 * numberColumns_ * sizeof(int);
+    sprintf(line, "network matrix saves %.0f KB", (bytesBefore - bytesAfter) / 1024.0);
+  } else if (found == 1 && (allowed & 1) != 0) {
+    ClpPlusMinusOneMatrix *plusMinusMatrix = new ClpPlusMinusOneMatrix(*matrix);
+    assert(plusMinusMatrix->getIndices());
+    plusMinusMatrix->setDimensions(numberRows_, numberColumns_);
+    newMatrix = plusMinusMatrix;
+    double bytesAfter = static_cast< double >(numberElements) * sizeof(int)
+      + static_cast< double >(numberColumns_) * 2.0 * sizeof(CoinBigIndex);
+    sprintf(line, "+- 1 matrix saves %.0f KB", (bytesBefore - bytesAfter) / 1024.0);
+  } else if (found) {
+    sprintf(line, "could be %s matrix but not converted",
+      found == 2 ? "network" : "+- 1");
+    found = -found;
+  } else {
+    sprintf(line, "kept as packed matrix");
+  }
+  handler_->message(CLP_MATRIX_STRUCTURE, messages_)
+    << static_cast< int >(numberPlus)
+    << static_cast< int >(numberMinus)
+    << static_cast< int >(numberOther)
+    << line << CoinMessageEol;
+  if (newMatrix)
+    replaceMatrix(newMatrix, true);
+  return found;
+#else
+  return 0;
+#endif
+}
 // Subproblem constructor
 ClpModel::ClpModel(const ClpModel *rhs,
   int numberRows, const int *whichRow,
@@ -3264,6 +3468,7 @@ ClpModel::ClpModel(const ClpModel *rhs,
   , maximumInternalRows_(-1)
   , savedRowScale_(NULL)
   , savedColumnScale_(NULL)
+  , importedScaling_(NULL)
 {
   defaultHandler_ = rhs->defaultHandler_;
   if (defaultHandler_)
@@ -3909,6 +4114,29 @@ void ClpModel::deleteNamesAsChar(const char *const *names, int number) const
 }
 #endif
 #endif
+// Returns current scale factors with fingerprint (or NULL)
+ClpScaleFactors *
+ClpModel::exportScaling() const
+{
+  if (!rowScale_ || !columnScale_ || !matrix_)
+    return NULL;
+  return new ClpScaleFactors(rowScale_, columnScale_, numberRows_,
+    matrix_->getPackedMatrix());
+}
+// Scale factors to be used if structure matches (copy kept)
+void ClpModel::importScaling(const ClpScaleFactors *factors)
+{
+  delete importedScaling_;
+  if (factors)
+    importedScaling_ = new ClpScaleFactors(*factors);
+  else
+    importedScaling_ = NULL;
+  // make sure scaling is redone (so treat as new matrix)
+  whatsChanged_ &= ~(2 + 4 + 8);
+  setClpScaledMatrix(NULL);
+  setRowScale(NULL);
+  setColumnScale(NULL);
+}
 // Pass in Event handler (cloned and deleted at end)
 void ClpModel::passInEventHandler(const ClpEventHandler *eventHandler)
 {
@@ -4486,6 +4714,106 @@ ClpDataSave::operator=(const ClpDataSave &rhs)
   }
   return *this;
 }
+//-------------------------------------------------------------------
+// Default Constructor
+//-------------------------------------------------------------------
+ClpScaleFactors::ClpScaleFactors()
+  : rowScale_(NULL)
+  , columnScale_(NULL)
+  , numberRows_(0)
+  , numberColumns_(0)
+  , numberElements_(0)
+  , fingerprint_(0)
+{
+}
+// Constructor from scales and matrix
+ClpScaleFactors::ClpScaleFactors(const double *rowScale, const double *columnScale,
+  int numberRows, const CoinPackedMatrix *matrix)
+{
+  numberRows_ = numberRows;
+  numberColumns_ = matrix->getNumCols();
+  rowScale_ = CoinCopyOfArray(rowScale, numberRows_);
+  columnScale_ = CoinCopyOfArray(columnScale, numberColumns_);
+  fingerprint_ = fingerprint(matrix, numberElements_);
+}
+
+//-------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------
+ClpScaleFactors::ClpScaleFactors(const ClpScaleFactors &rhs)
+  : numberRows_(rhs.numberRows_)
+  , numberColumns_(rhs.numberColumns_)
+  , numberElements_(rhs.numberElements_)
+  , fingerprint_(rhs.fingerprint_)
+{
+  rowScale_ = CoinCopyOfArray(rhs.rowScale_, numberRows_);
+  columnScale_ = CoinCopyOfArray(rhs.columnScale_, numberColumns_);
+}
+
+//-------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------
+ClpScaleFactors::~ClpScaleFactors()
+{
+  delete[] rowScale_;
+  delete[] columnScale_;
+}
+
+//----------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------
+ClpScaleFactors &
+ClpScaleFactors::operator=(const ClpScaleFactors &rhs)
+{
+  if (this != &rhs) {
+    delete[] rowScale_;
+    delete[] columnScale_;
+    numberRows_ = rhs.numberRows_;
+    numberColumns_ = rhs.numberColumns_;
+    numberElements_ = rhs.numberElements_;
+    fingerprint_ = rhs.fingerprint_;
+    rowScale_ = CoinCopyOfArray(rhs.rowScale_, numberRows_);
+    columnScale_ = CoinCopyOfArray(rhs.columnScale_, numberColumns_);
+  }
+  return *this;
+}
+// Hash of structure of column ordered matrix (FNV-1a style)
+unsigned int
+ClpScaleFactors::fingerprint(const CoinPackedMatrix *matrix,
+  CoinBigIndex &numberElements)
+{
+  assert(matrix->isColOrdered());
+  const int *row = matrix->getIndices();
+  const CoinBigIndex *columnStart = matrix->getVectorStarts();
+  const int *columnLength = matrix->getVectorLengths();
+  const double *element = matrix->getElements();
+  int numberColumns = matrix->getNumCols();
+  unsigned int hash = 2166136261u;
+  numberElements = 0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    int number = 0;
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      // scaling drops tiny elements so ignore them
+      if (fabs(element[j]) > 1.0e-20) {
+        hash = (hash ^ static_cast< unsigned int >(row[j])) * 16777619u;
+        number++;
+      }
+    }
+    hash = (hash ^ static_cast< unsigned int >(number)) * 16777619u;
+    numberElements += number;
+  }
+  return hash;
+}
+// Returns true if matrix (with numberRows) has same structure
+bool ClpScaleFactors::matches(int numberRows, const CoinPackedMatrix *matrix) const
+{
+  if (numberRows != numberRows_ || matrix->getNumCols() != numberColumns_)
+    return false;
+  CoinBigIndex numberElements;
+  unsigned int hash = fingerprint(matrix, numberElements);
+  return hash == fingerprint_ && numberElements == numberElements_;
+}
 // Create C++ lines to get to current state
 void ClpModel::generateCpp(FILE *fp)
 {
@@ -23,6 +23,7 @@
 #include "ClpParameters.hpp"
 #include "ClpObjective.hpp"
 class ClpEventHandler;
+class ClpScaleFactors;
 /** This is the base class for Linear and quadratic Models
     This knows nothing about the algorithm, but it seems to
     have a reasonable amount of information
@@ -111,6 +112,17 @@ public:
     const double *obj,
     const double *rowlb, const double *rowub,
     const double *rowObjective = NULL);
+  /** Just like loadProblem(const CoinPackedMatrix &...) except that
+         matrix and arrays are taken over rather than copied.  All must
+         have been allocated with new (or new []) and on return all
+         pointers are NULL.  A row ordered matrix has to be transposed
+         so is then deleted after copying.  If an array is NULL the
+         default is as in loadProblem.
+     */
+  void assignProblem(CoinPackedMatrix *&matrix,
+    double *&collb, double *&colub,
+    double *&obj,
+    double *&rowlb, double *&rowub);
   /** Load up quadratic objective.  This is stored as a CoinPackedMatrix */
   void loadQuadraticObjective(const int numberColumns,
     const CoinBigIndex *start,
@@ -120,7 +132,8 @@ public:
   void deleteQuadraticObjective();
   /// This just loads up a row objective
   void setRowObjective(const double *rowObjective);
-  /// Read an mps file from the given filename
+  /** Read an mps file from the given filename.  If numberThreads() > 1
+      a threaded reader (ClpMpsReader) is tried first. */
   int readMps(const char *filename,
     bool keepNames = false,
     bool ignoreErrors = false);
@@ -684,6 +697,20 @@ public:
   void setColumnScale(double *scale);
   /// get rid of scaling etc
   void cleanScalingEtc();
+  /** Returns current scale factors with a fingerprint of matrix
+      structure (caller owns result) or NULL if not scaled.  Scales
+      are those of model as solved, so use presolve off. */
+  ClpScaleFactors *exportScaling() const;
+  /** Scale factors to be used on next scaling if matrix has same
+      structure.  Instead of iterative scaling only one pass is done to
+      get final column scales.  A copy is kept (across loadProblem) -
+      NULL switches off. */
+  void importScaling(const ClpScaleFactors *factors);
+  /// Imported scale factors (or NULL)
+  inline const ClpScaleFactors *importedScaling() const
+  {
+    return importedScaling_;
+  }
   /// Scaling of objective
   inline double objectiveScale() const
   {
@@ -767,7 +794,9 @@ public:
   {
     return columnUpper_;
   }
-  /// Matrix (if not ClpPackedmatrix be careful about memory leak
+  /** Matrix (if not ClpPackedmatrix be careful about memory leak.
+      If model came from ClpSimplex::sharedClone use
+      ClpPackedMatrix::unshare before changing elements) */
   inline CoinPackedMatrix *matrix() const
   {
     if (matrix_ == NULL)
@@ -836,6 +865,16 @@ public:
   {
     replaceMatrix(new ClpPackedMatrix(newmatrix), deleteCurrent);
   }
+  /** Looks at structure of a column ordered ClpPackedMatrix and reports
+         what was found.  If allowed&2 and at most one +1 and one -1 in
+         each column (and nothing else) converts to ClpNetworkMatrix,
+         otherwise if allowed&1 and all elements +-1 converts to
+         ClpPlusMinusOneMatrix.  Neither keeps an element array.
+         Returns 0 nothing found, 1 converted to +- 1, 2 converted to network,
+         -1 or -2 if could have been converted but not allowed.
+         Called on load if specialOptions has 0x04000000 set.
+     */
+  int convertMatrixStructure(int allowed = 3);
   /// Objective value
   inline double objectiveValue() const
   {
@@ -922,7 +961,7 @@ public:
   {
     whatsChanged_ = value;
   }
-  /// Number of threads (not really being used)
+  /// Number of threads (used by some Cholesky, ClpPlusMinusOneMatrix pricing and readMps)
   inline int numberThreads() const
   {
     return numberThreads_;
@@ -1179,6 +1218,17 @@ public:
                 repository.  See COIN_CLP_VETTED comments.
          0x01000000 is Cbc (and in branch and bound)
          0x02000000 is in a different branch and bound
+         0x04000000 - on load (and after presolve in initialSolve) look at matrix
+                      and if possible convert to network or +- 1 matrix
+         0x08000000 - save memory - simplex keeps no row copy or extra scaled
+                      copy of matrix (pricing scales column copy on fly).
+                      Copies needed by other algorithms (e.g. barrier) are
+                      made by them when needed.  Use with assignProblem to
+                      keep just one copy of a very large matrix.
+         0x10000000 - implicit scaling - no scaled copy of matrix is kept.
+                      Simplex applies scale factors on fly and barrier uses
+                      powers of 2 so it can scale matrix in place and then
+                      undo that exactly.
      */
   inline unsigned int specialOptions() const
   {
@@ -1209,6 +1259,8 @@ protected:
     const double *obj,
     const double *rowlb, const double *rowub,
     const double *rowObjective = NULL);
+  /// Sets default solution and cleans infinite bounds
+  void gutsOfCleanBounds();
   /// Does much of scaling
   void gutsOfScaling();
   /// Objective value - always minimize
@@ -1389,6 +1441,8 @@ protected:
   double *savedRowScale_;
   /// Saved column scale factors
   double *savedColumnScale_;
+  /// Scale factors to use if structure matches
+  ClpScaleFactors *importedScaling_;
 #ifndef CLP_NO_STD
   /// Array of string parameters
   std::string strParam_[ClpLastStrParam];
@@ -1434,6 +1488,82 @@ public:
   unsigned int specialOptions_;
   //@}
 };
+/** Scale factors saved from one model so they can be used on another
+    with same matrix structure (e.g. same model with different rhs).
+
+    Fingerprint is a hash of row indices in each column (ignoring tiny
+    elements as scaling drops them) so element values may differ.
+ */
+class CLPLIB_EXPORT ClpScaleFactors {
+
+public:
+  /**@name Constructors and destructor
+      */
+  //@{
+  /// Default constructor
+  ClpScaleFactors();
+  /// Constructor from scales (numberRows and numberColumns long) and matrix
+  ClpScaleFactors(const double *rowScale, const double *columnScale,
+    int numberRows, const CoinPackedMatrix *matrix);
+  /// Copy constructor.
+  ClpScaleFactors(const ClpScaleFactors &);
+  /// Assignment operator. This copies the data
+  ClpScaleFactors &operator=(const ClpScaleFactors &rhs);
+  /// Destructor
+  ~ClpScaleFactors();
+  //@}
+
+  /**@name Fingerprint */
+  //@{
+  /** Hash of structure of column ordered matrix.  Number of elements
+      which are not tiny is also returned. */
+  static unsigned int fingerprint(const CoinPackedMatrix *matrix,
+    CoinBigIndex &numberElements);
+  /// Returns true if matrix (with numberRows) has same structure
+  bool matches(int numberRows, const CoinPackedMatrix *matrix) const;
+  //@}
+
+  /**@name Gets */
+  //@{
+  inline int numberRows() const
+  {
+    return numberRows_;
+  }
+  inline int numberColumns() const
+  {
+    return numberColumns_;
+  }
+  inline unsigned int fingerprint() const
+  {
+    return fingerprint_;
+  }
+  inline const double *rowScale() const
+  {
+    return rowScale_;
+  }
+  inline const double *columnScale() const
+  {
+    return columnScale_;
+  }
+  //@}
+
+private:
+  /**@name data */
+  //@{
+  /// Row scales
+  double *rowScale_;
+  /// Column scales
+  double *columnScale_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number of elements (not tiny)
+  CoinBigIndex numberElements_;
+  /// Hash of structure
+  unsigned int fingerprint_;
+  //@}
+};
 
 // Semi experimental options 
 #ifdef CLP_EXPERIMENT_JJF
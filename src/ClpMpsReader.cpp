@@ -0,0 +1,896 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "CoinFinite.hpp"
+#include "CoinError.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "ClpModel.hpp"
+#include "ClpMpsReader.hpp"
+#include "ClpThreadPool.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Default smallest number of bytes worth giving to a thread
+#define CLP_MPS_CHUNK 1048576
+
+// Name (or any token) in buffer - not zero terminated
+typedef struct {
+  const char *name;
+  int length;
+} clpMpsName;
+
+static inline bool isBlank(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+static inline bool sameName(const clpMpsName &a, const clpMpsName &b)
+{
+  return a.length == b.length && !memcmp(a.name, b.name, a.length);
+}
+static inline bool isToken(const clpMpsName &token, const char *word)
+{
+  int length = static_cast< int >(strlen(word));
+  return token.length == length && !memcmp(token.name, word, length);
+}
+/* Splits line into tokens.  Returns number of tokens (maximum+1 if
+   there are more than maximum) */
+static int tokenize(const char *start, const char *end,
+  clpMpsName *token, int maximum)
+{
+  int number = 0;
+  const char *put = start;
+  while (true) {
+    while (put < end && isBlank(*put))
+      put++;
+    if (put == end)
+      break;
+    if (number == maximum)
+      return maximum + 1;
+    token[number].name = put;
+    while (put < end && !isBlank(*put))
+      put++;
+    token[number].length = static_cast< int >(put - token[number].name);
+    number++;
+  }
+  return number;
+}
+/* Value of token (>=1.0e30 is infinite).  Returns false if token is not
+   all number.  Tokens are always followed by blank or newline so strtod
+   stops in buffer. */
+static inline bool tokenValue(const clpMpsName &token, double &value)
+{
+  char *end;
+  value = strtod(token.name, &end);
+  if (end != token.name + token.length)
+    return false;
+  if (value >= 1.0e30)
+    value = COIN_DBL_MAX;
+  else if (value <= -1.0e30)
+    value = -COIN_DBL_MAX;
+  return true;
+}
+// Hash of name (FNV-1a)
+static inline unsigned int hashName(const char *name, int length)
+{
+  unsigned int hash = 2166136261u;
+  for (int i = 0; i < length; i++)
+    hash = (hash ^ static_cast< unsigned char >(name[i])) * 16777619u;
+  return hash;
+}
+/* Open addressing hash table of names (which stay in buffer).
+   Once built it is only read so can be used by all threads. */
+class ClpMpsNameTable {
+public:
+  ClpMpsNameTable()
+    : names_(NULL)
+    , slot_(NULL)
+    , mask_(0)
+  {
+  }
+  ~ClpMpsNameTable()
+  {
+    delete[] slot_;
+  }
+  /// Builds table - returns index of first duplicate or -1
+  int build(const clpMpsName *names, int number)
+  {
+    names_ = names;
+    unsigned int size = 16;
+    while (size < 2 * static_cast< unsigned int >(number))
+      size *= 2;
+    mask_ = size - 1;
+    delete[] slot_;
+    slot_ = new int[size];
+    for (unsigned int i = 0; i < size; i++)
+      slot_[i] = -1;
+    for (int i = 0; i < number; i++) {
+      unsigned int k = hashName(names[i].name, names[i].length) & mask_;
+      while (slot_[k] >= 0) {
+        if (sameName(names[slot_[k]], names[i]))
+          return i;
+        k = (k + 1) & mask_;
+      }
+      slot_[k] = i;
+    }
+    return -1;
+  }
+  /// Finds name (-1 if not there)
+  inline int find(const clpMpsName &name) const
+  {
+    unsigned int k = hashName(name.name, name.length) & mask_;
+    while (slot_[k] >= 0) {
+      if (sameName(names_[slot_[k]], name))
+        return slot_[k];
+      k = (k + 1) & mask_;
+    }
+    return -1;
+  }
+
+private:
+  const clpMpsName *names_;
+  int *slot_;
+  unsigned int mask_;
+};
+/* Splits [start,end) into number chunks which start at lines.
+   chunk has number+1 entries */
+static void splitAtLines(const char *start, const char *end, int number,
+  std::vector< const char * > &chunk)
+{
+  size_t size = end - start;
+  chunk.resize(number + 1);
+  chunk[0] = start;
+  for (int i = 1; i < number; i++) {
+    const char *put = start + static_cast< size_t >((static_cast< double >(size) * i) / number);
+    if (put < chunk[i - 1])
+      put = chunk[i - 1];
+    const char *newline = static_cast< const char * >(memchr(put, '\n', end - put));
+    chunk[i] = newline ? newline + 1 : end;
+  }
+  chunk[number] = end;
+}
+// Number of chunks for number bytes
+static int numberChunks(size_t size, int numberThreads, int chunkSize)
+{
+  int number = 1;
+  if (numberThreads > 1) {
+    size_t most = size / CoinMax(chunkSize, 1);
+    number = 4 * numberThreads;
+    if (most < static_cast< size_t >(number))
+      number = CoinMax(1, static_cast< int >(most));
+  }
+  return number;
+}
+// Does work(i) for each chunk on threads
+static void forEachChunk(ClpThreadPool &pool, int number,
+  const std::function< void(int) > &work)
+{
+  pool.parallelFor(0, number, number,
+    [&](int, int first, int last) {
+      for (int i = first; i < last; i++)
+        work(i);
+    });
+}
+/* Calls line(start,end) for each data line in chunk (comments and
+   blank lines skipped).  Stops and returns false if line does. */
+template < class Line >
+static bool forEachLine(const char *start, const char *end, Line line)
+{
+  while (start < end) {
+    const char *next = static_cast< const char * >(memchr(start, '\n', end - start));
+    if (!next)
+      next = end;
+    if (*start != '*') {
+      const char *put = start;
+      while (put < next && isBlank(*put))
+        put++;
+      if (put < next && !line(start, next))
+        return false;
+    }
+    start = next + 1;
+  }
+  return true;
+}
+// Piece of COLUMNS section
+typedef struct {
+  std::vector< clpMpsName > name;
+  std::vector< CoinBigIndex > start;
+  std::vector< int > row;
+  std::vector< double > element;
+  std::vector< double > objective;
+  // 0 or 1, -1 if before first marker in chunk
+  std::vector< char > integer;
+  // marker state at end of chunk (-1 if no marker)
+  int marker;
+  bool error;
+} clpMpsColumns;
+// Piece of RHS or RANGES section
+typedef struct {
+  std::vector< int > row;
+  std::vector< double > value;
+  clpMpsName set;
+  bool error;
+} clpMpsRhs;
+// Piece of BOUNDS section
+typedef struct {
+  std::vector< char > type;
+  std::vector< int > column;
+  std::vector< double > value;
+  clpMpsName set;
+  bool error;
+} clpMpsBounds;
+// Sets set name or returns false if different
+static inline bool sameSet(clpMpsName &set, const clpMpsName &name)
+{
+  if (!set.name) {
+    set = name;
+    return true;
+  }
+  return sameName(set, name);
+}
+
+//#############################################################################
+// Constructors / Destructor
+//#############################################################################
+
+ClpMpsReader::ClpMpsReader()
+  : smallElement_(1.0e-14)
+  , objectiveOffset_(0.0)
+  , numberThreads_(0)
+  , chunkSize_(CLP_MPS_CHUNK)
+  , numberRows_(0)
+  , numberColumns_(0)
+  , numberElements_(0)
+  , start_(NULL)
+  , row_(NULL)
+  , element_(NULL)
+  , columnLower_(NULL)
+  , columnUpper_(NULL)
+  , objective_(NULL)
+  , rowLower_(NULL)
+  , rowUpper_(NULL)
+  , integerType_(NULL)
+{
+}
+
+ClpMpsReader::~ClpMpsReader()
+{
+  gutsOfDelete();
+}
+// Frees arrays
+void ClpMpsReader::gutsOfDelete()
+{
+  delete[] start_;
+  delete[] row_;
+  delete[] element_;
+  delete[] columnLower_;
+  delete[] columnUpper_;
+  delete[] objective_;
+  delete[] rowLower_;
+  delete[] rowUpper_;
+  delete[] integerType_;
+  start_ = NULL;
+  row_ = NULL;
+  element_ = NULL;
+  columnLower_ = NULL;
+  columnUpper_ = NULL;
+  objective_ = NULL;
+  rowLower_ = NULL;
+  rowUpper_ = NULL;
+  integerType_ = NULL;
+  numberRows_ = 0;
+  numberColumns_ = 0;
+  numberElements_ = 0;
+  objectiveOffset_ = 0.0;
+  problemName_ = "";
+  rowNames_.clear();
+  columnNames_.clear();
+}
+// Reads file
+int ClpMpsReader::readMps(const char *fileName, bool keepNames)
+{
+  gutsOfDelete();
+#ifndef _WIN32
+  {
+    // map file if it is plain
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+      return -1;
+    struct stat statBuf;
+    if (!fstat(fd, &statBuf) && S_ISREG(statBuf.st_mode) && statBuf.st_size > 3) {
+      size_t size = statBuf.st_size;
+      void *mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if (mapped == MAP_FAILED)
+        return -1;
+      const unsigned char *buffer = static_cast< const unsigned char * >(mapped);
+      bool compressed = (buffer[0] == 0x1f && buffer[1] == 0x8b)
+        || (buffer[0] == 'B' && buffer[1] == 'Z' && buffer[2] == 'h');
+      // need newline at end so parsing stays in buffer
+      if (!compressed && buffer[size - 1] == '\n') {
+        madvise(mapped, size, MADV_WILLNEED);
+        int returnCode = parse(static_cast< const char * >(mapped), size, keepNames);
+        munmap(mapped, size);
+        return returnCode;
+      }
+      munmap(mapped, size);
+    } else {
+      close(fd);
+    }
+  }
+#endif
+  /* decompress (or just read) in one pass.  Parsing needs one buffer so
+     whole uncompressed file is held (see class description for peak) */
+  char *buffer = NULL;
+  size_t size = 0;
+  try {
+    CoinFileInput *input = CoinFileInput::create(fileName);
+    size_t maximumSize = 0;
+    int blockSize = CLP_MPS_CHUNK;
+    while (true) {
+      if (size + blockSize + 1 > maximumSize) {
+        maximumSize = CoinMax(2 * maximumSize, size + blockSize + 1);
+        char *temp = static_cast< char * >(realloc(buffer, maximumSize));
+        if (!temp) {
+          free(buffer);
+          delete input;
+          return -1;
+        }
+        buffer = temp;
+      }
+      int number = input->read(buffer + size, blockSize);
+      if (number <= 0)
+        break;
+      size += number;
+    }
+    delete input;
+  } catch (CoinError e) {
+    free(buffer);
+    return -1;
+  }
+  if (!size) {
+    free(buffer);
+    return -1;
+  }
+  buffer[size++] = '\n';
+  int returnCode = parse(buffer, size, keepNames);
+  free(buffer);
+  return returnCode;
+}
+// Parses file in memory
+int ClpMpsReader::parse(const char *buffer, size_t size, bool keepNames)
+{
+  const char *end = buffer + size;
+  ClpThreadPool pool(numberThreads_ > 1 ? numberThreads_ - 1 : 0);
+  // find section headers (lines starting with non blank)
+  std::vector< const char * > chunk;
+  int nChunks = numberChunks(size, numberThreads_, chunkSize_);
+  splitAtLines(buffer, end, nChunks, chunk);
+  std::vector< std::vector< const char * > > chunkHeader(nChunks);
+  forEachChunk(pool, nChunks, [&](int iChunk) {
+    const char *start = chunk[iChunk];
+    const char *last = chunk[iChunk + 1];
+    while (start < last) {
+      if (!isBlank(*start) && *start != '*' && *start != '\n')
+        chunkHeader[iChunk].push_back(start);
+      const char *next = static_cast< const char * >(memchr(start, '\n', last - start));
+      if (!next)
+        break;
+      start = next + 1;
+    }
+  });
+  std::vector< const char * > header;
+  for (int iChunk = 0; iChunk < nChunks; iChunk++)
+    header.insert(header.end(), chunkHeader[iChunk].begin(), chunkHeader[iChunk].end());
+  chunkHeader.clear();
+  // sections - 0 ROWS, 1 COLUMNS, 2 RHS, 3 RANGES, 4 BOUNDS
+  const char *sectionStart[5] = { NULL, NULL, NULL, NULL, NULL };
+  const char *sectionEnd[5] = { NULL, NULL, NULL, NULL, NULL };
+  bool gotEnd = false;
+  int numberHeaders = static_cast< int >(header.size());
+  for (int iHeader = 0; iHeader < numberHeaders; iHeader++) {
+    const char *start = header[iHeader];
+    const char *next = static_cast< const char * >(memchr(start, '\n', end - start));
+    clpMpsName token[3];
+    int nTokens = tokenize(start, next, token, 2);
+    const char *contentEnd = (iHeader + 1 < numberHeaders) ? header[iHeader + 1] : end;
+    int iSection = -1;
+    if (isToken(token[0], "NAME")) {
+      if (iHeader || nTokens > 2)
+        return -2;
+      if (nTokens == 2)
+        problemName_ = std::string(token[1].name, token[1].length);
+    } else if (isToken(token[0], "ROWS")) {
+      iSection = 0;
+    } else if (isToken(token[0], "COLUMNS")) {
+      iSection = 1;
+    } else if (isToken(token[0], "RHS")) {
+      iSection = 2;
+    } else if (isToken(token[0], "RANGES")) {
+      iSection = 3;
+    } else if (isToken(token[0], "BOUNDS")) {
+      iSection = 4;
+    } else if (isToken(token[0], "ENDATA")) {
+      gotEnd = true;
+      break;
+    } else {
+      // OBJSENSE, quadratic, SOS etc
+      return -2;
+    }
+    if (iSection >= 0) {
+      if (nTokens != 1 || sectionStart[iSection])
+        return -2;
+      sectionStart[iSection] = next + 1;
+      sectionEnd[iSection] = contentEnd;
+    } else if (!forEachLine(next + 1, contentEnd,
+                 [](const char *, const char *) { return false; })) {
+      // data lines after NAME
+      return -2;
+    }
+  }
+  if (!gotEnd || !sectionStart[0] || !sectionStart[1])
+    return -2;
+  // ROWS
+  clpMpsName objectiveName = { NULL, -1 };
+  std::vector< clpMpsName > rowName;
+  std::vector< char > rowType;
+  {
+    splitAtLines(sectionStart[0], sectionEnd[0],
+      numberChunks(sectionEnd[0] - sectionStart[0], numberThreads_, chunkSize_), chunk);
+    int number = static_cast< int >(chunk.size()) - 1;
+    std::vector< std::vector< clpMpsName > > chunkName(number);
+    std::vector< std::vector< char > > chunkType(number);
+    std::vector< char > chunkError(number, 0);
+    forEachChunk(pool, number, [&](int iChunk) {
+      std::vector< clpMpsName > &name = chunkName[iChunk];
+      std::vector< char > &type = chunkType[iChunk];
+      bool okay = forEachLine(chunk[iChunk], chunk[iChunk + 1],
+        [&](const char *start, const char *next) {
+          clpMpsName token[3];
+          if (tokenize(start, next, token, 2) != 2 || token[0].length != 1)
+            return false;
+          char rowType = static_cast< char >(toupper(token[0].name[0]));
+          if (rowType != 'N' && rowType != 'E' && rowType != 'L' && rowType != 'G')
+            return false;
+          type.push_back(rowType);
+          name.push_back(token[1]);
+          return true;
+        });
+      chunkError[iChunk] = okay ? 0 : 1;
+    });
+    for (int iChunk = 0; iChunk < number; iChunk++) {
+      if (chunkError[iChunk])
+        return -2;
+      int n = static_cast< int >(chunkType[iChunk].size());
+      for (int i = 0; i < n; i++) {
+        if (chunkType[iChunk][i] == 'N') {
+          // only one free row is allowed (objective)
+          if (objectiveName.name)
+            return -2;
+          objectiveName = chunkName[iChunk][i];
+        } else {
+          rowName.push_back(chunkName[iChunk][i]);
+          rowType.push_back(chunkType[iChunk][i]);
+        }
+      }
+    }
+  }
+  numberRows_ = static_cast< int >(rowName.size());
+  ClpMpsNameTable rowTable;
+  if (rowTable.build(numberRows_ ? &rowName[0] : NULL, numberRows_) >= 0)
+    return -2;
+  if (objectiveName.name && rowTable.find(objectiveName) >= 0)
+    return -2;
+  // -2 for objective, -1 if not there
+  auto findRow = [&](const clpMpsName &name) {
+    if (objectiveName.name && sameName(name, objectiveName))
+      return -2;
+    return rowTable.find(name);
+  };
+  // COLUMNS
+  std::vector< clpMpsName > columnName;
+  {
+    splitAtLines(sectionStart[1], sectionEnd[1],
+      numberChunks(sectionEnd[1] - sectionStart[1], numberThreads_, chunkSize_), chunk);
+    int number = static_cast< int >(chunk.size()) - 1;
+    std::vector< clpMpsColumns > piece(number);
+    double smallElement = smallElement_;
+    forEachChunk(pool, number, [&](int iChunk) {
+      clpMpsColumns &columns = piece[iChunk];
+      int marker = -1;
+      columns.marker = -1;
+      bool okay = forEachLine(chunk[iChunk], chunk[iChunk + 1],
+        [&](const char *start, const char *next) {
+          clpMpsName token[6];
+          int nTokens = tokenize(start, next, token, 5);
+          if (nTokens == 3 && isToken(token[1], "'MARKER'")) {
+            if (isToken(token[2], "'INTORG'"))
+              marker = 1;
+            else if (isToken(token[2], "'INTEND'"))
+              marker = 0;
+            else
+              return false;
+            columns.marker = marker;
+            return true;
+          }
+          if (nTokens != 3 && nTokens != 5)
+            return false;
+          if (columns.name.empty() || !sameName(columns.name.back(), token[0])) {
+            columns.name.push_back(token[0]);
+            columns.start.push_back(static_cast< CoinBigIndex >(columns.row.size()));
+            columns.objective.push_back(0.0);
+            columns.integer.push_back(static_cast< char >(marker));
+          }
+          for (int i = 1; i < nTokens; i += 2) {
+            int iRow = findRow(token[i]);
+            double value;
+            if (iRow == -1 || !tokenValue(token[i + 1], value))
+              return false;
+            if (iRow == -2) {
+              columns.objective.back() = value;
+            } else if (fabs(value) >= smallElement) {
+              columns.row.push_back(iRow);
+              columns.element.push_back(value);
+            }
+          }
+          return true;
+        });
+      columns.error = !okay;
+    });
+    // see where each piece goes (first column may carry on from before)
+    std::vector< int > columnOffset(number + 1);
+    std::vector< CoinBigIndex > elementOffset(number + 1);
+    std::vector< char > carryOn(number, 0);
+    std::vector< char > markerAtStart(number, 0);
+    double totalElements = 0.0;
+    int nColumns = 0;
+    int marker = 0;
+    const clpMpsName *lastName = NULL;
+    for (int iChunk = 0; iChunk < number; iChunk++) {
+      clpMpsColumns &columns = piece[iChunk];
+      if (columns.error)
+        return -2;
+      int n = static_cast< int >(columns.name.size());
+      columnOffset[iChunk] = nColumns;
+      elementOffset[iChunk] = static_cast< CoinBigIndex >(totalElements);
+      markerAtStart[iChunk] = static_cast< char >(marker);
+      if (n) {
+        if (lastName && sameName(*lastName, columns.name[0]))
+          carryOn[iChunk] = 1;
+        nColumns += n - carryOn[iChunk];
+        lastName = &columns.name[n - 1];
+      }
+      if (columns.marker >= 0)
+        marker = columns.marker;
+      totalElements += static_cast< double >(columns.row.size());
+    }
+    if (totalElements > static_cast< double >(std::numeric_limits< CoinBigIndex >::max()))
+      return -2;
+    columnOffset[number] = nColumns;
+    numberColumns_ = nColumns;
+    numberElements_ = static_cast< CoinBigIndex >(totalElements);
+    start_ = new CoinBigIndex[numberColumns_ + 1];
+    row_ = new int[numberElements_];
+    element_ = new double[numberElements_];
+    objective_ = new double[numberColumns_];
+    integerType_ = new char[numberColumns_];
+    columnName.resize(numberColumns_);
+    // copy pieces into place
+    forEachChunk(pool, number, [&](int iChunk) {
+      clpMpsColumns &columns = piece[iChunk];
+      CoinBigIndex offset = elementOffset[iChunk];
+      CoinBigIndex n = static_cast< CoinBigIndex >(columns.row.size());
+      if (n) {
+        CoinMemcpyN(&columns.row[0], n, row_ + offset);
+        CoinMemcpyN(&columns.element[0], n, element_ + offset);
+      }
+      int nLocal = static_cast< int >(columns.name.size());
+      int put = columnOffset[iChunk];
+      for (int i = carryOn[iChunk]; i < nLocal; i++) {
+        start_[put] = offset + columns.start[i];
+        objective_[put] = columns.objective[i];
+        int integer = columns.integer[i];
+        integerType_[put] = static_cast< char >(integer >= 0 ? integer : markerAtStart[iChunk]);
+        columnName[put] = columns.name[i];
+        put++;
+      }
+      std::vector< CoinBigIndex >().swap(columns.start);
+      std::vector< int >().swap(columns.row);
+      std::vector< double >().swap(columns.element);
+    });
+    // objective entries of carried on columns
+    for (int iChunk = 0; iChunk < number; iChunk++) {
+      if (carryOn[iChunk] && piece[iChunk].objective[0])
+        objective_[columnOffset[iChunk] - 1] = piece[iChunk].objective[0];
+    }
+    start_[numberColumns_] = numberElements_;
+  }
+  ClpMpsNameTable columnTable;
+  if (columnTable.build(numberColumns_ ? &columnName[0] : NULL, numberColumns_) >= 0)
+    return -2;
+  // RHS and RANGES
+  std::vector< double > rhs(numberRows_, 0.0);
+  std::vector< double > range(numberRows_, 0.0);
+  std::vector< char > gotRange(numberRows_, 0);
+  for (int iSection = 2; iSection < 4; iSection++) {
+    if (!sectionStart[iSection])
+      continue;
+    splitAtLines(sectionStart[iSection], sectionEnd[iSection],
+      numberChunks(sectionEnd[iSection] - sectionStart[iSection], numberThreads_, chunkSize_), chunk);
+    int number = static_cast< int >(chunk.size()) - 1;
+    std::vector< clpMpsRhs > piece(number);
+    forEachChunk(pool, number, [&](int iChunk) {
+      clpMpsRhs &values = piece[iChunk];
+      values.set.name = NULL;
+      values.set.length = 0;
+      bool okay = forEachLine(chunk[iChunk], chunk[iChunk + 1],
+        [&](const char *start, const char *next) {
+          clpMpsName token[6];
+          int nTokens = tokenize(start, next, token, 5);
+          if (nTokens < 2 || nTokens > 5)
+            return false;
+          // odd number means set name is there
+          int first = nTokens & 1;
+          if (first && !sameSet(values.set, token[0]))
+            return false;
+          for (int i = first; i < nTokens; i += 2) {
+            int iRow = findRow(token[i]);
+            double value;
+            if (iRow == -1 || !tokenValue(token[i + 1], value))
+              return false;
+            values.row.push_back(iRow);
+            values.value.push_back(value);
+          }
+          return true;
+        });
+      values.error = !okay;
+    });
+    clpMpsName set = { NULL, 0 };
+    for (int iChunk = 0; iChunk < number; iChunk++) {
+      clpMpsRhs &values = piece[iChunk];
+      // only one set is allowed
+      if (values.error || (values.set.name && !sameSet(set, values.set)))
+        return -2;
+      int n = static_cast< int >(values.row.size());
+      for (int i = 0; i < n; i++) {
+        int iRow = values.row[i];
+        double value = values.value[i];
+        if (iSection == 2) {
+          if (iRow >= 0)
+            rhs[iRow] = value;
+          else
+            objectiveOffset_ = value;
+        } else {
+          if (iRow < 0)
+            return -2;
+          range[iRow] = value;
+          gotRange[iRow] = 1;
+        }
+      }
+    }
+  }
+  rowLower_ = new double[numberRows_];
+  rowUpper_ = new double[numberRows_];
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    double value = rhs[iRow];
+    double lower = -COIN_DBL_MAX;
+    double upper = COIN_DBL_MAX;
+    double rangeValue = fabs(range[iRow]);
+    switch (rowType[iRow]) {
+    case 'E':
+      lower = value;
+      upper = value;
+      if (gotRange[iRow]) {
+        if (range[iRow] > 0.0)
+          upper = value + rangeValue;
+        else
+          lower = value - rangeValue;
+      }
+      break;
+    case 'L':
+      upper = value;
+      if (gotRange[iRow])
+        lower = value - rangeValue;
+      break;
+    case 'G':
+      lower = value;
+      if (gotRange[iRow])
+        upper = value + rangeValue;
+      break;
+    }
+    rowLower_[iRow] = lower;
+    rowUpper_[iRow] = upper;
+  }
+  // BOUNDS
+  columnLower_ = new double[numberColumns_];
+  columnUpper_ = new double[numberColumns_];
+  CoinFillN(columnLower_, numberColumns_, 0.0);
+  CoinFillN(columnUpper_, numberColumns_, COIN_DBL_MAX);
+  if (sectionStart[4]) {
+    splitAtLines(sectionStart[4], sectionEnd[4],
+      numberChunks(sectionEnd[4] - sectionStart[4], numberThreads_, chunkSize_), chunk);
+    int number = static_cast< int >(chunk.size()) - 1;
+    std::vector< clpMpsBounds > piece(number);
+    forEachChunk(pool, number, [&](int iChunk) {
+      clpMpsBounds &bounds = piece[iChunk];
+      bounds.set.name = NULL;
+      bounds.set.length = 0;
+      bool okay = forEachLine(chunk[iChunk], chunk[iChunk + 1],
+        [&](const char *start, const char *next) {
+          clpMpsName token[5];
+          int nTokens = tokenize(start, next, token, 4);
+          if (nTokens < 2 || nTokens > 4 || token[0].length != 2)
+            return false;
+          char type;
+          bool needValue = true;
+          bool mayHaveValue = false;
+          if (isToken(token[0], "UP"))
+            type = 'U';
+          else if (isToken(token[0], "LO"))
+            type = 'L';
+          else if (isToken(token[0], "FX"))
+            type = 'X';
+          else if (isToken(token[0], "LI"))
+            type = 'l';
+          else if (isToken(token[0], "UI"))
+            type = 'u';
+          else {
+            needValue = false;
+            if (isToken(token[0], "FR"))
+              type = 'F';
+            else if (isToken(token[0], "MI"))
+              type = 'M';
+            else if (isToken(token[0], "PL"))
+              type = 'P';
+            else if (isToken(token[0], "BV"))
+              type = 'B';
+            else
+              return false; // SC etc
+            mayHaveValue = (type == 'B');
+          }
+          // work out if set name is there
+          int iColumn = 1;
+          bool gotValue = needValue;
+          if (needValue) {
+            if (nTokens == 4)
+              iColumn = 2;
+            else if (nTokens != 3)
+              return false;
+          } else if (nTokens == 3) {
+            // BV col value or set col
+            double value;
+            if (mayHaveValue && tokenValue(token[2], value)
+              && columnTable.find(token[1]) >= 0) {
+              gotValue = true;
+            } else {
+              iColumn = 2;
+            }
+          } else if (nTokens == 4) {
+            if (!mayHaveValue)
+              return false;
+            iColumn = 2;
+            gotValue = true;
+          }
+          if (iColumn == 2 && !sameSet(bounds.set, token[1]))
+            return false;
+          int jColumn = columnTable.find(token[iColumn]);
+          double value = 0.0;
+          if (jColumn < 0 || (gotValue && !tokenValue(token[iColumn + 1], value)))
+            return false;
+          bounds.type.push_back(type);
+          bounds.column.push_back(jColumn);
+          bounds.value.push_back(value);
+          return true;
+        });
+      bounds.error = !okay;
+    });
+    clpMpsName set = { NULL, 0 };
+    for (int iChunk = 0; iChunk < number; iChunk++) {
+      clpMpsBounds &bounds = piece[iChunk];
+      if (bounds.error || (bounds.set.name && !sameSet(set, bounds.set)))
+        return -2;
+      int n = static_cast< int >(bounds.type.size());
+      for (int i = 0; i < n; i++) {
+        int iColumn = bounds.column[i];
+        double value = bounds.value[i];
+        switch (bounds.type[i]) {
+        case 'u':
+          integerType_[iColumn] = 1;
+          // fall through
+        case 'U':
+          // negative upper bound with zero lower means lower is -infinity
+          if (value < 0.0 && columnLower_[iColumn] == 0.0)
+            columnLower_[iColumn] = -COIN_DBL_MAX;
+          columnUpper_[iColumn] = value;
+          break;
+        case 'l':
+          integerType_[iColumn] = 1;
+          // fall through
+        case 'L':
+          columnLower_[iColumn] = value;
+          break;
+        case 'X':
+          columnLower_[iColumn] = value;
+          columnUpper_[iColumn] = value;
+          break;
+        case 'F':
+          columnLower_[iColumn] = -COIN_DBL_MAX;
+          columnUpper_[iColumn] = COIN_DBL_MAX;
+          break;
+        case 'M':
+          columnLower_[iColumn] = -COIN_DBL_MAX;
+          break;
+        case 'P':
+          columnUpper_[iColumn] = COIN_DBL_MAX;
+          break;
+        case 'B':
+          integerType_[iColumn] = 1;
+          columnLower_[iColumn] = 0.0;
+          columnUpper_[iColumn] = 1.0;
+          break;
+        }
+      }
+    }
+  }
+  // only keep integer information if there are integers
+  int iColumn;
+  for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    if (integerType_[iColumn])
+      break;
+  }
+  if (iColumn == numberColumns_) {
+    delete[] integerType_;
+    integerType_ = NULL;
+  }
+  if (keepNames) {
+    rowNames_.resize(numberRows_);
+    columnNames_.resize(numberColumns_);
+    int number = numberChunks(size, numberThreads_, chunkSize_);
+    forEachChunk(pool, number, [&](int iChunk) {
+      int first = static_cast< int >((static_cast< double >(numberRows_) * iChunk) / number);
+      int last = static_cast< int >((static_cast< double >(numberRows_) * (iChunk + 1)) / number);
+      for (int i = first; i < last; i++)
+        rowNames_[i].assign(rowName[i].name, rowName[i].length);
+      first = static_cast< int >((static_cast< double >(numberColumns_) * iChunk) / number);
+      last = static_cast< int >((static_cast< double >(numberColumns_) * (iChunk + 1)) / number);
+      for (int i = first; i < last; i++)
+        columnNames_[i].assign(columnName[i].name, columnName[i].length);
+    });
+  }
+  return 0;
+}
+// Hands over problem to model
+void ClpMpsReader::loadIntoModel(ClpModel &model)
+{
+  CoinPackedMatrix *matrix = new CoinPackedMatrix();
+  matrix->setExtraGap(0.0);
+  matrix->setExtraMajor(0.0);
+  int *length = NULL;
+  matrix->assignMatrix(true, numberRows_, numberColumns_, numberElements_,
+    element_, row_, start_, length);
+  model.assignProblem(matrix, columnLower_, columnUpper_, objective_,
+    rowLower_, rowUpper_);
+  if (integerType_)
+    model.copyInIntegerInformation(integerType_);
+  delete[] integerType_;
+  integerType_ = NULL;
+  model.setDblParam(ClpObjOffset, objectiveOffset_);
+#ifndef CLP_NO_STD
+  model.setStrParam(ClpProbName, problemName_);
+#endif
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
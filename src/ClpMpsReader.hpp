@@ -0,0 +1,182 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpMpsReader_H
+#define ClpMpsReader_H
+
+#include "CoinPragma.hpp"
+#include "ClpConfig.h"
+#include "CoinTypes.h"
+
+#include <string>
+#include <vector>
+
+class ClpModel;
+
+/** Reads MPS files using threads.
+
+    Whole file is mapped into memory (or decompressed into memory in one
+    pass if gzipped or bzipped), split into chunks at line boundaries and
+    chunks of each section are parsed at same time.  Each chunk of the
+    COLUMNS section gives a piece of the column ordered matrix and these
+    are copied into place, so no row ordered or triple form is made.
+
+    Parsing needs the whole file as one buffer.  Plain files are mapped
+    so cost no extra memory, but a gzipped or bzipped file is NOT
+    streamed - it is fully decompressed into one malloced buffer (which
+    grows by doubling) before any parsing.  So while reading a compressed
+    file up to three times its uncompressed size may be allocated for a
+    moment (old and new buffer during a realloc) and twice its size is
+    held until parsing ends.  This is not suitable for very large
+    compressed files - uncompress them first (so they are mapped) or use
+    CoinMpsIO, which streams.
+
+    Only the usual subset of MPS is handled - NAME, ROWS (one N row),
+    COLUMNS (with integer markers), one RHS, RANGES and BOUNDS set and
+    names without spaces.  For anything else (or any error) readMps
+    returns -2 so caller can fall back to CoinMpsIO which will also
+    report errors properly.
+*/
+class CLPLIB_EXPORT ClpMpsReader {
+
+public:
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  ClpMpsReader();
+  /// Destructor
+  ~ClpMpsReader();
+  //@}
+
+  /**@name Reading */
+  //@{
+  /** Reads file.  Returns 0 if okay, -1 if file could not be read and
+      -2 if file has something not handled here.  A compressed file is
+      fully decompressed into memory first (not streamed) so is not
+      suitable for very large files - see class description. */
+  int readMps(const char *fileName, bool keepNames = false);
+  /** Hands over problem to model (arrays are not copied).  Names are
+      left here (see rowNames()). */
+  void loadIntoModel(ClpModel &model);
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Number of threads to use (0 or 1 means none)
+  inline int numberThreads() const
+  {
+    return numberThreads_;
+  }
+  inline void setNumberThreads(int value)
+  {
+    numberThreads_ = value;
+  }
+  /** Smallest number of bytes in a chunk given to a thread (default
+      1048576).  Sections smaller than this are not split. */
+  inline int chunkSize() const
+  {
+    return chunkSize_;
+  }
+  inline void setChunkSize(int value)
+  {
+    chunkSize_ = value;
+  }
+  /// Elements smaller than this are dropped (default 1.0e-14)
+  inline double smallElementValue() const
+  {
+    return smallElement_;
+  }
+  inline void setSmallElementValue(double value)
+  {
+    smallElement_ = value;
+  }
+  inline int numberRows() const
+  {
+    return numberRows_;
+  }
+  inline int numberColumns() const
+  {
+    return numberColumns_;
+  }
+  inline CoinBigIndex numberElements() const
+  {
+    return numberElements_;
+  }
+  /// Problem name
+  inline const std::string &problemName() const
+  {
+    return problemName_;
+  }
+  /// Objective offset (rhs on objective row)
+  inline double objectiveOffset() const
+  {
+    return objectiveOffset_;
+  }
+  /// Row names (if kept) - can be swapped out
+  inline std::vector< std::string > &rowNames()
+  {
+    return rowNames_;
+  }
+  /// Column names (if kept) - can be swapped out
+  inline std::vector< std::string > &columnNames()
+  {
+    return columnNames_;
+  }
+  //@}
+
+private:
+  /// Not copyable
+  ClpMpsReader(const ClpMpsReader &);
+  ClpMpsReader &operator=(const ClpMpsReader &);
+  /// Parses file in memory (buffer must end with newline)
+  int parse(const char *buffer, size_t size, bool keepNames);
+  /// Frees arrays
+  void gutsOfDelete();
+
+  /**@name Data */
+  //@{
+  /// Smallest element kept
+  double smallElement_;
+  /// Objective offset
+  double objectiveOffset_;
+  /// Number of threads
+  int numberThreads_;
+  /// Smallest chunk in bytes
+  int chunkSize_;
+  /// Number of rows
+  int numberRows_;
+  /// Number of columns
+  int numberColumns_;
+  /// Number of elements
+  CoinBigIndex numberElements_;
+  /// Column starts
+  CoinBigIndex *start_;
+  /// Row indices
+  int *row_;
+  /// Elements
+  double *element_;
+  /// Column lower bounds
+  double *columnLower_;
+  /// Column upper bounds
+  double *columnUpper_;
+  /// Objective
+  double *objective_;
+  /// Row lower bounds
+  double *rowLower_;
+  /// Row upper bounds
+  double *rowUpper_;
+  /// Integer information (or NULL)
+  char *integerType_;
+  /// Problem name
+  std::string problemName_;
+  /// Row names
+  std::vector< std::string > rowNames_;
+  /// Column names
+  std::vector< std::string > columnNames_;
+  //@}
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -3,6 +3,7 @@
 // This code is licensed under the terms of the Eclipse Public License (EPL).
 
 #include <cstdio>
+#include <atomic>
 
 #include "CoinPragma.hpp"
 #include "CoinIndexedVector.hpp"
@@ -22,6 +23,7 @@
 // at end to get min/max!
 #include "ClpPackedMatrix.hpp"
 #include "ClpMessage.hpp"
+#include "ClpThreadPool.hpp"
 #ifdef INTEL_MKL
 #include "mkl_spblas.h"
 #endif
@@ -29,6 +31,15 @@
 #include "omp.h"
 #endif
 //#define DO_CHECK_FLAGS 1
+/// Count of ClpPackedMatrix objects using one CoinPackedMatrix
+class ClpPackedMatrixShare {
+public:
+  explicit ClpPackedMatrixShare(int number)
+    : count(number)
+  {
+  }
+  std::atomic< int > count;
+};
 //=============================================================================
 #ifdef COIN_PREFETCH
 #if 1
@@ -79,6 +90,7 @@ ClpPackedMatrix::ClpPackedMatrix()
   , flags_(2)
   , rowCopy_(NULL)
   , columnCopy_(NULL)
+  , share_(NULL)
 {
   setType(1);
 }
@@ -88,6 +100,7 @@ ClpPackedMatrix::ClpPackedMatrix()
 //-------------------------------------------------------------------
 ClpPackedMatrix::ClpPackedMatrix(const ClpPackedMatrix &rhs)
   : ClpMatrixBase(rhs)
+  , share_(NULL)
 {
 #ifdef DO_CHECK_FLAGS
   rhs.checkFlags(0);
@@ -131,6 +144,7 @@ ClpPackedMatrix::ClpPackedMatrix(const ClpPackedMatrix &rhs)
 //-------------------------------------------------------------------
 ClpPackedMatrix::ClpPackedMatrix(CoinPackedMatrix *rhs)
   : ClpMatrixBase()
+  , share_(NULL)
 {
   matrix_ = rhs;
   flags_ = ((matrix_->hasGaps()) ? 0x02 : 0);
@@ -145,6 +159,7 @@ ClpPackedMatrix::ClpPackedMatrix(CoinPackedMatrix *rhs)
 
 ClpPackedMatrix::ClpPackedMatrix(const CoinPackedMatrix &rhs)
   : ClpMatrixBase()
+  , share_(NULL)
 {
 #ifndef COIN_SPARSE_MATRIX
   matrix_ = new CoinPackedMatrix(rhs, -1, 0);
@@ -167,7 +182,7 @@ ClpPackedMatrix::ClpPackedMatrix(const CoinPackedMatrix &rhs)
 //-------------------------------------------------------------------
 ClpPackedMatrix::~ClpPackedMatrix()
 {
-  delete matrix_;
+  releaseMatrix();
   delete rowCopy_;
   delete columnCopy_;
 }
@@ -180,7 +195,7 @@ ClpPackedMatrix::operator=(const ClpPackedMatrix &rhs)
 {
   if (this != &rhs) {
     ClpMatrixBase::operator=(rhs);
-    delete matrix_;
+    releaseMatrix();
 #ifndef COIN_SPARSE_MATRIX
     matrix_ = new CoinPackedMatrix(*(rhs.matrix_), -1, 0);
     flags_ = rhs.flags_ & (~0x02);
@@ -218,13 +233,86 @@ ClpMatrixBase *ClpPackedMatrix::clone() const
 {
   return new ClpPackedMatrix(*this);
 }
+// Clone sharing CoinPackedMatrix
+ClpPackedMatrix *
+ClpPackedMatrix::sharedClone() const
+{
+  ClpPackedMatrix *copy = new ClpPackedMatrix();
+  copy->ClpMatrixBase::operator=(*this);
+  if (share_)
+    share_->count++;
+  else
+    share_ = new ClpPackedMatrixShare(2);
+  copy->share_ = share_;
+  copy->matrix_ = matrix_;
+  copy->numberActiveColumns_ = numberActiveColumns_;
+  // special copies will be made again if wanted
+  copy->flags_ = flags_ & (~(4 + 8));
+  return copy;
+}
+// Number of ClpPackedMatrix objects using this CoinPackedMatrix
+int ClpPackedMatrix::shareCount() const
+{
+  return share_ ? share_->count.load() : 1;
+}
+// Takes own copy of CoinPackedMatrix if it is shared
+void ClpPackedMatrix::unshare()
+{
+  if (share_) {
+    if (share_->count > 1) {
+      // copy before giving up reference so no one else can change it
+      CoinPackedMatrix *copy = new CoinPackedMatrix(*matrix_);
+      if (--share_->count) {
+        matrix_ = copy;
+      } else {
+        // others have gone in meantime
+        delete copy;
+        delete share_;
+      }
+    } else {
+      delete share_;
+    }
+    share_ = NULL;
+  }
+}
+// Gives up CoinPackedMatrix without deleting or copying it
+void ClpPackedMatrix::setMatrixNull()
+{
+  if (share_) {
+    // caller will only own matrix if it called unshare()
+    if (!--share_->count)
+      delete share_;
+    share_ = NULL;
+  }
+  matrix_ = NULL;
+}
+// Gives up CoinPackedMatrix (deleting it if not shared)
+void ClpPackedMatrix::releaseMatrix()
+{
+  if (share_) {
+    if (!--share_->count) {
+      delete matrix_;
+      delete share_;
+    }
+    share_ = NULL;
+  } else {
+    delete matrix_;
+  }
+  matrix_ = NULL;
+}
 // Copy contents - resizing if necessary - otherwise re-use memory
 void ClpPackedMatrix::copy(const ClpPackedMatrix *rhs)
 {
   //*this = *rhs;
   assert(numberActiveColumns_ == rhs->numberActiveColumns_);
   assert(matrix_->isColOrdered() == rhs->matrix_->isColOrdered());
-  matrix_->copyReuseArrays(*rhs->matrix_);
+  if (!share_) {
+    matrix_->copyReuseArrays(*rhs->matrix_);
+  } else {
+    // arrays are not ours to re-use
+    releaseMatrix();
+    matrix_ = new CoinPackedMatrix(*rhs->matrix_);
+  }
 #ifdef DO_CHECK_FLAGS
   checkFlags(0);
 #endif
@@ -246,6 +334,7 @@ ClpPackedMatrix::ClpPackedMatrix(
   int numberRows, const int *whichRows,
   int numberColumns, const int *whichColumns)
   : ClpMatrixBase(rhs)
+  , share_(NULL)
 {
   matrix_ = new CoinPackedMatrix(*(rhs.matrix_), numberRows, whichRows,
     numberColumns, whichColumns);
@@ -262,6 +351,7 @@ ClpPackedMatrix::ClpPackedMatrix(
   int numberRows, const int *whichRows,
   int numberColumns, const int *whichColumns)
   : ClpMatrixBase()
+  , share_(NULL)
 {
   matrix_ = new CoinPackedMatrix(rhs, numberRows, whichRows,
     numberColumns, whichColumns);
@@ -4127,6 +4217,30 @@ static void doSqrts(double *array, int n)
     array[i] = 1.0 / sqrt(array[i]);
 }
 #endif
+// Smallest number of rows or columns in a block when scaling on threads
+#define CLP_SCALE_BLOCK 20000
+/* Number of blocks to split number rows or columns into for scaling.
+   Passes only combine blocks by max, min or integer sums so scales are
+   the same whatever the number of blocks. */
+static int scaleBlocks(const ClpModel *model, int number)
+{
+  int numberBlocks = 1;
+  if (model->numberThreads() > 1 && number >= 2 * CLP_SCALE_BLOCK) {
+    numberBlocks = CoinMin(model->numberThreads(),
+      ClpPricingThreadPool()->numberThreads() + 1);
+    numberBlocks = CoinMin(numberBlocks, number / CLP_SCALE_BLOCK);
+  }
+  return numberBlocks;
+}
+// Does work(iBlock,first,last) over blocks of 0 to number-1
+static void scaleLoop(int number, int numberBlocks,
+  const ClpThreadPool::BlockFunction &work)
+{
+  if (numberBlocks > 1)
+    ClpPricingThreadPool()->parallelFor(0, number, numberBlocks, work);
+  else if (number)
+    work(0, 0, number);
+}
 //static int scale_stats[5]={0,0,0,0,0};
 // Creates scales for column copy (rowCopy in model may be modified)
 int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
@@ -4199,59 +4313,101 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
   //  scale_stats[model->scalingFlag()]++;
   double largest = 0.0;
   double smallest = 1.0e50;
+  if (share_) {
+    // tiny elements are deleted in place so need own copy if any
+    const CoinBigIndex *columnStart = matrix_->getVectorStarts();
+    const int *columnLength = matrix_->getVectorLengths();
+    const double *element = matrix_->getElements();
+    for (iColumn = 0; iColumn < numberColumns; iColumn++) {
+      CoinBigIndex j;
+      CoinBigIndex end = columnStart[iColumn] + columnLength[iColumn];
+      for (j = columnStart[iColumn]; j < end; j++) {
+        if (fabs(element[j]) <= 1.0e-20)
+          break;
+      }
+      if (j < end) {
+        const_cast< ClpPackedMatrix * >(this)->unshare();
+        break;
+      }
+    }
+  }
   // get matrix data pointers
   int *COIN_RESTRICT row = matrix_->getMutableIndices();
   const CoinBigIndex *COIN_RESTRICT columnStart = matrix_->getVectorStarts();
   int *COIN_RESTRICT columnLength = matrix_->getMutableVectorLengths();
   double *COIN_RESTRICT elementByColumn = matrix_->getMutableElements();
   CoinBigIndex deletedElements = 0;
-  for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-    CoinBigIndex j;
-    char useful = 0;
-    bool deleteSome = false;
-    CoinBigIndex start = columnStart[iColumn];
-    CoinBigIndex end = start + columnLength[iColumn];
+  // passes are done on blocks of rows or columns (on threads if wanted)
+  int numberRowBlocks = scaleBlocks(model, numberRows);
+  int numberColumnBlocks = scaleBlocks(model, numberColumns);
+  int maximumBlocks = CoinMax(numberRowBlocks, numberColumnBlocks);
+  double *COIN_RESTRICT blockLargest = new double[2 * maximumBlocks];
+  double *COIN_RESTRICT blockSmallest = blockLargest + maximumBlocks;
+  CoinBigIndex *COIN_RESTRICT blockDeleted = new CoinBigIndex[maximumBlocks];
+  CoinFillN(blockLargest, maximumBlocks, 0.0);
+  CoinFillN(blockSmallest, maximumBlocks, 1.0e50);
+  CoinZeroN(blockDeleted, maximumBlocks);
+  scaleLoop(numberColumns, numberColumnBlocks,
+    [&](int iBlock, int first, int last) {
+      double largest = 0.0;
+      double smallest = 1.0e50;
+      CoinBigIndex deletedElements = 0;
+      for (int iColumn = first; iColumn < last; iColumn++) {
+        CoinBigIndex j;
+        char useful = 0;
+        bool deleteSome = false;
+        CoinBigIndex start = columnStart[iColumn];
+        CoinBigIndex end = start + columnLength[iColumn];
 #ifndef LEAVE_FIXED
-    if (columnUpper[iColumn] > columnLower[iColumn] + 1.0e-12 || (simplex && simplex->getColumnStatus(iColumn) == ClpSimplex::basic)) {
+        if (columnUpper[iColumn] > columnLower[iColumn] + 1.0e-12 || (simplex && simplex->getColumnStatus(iColumn) == ClpSimplex::basic)) {
 #endif
-      for (j = start; j < end; j++) {
-        iRow = row[j];
-        double value = fabs(elementByColumn[j]);
-        if (value > 1.0e-20) {
-          useful = 1;
-          largest = CoinMax(largest, fabs(elementByColumn[j]));
-          smallest = CoinMin(smallest, fabs(elementByColumn[j]));
-        } else {
-          // small
-          deleteSome = true;
-        }
-      }
+          for (j = start; j < end; j++) {
+            double value = fabs(elementByColumn[j]);
+            if (value > 1.0e-20) {
+              useful = 1;
+              largest = CoinMax(largest, value);
+              smallest = CoinMin(smallest, value);
+            } else {
+              // small
+              deleteSome = true;
+            }
+          }
 #ifndef LEAVE_FIXED
-    } else {
-      // just check values
-      for (j = start; j < end; j++) {
-        double value = fabs(elementByColumn[j]);
-        if (value <= 1.0e-20) {
-          // small
-          deleteSome = true;
+        } else {
+          // just check values
+          for (j = start; j < end; j++) {
+            double value = fabs(elementByColumn[j]);
+            if (value <= 1.0e-20) {
+              // small
+              deleteSome = true;
+            }
+          }
         }
-      }
-    }
 #endif
-    usefulColumn[iColumn] = useful;
-    if (deleteSome) {
-      CoinBigIndex put = start;
-      for (j = start; j < end; j++) {
-        double value = elementByColumn[j];
-        if (fabs(value) > 1.0e-20) {
-          row[put] = row[j];
-          elementByColumn[put++] = value;
+        usefulColumn[iColumn] = useful;
+        if (deleteSome) {
+          CoinBigIndex put = start;
+          for (j = start; j < end; j++) {
+            double value = elementByColumn[j];
+            if (fabs(value) > 1.0e-20) {
+              row[put] = row[j];
+              elementByColumn[put++] = value;
+            }
+          }
+          deletedElements += end - put;
+          columnLength[iColumn] = static_cast< int >(put - start);
         }
       }
-      deletedElements += end - put;
-      columnLength[iColumn] = static_cast< int >(put - start);
-    }
+      blockLargest[iBlock] = largest;
+      blockSmallest[iBlock] = smallest;
+      blockDeleted[iBlock] = deletedElements;
+    });
+  for (int iBlock = 0; iBlock < numberColumnBlocks; iBlock++) {
+    largest = CoinMax(largest, blockLargest[iBlock]);
+    smallest = CoinMin(smallest, blockSmallest[iBlock]);
+    deletedElements += blockDeleted[iBlock];
   }
+  delete[] blockDeleted;
   // don't scale integers if option set
   if ((model->specialOptions() & 4194304) != 0 && model->integerInformation()) {
     const char *COIN_RESTRICT integer = model->integerInformation();
@@ -4284,6 +4440,7 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
       model->setColumnScale(NULL);
     }
     delete[] usefulColumn;
+    delete[] blockLargest;
     return 1;
   } else {
 #ifdef CLP_INVESTIGATE
@@ -4341,33 +4498,51 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
 	      assert(usefulColumn[iColumn]==0);
 	  }
 #endif
+    // scales from a model with same structure can be used as they are
+    const ClpScaleFactors *imported = model->importedScaling();
+    if (imported && !imported->matches(numberRows, matrix_))
+      imported = NULL;
     while (!finished) {
       int numberPass = 3;
       overallLargest = -1.0e-20;
       overallSmallest = 1.0e20;
       ClpFillN(rowScale, numberRows, 1.0);
       ClpFillN(columnScale, numberColumns, 1.0);
-      if (scalingMethod == 1 || scalingMethod == 3) {
+      if (imported) {
+        // just row scales - final pass gets column scales
+        CoinMemcpyN(imported->rowScale(), numberRows, rowScale);
+      } else if (scalingMethod == 1 || scalingMethod == 3) {
         // Maximum in each row
-        for (iRow = 0; iRow < numberRows; iRow++) {
-          CoinBigIndex j;
-          largest = 1.0e-10;
-          for (j = rowStart[iRow]; j < rowStart[iRow + 1]; j++) {
-            int iColumn = column[j];
-            if (usefulColumn[iColumn]) {
-              double value = fabs(element[j]);
-              largest = CoinMax(largest, value);
-              assert(largest < 1.0e40);
-            }
-          }
-          rowScale[iRow] = 1.0 / largest;
+        CoinFillN(blockLargest, numberRowBlocks, overallLargest);
+        CoinFillN(blockSmallest, numberRowBlocks, overallSmallest);
+        scaleLoop(numberRows, numberRowBlocks,
+          [&](int iBlock, int first, int last) {
+            for (int iRow = first; iRow < last; iRow++) {
+              CoinBigIndex j;
+              double largest = 1.0e-10;
+              for (j = rowStart[iRow]; j < rowStart[iRow + 1]; j++) {
+                int iColumn = column[j];
+                if (usefulColumn[iColumn]) {
+                  double value = fabs(element[j]);
+                  largest = CoinMax(largest, value);
+                  assert(largest < 1.0e40);
+                }
+              }
+              rowScale[iRow] = 1.0 / largest;
 #ifdef COIN_DEVELOP
-          if (extraDetails) {
-            overallLargest = CoinMax(overallLargest, largest);
-            overallSmallest = CoinMin(overallSmallest, largest);
-          }
+              if (extraDetails) {
+                blockLargest[iBlock] = CoinMax(blockLargest[iBlock], largest);
+                blockSmallest[iBlock] = CoinMin(blockSmallest[iBlock], largest);
+              }
 #endif
+            }
+          });
+#ifdef COIN_DEVELOP
+        for (int iBlock = 0; iBlock < numberRowBlocks; iBlock++) {
+          overallLargest = CoinMax(overallLargest, blockLargest[iBlock]);
+          overallSmallest = CoinMin(overallSmallest, blockSmallest[iBlock]);
         }
+#endif
       } else {
 #ifdef USE_OBJECTIVE
         // This will be used to help get scale factors
@@ -4380,30 +4555,39 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
           overallSmallest = 1.0e50;
           numberPass--;
           // Geometric mean on row scales
-          for (iRow = 0; iRow < numberRows; iRow++) {
-            CoinBigIndex j;
-            largest = 1.0e-50;
-            smallest = 1.0e50;
-            for (j = rowStart[iRow]; j < rowStart[iRow + 1]; j++) {
-              int iColumn = column[j];
-              if (usefulColumn[iColumn]) {
-                double value = fabs(element[j]);
-                value *= columnScale[iColumn];
-                largest = CoinMax(largest, value);
-                smallest = CoinMin(smallest, value);
-              }
-            }
+          CoinFillN(blockLargest, numberRowBlocks, overallLargest);
+          CoinFillN(blockSmallest, numberRowBlocks, overallSmallest);
+          scaleLoop(numberRows, numberRowBlocks,
+            [&](int iBlock, int first, int last) {
+              for (int iRow = first; iRow < last; iRow++) {
+                CoinBigIndex j;
+                double largest = 1.0e-50;
+                double smallest = 1.0e50;
+                for (j = rowStart[iRow]; j < rowStart[iRow + 1]; j++) {
+                  int iColumn = column[j];
+                  if (usefulColumn[iColumn]) {
+                    double value = fabs(element[j]);
+                    value *= columnScale[iColumn];
+                    largest = CoinMax(largest, value);
+                    smallest = CoinMin(smallest, value);
+                  }
+                }
 
 #ifdef SQRT_ARRAY
-            rowScale[iRow] = smallest * largest;
+                rowScale[iRow] = smallest * largest;
 #else
-            rowScale[iRow] = 1.0 / sqrt(smallest * largest);
+                rowScale[iRow] = 1.0 / sqrt(smallest * largest);
 #endif
-            //rowScale[iRow]=CoinMax(1.0e-10,CoinMin(1.0e10,rowScale[iRow]));
-            if (extraDetails) {
-              overallLargest = CoinMax(largest * rowScale[iRow], overallLargest);
-              overallSmallest = CoinMin(smallest * rowScale[iRow], overallSmallest);
-            }
+                //rowScale[iRow]=CoinMax(1.0e-10,CoinMin(1.0e10,rowScale[iRow]));
+                if (extraDetails) {
+                  blockLargest[iBlock] = CoinMax(largest * rowScale[iRow], blockLargest[iBlock]);
+                  blockSmallest[iBlock] = CoinMin(smallest * rowScale[iRow], blockSmallest[iBlock]);
+                }
+              }
+            });
+          for (int iBlock = 0; iBlock < numberRowBlocks; iBlock++) {
+            overallLargest = CoinMax(overallLargest, blockLargest[iBlock]);
+            overallSmallest = CoinMin(overallSmallest, blockSmallest[iBlock]);
           }
           if (model->scalingFlag() == 5)
             break; // just scale rows
@@ -4431,34 +4615,37 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
           if (numberPass == 1)
             break;
           // Geometric mean on column scales
-          for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-            if (usefulColumn[iColumn]) {
-              CoinBigIndex j;
-              largest = 1.0e-50;
-              smallest = 1.0e50;
-              for (j = columnStart[iColumn];
-                   j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-                iRow = row[j];
-                double value = fabs(elementByColumn[j]);
-                value *= rowScale[iRow];
-                largest = CoinMax(largest, value);
-                smallest = CoinMin(smallest, value);
-              }
+          scaleLoop(numberColumns, numberColumnBlocks,
+            [&](int, int first, int last) {
+              for (int iColumn = first; iColumn < last; iColumn++) {
+                if (usefulColumn[iColumn]) {
+                  CoinBigIndex j;
+                  double largest = 1.0e-50;
+                  double smallest = 1.0e50;
+                  for (j = columnStart[iColumn];
+                       j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+                    int iRow = row[j];
+                    double value = fabs(elementByColumn[j]);
+                    value *= rowScale[iRow];
+                    largest = CoinMax(largest, value);
+                    smallest = CoinMin(smallest, value);
+                  }
 #ifdef USE_OBJECTIVE
-              if (fabs(objective[iColumn]) > 1.0e-20) {
-                double value = fabs(objective[iColumn]) * objScale;
-                largest = CoinMax(largest, value);
-                smallest = CoinMin(smallest, value);
-              }
+                  if (fabs(objective[iColumn]) > 1.0e-20) {
+                    double value = fabs(objective[iColumn]) * objScale;
+                    largest = CoinMax(largest, value);
+                    smallest = CoinMin(smallest, value);
+                  }
 #endif
 #ifdef SQRT_ARRAY
-              columnScale[iColumn] = smallest * largest;
+                  columnScale[iColumn] = smallest * largest;
 #else
-              columnScale[iColumn] = 1.0 / sqrt(smallest * largest);
+                  columnScale[iColumn] = 1.0 / sqrt(smallest * largest);
 #endif
-              //columnScale[iColumn]=CoinMax(1.0e-10,CoinMin(1.0e10,columnScale[iColumn]));
-            }
-          }
+                  //columnScale[iColumn]=CoinMax(1.0e-10,CoinMin(1.0e10,columnScale[iColumn]));
+                }
+              }
+            });
 #ifdef SQRT_ARRAY
           doSqrts(columnScale, numberColumns);
 #endif
@@ -4484,24 +4671,37 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
       // See what smallest will be if largest is 1.0
       if (model->scalingFlag() != 5) {
         overallSmallest = 1.0e50;
+        // column extremes go in columnScale and inverseColumnScale (both are
+        // set again before use) then ratio is found in same order as before
+        scaleLoop(numberColumns, numberColumnBlocks,
+          [&](int, int first, int last) {
+            for (int iColumn = first; iColumn < last; iColumn++) {
+              if (usefulColumn[iColumn]) {
+                CoinBigIndex j;
+                double largest = 1.0e-20;
+                double smallest = 1.0e50;
+                for (j = columnStart[iColumn];
+                     j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+                  int iRow = row[j];
+                  double value = fabs(elementByColumn[j] * rowScale[iRow]);
+                  largest = CoinMax(largest, value);
+                  smallest = CoinMin(smallest, value);
+                }
+                columnScale[iColumn] = smallest;
+                inverseColumnScale[iColumn] = largest;
+              }
+            }
+          });
         for (iColumn = 0; iColumn < numberColumns; iColumn++) {
           if (usefulColumn[iColumn]) {
-            CoinBigIndex j;
-            largest = 1.0e-20;
-            smallest = 1.0e50;
-            for (j = columnStart[iColumn];
-                 j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-              iRow = row[j];
-              double value = fabs(elementByColumn[j] * rowScale[iRow]);
-              largest = CoinMax(largest, value);
-              smallest = CoinMin(smallest, value);
-            }
+            largest = inverseColumnScale[iColumn];
+            smallest = columnScale[iColumn];
             if (overallSmallest * largest > smallest)
               overallSmallest = smallest / largest;
           }
         }
       }
-      if (scalingMethod == 1 || scalingMethod == 2) {
+      if (imported || scalingMethod == 1 || scalingMethod == 2) {
         finished = true;
       } else if (savedOverallRatio == 0.0 && scalingMethod != 4) {
         savedOverallRatio = overallSmallest;
@@ -4550,51 +4750,67 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
       overallLargest = 1.0 / sqrt(overallSmallest);
     overallLargest = CoinMin(100.0, overallLargest);
     overallSmallest = 1.0e50;
-    char *usedRow = reinterpret_cast< char * >(inverseRowScale);
-    memset(usedRow, 0, numberRows);
     //printf("scaling %d\n",model->scalingFlag());
     if (model->scalingFlag() != 5) {
-      for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-        if (columnUpper[iColumn] > columnLower[iColumn] + 1.0e-12) {
-          //if (usefulColumn[iColumn]) {
-          CoinBigIndex j;
-          largest = 1.0e-20;
-          smallest = 1.0e50;
-          for (j = columnStart[iColumn];
-               j < columnStart[iColumn] + columnLength[iColumn]; j++) {
-            iRow = row[j];
-            usedRow[iRow] = 1;
-            double value = fabs(elementByColumn[j] * rowScale[iRow]);
-            largest = CoinMax(largest, value);
-            smallest = CoinMin(smallest, value);
-          }
-          columnScale[iColumn] = overallLargest / largest;
-          //columnScale[iColumn]=CoinMax(1.0e-10,CoinMin(1.0e10,columnScale[iColumn]));
 #ifdef RANDOMIZE
-          double value = 0.5 - randomNumberGenerator_.randomDouble(); //between -0.5 to + 0.5
-          columnScale[iColumn] *= (1.0 + 0.1 * value);
-#endif
-          double difference = columnUpper[iColumn] - columnLower[iColumn];
-          if (difference < 1.0e-5 * columnScale[iColumn]) {
-            // make gap larger
-            columnScale[iColumn] = difference / 1.0e-5;
-            //printf("Column %d difference %g scaled diff %g => %g\n",iColumn,difference,
-            // scaledDifference,difference*columnScale[iColumn]);
+      // random numbers must be taken in order
+      numberColumnBlocks = 1;
+#endif
+      CoinFillN(blockSmallest, numberColumnBlocks, overallSmallest);
+      scaleLoop(numberColumns, numberColumnBlocks,
+        [&](int iBlock, int first, int last) {
+          for (int iColumn = first; iColumn < last; iColumn++) {
+            if (columnUpper[iColumn] > columnLower[iColumn] + 1.0e-12) {
+              //if (usefulColumn[iColumn]) {
+              CoinBigIndex j;
+              double largest = 1.0e-20;
+              double smallest = 1.0e50;
+              for (j = columnStart[iColumn];
+                   j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+                int iRow = row[j];
+                double value = fabs(elementByColumn[j] * rowScale[iRow]);
+                largest = CoinMax(largest, value);
+                smallest = CoinMin(smallest, value);
+              }
+              columnScale[iColumn] = overallLargest / largest;
+              //columnScale[iColumn]=CoinMax(1.0e-10,CoinMin(1.0e10,columnScale[iColumn]));
+#ifdef RANDOMIZE
+              double value = 0.5 - randomNumberGenerator_.randomDouble(); //between -0.5 to + 0.5
+              columnScale[iColumn] *= (1.0 + 0.1 * value);
+#endif
+              double difference = columnUpper[iColumn] - columnLower[iColumn];
+              if (difference < 1.0e-5 * columnScale[iColumn]) {
+                // make gap larger
+                columnScale[iColumn] = difference / 1.0e-5;
+                //printf("Column %d difference %g scaled diff %g => %g\n",iColumn,difference,
+                // scaledDifference,difference*columnScale[iColumn]);
+              }
+              double value = smallest * columnScale[iColumn];
+              if (blockSmallest[iBlock] > value)
+                blockSmallest[iBlock] = value;
+              //overallSmallest = CoinMin(overallSmallest,smallest*columnScale[iColumn]);
+            } else {
+              //assert(columnScale[iColumn] == 1.0);
+              columnScale[iColumn] = 1.0;
+            }
           }
-          double value = smallest * columnScale[iColumn];
-          if (overallSmallest > value)
-            overallSmallest = value;
-          //overallSmallest = CoinMin(overallSmallest,smallest*columnScale[iColumn]);
-        } else {
-          //assert(columnScale[iColumn] == 1.0);
-          columnScale[iColumn] = 1.0;
-        }
-      }
-      for (iRow = 0; iRow < numberRows; iRow++) {
-        if (!usedRow[iRow]) {
-          rowScale[iRow] = 1.0;
-        }
-      }
+        });
+      for (int iBlock = 0; iBlock < numberColumnBlocks; iBlock++)
+        overallSmallest = CoinMin(overallSmallest, blockSmallest[iBlock]);
+      // rows with no elements in columns which are not fixed are not scaled
+      scaleLoop(numberRows, numberRowBlocks,
+        [&](int, int first, int last) {
+          for (int iRow = first; iRow < last; iRow++) {
+            CoinBigIndex j;
+            for (j = rowStart[iRow]; j < rowStart[iRow + 1]; j++) {
+              int iColumn = column[j];
+              if (columnUpper[iColumn] > columnLower[iColumn] + 1.0e-12)
+                break;
+            }
+            if (j == rowStart[iRow + 1])
+              rowScale[iRow] = 1.0;
+          }
+        });
     }
     model->messageHandler()->message(CLP_PACKEDSCALE_FINAL, *model->messagesPointer())
       << overallSmallest
@@ -4623,6 +4839,7 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
       simplex->setZeroTolerance(newTolerance);
     }
     delete[] usefulColumn;
+    delete[] blockLargest;
 #ifndef SLIM_CLP
     // If quadratic then make symmetric
     ClpObjective *obj = model->objectiveAsObject();
@@ -4722,19 +4939,22 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
       const int *COIN_RESTRICT column = rowCopy->getIndices();
       const CoinBigIndex *COIN_RESTRICT rowStart = rowCopy->getVectorStarts();
       // scale row copy
-      for (iRow = 0; iRow < numberRows; iRow++) {
-        CoinBigIndex j;
-        double scale = rowScale[iRow];
-        double *COIN_RESTRICT elementsInThisRow = element + rowStart[iRow];
-        const int *COIN_RESTRICT columnsInThisRow = column + rowStart[iRow];
-        int number = static_cast< int >(rowStart[iRow + 1] - rowStart[iRow]);
-        assert(number <= numberColumns);
-        for (j = 0; j < number; j++) {
-          int iColumn = columnsInThisRow[j];
-          elementsInThisRow[j] *= scale * columnScale[iColumn];
-        }
-      }
-      if ((model->specialOptions() & 262144) != 0) {
+      scaleLoop(numberRows, numberRowBlocks,
+        [&](int, int first, int last) {
+          for (int iRow = first; iRow < last; iRow++) {
+            CoinBigIndex j;
+            double scale = rowScale[iRow];
+            double *COIN_RESTRICT elementsInThisRow = element + rowStart[iRow];
+            const int *COIN_RESTRICT columnsInThisRow = column + rowStart[iRow];
+            int number = static_cast< int >(rowStart[iRow + 1] - rowStart[iRow]);
+            assert(number <= numberColumns);
+            for (j = 0; j < number; j++) {
+              int iColumn = columnsInThisRow[j];
+              elementsInThisRow[j] *= scale * columnScale[iColumn];
+            }
+          }
+        });
+      if ((model->specialOptions() & (262144 | 0x08000000 | 0x10000000)) == 262144) {
         //if ((model->specialOptions()&(COIN_CBC_USING_CLP|16384))!=0) {
         //if (model->inCbcBranchAndBound()&&false) {
         // copy without gaps
@@ -4748,16 +4968,19 @@ int ClpPackedMatrix::scale(ClpModel *model, ClpSimplex *simplex) const
         const int *COIN_RESTRICT columnLength = scaledMatrix->getVectorLengths();
 #endif
         double *COIN_RESTRICT elementByColumn = scaledMatrix->getMutableElements();
-        for (iColumn = 0; iColumn < numberColumns; iColumn++) {
-          CoinBigIndex j;
-          double scale = columnScale[iColumn];
-          assert(columnStart[iColumn + 1] == columnStart[iColumn] + columnLength[iColumn]);
-          for (j = columnStart[iColumn];
-               j < columnStart[iColumn + 1]; j++) {
-            int iRow = row[j];
-            elementByColumn[j] *= scale * rowScale[iRow];
-          }
-        }
+        scaleLoop(numberColumns, numberColumnBlocks,
+          [&](int, int first, int last) {
+            for (int iColumn = first; iColumn < last; iColumn++) {
+              CoinBigIndex j;
+              double scale = columnScale[iColumn];
+              assert(columnStart[iColumn + 1] == columnStart[iColumn] + columnLength[iColumn]);
+              for (j = columnStart[iColumn];
+                   j < columnStart[iColumn + 1]; j++) {
+                int iRow = row[j];
+                elementByColumn[j] *= scale * rowScale[iRow];
+              }
+            }
+          });
       } else {
         //printf("not in b&b\n");
       }
@@ -4953,7 +5176,10 @@ bool ClpPackedMatrix::allElementsInRange(ClpModel *model,
   if (model->clpScaledMatrix())
     assert(model->clpScaledMatrix()->getNumElements() == matrix_->getNumElements());
   assert(matrix_->getNumRows() <= model->numberRows());
-  matrix_->setDimensions(model->numberRows(), model->numberColumns());
+  if (!share_ || matrix_->getNumRows() != model->numberRows() || matrix_->getNumCols() != model->numberColumns()) {
+    unshare();
+    matrix_->setDimensions(model->numberRows(), model->numberColumns());
+  }
   CoinBigIndex numberLarge = 0;
   ;
   CoinBigIndex numberSmall = 0;
@@ -5087,6 +5313,8 @@ bool ClpPackedMatrix::allElementsInRange(ClpModel *model,
     model->messageHandler()->message(CLP_DUPLICATEELEMENTS, model->messages())
       << numberDuplicate
       << CoinMessageEol;
+  if (numberDuplicate || numberSmall)
+    unshare();
   if (numberDuplicate)
     matrix_->eliminateDuplicates(smallest);
   else if (numberSmall)
@@ -5663,6 +5891,7 @@ ClpPackedMatrix::scaledColumnCopy(ClpModel *model) const
 // Really scale matrix
 void ClpPackedMatrix::reallyScale(const double *rowScale, const double *columnScale)
 {
+  unshare();
   clearCopies();
   int numberColumns = matrix_->getNumCols();
   const int *row = matrix_->getIndices();
@@ -5682,6 +5911,7 @@ void ClpPackedMatrix::reallyScale(const double *rowScale, const double *columnSc
 /* Delete the columns whose indices are listed in <code>indDel</code>. */
 void ClpPackedMatrix::deleteCols(const int numDel, const int *indDel)
 {
+  unshare();
   if (matrix_->getNumCols())
     matrix_->deleteCols(numDel, indDel);
   clearCopies();
@@ -5696,6 +5926,7 @@ void ClpPackedMatrix::deleteCols(const int numDel, const int *indDel)
 /* Delete the rows whose indices are listed in <code>indDel</code>. */
 void ClpPackedMatrix::deleteRows(const int numDel, const int *indDel)
 {
+  unshare();
   if (matrix_->getNumRows())
     matrix_->deleteRows(numDel, indDel);
   clearCopies();
@@ -5711,6 +5942,7 @@ void ClpPackedMatrix::deleteRows(const int numDel, const int *indDel)
 // Append Columns
 void ClpPackedMatrix::appendCols(int number, const CoinPackedVectorBase *const *columns)
 {
+  unshare();
   matrix_->appendCols(number, columns);
   numberActiveColumns_ = matrix_->getNumCols();
   clearCopies();
@@ -5718,6 +5950,7 @@ void ClpPackedMatrix::appendCols(int number, const CoinPackedVectorBase *const *
 // Append Rows
 void ClpPackedMatrix::appendRows(int number, const CoinPackedVectorBase *const *rows)
 {
+  unshare();
   matrix_->appendRows(number, rows);
   numberActiveColumns_ = matrix_->getNumCols();
   // may now have gaps
@@ -5735,6 +5968,12 @@ void ClpPackedMatrix::appendRows(int number, const CoinPackedVectorBase *const *
    is thrown. */
 void ClpPackedMatrix::setDimensions(int numrows, int numcols)
 {
+  if (share_) {
+    // leave shared matrix alone if nothing changes
+    if ((numrows < 0 || numrows == matrix_->getNumRows()) && (numcols < 0 || numcols == matrix_->getNumCols()))
+      return;
+    unshare();
+  }
   matrix_->setDimensions(numrows, numcols);
 #ifdef DO_CHECK_FLAGS
   checkFlags(0);
@@ -5749,6 +5988,7 @@ int ClpPackedMatrix::appendMatrix(int number, int type,
   const double *element, int numberOther)
 {
   int numberErrors = 0;
+  unshare();
   // make sure other dimension is big enough
   if (type == 0) {
     // rows
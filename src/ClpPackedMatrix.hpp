@@ -18,6 +18,7 @@
 
 class ClpPackedMatrix2;
 class ClpPackedMatrix3;
+class ClpPackedMatrixShare;
 class CoinDoubleArrayWithLength;
 class CLPLIB_EXPORT ClpPackedMatrix : public ClpMatrixBase {
 
@@ -61,6 +62,8 @@ public:
   /// Mutable elements
   inline double *getMutableElements() const
   {
+    if (share_)
+      const_cast< ClpPackedMatrix * >(this)->unshare();
     return matrix_->getMutableElements();
   }
   /** A vector containing the minor indices of the elements in the packed
@@ -112,6 +115,8 @@ public:
   virtual void replaceVector(const int index,
     const int numReplace, const double *newElements)
   {
+    if (share_)
+      unshare();
     matrix_->replaceVector(index, numReplace, newElements);
   }
   /** Modify one element of packed matrix.  An element may be added.
@@ -120,6 +125,8 @@ public:
   virtual void modifyCoefficient(int row, int column, double newElement,
     bool keepZero = false)
   {
+    if (share_)
+      unshare();
     matrix_->modifyCoefficient(row, column, newElement, keepZero);
   }
   /** Returns a new matrix in reverse order without gaps */
@@ -309,18 +316,28 @@ public:
 
   /**@name Other */
   //@{
-  /// Returns CoinPackedMatrix (non const)
+  /** Returns CoinPackedMatrix (non const).
+      If shared (see sharedClone) call unshare() before changing it */
   inline CoinPackedMatrix *matrix() const
   {
     return matrix_;
   }
   /** Just sets matrix_ to NULL so it can be used elsewhere.
-         used in GUB
+         used in GUB.  If matrix may be shared call unshare() before
+         getting it.
      */
-  inline void setMatrixNull()
-  {
-    matrix_ = NULL;
-  }
+  void setMatrixNull();
+  /** Returns a new ClpPackedMatrix which uses the same CoinPackedMatrix
+      as this (copy on write).  The first of them to be changed by a
+      ClpPackedMatrix method takes its own copy.  Special row and column
+      copies are not cloned.  The count is thread safe but the first
+      sharedClone of a matrix should not be made on several threads at once.
+  */
+  ClpPackedMatrix *sharedClone() const;
+  /// Number of ClpPackedMatrix objects using this CoinPackedMatrix
+  int shareCount() const;
+  /// Takes own copy of CoinPackedMatrix if it is shared
+  void unshare();
   /// Say we want special column copy
   inline void makeSpecialColumnCopy()
   {
@@ -481,6 +498,8 @@ private:
 protected:
   /// Check validity
   void checkFlags(int type) const;
+  /// Gives up CoinPackedMatrix (deleting it if not shared)
+  void releaseMatrix();
   /**@name Data members
         The data members are protected to allow access for derived classes. */
   //@{
@@ -500,6 +519,8 @@ protected:
   ClpPackedMatrix2 *rowCopy_;
   /// Special column copy
   ClpPackedMatrix3 *columnCopy_;
+  /// Reference count if matrix_ shared (NULL if not)
+  mutable ClpPackedMatrixShare *share_;
   //@}
 };
 #ifdef THREAD
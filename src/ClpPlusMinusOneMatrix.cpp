@@ -3,6 +3,7 @@
 // This code is licensed under the terms of the Eclipse Public License (EPL).
 
 #include <cstdio>
+#include <cstring>
 
 #include "CoinPragma.hpp"
 #include "CoinIndexedVector.hpp"
@@ -14,6 +15,83 @@
 // at end to get min/max!
 #include "ClpPlusMinusOneMatrix.hpp"
 #include "ClpMessage.hpp"
+#include "ClpThreadPool.hpp"
+#if defined(COIN_AVX2) && COIN_AVX2 >= 4 && defined(__AVX2__)
+#include <immintrin.h>
+#define CLP_PLUS_ONE_GATHER
+#endif
+// Fewest columns in a block when pricing is split over threads
+#ifndef CLP_PLUS_ONE_BLOCK
+#define CLP_PLUS_ONE_BLOCK 20000
+#endif
+/* Sum of x over n indices.  Runs in set partitioning are short so a plain
+   loop per run (which predicts well) is best.  With AVX2 longer runs use
+   gathers into four partial sums. */
+static inline double gatherSum(const double *COIN_RESTRICT x,
+  const int *COIN_RESTRICT which, CoinBigIndex n)
+{
+  double sum = 0.0;
+  CoinBigIndex i = 0;
+#ifdef CLP_PLUS_ONE_GATHER
+  if (n >= 8) {
+    __m256d sum4 = _mm256_setzero_pd();
+    for (; i + 4 <= n; i += 4) {
+      __m128i index4 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(which + i));
+      sum4 = _mm256_add_pd(sum4, _mm256_i32gather_pd(x, index4, 8));
+    }
+    __m128d sum2 = _mm_add_pd(_mm256_castpd256_pd128(sum4),
+      _mm256_extractf128_pd(sum4, 1));
+    sum = _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+  }
+#endif
+  for (; i < n; i++)
+    sum += x[which[i]];
+  return sum;
+}
+// x summed over +1 entries less x summed over -1 entries
+static inline double plusMinusOneSum(const double *COIN_RESTRICT x,
+  const int *COIN_RESTRICT indices, CoinBigIndex startPositive,
+  CoinBigIndex startNegative, CoinBigIndex end)
+{
+  return gatherSum(x, indices + startPositive, startNegative - startPositive)
+    - gatherSum(x, indices + startNegative, end - startNegative);
+}
+/* Does work(first,last) over blocks of columns.  work puts its nonzeros
+   from index[first] on (and array[first] on if packed) and returns how many.
+   They are moved down afterwards so result is as if done in one pass. */
+static int plusMinusOneBlocks(const ClpSimplex *model, int numberColumns,
+  bool packed, double *COIN_RESTRICT array, int *COIN_RESTRICT index,
+  const std::function< int(int, int) > &work)
+{
+  int numberBlocks = 1;
+  if (model->numberThreads() > 1 && numberColumns >= 2 * CLP_PLUS_ONE_BLOCK) {
+    numberBlocks = CoinMin(model->numberThreads(),
+      ClpPricingThreadPool()->numberThreads() + 1);
+    numberBlocks = CoinMin(numberBlocks, numberColumns / CLP_PLUS_ONE_BLOCK);
+  }
+  if (numberBlocks <= 1)
+    return work(0, numberColumns);
+  int *first = new int[2 * numberBlocks];
+  int *count = first + numberBlocks;
+  CoinZeroN(count, numberBlocks);
+  ClpPricingThreadPool()->parallelFor(0, numberColumns, numberBlocks,
+    [&](int iBlock, int start, int end) {
+      first[iBlock] = start;
+      count[iBlock] = work(start, end);
+    });
+  int numberNonZero = count[0];
+  for (int iBlock = 1; iBlock < numberBlocks; iBlock++) {
+    int n = count[iBlock];
+    if (n) {
+      memmove(index + numberNonZero, index + first[iBlock], n * sizeof(int));
+      if (packed)
+        memmove(array + numberNonZero, array + first[iBlock], n * sizeof(double));
+      numberNonZero += n;
+    }
+  }
+  delete[] first;
+  return numberNonZero;
+}
 #ifdef CLP_PLUS_ONE_MATRIX
 static int oneitcount[13] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 static void oneit(int i)
@@ -499,27 +577,20 @@ void ClpPlusMinusOneMatrix::transposeTimes(double scalar,
 {
   int numberMajor = (columnOrdered_) ? numberColumns_ : numberRows_;
   int i;
-  CoinBigIndex j = 0;
   assert(columnOrdered_);
 #ifdef CLP_PLUS_ONE_MATRIX
   if ((otherFlags_ & 1) == 0 || !doPlusOnes) {
 #endif
     for (i = 0; i < numberMajor; i++) {
-      double value = 0.0;
-      for (; j < startNegative_[i]; j++) {
-        int iRow = indices_[j];
-        value += x[iRow];
-      }
-      for (; j < startPositive_[i + 1]; j++) {
-        int iRow = indices_[j];
-        value -= x[iRow];
-      }
+      double value = plusMinusOneSum(x, indices_, startPositive_[i],
+        startNegative_[i], startPositive_[i + 1]);
       y[i] += scalar * value;
     }
 #ifdef CLP_PLUS_ONE_MATRIX
   } else {
     // plus one
     oneit(1);
+    CoinBigIndex j = 0;
     for (i = 0; i < numberMajor; i++) {
       double value = 0.0;
       for (; j < startPositive_[i + 1]; j++) {
@@ -588,9 +659,10 @@ void ClpPlusMinusOneMatrix::transposeTimes(const ClpSimplex *model, double scala
     assert(!y->getNumElements());
     // do by column
     // Need to expand if packed mode
-    int iColumn;
-    CoinBigIndex j = 0;
     assert(columnOrdered_);
+    const CoinBigIndex *COIN_RESTRICT startPositive = startPositive_;
+    const CoinBigIndex *COIN_RESTRICT startNegative = startNegative_;
+    const int *COIN_RESTRICT row = indices_;
     if (packed) {
       // need to expand pi into y
       assert(y->capacity() >= numberRows);
@@ -606,26 +678,25 @@ void ClpPlusMinusOneMatrix::transposeTimes(const ClpSimplex *model, double scala
 #ifdef CLP_PLUS_ONE_MATRIX
       if ((otherFlags_ & 1) == 0 || !doPlusOnes) {
 #endif
-        for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-          double value = 0.0;
-          for (; j < startNegative_[iColumn]; j++) {
-            int iRow = indices_[j];
-            value += pi[iRow];
-          }
-          for (; j < startPositive_[iColumn + 1]; j++) {
-            int iRow = indices_[j];
-            value -= pi[iRow];
-          }
-          if (fabs(value) > zeroTolerance) {
-            array[numberNonZero] = value;
-            index[numberNonZero++] = iColumn;
-          }
-        }
+        numberNonZero = plusMinusOneBlocks(model, numberColumns_, true, array, index,
+          [=](int first, int last) {
+            int n = first;
+            for (int iColumn = first; iColumn < last; iColumn++) {
+              double value = plusMinusOneSum(pi, row, startPositive[iColumn],
+                startNegative[iColumn], startPositive[iColumn + 1]);
+              if (fabs(value) > zeroTolerance) {
+                array[n] = value;
+                index[n++] = iColumn;
+              }
+            }
+            return n - first;
+          });
 #ifdef CLP_PLUS_ONE_MATRIX
       } else {
         // plus one
         oneit(2);
-        for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+        CoinBigIndex j = 0;
+        for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
           double value = 0.0;
           for (; j < startPositive_[iColumn + 1]; j++) {
             int iRow = indices_[j];
@@ -643,22 +714,19 @@ void ClpPlusMinusOneMatrix::transposeTimes(const ClpSimplex *model, double scala
         pi[iRow] = 0.0;
       }
     } else {
-      for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-        double value = 0.0;
-        for (; j < startNegative_[iColumn]; j++) {
-          int iRow = indices_[j];
-          value += pi[iRow];
-        }
-        for (; j < startPositive_[iColumn + 1]; j++) {
-          int iRow = indices_[j];
-          value -= pi[iRow];
-        }
-        value *= scalar;
-        if (fabs(value) > zeroTolerance) {
-          index[numberNonZero++] = iColumn;
-          array[iColumn] = value;
-        }
-      }
+      numberNonZero = plusMinusOneBlocks(model, numberColumns_, false, array, index,
+        [=](int first, int last) {
+          int n = first;
+          for (int iColumn = first; iColumn < last; iColumn++) {
+            double value = scalar * plusMinusOneSum(pi, row, startPositive[iColumn],
+              startNegative[iColumn], startPositive[iColumn + 1]);
+            if (fabs(value) > zeroTolerance) {
+              index[n++] = iColumn;
+              array[iColumn] = value;
+            }
+          }
+          return n - first;
+        });
     }
     columnArray->setNumElements(numberNonZero);
   } else {
@@ -1107,17 +1175,8 @@ void ClpPlusMinusOneMatrix::subsetTransposeTimes(const ClpSimplex *,
 #endif
     for (jColumn = 0; jColumn < numberToDo; jColumn++) {
       int iColumn = which[jColumn];
-      double value = 0.0;
-      CoinBigIndex j = startPositive_[iColumn];
-      for (; j < startNegative_[iColumn]; j++) {
-        int iRow = indices_[j];
-        value += pi[iRow];
-      }
-      for (; j < startPositive_[iColumn + 1]; j++) {
-        int iRow = indices_[j];
-        value -= pi[iRow];
-      }
-      array[jColumn] = value;
+      array[jColumn] = plusMinusOneSum(pi, indices_, startPositive_[iColumn],
+        startNegative_[iColumn], startPositive_[iColumn + 1]);
     }
 #ifdef CLP_PLUS_ONE_MATRIX
   } else {
@@ -1744,7 +1803,6 @@ void ClpPlusMinusOneMatrix::partialPricing(ClpSimplex *model, double startFracti
   numberWanted = currentWanted_;
   int start = static_cast< int >(startFraction * numberColumns_);
   int end = CoinMin(static_cast< int >(endFraction * numberColumns_ + 1), numberColumns_);
-  CoinBigIndex j;
   double tolerance = model->currentDualTolerance();
   double *COIN_RESTRICT reducedCost = model->djRegion();
   const double *COIN_RESTRICT duals = model->dualRowSolution();
@@ -1769,16 +1827,8 @@ void ClpPlusMinusOneMatrix::partialPricing(ClpSimplex *model, double startFracti
         break;
       case ClpSimplex::isFree:
       case ClpSimplex::superBasic:
-        value = cost[iSequence];
-        j = startPositive_[iSequence];
-        for (; j < startNegative_[iSequence]; j++) {
-          int iRow = indices_[j];
-          value -= duals[iRow];
-        }
-        for (; j < startPositive_[iSequence + 1]; j++) {
-          int iRow = indices_[j];
-          value += duals[iRow];
-        }
+        value = cost[iSequence] - plusMinusOneSum(duals, indices_, startPositive_[iSequence],
+          startNegative_[iSequence], startPositive_[iSequence + 1]);
         value = fabs(value);
         if (value > FREE_ACCEPT * tolerance) {
           numberWanted--;
@@ -1797,16 +1847,8 @@ void ClpPlusMinusOneMatrix::partialPricing(ClpSimplex *model, double startFracti
         }
         break;
       case ClpSimplex::atUpperBound:
-        value = cost[iSequence];
-        j = startPositive_[iSequence];
-        for (; j < startNegative_[iSequence]; j++) {
-          int iRow = indices_[j];
-          value -= duals[iRow];
-        }
-        for (; j < startPositive_[iSequence + 1]; j++) {
-          int iRow = indices_[j];
-          value += duals[iRow];
-        }
+        value = cost[iSequence] - plusMinusOneSum(duals, indices_, startPositive_[iSequence],
+          startNegative_[iSequence], startPositive_[iSequence + 1]);
         if (value > tolerance) {
           numberWanted--;
           if (value > bestDj) {
@@ -1822,16 +1864,8 @@ void ClpPlusMinusOneMatrix::partialPricing(ClpSimplex *model, double startFracti
         }
         break;
       case ClpSimplex::atLowerBound:
-        value = cost[iSequence];
-        j = startPositive_[iSequence];
-        for (; j < startNegative_[iSequence]; j++) {
-          int iRow = indices_[j];
-          value -= duals[iRow];
-        }
-        for (; j < startPositive_[iSequence + 1]; j++) {
-          int iRow = indices_[j];
-          value += duals[iRow];
-        }
+        value = cost[iSequence] - plusMinusOneSum(duals, indices_, startPositive_[iSequence],
+          startNegative_[iSequence], startPositive_[iSequence + 1]);
         value = -value;
         if (value > tolerance) {
           numberWanted--;
@@ -1854,16 +1888,8 @@ void ClpPlusMinusOneMatrix::partialPricing(ClpSimplex *model, double startFracti
   }
   if (bestSequence != saveSequence) {
     // recompute dj
-    double value = cost[bestSequence];
-    j = startPositive_[bestSequence];
-    for (; j < startNegative_[bestSequence]; j++) {
-      int iRow = indices_[j];
-      value -= duals[iRow];
-    }
-    for (; j < startPositive_[bestSequence + 1]; j++) {
-      int iRow = indices_[j];
-      value += duals[iRow];
-    }
+    double value = cost[bestSequence] - plusMinusOneSum(duals, indices_, startPositive_[bestSequence],
+      startNegative_[bestSequence], startPositive_[bestSequence + 1]);
     reducedCost[bestSequence] = value;
     savedBestSequence_ = bestSequence;
     savedBestDj_ = reducedCost[savedBestSequence_];
@@ -1934,7 +1960,6 @@ int ClpPlusMinusOneMatrix::transposeTimes2(const ClpSimplex *model,
   double zeroTolerance = model->zeroTolerance();
   bool packed = pi1->packedMode();
   // do by column
-  int iColumn;
   assert(!spare->getNumElements());
   double *COIN_RESTRICT piWeight = pi2->denseVector();
   assert(!pi2->packedMode());
@@ -1942,120 +1967,70 @@ int ClpPlusMinusOneMatrix::transposeTimes2(const ClpSimplex *model,
   if (!scaleFactor)
     scaleFactor = 1.0;
   // Note scale factor was -1.0
+  const int *COIN_RESTRICT whichRow = pi1->getIndices();
   if (packed) {
     // need to expand pi into y
     assert(spare->capacity() >= model->numberRows());
     double *COIN_RESTRICT piOld = pi;
     pi = spare->denseVector();
-    const int *COIN_RESTRICT whichRow = pi1->getIndices();
     int i;
     // modify pi so can collapse to one loop
     for (i = 0; i < numberInRowArray; i++) {
       int iRow = whichRow[i];
       pi[iRow] = piOld[i];
     }
-    CoinBigIndex j;
-    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-      ClpSimplex::Status status = model->getStatus(iColumn);
-      if (status == ClpSimplex::basic || status == ClpSimplex::isFixed)
-        continue;
-      double value = 0.0;
-      for (j = startPositive_[iColumn]; j < startNegative_[iColumn]; j++) {
-        int iRow = indices_[j];
-        value -= pi[iRow];
-      }
-      for (; j < startPositive_[iColumn + 1]; j++) {
-        int iRow = indices_[j];
-        value += pi[iRow];
-      }
-      if (fabs(value) > zeroTolerance) {
-        // and do other array
-        double modification = 0.0;
-        for (j = startPositive_[iColumn]; j < startNegative_[iColumn]; j++) {
-          int iRow = indices_[j];
-          modification += piWeight[iRow];
-        }
-        for (; j < startPositive_[iColumn + 1]; j++) {
-          int iRow = indices_[j];
-          modification -= piWeight[iRow];
-        }
-        double thisWeight = weights[iColumn];
-        double pivot = value * scaleFactor;
-        double pivotSquared = pivot * pivot;
-        thisWeight += pivotSquared * devex + pivot * modification;
-        if (thisWeight < DEVEX_TRY_NORM) {
-          if (referenceIn < 0.0) {
-            // steepest
-            thisWeight = CoinMax(DEVEX_TRY_NORM, DEVEX_ADD_ONE + pivotSquared);
-          } else {
-            // exact
-            thisWeight = referenceIn * pivotSquared;
-            if (reference(iColumn))
-              thisWeight += 1.0;
-            thisWeight = CoinMax(thisWeight, DEVEX_TRY_NORM);
+  }
+  const CoinBigIndex *COIN_RESTRICT startPositive = startPositive_;
+  const CoinBigIndex *COIN_RESTRICT startNegative = startNegative_;
+  const int *COIN_RESTRICT row = indices_;
+  // columns are independent so can be done in blocks
+  numberNonZero = plusMinusOneBlocks(model, numberColumns_, packed, array, index,
+    [=](int first, int last) {
+      int n = first;
+      for (int iColumn = first; iColumn < last; iColumn++) {
+        ClpSimplex::Status status = model->getStatus(iColumn);
+        if (status == ClpSimplex::basic || status == ClpSimplex::isFixed)
+          continue;
+        double value = -plusMinusOneSum(pi, row, startPositive[iColumn],
+          startNegative[iColumn], startPositive[iColumn + 1]);
+        if (fabs(value) > zeroTolerance) {
+          // and do other array
+          double modification = plusMinusOneSum(piWeight, row, startPositive[iColumn],
+            startNegative[iColumn], startPositive[iColumn + 1]);
+          double thisWeight = weights[iColumn];
+          double pivot = value * scaleFactor;
+          double pivotSquared = pivot * pivot;
+          thisWeight += pivotSquared * devex + pivot * modification;
+          if (thisWeight < DEVEX_TRY_NORM) {
+            if (referenceIn < 0.0) {
+              // steepest
+              thisWeight = CoinMax(DEVEX_TRY_NORM, DEVEX_ADD_ONE + pivotSquared);
+            } else {
+              // exact
+              thisWeight = referenceIn * pivotSquared;
+              if (reference(iColumn))
+                thisWeight += 1.0;
+              thisWeight = CoinMax(thisWeight, DEVEX_TRY_NORM);
+            }
+          }
+          weights[iColumn] = thisWeight;
+          if (!killDjs) {
+            if (packed)
+              array[n] = value;
+            else
+              array[iColumn] = value;
+            index[n++] = iColumn;
           }
-        }
-        weights[iColumn] = thisWeight;
-        if (!killDjs) {
-          array[numberNonZero] = value;
-          index[numberNonZero++] = iColumn;
         }
       }
-    }
+      return n - first;
+    });
+  if (packed) {
     // zero out
-    for (i = 0; i < numberInRowArray; i++) {
+    for (int i = 0; i < numberInRowArray; i++) {
       int iRow = whichRow[i];
       pi[iRow] = 0.0;
     }
-  } else {
-    CoinBigIndex j;
-    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-      ClpSimplex::Status status = model->getStatus(iColumn);
-      if (status == ClpSimplex::basic || status == ClpSimplex::isFixed)
-        continue;
-      double value = 0.0;
-      for (j = startPositive_[iColumn]; j < startNegative_[iColumn]; j++) {
-        int iRow = indices_[j];
-        value -= pi[iRow];
-      }
-      for (; j < startPositive_[iColumn + 1]; j++) {
-        int iRow = indices_[j];
-        value += pi[iRow];
-      }
-      if (fabs(value) > zeroTolerance) {
-        // and do other array
-        double modification = 0.0;
-        for (j = startPositive_[iColumn]; j < startNegative_[iColumn]; j++) {
-          int iRow = indices_[j];
-          modification += piWeight[iRow];
-        }
-        for (; j < startPositive_[iColumn + 1]; j++) {
-          int iRow = indices_[j];
-          modification -= piWeight[iRow];
-        }
-        double thisWeight = weights[iColumn];
-        double pivot = value * scaleFactor;
-        double pivotSquared = pivot * pivot;
-        thisWeight += pivotSquared * devex + pivot * modification;
-        if (thisWeight < DEVEX_TRY_NORM) {
-          if (referenceIn < 0.0) {
-            // steepest
-            thisWeight = CoinMax(DEVEX_TRY_NORM, DEVEX_ADD_ONE + pivotSquared);
-          } else {
-            // exact
-            thisWeight = referenceIn * pivotSquared;
-            if (reference(iColumn))
-              thisWeight += 1.0;
-            thisWeight = CoinMax(thisWeight, DEVEX_TRY_NORM);
-          }
-        }
-        weights[iColumn] = thisWeight;
-        if (!killDjs) {
-          array[iColumn] = value;
-          index[numberNonZero++] = iColumn;
-        }
-      }
-    }
   }
   dj1->setNumElements(numberNonZero);
   spare->setNumElements(0);
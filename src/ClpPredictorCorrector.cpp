@@ -63,13 +63,37 @@ void ClpPredictorCorrector::saveSolution(std::string fileName)
 }
 #endif
 // Could change on CLP_LONG_CHOLESKY or COIN_LONG_WORK?
-static CoinWorkDouble eScale = 1.0e27;
-static CoinWorkDouble eBaseCaution = 1.0e-12;
-static CoinWorkDouble eBase = 1.0e-12;
-static CoinWorkDouble eDiagonal = 1.0e25;
-static CoinWorkDouble eDiagonalCaution = 1.0e18;
-static CoinWorkDouble eExtra = 1.0e-12;
+static const CoinWorkDouble eScale = 1.0e27;
+static const CoinWorkDouble eBaseCaution = 1.0e-12;
+static const CoinWorkDouble eBase = 1.0e-12;
+static const CoinWorkDouble eDiagonal = 1.0e25;
+static const CoinWorkDouble eDiagonalCaution = 1.0e18;
+static const CoinWorkDouble eExtra = 1.0e-12;
 
+// Returns true if all scale factors are powers of 2
+static bool powersOfTwo(const double *scale, int number)
+{
+  for (int i = 0; i < number; i++) {
+    int exponent;
+    if (frexp(scale[i], &exponent) != 0.5)
+      return false;
+  }
+  return true;
+}
+/* Puts back unscaled matrix - either deleting scaled copy or (if it
+   was scaled in place by powers of 2) scaling back exactly */
+static void restoreMatrix(ClpMatrixBase *&matrix, ClpMatrixBase *saveMatrix,
+  const double *rowScale, const double *columnScale,
+  int numberRows, int numberColumns)
+{
+  if (matrix == saveMatrix) {
+    // inverses follow scales
+    matrix->reallyScale(rowScale + numberRows, columnScale + numberColumns);
+  } else {
+    delete matrix;
+    matrix = saveMatrix;
+  }
+}
 // main function
 
 int ClpPredictorCorrector::solve()
@@ -126,7 +150,14 @@ int ClpPredictorCorrector::solve()
   // If scaled then really scale matrix
   if (scalingFlag_ > 0 && rowScale_) {
     saveMatrix = matrix_;
-    matrix_ = matrix_->scaledColumnCopy(this);
+    if ((specialOptions_ & 0x10000000) != 0 && matrix_->type() == 1
+      && powersOfTwo(rowScale_, numberRows_)
+      && powersOfTwo(columnScale_, numberColumns_)) {
+      // implicit scaling - no copy, scale in place (can be undone exactly)
+      matrix_->reallyScale(rowScale_, columnScale_);
+    } else {
+      matrix_ = matrix_->scaledColumnCopy(this);
+    }
   }
   //initializeFeasible(); - this just set fixed flag
   smallestInfeasibility_ = COIN_DBL_MAX;
@@ -142,11 +173,9 @@ int ClpPredictorCorrector::solve()
     problemStatus_ = 4;
     //delete all temporary regions
     deleteWorkingData();
-    if (saveMatrix) {
-      // restore normal copy
-      delete matrix_;
-      matrix_ = saveMatrix;
-    }
+    if (saveMatrix)
+      restoreMatrix(matrix_, saveMatrix, rowScale_, columnScale_,
+        numberRows_, numberColumns_);
     // Restore quadratic objective if necessary
     if (saveObjective) {
       delete objective_;
@@ -165,11 +194,9 @@ int ClpPredictorCorrector::solve()
     problemStatus_ = 4;
     //delete all temporary regions
     deleteWorkingData();
-    if (saveMatrix) {
-      // restore normal copy
-      delete matrix_;
-      matrix_ = saveMatrix;
-    }
+    if (saveMatrix)
+      restoreMatrix(matrix_, saveMatrix, rowScale_, columnScale_,
+        numberRows_, numberColumns_);
     return -1;
   }
   CoinWorkDouble *dualArray = reinterpret_cast< CoinWorkDouble * >(dual_);
@@ -522,11 +549,9 @@ int ClpPredictorCorrector::solve()
         problemStatus_ = 4;
         //delete all temporary regions
         deleteWorkingData();
-        if (saveMatrix) {
-          // restore normal copy
-          delete matrix_;
-          matrix_ = saveMatrix;
-        }
+        if (saveMatrix)
+          restoreMatrix(matrix_, saveMatrix, rowScale_, columnScale_,
+            numberRows_, numberColumns_);
         return -1;
       } else {
 #ifndef NDEBUG
@@ -977,11 +1002,9 @@ int ClpPredictorCorrector::solve()
      }
 #endif
 #endif
-  if (saveMatrix) {
-    // restore normal copy
-    delete matrix_;
-    matrix_ = saveMatrix;
-  }
+  if (saveMatrix)
+    restoreMatrix(matrix_, saveMatrix, rowScale_, columnScale_,
+      numberRows_, numberColumns_);
   return problemStatus_;
 }
 // findStepLength.
@@ -0,0 +1,147 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+
+#include "ClpPricingOracle.hpp"
+
+//-------------------------------------------------------------------
+// Default Constructor
+//-------------------------------------------------------------------
+ClpPricingOracle::ClpPricingOracle()
+  : numberColumns_(0)
+  , maximumColumns_(0)
+  , maximumElements_(0)
+  , startColumn_(NULL)
+  , row_(NULL)
+  , element_(NULL)
+  , cost_(NULL)
+  , set_(NULL)
+  , columnUpper_(NULL)
+{
+}
+
+//-------------------------------------------------------------------
+// Copy constructor
+//-------------------------------------------------------------------
+ClpPricingOracle::ClpPricingOracle(const ClpPricingOracle &rhs)
+  : numberColumns_(0)
+  , maximumColumns_(0)
+  , maximumElements_(0)
+  , startColumn_(NULL)
+  , row_(NULL)
+  , element_(NULL)
+  , cost_(NULL)
+  , set_(NULL)
+  , columnUpper_(NULL)
+{
+  copyBatch(rhs);
+}
+
+//-------------------------------------------------------------------
+// Destructor
+//-------------------------------------------------------------------
+ClpPricingOracle::~ClpPricingOracle()
+{
+  delete[] startColumn_;
+  delete[] row_;
+  delete[] element_;
+  delete[] cost_;
+  delete[] set_;
+  delete[] columnUpper_;
+}
+
+//----------------------------------------------------------------
+// Assignment operator
+//-------------------------------------------------------------------
+ClpPricingOracle &
+ClpPricingOracle::operator=(const ClpPricingOracle &rhs)
+{
+  if (this != &rhs) {
+    clearBatch();
+    copyBatch(rhs);
+  }
+  return *this;
+}
+// Copies batch
+void ClpPricingOracle::copyBatch(const ClpPricingOracle &rhs)
+{
+  int numberColumns = rhs.numberColumns_;
+  if (numberColumns) {
+    CoinBigIndex numberElements = rhs.startColumn_[numberColumns];
+    reserve(numberColumns, numberElements);
+    CoinMemcpyN(rhs.startColumn_, numberColumns + 1, startColumn_);
+    CoinMemcpyN(rhs.row_, numberElements, row_);
+    CoinMemcpyN(rhs.element_, numberElements, element_);
+    CoinMemcpyN(rhs.cost_, numberColumns, cost_);
+    CoinMemcpyN(rhs.set_, numberColumns, set_);
+    CoinMemcpyN(rhs.columnUpper_, numberColumns, columnUpper_);
+  }
+  numberColumns_ = numberColumns;
+}
+// Makes sure batch has room
+void ClpPricingOracle::reserve(int numberColumns, CoinBigIndex numberElements)
+{
+  if (numberColumns > maximumColumns_) {
+    int newMaximum = CoinMax(numberColumns, 2 * maximumColumns_ + 10);
+    CoinBigIndex *startColumn = new CoinBigIndex[newMaximum + 1];
+    double *cost = new double[newMaximum];
+    int *set = new int[newMaximum];
+    double *columnUpper = new double[newMaximum];
+    if (maximumColumns_) {
+      CoinMemcpyN(startColumn_, numberColumns_ + 1, startColumn);
+      CoinMemcpyN(cost_, numberColumns_, cost);
+      CoinMemcpyN(set_, numberColumns_, set);
+      CoinMemcpyN(columnUpper_, numberColumns_, columnUpper);
+    } else {
+      startColumn[0] = 0;
+    }
+    delete[] startColumn_;
+    delete[] cost_;
+    delete[] set_;
+    delete[] columnUpper_;
+    startColumn_ = startColumn;
+    cost_ = cost;
+    set_ = set;
+    columnUpper_ = columnUpper;
+    maximumColumns_ = newMaximum;
+  }
+  if (numberElements > maximumElements_) {
+    CoinBigIndex newMaximum = CoinMax(numberElements, 2 * maximumElements_ + 100);
+    int *row = new int[newMaximum];
+    double *element = new double[newMaximum];
+    CoinBigIndex numberNow = numberColumns_ ? startColumn_[numberColumns_] : 0;
+    CoinMemcpyN(row_, numberNow, row);
+    CoinMemcpyN(element_, numberNow, element);
+    delete[] row_;
+    delete[] element_;
+    row_ = row;
+    element_ = element;
+    maximumElements_ = newMaximum;
+  }
+}
+// Adds a column to batch
+void ClpPricingOracle::addColumn(int numberEntries, const int *row, const double *element,
+  double cost, int iSet, double upper)
+{
+  CoinBigIndex start = numberColumns_ ? startColumn_[numberColumns_] : 0;
+  reserve(numberColumns_ + 1, start + numberEntries);
+  CoinMemcpyN(row, numberEntries, row_ + start);
+  CoinMemcpyN(element, numberEntries, element_ + start);
+  cost_[numberColumns_] = cost;
+  set_[numberColumns_] = iSet;
+  columnUpper_[numberColumns_] = upper;
+  numberColumns_++;
+  startColumn_[numberColumns_] = start + numberEntries;
+}
+// Empties batch
+void ClpPricingOracle::clearBatch()
+{
+  numberColumns_ = 0;
+  if (startColumn_)
+    startColumn_[0] = 0;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,137 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpPricingOracle_H
+#define ClpPricingOracle_H
+
+#include "CoinPragma.hpp"
+#include "ClpConfig.h"
+#include "CoinTypes.h"
+
+class ClpDynamicMatrix;
+
+/** Base class for column generation with ClpDynamicMatrix
+
+    When no column in the pool held by ClpDynamicMatrix prices out the
+    matrix asks the oracle for more.  The oracle is given the duals on the
+    static rows and a dual for each set (gub row).  A column a in set s with
+    cost c is attractive if
+
+        c - duals.a - setDuals[s] < -tolerance
+
+    The oracle passes back a batch of columns using addColumn.  It may
+    ignore the tolerance (the matrix recomputes all reduced costs), but
+    returning no columns means the current pool is optimal.
+
+    The matrix keeps a bounded pool - columns which have been out of the
+    small problem for a long time may be thrown away and later regenerated.
+    So an oracle should not assume anything it generated is still in the pool.
+*/
+
+class CLPLIB_EXPORT ClpPricingOracle {
+
+public:
+  /**@name Virtual methods that the derived classes must provide */
+  //@{
+  /** Generate columns.  duals are of length matrix->numberStaticRows()
+         and setDuals of length matrix->numberSets().  At most maximumColumns
+         should be added.  Returns number of columns added to batch.
+     */
+  virtual int generateColumns(const ClpDynamicMatrix *matrix,
+    const double *duals, const double *setDuals,
+    double tolerance, int maximumColumns)
+    = 0;
+  /// Clone
+  virtual ClpPricingOracle *clone() const = 0;
+  //@}
+
+  /**@name Batch of columns (filled by generateColumns) */
+  //@{
+  /** Adds a column to batch - elements should not include set (gub) row.
+         Lower bound is zero and upper bound is only used if matrix has
+         column upper bounds */
+  void addColumn(int numberEntries, const int *row, const double *element,
+    double cost, int iSet, double upper = 1.0e30);
+  /// Empties batch
+  void clearBatch();
+  /// Number of columns in batch
+  inline int numberColumns() const
+  {
+    return numberColumns_;
+  }
+  /// Starts of each column in batch
+  inline const CoinBigIndex *startColumn() const
+  {
+    return startColumn_;
+  }
+  /// Rows in batch
+  inline const int *row() const
+  {
+    return row_;
+  }
+  /// Elements in batch
+  inline const double *element() const
+  {
+    return element_;
+  }
+  /// Costs in batch
+  inline const double *cost() const
+  {
+    return cost_;
+  }
+  /// Set of each column in batch
+  inline const int *set() const
+  {
+    return set_;
+  }
+  /// Upper bounds in batch
+  inline const double *columnUpper() const
+  {
+    return columnUpper_;
+  }
+  //@}
+
+  /**@name Constructors, destructor */
+  //@{
+  /** Default constructor. */
+  ClpPricingOracle();
+  /** Destructor */
+  virtual ~ClpPricingOracle();
+  /** The copy constructor. */
+  ClpPricingOracle(const ClpPricingOracle &);
+  /// Assignment
+  ClpPricingOracle &operator=(const ClpPricingOracle &);
+  //@}
+
+private:
+  /// Makes sure batch has room
+  void reserve(int numberColumns, CoinBigIndex numberElements);
+  /// Copies batch
+  void copyBatch(const ClpPricingOracle &rhs);
+  /**@name Data members */
+  //@{
+  /// Number of columns in batch
+  int numberColumns_;
+  /// Space for columns
+  int maximumColumns_;
+  /// Space for elements
+  CoinBigIndex maximumElements_;
+  /// Starts of each column
+  CoinBigIndex *startColumn_;
+  /// rows
+  int *row_;
+  /// elements
+  double *element_;
+  /// costs
+  double *cost_;
+  /// sets
+  int *set_;
+  /// upper bounds
+  double *columnUpper_;
+  //@}
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
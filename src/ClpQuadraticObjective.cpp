@@ -8,6 +8,7 @@
 #include "ClpFactorization.hpp"
 #include "ClpSimplex.hpp"
 #include "ClpQuadraticObjective.hpp"
+#include <cstring>
 //#############################################################################
 // Constructors / Destructor / Assignment
 //#############################################################################
@@ -25,6 +26,14 @@ ClpQuadraticObjective::ClpQuadraticObjective()
   numberExtendedColumns_ = 0;
   activated_ = 0;
   fullMatrix_ = false;
+  incremental_ = true;
+  hessianType_ = 0;
+  hessianSolution_ = NULL;
+  lastSolution_ = NULL;
+  lastColumnScale_ = NULL;
+  lastScaleFactor_ = 0.0;
+  numberUpdates_ = -1;
+  rowCopy_ = NULL;
 }
 
 //-------------------------------------------------------------------
@@ -59,6 +68,15 @@ ClpQuadraticObjective::ClpQuadraticObjective(const double *objective,
   gradient_ = NULL;
   activated_ = 1;
   fullMatrix_ = false;
+  incremental_ = true;
+  hessianType_ = 0;
+  hessianSolution_ = NULL;
+  lastSolution_ = NULL;
+  lastColumnScale_ = NULL;
+  lastScaleFactor_ = 0.0;
+  numberUpdates_ = -1;
+  rowCopy_ = NULL;
+  analyzeHessian();
 }
 
 //-------------------------------------------------------------------
@@ -71,6 +89,14 @@ ClpQuadraticObjective::ClpQuadraticObjective(const ClpQuadraticObjective &rhs,
   numberColumns_ = rhs.numberColumns_;
   numberExtendedColumns_ = rhs.numberExtendedColumns_;
   fullMatrix_ = rhs.fullMatrix_;
+  incremental_ = rhs.incremental_;
+  hessianType_ = 0;
+  hessianSolution_ = NULL;
+  lastSolution_ = NULL;
+  lastColumnScale_ = NULL;
+  lastScaleFactor_ = 0.0;
+  numberUpdates_ = -1;
+  rowCopy_ = NULL;
   if (rhs.objective_) {
     objective_ = new double[numberExtendedColumns_];
     CoinMemcpyN(rhs.objective_, numberExtendedColumns_, objective_);
@@ -180,14 +206,50 @@ ClpQuadraticObjective::ClpQuadraticObjective(const ClpQuadraticObjective &rhs,
         delete[] columnQuadratic2;
         delete[] quadraticElement2;
       }
+    } else if (!rhs.fullMatrix_) {
+      // already half
+      quadraticObjective_ = new CoinPackedMatrix(*rhs.quadraticObjective_);
     } else {
+      // keep lower triangle
       fullMatrix_ = false;
-      abort(); // code when needed
+      const int *columnQuadratic1 = rhs.quadraticObjective_->getIndices();
+      const CoinBigIndex *columnQuadraticStart1 = rhs.quadraticObjective_->getVectorStarts();
+      const int *columnQuadraticLength1 = rhs.quadraticObjective_->getVectorLengths();
+      const double *quadraticElement1 = rhs.quadraticObjective_->getElements();
+      int numberColumns = rhs.quadraticObjective_->getNumCols();
+      CoinBigIndex *columnQuadraticStart2 = new CoinBigIndex[numberColumns + 1];
+      int *columnQuadratic2 = new int[rhs.quadraticObjective_->getNumElements()];
+      double *quadraticElement2 = new double[rhs.quadraticObjective_->getNumElements()];
+      CoinBigIndex numberElements = 0;
+      columnQuadraticStart2[0] = 0;
+      for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+        for (CoinBigIndex j = columnQuadraticStart1[iColumn];
+             j < columnQuadraticStart1[iColumn] + columnQuadraticLength1[iColumn]; j++) {
+          int jColumn = columnQuadratic1[j];
+          if (jColumn >= iColumn) {
+            quadraticElement2[numberElements] = quadraticElement1[j];
+            columnQuadratic2[numberElements++] = jColumn;
+          }
+        }
+        columnQuadraticStart2[iColumn + 1] = numberElements;
+      }
+      quadraticObjective_ = new CoinPackedMatrix(true,
+        rhs.quadraticObjective_->getNumRows(),
+        numberColumns,
+        numberElements,
+        quadraticElement2,
+        columnQuadratic2,
+        columnQuadraticStart2,
+        NULL, 0.0, 0.0);
+      delete[] columnQuadraticStart2;
+      delete[] columnQuadratic2;
+      delete[] quadraticElement2;
     }
 
   } else {
     quadraticObjective_ = NULL;
   }
+  analyzeHessian();
 }
 /* Subset constructor.  Duplicates are allowed
    and order is as given.
@@ -198,6 +260,14 @@ ClpQuadraticObjective::ClpQuadraticObjective(const ClpQuadraticObjective &rhs,
   : ClpObjective(rhs)
 {
   fullMatrix_ = rhs.fullMatrix_;
+  incremental_ = rhs.incremental_;
+  hessianType_ = 0;
+  hessianSolution_ = NULL;
+  lastSolution_ = NULL;
+  lastColumnScale_ = NULL;
+  lastScaleFactor_ = 0.0;
+  numberUpdates_ = -1;
+  rowCopy_ = NULL;
   objective_ = NULL;
   int extra = rhs.numberExtendedColumns_ - rhs.numberColumns_;
   numberColumns_ = 0;
@@ -238,6 +308,7 @@ ClpQuadraticObjective::ClpQuadraticObjective(const ClpQuadraticObjective &rhs,
   } else {
     quadraticObjective_ = NULL;
   }
+  analyzeHessian();
 }
 
 //-------------------------------------------------------------------
@@ -248,6 +319,7 @@ ClpQuadraticObjective::~ClpQuadraticObjective()
   delete[] objective_;
   delete[] gradient_;
   delete quadraticObjective_;
+  clearHessianCache();
 }
 
 //----------------------------------------------------------------
@@ -258,6 +330,7 @@ ClpQuadraticObjective::operator=(const ClpQuadraticObjective &rhs)
 {
   if (this != &rhs) {
     fullMatrix_ = rhs.fullMatrix_;
+    incremental_ = rhs.incremental_;
     delete quadraticObjective_;
     quadraticObjective_ = NULL;
     delete[] objective_;
@@ -282,6 +355,7 @@ ClpQuadraticObjective::operator=(const ClpQuadraticObjective &rhs)
     } else {
       quadraticObjective_ = NULL;
     }
+    analyzeHessian();
   }
   return *this;
 }
@@ -311,10 +385,6 @@ ClpQuadraticObjective::gradient(const ClpSimplex *model,
       if (refresh || !gradient_) {
         if (!gradient_)
           gradient_ = new double[numberExtendedColumns_];
-        const int *columnQuadratic = quadraticObjective_->getIndices();
-        const CoinBigIndex *columnQuadraticStart = quadraticObjective_->getVectorStarts();
-        const int *columnQuadraticLength = quadraticObjective_->getVectorLengths();
-        const double *quadraticElement = quadraticObjective_->getElements();
         offset = 0.0;
         // use current linear cost region
         if (includeLinear == 1)
@@ -324,56 +394,13 @@ ClpQuadraticObjective::gradient(const ClpSimplex *model,
         else
           memset(gradient_, 0, numberExtendedColumns_ * sizeof(double));
         if (activated_) {
-          if (!fullMatrix_) {
-            int iColumn;
-            for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-              double valueI = solution[iColumn];
-              CoinBigIndex j;
-              for (j = columnQuadraticStart[iColumn];
-                   j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-                int jColumn = columnQuadratic[j];
-                double valueJ = solution[jColumn];
-                double elementValue = quadraticElement[j];
-                if (iColumn != jColumn) {
-                  offset += valueI * valueJ * elementValue;
-                  //if (fabs(valueI*valueJ*elementValue)>1.0e-12)
-                  //printf("%d %d %g %g %g -> %g\n",
-                  //       iColumn,jColumn,valueI,valueJ,elementValue,
-                  //       valueI*valueJ*elementValue);
-                  double gradientI = valueJ * elementValue;
-                  double gradientJ = valueI * elementValue;
-                  gradient_[iColumn] += gradientI;
-                  gradient_[jColumn] += gradientJ;
-                } else {
-                  offset += 0.5 * valueI * valueI * elementValue;
-                  //if (fabs(valueI*valueI*elementValue)>1.0e-12)
-                  //printf("XX %d %g %g -> %g\n",
-                  //       iColumn,valueI,elementValue,
-                  //       0.5*valueI*valueI*elementValue);
-                  double gradientI = valueI * elementValue;
-                  gradient_[iColumn] += gradientI;
-                }
-              }
-            }
-          } else {
-            // full matrix
-            int iColumn;
-            offset *= 2.0;
-            for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-              CoinBigIndex j;
-              double value = 0.0;
-              double current = gradient_[iColumn];
-              for (j = columnQuadraticStart[iColumn];
-                   j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-                int jColumn = columnQuadratic[j];
-                double valueJ = solution[jColumn] * quadraticElement[j];
-                value += valueJ;
-              }
-              offset += value * solution[iColumn];
-              gradient_[iColumn] = current + value;
-            }
-            offset *= 0.5;
+          const double *hessianSolution = hessianTimesSolution(solution, 1.0, NULL);
+          for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+            double value = hessianSolution[iColumn];
+            offset += value * solution[iColumn];
+            gradient_[iColumn] += value;
           }
+          offset *= 0.5;
         }
       }
       if (model)
@@ -383,8 +410,6 @@ ClpQuadraticObjective::gradient(const ClpSimplex *model,
   } else {
     // do scaling
     assert(solution);
-    // for now only if half
-    assert(!fullMatrix_);
     if (refresh || !gradient_) {
       if (!gradient_)
         gradient_ = new double[numberExtendedColumns_];
@@ -392,10 +417,6 @@ ClpQuadraticObjective::gradient(const ClpSimplex *model,
       // direction is actually scale out not scale in
       //if (direction)
       //direction = 1.0/direction;
-      const int *columnQuadratic = quadraticObjective_->getIndices();
-      const CoinBigIndex *columnQuadraticStart = quadraticObjective_->getVectorStarts();
-      const int *columnQuadraticLength = quadraticObjective_->getVectorLengths();
-      const double *quadraticElement = quadraticObjective_->getElements();
       int iColumn;
       const double *columnScale = model->columnScale();
       // use current linear cost region (already scaled)
@@ -415,64 +436,214 @@ ClpQuadraticObjective::gradient(const ClpSimplex *model,
       } else {
         memset(gradient_, 0, numberExtendedColumns_ * sizeof(double));
       }
-      if (!columnScale) {
-        if (activated_) {
-          for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-            double valueI = solution[iColumn];
-            CoinBigIndex j;
-            for (j = columnQuadraticStart[iColumn];
-                 j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-              int jColumn = columnQuadratic[j];
-              double valueJ = solution[jColumn];
-              double elementValue = quadraticElement[j];
-              elementValue *= direction;
-              if (iColumn != jColumn) {
-                offset += valueI * valueJ * elementValue;
-                double gradientI = valueJ * elementValue;
-                double gradientJ = valueI * elementValue;
-                gradient_[iColumn] += gradientI;
-                gradient_[jColumn] += gradientJ;
-              } else {
-                offset += 0.5 * valueI * valueI * elementValue;
-                double gradientI = valueI * elementValue;
-                gradient_[iColumn] += gradientI;
-              }
-            }
+      if (activated_) {
+        const double *hessianSolution = hessianTimesSolution(solution, direction, columnScale);
+        for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+          double value = hessianSolution[iColumn];
+          offset += value * solution[iColumn];
+          gradient_[iColumn] += value;
+        }
+        offset *= 0.5;
+      }
+    }
+    if (model)
+      offset *= model->optimizationDirection();
+    return gradient_;
+  }
+}
+
+// Full product is done at least this often to stop errors building up
+#define CLP_HESSIAN_REFRESH 50
+/* Returns Hessian times solution with elements multiplied by
+   scaleFactor and column scales (may be NULL).  Updated from last
+   call if only a few values have changed. */
+const double *
+ClpQuadraticObjective::hessianTimesSolution(const double *solution,
+  double scaleFactor, const double *columnScale)
+{
+  const int *columnQuadratic = quadraticObjective_->getIndices();
+  const CoinBigIndex *columnQuadraticStart = quadraticObjective_->getVectorStarts();
+  const int *columnQuadraticLength = quadraticObjective_->getVectorLengths();
+  const double *quadraticElement = quadraticObjective_->getElements();
+  int iColumn;
+  if (!hessianSolution_) {
+    hessianSolution_ = new double[numberExtendedColumns_];
+    CoinZeroN(hessianSolution_ + numberColumns_, numberExtendedColumns_ - numberColumns_);
+  }
+  if (hessianType_ == 1) {
+    // diagonal - just do it
+    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      double value = 0.0;
+      if (columnQuadraticLength[iColumn]) {
+        value = quadraticElement[columnQuadraticStart[iColumn]] * scaleFactor * solution[iColumn];
+        if (columnScale)
+          value *= columnScale[iColumn] * columnScale[iColumn];
+      }
+      hessianSolution_[iColumn] = value;
+    }
+    return hessianSolution_;
+  }
+  // see if can update
+  bool update = incremental_ && numberUpdates_ >= 0 && numberUpdates_ < CLP_HESSIAN_REFRESH && scaleFactor == lastScaleFactor_ && (columnScale != NULL) == (lastColumnScale_ != NULL);
+  if (update && columnScale)
+    update = !memcmp(columnScale, lastColumnScale_, numberColumns_ * sizeof(double));
+  const CoinBigIndex *rowStart = NULL;
+  const int *rowLength = NULL;
+  const int *rowColumn = NULL;
+  const double *rowElement = NULL;
+  if (rowCopy_) {
+    rowStart = rowCopy_->getVectorStarts();
+    rowLength = rowCopy_->getVectorLengths();
+    rowColumn = rowCopy_->getIndices();
+    rowElement = rowCopy_->getElements();
+  }
+  if (update) {
+    // only worth it if much less work than full product
+    CoinBigIndex work = 0;
+    CoinBigIndex maximumWork = quadraticObjective_->getNumElements() >> 1;
+    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      if (solution[iColumn] != lastSolution_[iColumn]) {
+        work += columnQuadraticLength[iColumn];
+        if (rowCopy_)
+          work += rowLength[iColumn];
+        if (work > maximumWork) {
+          update = false;
+          break;
+        }
+      }
+    }
+  }
+  if (update) {
+    numberUpdates_++;
+    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      double change = solution[iColumn] - lastSolution_[iColumn];
+      if (change) {
+        lastSolution_[iColumn] = solution[iColumn];
+        change *= scaleFactor;
+        if (columnScale)
+          change *= columnScale[iColumn];
+        CoinBigIndex j;
+        if (!columnScale) {
+          for (j = columnQuadraticStart[iColumn];
+               j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
+            int jColumn = columnQuadratic[j];
+            hessianSolution_[jColumn] += change * quadraticElement[j];
+          }
+        } else {
+          for (j = columnQuadraticStart[iColumn];
+               j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
+            int jColumn = columnQuadratic[j];
+            hessianSolution_[jColumn] += change * quadraticElement[j] * columnScale[jColumn];
           }
         }
-      } else {
-        // scaling
-        if (activated_) {
-          for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
-            double valueI = solution[iColumn];
-            double scaleI = columnScale[iColumn] * direction;
-            CoinBigIndex j;
-            for (j = columnQuadraticStart[iColumn];
-                 j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
-              int jColumn = columnQuadratic[j];
-              double valueJ = solution[jColumn];
-              double elementValue = quadraticElement[j];
-              double scaleJ = columnScale[jColumn];
-              elementValue *= scaleI * scaleJ;
-              if (iColumn != jColumn) {
-                offset += valueI * valueJ * elementValue;
-                double gradientI = valueJ * elementValue;
-                double gradientJ = valueI * elementValue;
-                gradient_[iColumn] += gradientI;
-                gradient_[jColumn] += gradientJ;
-              } else {
-                offset += 0.5 * valueI * valueI * elementValue;
-                double gradientI = valueI * elementValue;
-                gradient_[iColumn] += gradientI;
-              }
+        if (rowCopy_) {
+          // half matrix - elements of other columns in this row
+          for (j = rowStart[iColumn]; j < rowStart[iColumn] + rowLength[iColumn]; j++) {
+            int jColumn = rowColumn[j];
+            if (jColumn != iColumn && jColumn < numberColumns_) {
+              double value = change * rowElement[j];
+              if (columnScale)
+                value *= columnScale[jColumn];
+              hessianSolution_[jColumn] += value;
             }
           }
         }
       }
     }
-    if (model)
-      offset *= model->optimizationDirection();
-    return gradient_;
+    return hessianSolution_;
+  }
+  // full product
+  CoinZeroN(hessianSolution_, numberColumns_);
+  if (!fullMatrix_) {
+    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      double valueI = solution[iColumn];
+      double scaleI = scaleFactor;
+      if (columnScale)
+        scaleI *= columnScale[iColumn];
+      double value = 0.0;
+      CoinBigIndex j;
+      for (j = columnQuadraticStart[iColumn];
+           j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
+        int jColumn = columnQuadratic[j];
+        double elementValue = quadraticElement[j] * scaleI;
+        if (columnScale)
+          elementValue *= columnScale[jColumn];
+        value += solution[jColumn] * elementValue;
+        if (iColumn != jColumn)
+          hessianSolution_[jColumn] += valueI * elementValue;
+      }
+      hessianSolution_[iColumn] += value;
+    }
+  } else {
+    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      double scaleI = scaleFactor;
+      if (columnScale)
+        scaleI *= columnScale[iColumn];
+      double value = 0.0;
+      CoinBigIndex j;
+      if (!columnScale) {
+        for (j = columnQuadraticStart[iColumn];
+             j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
+          int jColumn = columnQuadratic[j];
+          value += solution[jColumn] * quadraticElement[j];
+        }
+      } else {
+        for (j = columnQuadraticStart[iColumn];
+             j < columnQuadraticStart[iColumn] + columnQuadraticLength[iColumn]; j++) {
+          int jColumn = columnQuadratic[j];
+          value += solution[jColumn] * quadraticElement[j] * columnScale[jColumn];
+        }
+      }
+      hessianSolution_[iColumn] = value * scaleI;
+    }
+  }
+  if (incremental_) {
+    // save for next time
+    if (!lastSolution_)
+      lastSolution_ = new double[numberColumns_];
+    CoinMemcpyN(solution, numberColumns_, lastSolution_);
+    delete[] lastColumnScale_;
+    lastColumnScale_ = CoinCopyOfArray(columnScale, numberColumns_);
+    lastScaleFactor_ = scaleFactor;
+    numberUpdates_ = 0;
+    if (!fullMatrix_ && !rowCopy_) {
+      rowCopy_ = new CoinPackedMatrix();
+      rowCopy_->reverseOrderedCopyOf(*quadraticObjective_);
+    }
+  }
+  return hessianSolution_;
+}
+// Throws away cached Hessian times solution
+void ClpQuadraticObjective::clearHessianCache()
+{
+  delete[] hessianSolution_;
+  delete[] lastSolution_;
+  delete[] lastColumnScale_;
+  delete rowCopy_;
+  hessianSolution_ = NULL;
+  lastSolution_ = NULL;
+  lastColumnScale_ = NULL;
+  rowCopy_ = NULL;
+  numberUpdates_ = -1;
+}
+// Sees if diagonal and throws away cache
+void ClpQuadraticObjective::analyzeHessian()
+{
+  clearHessianCache();
+  hessianType_ = 0;
+  if (quadraticObjective_) {
+    const int *columnQuadratic = quadraticObjective_->getIndices();
+    const CoinBigIndex *columnQuadraticStart = quadraticObjective_->getVectorStarts();
+    const int *columnQuadraticLength = quadraticObjective_->getVectorLengths();
+    int numberColumns = CoinMin(numberColumns_, quadraticObjective_->getNumCols());
+    hessianType_ = 1;
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      int length = columnQuadraticLength[iColumn];
+      if (length > 1 || (length && columnQuadratic[columnQuadraticStart[iColumn]] != iColumn)) {
+        hessianType_ = 0;
+        break;
+      }
+    }
   }
 }
 
@@ -529,6 +700,7 @@ void ClpQuadraticObjective::resize(int newNumberColumns)
     }
     numberColumns_ = newNumberColumns;
     numberExtendedColumns_ = newExtended;
+    analyzeHessian();
   }
 }
 // Delete columns in  objective
@@ -596,6 +768,7 @@ void ClpQuadraticObjective::deleteSome(int numberToDelete, const int *which)
     quadraticObjective_->deleteCols(numberToDelete, which);
     quadraticObjective_->deleteRows(numberToDelete, which);
   }
+  analyzeHessian();
 }
 
 // Load up quadratic objective
@@ -628,17 +801,25 @@ void ClpQuadraticObjective::loadQuadraticObjective(const int numberColumns, cons
   } else {
     numberExtendedColumns_ = numberColumns_;
   }
+  analyzeHessian();
 }
 void ClpQuadraticObjective::loadQuadraticObjective(const CoinPackedMatrix &matrix)
 {
   delete quadraticObjective_;
   quadraticObjective_ = new CoinPackedMatrix(matrix);
+  analyzeHessian();
 }
 // Get rid of quadratic objective
 void ClpQuadraticObjective::deleteQuadraticObjective()
 {
   delete quadraticObjective_;
   quadraticObjective_ = NULL;
+  analyzeHessian();
+}
+// Must be called if quadratic objective modified in place
+void ClpQuadraticObjective::hessianChanged()
+{
+  analyzeHessian();
 }
 /* Returns reduced gradient.Returns an offset (to be added to current one).
  */
@@ -760,7 +941,30 @@ ClpQuadraticObjective::stepLength(ClpSimplex *model,
   double a = 0.0;
   double b = delta;
   double c = 0.0;
-  if (!scaling) {
+  if (hessianType_ == 1) {
+    // diagonal
+    const double *columnScale = NULL;
+    double direction = 1.0;
+    if (scaling) {
+      columnScale = model->columnScale();
+      direction = model->optimizationDirection() * model->objectiveScale();
+      // direction is actually scale out not scale in
+      if (direction)
+        direction = 1.0 / direction;
+    }
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      if (columnQuadraticLength[iColumn]) {
+        double valueI = solution[iColumn];
+        double changeI = change[iColumn];
+        double elementValue = quadraticElement[columnQuadraticStart[iColumn]] * direction;
+        if (columnScale)
+          elementValue *= columnScale[iColumn] * columnScale[iColumn];
+        a += 0.5 * changeI * changeI * elementValue;
+        b += changeI * valueI * elementValue;
+        c += 0.5 * valueI * valueI * elementValue;
+      }
+    }
+  } else if (!scaling) {
     if (!fullMatrix_) {
       int iColumn;
       for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
@@ -915,7 +1119,27 @@ ClpQuadraticObjective::objectiveValue(const ClpSimplex *model, const double *sol
   const int *columnQuadraticLength = quadraticObjective_->getVectorLengths();
   const double *quadraticElement = quadraticObjective_->getElements();
   double c = 0.0;
-  if (!scaling) {
+  if (hessianType_ == 1) {
+    // diagonal
+    const double *columnScale = NULL;
+    double direction = 1.0;
+    if (scaling) {
+      columnScale = model->columnScale();
+      direction = model->objectiveScale();
+      // direction is actually scale out not scale in
+      if (direction)
+        direction = 1.0 / direction;
+    }
+    for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      if (columnQuadraticLength[iColumn]) {
+        double valueI = solution[iColumn];
+        double elementValue = quadraticElement[columnQuadraticStart[iColumn]] * direction;
+        if (columnScale)
+          elementValue *= columnScale[iColumn] * columnScale[iColumn];
+        c += 0.5 * valueI * valueI * elementValue;
+      }
+    }
+  } else if (!scaling) {
     if (!fullMatrix_) {
       int iColumn;
       for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
@@ -1017,6 +1241,7 @@ void ClpQuadraticObjective::reallyScale(const double *columnScale)
       quadraticElement[j] *= scaleI * columnScale[jColumn];
     }
   }
+  clearHessianCache();
 }
 /* Given a zeroed array sets nonlinear columns to 1.
    Returns number of nonlinear columns
@@ -73,7 +73,7 @@ public:
     int numberExtendedColumns_ = -1);
 
   /** Copy constructor .
-         If type is -1 then make sure half symmetric,
+         If type is -1 then make sure half symmetric (lower triangle kept),
          if +1 then make sure full
      */
   ClpQuadraticObjective(const ClpQuadraticObjective &rhs, int type = 0);
@@ -105,6 +105,9 @@ public:
   void loadQuadraticObjective(const CoinPackedMatrix &matrix);
   /// Get rid of quadratic objective
   void deleteQuadraticObjective();
+  /** Must be called if quadratic objective is modified in place
+         (so cached Hessian times solution is thrown away) */
+  void hessianChanged();
   //@}
   ///@name Gets and sets
   //@{
@@ -133,11 +136,39 @@ public:
   {
     return fullMatrix_;
   }
+  /// If quadratic objective is diagonal
+  inline bool diagonalHessian() const
+  {
+    return hessianType_ == 1;
+  }
+  /** If gradient is updated using only columns whose solution
+         values changed since last call (default true) */
+  inline bool incrementalGradient() const
+  {
+    return incremental_;
+  }
+  inline void setIncrementalGradient(bool yesNo)
+  {
+    incremental_ = yesNo;
+    clearHessianCache();
+  }
   //@}
 
   //---------------------------------------------------------------------------
 
 private:
+  ///@name Private methods
+  //@{
+  /** Returns Hessian times solution with elements multiplied by
+         scaleFactor and column scales (may be NULL).  Updated from last
+         call if only a few values have changed. */
+  const double *hessianTimesSolution(const double *solution,
+    double scaleFactor, const double *columnScale);
+  /// Throws away cached Hessian times solution
+  void clearHessianCache();
+  /// Sees if diagonal and throws away cache
+  void analyzeHessian();
+  //@}
   ///@name Private member data
   /// Quadratic objective
   CoinPackedMatrix *quadraticObjective_;
@@ -151,6 +182,22 @@ private:
   int numberExtendedColumns_;
   /// True if full symmetric matrix, false if half
   bool fullMatrix_;
+  /// True if gradient updated incrementally
+  bool incremental_;
+  /// 0 general, 1 diagonal only
+  int hessianType_;
+  /// Hessian times solution as at lastSolution_
+  double *hessianSolution_;
+  /// Solution used for hessianSolution_
+  double *lastSolution_;
+  /// Column scales used for hessianSolution_ (or NULL)
+  double *lastColumnScale_;
+  /// Scale factor used for hessianSolution_
+  double lastScaleFactor_;
+  /// Number of incremental updates since full product (-1 if not valid)
+  int numberUpdates_;
+  /// Row copy of half matrix for updates
+  CoinPackedMatrix *rowCopy_;
   //@}
 };
 
@@ -2613,6 +2613,33 @@ ClpSimplex::operator=(const ClpSimplex &rhs)
   }
   return *this;
 }
+// Copy sharing packed matrices
+ClpSimplex *
+ClpSimplex::sharedClone() const
+{
+  ClpSimplex *model = const_cast< ClpSimplex * >(this);
+  ClpMatrixBase *saveMatrix = matrix_;
+  ClpMatrixBase *saveRowCopy = rowCopy_;
+  ClpPackedMatrix *saveScaledMatrix = scaledMatrix_;
+  // make sure packed matrices are not copied
+  if (matrix_ && matrix_->type() == 1)
+    model->matrix_ = NULL;
+  if (rowCopy_ && rowCopy_->type() == 1)
+    model->rowCopy_ = NULL;
+  if (scaledMatrix_ && scaledMatrix_->type() == 1)
+    model->scaledMatrix_ = NULL;
+  ClpSimplex *copy = new ClpSimplex(*this);
+  model->matrix_ = saveMatrix;
+  model->rowCopy_ = saveRowCopy;
+  model->scaledMatrix_ = saveScaledMatrix;
+  if (!copy->matrix_ && matrix_)
+    copy->matrix_ = static_cast< ClpPackedMatrix * >(matrix_)->sharedClone();
+  if (!copy->rowCopy_ && rowCopy_)
+    copy->rowCopy_ = static_cast< ClpPackedMatrix * >(rowCopy_)->sharedClone();
+  if (!copy->scaledMatrix_ && scaledMatrix_)
+    copy->scaledMatrix_ = scaledMatrix_->sharedClone();
+  return copy;
+}
 void ClpSimplex::gutsOfCopy(const ClpSimplex &rhs)
 {
   assert(numberRows_ == rhs.numberRows_);
@@ -3499,6 +3526,14 @@ bool ClpSimplex::createRim(int what, bool makeRowCopy, int startFinishOptions)
     // We may want to switch stuff off for speed
     if ((specialOptions_ & 256) != 0)
       makeRowCopy = false; // no row copy
+    if ((specialOptions_ & 0x08000000) != 0) {
+      // save memory - only column copy (scaled on fly)
+      makeRowCopy = false;
+      if (!oldMatrix) {
+        delete rowCopy_;
+        rowCopy_ = NULL;
+      }
+    }
     if ((specialOptions_ & 128) != 0)
       doSanityCheck = false; // no sanity check
     //check matrix
@@ -6315,6 +6350,18 @@ int ClpSimplex::readBasis(const char *filename)
 {
   return static_cast< ClpSimplexOther * >(this)->readBasis(filename);
 }
+// Write a basis in binary form
+int ClpSimplex::writeBasisBinary(const char *filename,
+  bool writeValues) const
+{
+  return static_cast< const ClpSimplexOther * >(this)->writeBasisBinary(filename, writeValues);
+}
+// Read a binary basis
+int ClpSimplex::readBasisBinary(const char *filename,
+  bool checkFingerprint)
+{
+  return static_cast< ClpSimplexOther * >(this)->readBasisBinary(filename, checkFingerprint);
+}
 #include "ClpSimplexNonlinear.hpp"
 /* Solves nonlinear problem using SLP - may be used as crash
    for other algorithms when number of iterations small
@@ -6356,6 +6403,12 @@ int ClpSimplex::reducedGradient(int phase)
   int returnCode = static_cast< ClpSimplexNonlinear * >(this)->primal();
   return returnCode;
 }
+#include "ClpSimplexNetwork.hpp"
+// Solves pure network by network simplex
+int ClpSimplex::networkSolve()
+{
+  return static_cast< ClpSimplexNetwork * >(this)->networkSolve();
+}
 #include "ClpPredictorCorrector.hpp"
 #include "ClpCholeskyBase.hpp"
 // Preference is PARDISO, WSSMP, UFL (just ordering), MUMPS, TAUCS then base
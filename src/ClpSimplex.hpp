@@ -217,6 +217,15 @@ public:
   void setToBaseModel(ClpSimplex *model = NULL);
   /// Assignment operator. This copies the data
   ClpSimplex &operator=(const ClpSimplex &rhs);
+  /** Copy for forks (strong branching, concurrent or what-if solves).
+      As copy constructor except that the matrix, row copy and scaled
+      matrix (if ClpPackedMatrix) use the same elements as this model
+      until one of the models changes them (copy on write - see
+      ClpPackedMatrix::sharedClone).  Bounds, objective, status and
+      solution are copied as usual.  Should not be called for one model
+      on several threads at once.
+  */
+  ClpSimplex *sharedClone() const;
   /// Destructor
   ~ClpSimplex();
   // Ones below are just ClpModel with some changes
@@ -362,8 +371,14 @@ public:
   /** Solves non-linear using reduced gradient.  Phase = 0 get feasible,
          =1 use solution */
   int reducedGradient(int phase = 0);
+  /** Solves pure network (min cost flow) by network simplex -
+         see ClpSimplexNetwork.hpp.  If not a pure network uses dual. */
+  int networkSolve();
   /// Solve using structure of model and maybe in parallel
   int solve(CoinStructuredModel *model);
+  /** Solve using structure of model and maybe in parallel.
+         options can set number of passes and Benders options */
+  int solve(CoinStructuredModel *model, const ClpSolve &options);
 #ifdef ABC_INHERIT
   /** solvetype 0 for dual, 1 for primal
       startup 1 for values pass
@@ -515,9 +530,19 @@ public:
   int writeBasis(const char *filename,
     bool writeValues = false,
     int formatType = 0) const;
-  /** Read a basis from the given filename,
-         returns -1 on file error, 0 if no values, 1 if values */
+  /** Read a basis from the given filename (binary basis files are
+         recognized), returns -1 on file error, 0 if no values, 1 if values */
   int readBasis(const char *filename);
+  /** Write a basis in compact binary form - status of each variable in
+         two bits, a fingerprint of the matrix and optionally column
+         values and duals.  Returns non-zero on I/O error */
+  int writeBasisBinary(const char *filename,
+    bool writeValues = false) const;
+  /** Read a basis written by writeBasisBinary.  Returns -1 on file
+         error, -2 if basis is not for this model (if checkFingerprint
+         then matrix structure must match), 0 if no values, 1 if values */
+  int readBasisBinary(const char *filename,
+    bool checkFingerprint = true);
   /// Returns a basis (to be deleted by user)
   CoinWarmStartBasis *getBasis() const;
   /// Passes in factorization
@@ -557,7 +582,8 @@ public:
   void setDualRowPivotAlgorithm(ClpDualRowPivot &choice);
   /// Sets column pivot choice algorithm in primal
   void setPrimalColumnPivotAlgorithm(ClpPrimalColumnPivot &choice);
-  /// Create a hotstart point of the optimization process
+  /** Create a hotstart point of the optimization process
+      (see ClpSnapshotPool for keeping many saved bases) */
   void markHotStart(void *&saveStuff);
   /// Optimize starting from the hotstart
   void solveFromHotStart(void *saveStuff);
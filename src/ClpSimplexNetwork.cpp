@@ -0,0 +1,638 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinPragma.hpp"
+
+#include <math.h>
+
+#include "CoinHelperFunctions.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "ClpSimplexNetwork.hpp"
+#include "ClpNetworkMatrix.hpp"
+#include "ClpObjective.hpp"
+#include "ClpMessage.hpp"
+#include <cassert>
+#include <stdio.h>
+
+/* Arcs and spanning tree for network simplex.
+   Nodes are rows and root (numberRows).  Arcs are columns, then a slack
+   arc from each row to root with row activity as flow, then an
+   artificial arc between each row and root.
+   Reduced cost of arc is cost + pi[tail] - pi[head].
+   Thread is preorder of tree (circular through root), lastSucc is
+   last node of subtree in that order and succNum is size of subtree. */
+typedef struct {
+  int numberNodes_;
+  int numberArcs_;
+  int root_;
+  int *tail_;
+  int *head_;
+  double *lower_;
+  double *upper_;
+  double *cost_;
+  double *flow_;
+  char *inTree_;
+  int *parent_;
+  int *predArc_;
+  int *succNum_;
+  int *thread_;
+  int *revThread_;
+  int *lastSucc_;
+  double *pi_;
+  // work array for moving a subtree
+  int *dirty_;
+  // pricing
+  int nextArc_;
+  int blockSize_;
+  double primalTolerance_;
+  double dualTolerance_;
+} ClpNetworkTree;
+
+// Recomputes all potentials going down thread from root
+static void networkPotentials(ClpNetworkTree &tree)
+{
+  const int *parent = tree.parent_;
+  const int *predArc = tree.predArc_;
+  const int *tail = tree.tail_;
+  const double *cost = tree.cost_;
+  double *pi = tree.pi_;
+  int root = tree.root_;
+  pi[root] = 0.0;
+  for (int iNode = tree.thread_[root]; iNode != root; iNode = tree.thread_[iNode]) {
+    int iArc = predArc[iNode];
+    int iParent = parent[iNode];
+    if (tail[iArc] == iParent)
+      pi[iNode] = pi[iParent] + cost[iArc];
+    else
+      pi[iNode] = pi[iParent] - cost[iArc];
+  }
+}
+
+/* Block search pricing - returns best arc in first block with an
+   eligible arc (or -1 if optimal) */
+static int networkEntering(ClpNetworkTree &tree)
+{
+  const int *tail = tree.tail_;
+  const int *head = tree.head_;
+  const double *lower = tree.lower_;
+  const double *upper = tree.upper_;
+  const double *cost = tree.cost_;
+  const double *flow = tree.flow_;
+  const char *inTree = tree.inTree_;
+  const double *pi = tree.pi_;
+  int numberArcs = tree.numberArcs_;
+  double primalTolerance = tree.primalTolerance_;
+  double best = -tree.dualTolerance_;
+  int bestArc = -1;
+  int iArc = tree.nextArc_;
+  int numberInBlock = 0;
+  for (int i = 0; i < numberArcs; i++) {
+    if (!inTree[iArc]) {
+      double dj = cost[iArc] + pi[tail[iArc]] - pi[head[iArc]];
+      double value = flow[iArc];
+      if (dj < best) {
+        if (value < upper[iArc] - primalTolerance) {
+          best = dj;
+          bestArc = iArc;
+        }
+      } else if (-dj < best) {
+        if (value > lower[iArc] + primalTolerance) {
+          best = -dj;
+          bestArc = iArc;
+        }
+      }
+    }
+    iArc++;
+    if (iArc == numberArcs)
+      iArc = 0;
+    numberInBlock++;
+    if (numberInBlock == tree.blockSize_) {
+      if (bestArc >= 0)
+        break;
+      numberInBlock = 0;
+    }
+  }
+  tree.nextArc_ = iArc;
+  return bestArc;
+}
+
+/* Moves subtree below uOut so it hangs from vIn by arc in with uIn
+   (in subtree) as new top.  Only stem (path from uIn up to uOut) and
+   paths up to join are looked at for tree structure.  Potentials
+   of subtree all change by same amount (or rest of tree by minus that
+   amount if smaller, so root need not have zero potential). */
+static void networkUpdateTree(ClpNetworkTree &tree, int in,
+  int uIn, int vIn, int uOut, int join)
+{
+  int *parent = tree.parent_;
+  int *predArc = tree.predArc_;
+  int *succNum = tree.succNum_;
+  int *thread = tree.thread_;
+  int *revThread = tree.revThread_;
+  int *lastSucc = tree.lastSucc_;
+  int *dirty = tree.dirty_;
+  int oldRevThread = revThread[uOut];
+  int oldSuccNum = succNum[uOut];
+  int oldLastSucc = lastSucc[uOut];
+  int vOut = parent[uOut];
+  if (uIn == uOut) {
+    parent[uIn] = vIn;
+    predArc[uIn] = in;
+    if (thread[vIn] != uOut) {
+      // move subtree in thread to after vIn
+      int after = thread[oldLastSucc];
+      thread[oldRevThread] = after;
+      revThread[after] = oldRevThread;
+      after = thread[vIn];
+      thread[vIn] = uOut;
+      revThread[uOut] = vIn;
+      thread[oldLastSucc] = after;
+      revThread[after] = oldLastSucc;
+    }
+  } else {
+    // if oldRevThread is vIn then join is vOut
+    int threadContinue = oldRevThread == vIn ? thread[oldLastSucc] : thread[vIn];
+    // go up stem putting each node (and its subtree less stem) in thread
+    int stem = uIn;
+    int parentStem = vIn;
+    int last = lastSucc[uIn];
+    int after = thread[last];
+    int numberDirty = 0;
+    thread[vIn] = uIn;
+    dirty[numberDirty++] = vIn;
+    while (stem != uOut) {
+      int nextStem = parent[stem];
+      thread[last] = nextStem;
+      dirty[numberDirty++] = last;
+      // take subtree of stem out of thread
+      int before = revThread[stem];
+      thread[before] = after;
+      revThread[after] = before;
+      parent[stem] = parentStem;
+      parentStem = stem;
+      stem = nextStem;
+      last = lastSucc[stem] == lastSucc[parentStem] ? revThread[parentStem] : lastSucc[stem];
+      after = thread[last];
+    }
+    parent[uOut] = parentStem;
+    thread[last] = threadContinue;
+    revThread[threadContinue] = last;
+    lastSucc[uOut] = last;
+    if (oldRevThread != vIn) {
+      thread[oldRevThread] = after;
+      revThread[after] = oldRevThread;
+    }
+    for (int i = 0; i < numberDirty; i++) {
+      int iNode = dirty[i];
+      revThread[thread[iNode]] = iNode;
+    }
+    // arcs, subtree sizes and last successors down stem
+    int numberSucc = 0;
+    int lastOut = lastSucc[uOut];
+    for (int iNode = uOut, iParent = parent[iNode]; iNode != uIn;
+         iNode = iParent, iParent = parent[iNode]) {
+      predArc[iNode] = predArc[iParent];
+      numberSucc += succNum[iNode] - succNum[iParent];
+      succNum[iNode] = numberSucc;
+      lastSucc[iParent] = lastOut;
+    }
+    predArc[uIn] = in;
+    succNum[uIn] = oldSuccNum;
+  }
+  // last successors and subtree sizes up to join
+  int upLimitOut = lastSucc[join] == vIn ? join : -1;
+  int lastSuccOut = lastSucc[uOut];
+  for (int iNode = vIn; iNode >= 0 && lastSucc[iNode] == vIn; iNode = parent[iNode])
+    lastSucc[iNode] = lastSuccOut;
+  if (join != oldRevThread && vIn != oldRevThread) {
+    for (int iNode = vOut; iNode != upLimitOut && lastSucc[iNode] == oldLastSucc;
+         iNode = parent[iNode])
+      lastSucc[iNode] = oldRevThread;
+  } else if (lastSuccOut != oldLastSucc) {
+    for (int iNode = vOut; iNode != upLimitOut && lastSucc[iNode] == oldLastSucc;
+         iNode = parent[iNode])
+      lastSucc[iNode] = lastSuccOut;
+  }
+  for (int iNode = vIn; iNode != join; iNode = parent[iNode])
+    succNum[iNode] += oldSuccNum;
+  for (int iNode = vOut; iNode != join; iNode = parent[iNode])
+    succNum[iNode] -= oldSuccNum;
+  // potentials
+  const double *cost = tree.cost_;
+  double *pi = tree.pi_;
+  double newPi = (tree.tail_[in] == vIn) ? pi[vIn] + cost[in] : pi[vIn] - cost[in];
+  double shift = newPi - pi[uIn];
+  int end = thread[lastSucc[uIn]];
+  if (2 * succNum[uIn] <= tree.numberNodes_) {
+    for (int iNode = uIn; iNode != end; iNode = thread[iNode])
+      pi[iNode] += shift;
+  } else {
+    // cheaper to move rest of tree the other way
+    for (int iNode = end; iNode != uIn; iNode = thread[iNode])
+      pi[iNode] -= shift;
+  }
+}
+
+/* Does up to maximumPivots iterations.
+   Returns 0 optimal, 2 unbounded, 3 stopped */
+static int networkIterate(ClpNetworkTree &tree, int maximumPivots,
+  int &numberIterations)
+{
+  const int *tail = tree.tail_;
+  const int *head = tree.head_;
+  const double *lower = tree.lower_;
+  const double *upper = tree.upper_;
+  double *flow = tree.flow_;
+  char *inTree = tree.inTree_;
+  const int *parent = tree.parent_;
+  const int *predArc = tree.predArc_;
+  const int *succNum = tree.succNum_;
+  const double *pi = tree.pi_;
+  const double *cost = tree.cost_;
+  // potentials are shifted at each pivot so refresh
+  networkPotentials(tree);
+  for (int iPivot = 0; iPivot < maximumPivots; iPivot++) {
+    int in = networkEntering(tree);
+    if (in < 0)
+      return 0;
+    numberIterations++;
+    double dj = cost[in] + pi[tail[in]] - pi[head[in]];
+    // if increasing flow goes round from head to tail in tree
+    bool increase = dj < 0.0;
+    int from = increase ? head[in] : tail[in];
+    int to = increase ? tail[in] : head[in];
+    // join
+    int iNode = from;
+    int jNode = to;
+    while (iNode != jNode) {
+      if (succNum[iNode] < succNum[jNode])
+        iNode = parent[iNode];
+      else
+        jNode = parent[jNode];
+    }
+    int join = iNode;
+    /* ratio test - ties broken so as to keep tree strongly feasible
+       (last blocking arc going round cycle from join) */
+    double delta = upper[in] - lower[in];
+    int uOut = -1;
+    int side = 0;
+    for (iNode = to; iNode != join; iNode = parent[iNode]) {
+      // flow goes from parent to iNode
+      int iArc = predArc[iNode];
+      double room = (tail[iArc] == parent[iNode]) ? upper[iArc] - flow[iArc] : flow[iArc] - lower[iArc];
+      if (room < delta) {
+        delta = room;
+        uOut = iNode;
+        side = 1;
+      }
+    }
+    for (iNode = from; iNode != join; iNode = parent[iNode]) {
+      // flow goes from iNode to parent
+      int iArc = predArc[iNode];
+      double room = (tail[iArc] == iNode) ? upper[iArc] - flow[iArc] : flow[iArc] - lower[iArc];
+      if (room <= delta) {
+        delta = room;
+        uOut = iNode;
+        side = 2;
+      }
+    }
+    if (delta >= 1.0e30)
+      return 2;
+    delta = CoinMax(delta, 0.0);
+    // change flows
+    if (delta) {
+      flow[in] += increase ? delta : -delta;
+      for (iNode = to; iNode != join; iNode = parent[iNode]) {
+        int iArc = predArc[iNode];
+        flow[iArc] += (tail[iArc] == parent[iNode]) ? delta : -delta;
+      }
+      for (iNode = from; iNode != join; iNode = parent[iNode]) {
+        int iArc = predArc[iNode];
+        flow[iArc] += (tail[iArc] == iNode) ? delta : -delta;
+      }
+    }
+    if (!side) {
+      // just goes to other bound
+      flow[in] = increase ? upper[in] : lower[in];
+      continue;
+    }
+    // leaving arc goes exactly to bound
+    int out = predArc[uOut];
+    bool outUp = (side == 1) ? (tail[out] == parent[uOut]) : (tail[out] == uOut);
+    flow[out] = outUp ? upper[out] : lower[out];
+    inTree[out] = 0;
+    inTree[in] = 1;
+    int uIn = (side == 1) ? to : from;
+    int vIn = (side == 1) ? from : to;
+    networkUpdateTree(tree, in, uIn, vIn, uOut, join);
+  }
+  return 3;
+}
+
+/* Gets tail and head of each column (numberRows for root).
+   Returns false if not a network. */
+static bool networkArcs(const ClpSimplex *model, int *tail, int *head)
+{
+  int numberRows = model->numberRows();
+  int numberColumns = model->numberColumns();
+  ClpMatrixBase *matrix = model->clpMatrix();
+#ifndef NO_RTTI
+  ClpNetworkMatrix *network = dynamic_cast< ClpNetworkMatrix * >(matrix);
+#else
+  ClpNetworkMatrix *network = NULL;
+  if (matrix->type() == 11)
+    network = static_cast< ClpNetworkMatrix * >(matrix);
+#endif
+  if (network) {
+    const int *indices = network->indices();
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      int iRow = indices[2 * iColumn];
+      tail[iColumn] = iRow >= 0 ? iRow : numberRows;
+      iRow = indices[2 * iColumn + 1];
+      head[iColumn] = iRow >= 0 ? iRow : numberRows;
+    }
+    return true;
+  }
+  const CoinPackedMatrix *packed = matrix->getPackedMatrix();
+  if (!packed || !packed->isColOrdered())
+    return false;
+  const int *row = packed->getIndices();
+  const CoinBigIndex *columnStart = packed->getVectorStarts();
+  const int *columnLength = packed->getVectorLengths();
+  const double *element = packed->getElements();
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    int iTail = numberRows;
+    int iHead = numberRows;
+    for (CoinBigIndex j = columnStart[iColumn];
+         j < columnStart[iColumn] + columnLength[iColumn]; j++) {
+      double value = element[j];
+      if (!value)
+        continue;
+      if (fabs(value - 1.0) < 1.0e-10 && iHead == numberRows) {
+        iHead = row[j];
+      } else if (fabs(value + 1.0) < 1.0e-10 && iTail == numberRows) {
+        iTail = row[j];
+      } else {
+        return false;
+      }
+    }
+    tail[iColumn] = iTail;
+    head[iColumn] = iHead;
+  }
+  return true;
+}
+
+// Returns true if model is a pure network
+bool ClpSimplexNetwork::isNetwork() const
+{
+  if (!numberRows_ || !matrix_ || !objective_ || objective_->type() != 1)
+    return false;
+  int *arcs = new int[2 * numberColumns_];
+  bool network = networkArcs(this, arcs, arcs + numberColumns_);
+  delete[] arcs;
+  return network;
+}
+
+// Solves by network simplex
+int ClpSimplexNetwork::networkSolve()
+{
+  if (!numberRows_ || !matrix_ || !objective_ || objective_->type() != 1)
+    return dual();
+  int numberNodes = numberRows_ + 1;
+  int root = numberRows_;
+  int numberArcs = numberColumns_ + 2 * numberRows_;
+  ClpNetworkTree tree;
+  tree.numberNodes_ = numberNodes;
+  tree.numberArcs_ = numberArcs;
+  tree.root_ = root;
+  tree.tail_ = new int[2 * numberArcs];
+  tree.head_ = tree.tail_ + numberArcs;
+  if (!networkArcs(this, tree.tail_, tree.head_)) {
+    delete[] tree.tail_;
+    handler_->message(CLP_GENERAL, messages_)
+      << "Not a pure network - using dual simplex"
+      << CoinMessageEol;
+    return dual();
+  }
+  tree.lower_ = new double[5 * numberArcs + numberNodes];
+  tree.upper_ = tree.lower_ + numberArcs;
+  tree.cost_ = tree.upper_ + numberArcs;
+  tree.flow_ = tree.cost_ + numberArcs;
+  double *phase2Cost = tree.flow_ + numberArcs;
+  tree.pi_ = phase2Cost + numberArcs;
+  tree.inTree_ = new char[numberArcs];
+  tree.parent_ = new int[7 * numberNodes];
+  tree.predArc_ = tree.parent_ + numberNodes;
+  tree.succNum_ = tree.predArc_ + numberNodes;
+  tree.thread_ = tree.succNum_ + numberNodes;
+  tree.revThread_ = tree.thread_ + numberNodes;
+  tree.lastSucc_ = tree.revThread_ + numberNodes;
+  tree.dirty_ = tree.lastSucc_ + numberNodes;
+  tree.nextArc_ = 0;
+  tree.blockSize_ = CoinMax(10, static_cast< int >(sqrt(static_cast< double >(numberArcs))));
+  tree.primalTolerance_ = primalTolerance();
+  tree.dualTolerance_ = dualTolerance();
+  int *tail = tree.tail_;
+  int *head = tree.head_;
+  double *lower = tree.lower_;
+  double *upper = tree.upper_;
+  double *flow = tree.flow_;
+  char *inTree = tree.inTree_;
+  // arcs
+  double direction = optimizationDirection_;
+  const double *obj = objective();
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    lower[iColumn] = columnLower_[iColumn] > -1.0e30 ? columnLower_[iColumn] : -COIN_DBL_MAX;
+    upper[iColumn] = columnUpper_[iColumn] < 1.0e30 ? columnUpper_[iColumn] : COIN_DBL_MAX;
+    phase2Cost[iColumn] = direction * obj[iColumn];
+  }
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    int iArc = numberColumns_ + iRow;
+    tail[iArc] = iRow;
+    head[iArc] = root;
+    lower[iArc] = rowLower_[iRow] > -1.0e30 ? rowLower_[iRow] : -COIN_DBL_MAX;
+    upper[iArc] = rowUpper_[iRow] < 1.0e30 ? rowUpper_[iRow] : COIN_DBL_MAX;
+    phase2Cost[iArc] = 0.0;
+  }
+  int firstArtificial = numberColumns_ + numberRows_;
+  double *excess = tree.pi_;
+  CoinZeroN(excess, numberNodes);
+  int numberBadBounds = 0;
+  for (int iArc = 0; iArc < firstArtificial; iArc++) {
+    if (lower[iArc] > upper[iArc] + primalTolerance_)
+      numberBadBounds++;
+    // start at a bound (free at zero)
+    double value = 0.0;
+    if (lower[iArc] > -COIN_DBL_MAX)
+      value = lower[iArc];
+    else if (upper[iArc] < COIN_DBL_MAX)
+      value = upper[iArc];
+    flow[iArc] = value;
+    excess[head[iArc]] += value;
+    excess[tail[iArc]] -= value;
+    inTree[iArc] = 0;
+    tree.cost_[iArc] = 0.0;
+  }
+  // initial tree of artificials - all hang from root
+  int *parent = tree.parent_;
+  int *thread = tree.thread_;
+  int *revThread = tree.revThread_;
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    int iArc = firstArtificial + iRow;
+    phase2Cost[iArc] = 0.0;
+    tree.cost_[iArc] = 1.0;
+    lower[iArc] = 0.0;
+    upper[iArc] = COIN_DBL_MAX;
+    inTree[iArc] = 1;
+    if (excess[iRow] > 0.0) {
+      // too much coming in
+      tail[iArc] = iRow;
+      head[iArc] = root;
+      flow[iArc] = excess[iRow];
+    } else {
+      tail[iArc] = root;
+      head[iArc] = iRow;
+      flow[iArc] = -excess[iRow];
+    }
+    parent[iRow] = root;
+    tree.predArc_[iRow] = iArc;
+    tree.succNum_[iRow] = 1;
+    thread[iRow] = iRow + 1;
+    revThread[iRow + 1] = iRow;
+    tree.lastSucc_[iRow] = iRow;
+  }
+  parent[root] = -1;
+  tree.predArc_[root] = -1;
+  tree.succNum_[root] = numberNodes;
+  thread[root] = 0;
+  revThread[0] = root;
+  tree.lastSucc_[root] = numberRows_ - 1;
+  int numberPivots = 0;
+  int returnCode = 0;
+  int startIterations = numberIterations_;
+  numberPrimalInfeasibilities_ = numberBadBounds;
+  sumPrimalInfeasibilities_ = 0.0;
+  // phase 1 then phase 2 (not if bounds inconsistent)
+  for (int phase = numberBadBounds ? 3 : 1; phase <= 2; phase++) {
+    if (phase == 2) {
+      // artificials now fixed at current (zero) flow
+      for (int iRow = 0; iRow < numberRows_; iRow++) {
+        int iArc = firstArtificial + iRow;
+        upper[iArc] = flow[iArc];
+      }
+      CoinMemcpyN(phase2Cost, numberArcs, tree.cost_);
+    }
+    while (true) {
+      returnCode = networkIterate(tree, 1000, numberPivots);
+      numberIterations_ = startIterations + numberPivots;
+      if (returnCode != 3)
+        break;
+      if (hitMaximumIterations())
+        break;
+      if ((numberPivots % 10000) == 0 && handler_->logLevel() > 1) {
+        char line[100];
+        sprintf(line, "Network phase %d - %d iterations", phase, numberPivots);
+        handler_->message(CLP_GENERAL, messages_)
+          << line << CoinMessageEol;
+      }
+    }
+    if (phase == 1) {
+      assert(returnCode != 2);
+      sumPrimalInfeasibilities_ = 0.0;
+      numberPrimalInfeasibilities_ = 0;
+      for (int iRow = 0; iRow < numberRows_; iRow++) {
+        double value = flow[firstArtificial + iRow];
+        if (value > primalTolerance_) {
+          sumPrimalInfeasibilities_ += value;
+          numberPrimalInfeasibilities_++;
+        }
+      }
+      if (returnCode || numberPrimalInfeasibilities_)
+        break;
+    }
+  }
+  // solution
+  problemStatus_ = returnCode;
+  if (!returnCode && numberPrimalInfeasibilities_)
+    problemStatus_ = 1;
+  secondaryStatus_ = 0;
+  if (problemStatus_ == 3)
+    onStopped();
+  numberDualInfeasibilities_ = 0;
+  sumDualInfeasibilities_ = 0.0;
+  if (!status_)
+    createStatus();
+  if (!columnActivity_) {
+    columnActivity_ = new double[numberColumns_];
+    reducedCost_ = new double[numberColumns_];
+    rowActivity_ = new double[numberRows_];
+    dual_ = new double[numberRows_];
+  }
+  networkPotentials(tree);
+  const double *pi = tree.pi_;
+  objectiveValue_ = 0.0;
+  for (int iColumn = 0; iColumn < numberColumns_; iColumn++) {
+    double value = flow[iColumn];
+    columnActivity_[iColumn] = value;
+    double dj = phase2Cost[iColumn] + pi[tail[iColumn]] - pi[head[iColumn]];
+    reducedCost_[iColumn] = direction * dj;
+    objectiveValue_ += phase2Cost[iColumn] * value;
+    Status status;
+    if (inTree[iColumn])
+      status = basic;
+    else if (value <= lower[iColumn] + primalTolerance_)
+      status = atLowerBound;
+    else if (value >= upper[iColumn] - primalTolerance_)
+      status = atUpperBound;
+    else if (lower[iColumn] == -COIN_DBL_MAX && upper[iColumn] == COIN_DBL_MAX)
+      status = isFree;
+    else
+      status = superBasic;
+    setColumnStatus(iColumn, status);
+  }
+  CoinZeroN(rowActivity_, numberRows_);
+  times(1.0, columnActivity_, rowActivity_);
+  for (int iRow = 0; iRow < numberRows_; iRow++) {
+    int iArc = numberColumns_ + iRow;
+    dual_[iRow] = direction * pi[iRow];
+    double value = rowActivity_[iRow];
+    Status status;
+    // a basic artificial is parallel to slack (which can not be basic)
+    if (inTree[iArc] || inTree[firstArtificial + iRow])
+      status = basic;
+    else if (value <= lower[iArc] + primalTolerance_)
+      status = atLowerBound;
+    else if (value >= upper[iArc] - primalTolerance_)
+      status = atUpperBound;
+    else if (lower[iArc] == -COIN_DBL_MAX && upper[iArc] == COIN_DBL_MAX)
+      status = isFree;
+    else
+      status = superBasic;
+    setRowStatus(iRow, status);
+  }
+  delete[] tree.tail_;
+  delete[] tree.lower_;
+  delete[] tree.inTree_;
+  delete[] tree.parent_;
+  char line[100];
+  sprintf(line, "Network simplex - %d nodes, %d arcs, %d iterations",
+    numberNodes, numberColumns_, numberPivots);
+  handler_->message(CLP_GENERAL, messages_)
+    << line << CoinMessageEol;
+  if (problemStatus_ == 0)
+    handler_->message(CLP_SIMPLEX_FINISHED, messages_)
+      << objectiveValue() << CoinMessageEol;
+  else if (problemStatus_ == 1)
+    handler_->message(CLP_SIMPLEX_INFEASIBLE, messages_)
+      << objectiveValue() << CoinMessageEol;
+  else if (problemStatus_ == 2)
+    handler_->message(CLP_SIMPLEX_UNBOUNDED, messages_)
+      << objectiveValue() << CoinMessageEol;
+  else
+    handler_->message(CLP_SIMPLEX_STOPPED, messages_)
+      << objectiveValue() << CoinMessageEol;
+  return problemStatus_;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,43 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpSimplexNetwork_H
+#define ClpSimplexNetwork_H
+
+#include "ClpSimplex.hpp"
+
+/** This solves pure minimum cost flow problems by network simplex.
+
+    A model is a pure network if every column has at most one +1 and
+    at most one -1 (and nothing else) and the objective is linear.
+    Each row is a node and each column an arc from the row with -1 to
+    the row with +1 (a missing entry is an extra root node).  Row bounds
+    are handled as an arc from each row to the root whose flow is the
+    row activity.
+
+    The basis is kept as a spanning tree with parent, thread and depth
+    arrays so an iteration costs time proportional to the cycle and the
+    subtree which moves, rather than to the number of rows.  Pricing is
+    block search.  Phase 1 uses one artificial arc per row.
+
+    It inherits from ClpSimplex.  It has no data of its own and
+    is never created - only cast from a ClpSimplex object at algorithm time.
+*/
+
+class CLPLIB_EXPORT ClpSimplexNetwork : public ClpSimplex {
+
+public:
+  /**@name Methods */
+  //@{
+  /** Solves by network simplex.  If model is not a pure network
+      it is solved by dual simplex instead.
+      Returns as primal and dual. */
+  int networkSolve();
+  /// Returns true if model is a pure network (see class description)
+  bool isNetwork() const;
+  //@}
+};
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -38,6 +38,9 @@
 #define COIN_ANY_MASK_PER_INT 0x1f
 #endif
 #define SMALL_INFINITY 0.99999999999999e20
+// First four bytes of binary basis file
+#define CLP_BINARY_BASIS "CLPb"
+#define CLP_BINARY_BASIS_VERSION 1
 /* Dual ranging.
    This computes increase/decrease in cost for each given variable and corresponding
    sequence numbers which would change basis.  Sequence numbers are 0..numberColumns
@@ -1139,8 +1142,12 @@ int ClpSimplexOther::readBasis(const char *fileName)
   if (strcmp(fileName, "-") != 0 && strcmp(fileName, "stdin") != 0) {
     FILE *fp = fopen(fileName, "r");
     if (fp) {
-      // can open - lets go for it
+      // can open - lets go for it (may be binary)
+      char magic[4] = { 0, 0, 0, 0 };
+      size_t numberRead = fread(magic, 1, 4, fp);
       fclose(fp);
+      if (numberRead == 4 && !memcmp(magic, CLP_BINARY_BASIS, 4))
+        return readBasisBinary(fileName, false);
     } else {
       handler_->message(CLP_UNABLE_OPEN, messages_)
         << fileName << CoinMessageEol;
@@ -1184,6 +1191,151 @@ int ClpSimplexOther::readBasis(const char *fileName)
   }
   return status;
 }
+/* Binary basis file is
+   magic "CLPb", version, numberRows, numberColumns, 1 if values,
+   fingerprint of matrix structure, status of columns then rows packed
+   four to a byte and then (if wanted) column values and duals.
+*/
+// Write a basis in binary form
+int ClpSimplexOther::writeBasisBinary(const char *filename,
+  bool writeValues) const
+{
+  if (!status_)
+    return -1;
+  FILE *fp = fopen(filename, "wb");
+  if (!fp)
+    return -1;
+  int header[4];
+  header[0] = CLP_BINARY_BASIS_VERSION;
+  header[1] = numberRows_;
+  header[2] = numberColumns_;
+  header[3] = writeValues ? 1 : 0;
+  CoinBigIndex numberElements;
+  unsigned int fingerprint = ClpScaleFactors::fingerprint(matrix(), numberElements);
+  int numberTotal = numberColumns_ + numberRows_;
+  int numberBytes = (numberTotal + 3) >> 2;
+  unsigned char *packed = new unsigned char[numberBytes];
+  memset(packed, 0, numberBytes);
+  for (int i = 0; i < numberTotal; i++) {
+    // same order as status_ - columns then rows
+    unsigned char iStatus = static_cast< unsigned char >(status_[i] & 7);
+    // superBasic goes as isFree and fixed as at lower bound
+    if (iStatus == superBasic)
+      iStatus = isFree;
+    else if (iStatus == isFixed)
+      iStatus = atLowerBound;
+    packed[i >> 2] = static_cast< unsigned char >(packed[i >> 2] | (iStatus << ((i & 3) << 1)));
+  }
+  bool okay = fwrite(CLP_BINARY_BASIS, 1, 4, fp) == 4
+    && fwrite(header, sizeof(int), 4, fp) == 4
+    && fwrite(&fingerprint, sizeof(unsigned int), 1, fp) == 1
+    && fwrite(packed, 1, numberBytes, fp) == static_cast< size_t >(numberBytes);
+  delete[] packed;
+  if (okay && writeValues) {
+    okay = fwrite(columnActivity_, sizeof(double), numberColumns_, fp)
+        == static_cast< size_t >(numberColumns_)
+      && fwrite(dual_, sizeof(double), numberRows_, fp)
+        == static_cast< size_t >(numberRows_);
+  }
+  if (fclose(fp))
+    okay = false;
+  return okay ? 0 : -1;
+}
+/* Read a binary basis - returns -1 on file error, -2 if not for this
+   model, 0 if no values, 1 if values */
+int ClpSimplexOther::readBasisBinary(const char *fileName,
+  bool checkFingerprint)
+{
+  FILE *fp = fopen(fileName, "rb");
+  if (!fp) {
+    handler_->message(CLP_UNABLE_OPEN, messages_)
+      << fileName << CoinMessageEol;
+    return -1;
+  }
+  char magic[4];
+  int header[4];
+  unsigned int fingerprint;
+  int status = 0;
+  if (fread(magic, 1, 4, fp) != 4 || memcmp(magic, CLP_BINARY_BASIS, 4)
+    || fread(header, sizeof(int), 4, fp) != 4
+    || fread(&fingerprint, sizeof(unsigned int), 1, fp) != 1) {
+    status = -1;
+  } else if (header[0] != CLP_BINARY_BASIS_VERSION
+    || header[1] != numberRows_ || header[2] != numberColumns_) {
+    status = -2;
+  } else if (checkFingerprint) {
+    CoinBigIndex numberElements;
+    if (fingerprint != ClpScaleFactors::fingerprint(matrix(), numberElements))
+      status = -2;
+  }
+  int numberTotal = numberColumns_ + numberRows_;
+  int numberBytes = (numberTotal + 3) >> 2;
+  unsigned char *packed = NULL;
+  double *values = NULL;
+  if (!status) {
+    packed = new unsigned char[numberBytes];
+    if (fread(packed, 1, numberBytes, fp) != static_cast< size_t >(numberBytes))
+      status = -1;
+  }
+  if (!status && header[3]) {
+    values = new double[numberTotal];
+    if (fread(values, sizeof(double), numberTotal, fp) != static_cast< size_t >(numberTotal))
+      status = -1;
+    else
+      status = 1;
+  }
+  fclose(fp);
+  if (status < 0) {
+    delete[] packed;
+    delete[] values;
+    handler_->message(CLP_IMPORT_ERRORS, messages_)
+      << status << fileName << CoinMessageEol;
+    return status;
+  }
+  // nothing changed until whole file read
+  if (!status_)
+    createStatus();
+  for (int i = 0; i < numberTotal; i++) {
+    Status iStatus = static_cast< Status >((packed[i >> 2] >> ((i & 3) << 1)) & 3);
+    double lower, upper;
+    if (i < numberColumns_) {
+      lower = columnLower_[i];
+      upper = columnUpper_[i];
+    } else {
+      lower = rowLower_[i - numberColumns_];
+      upper = rowUpper_[i - numberColumns_];
+    }
+    if (iStatus == isFree && (lower > -1.0e30 || upper < 1.0e30))
+      iStatus = superBasic;
+    status_[i] = static_cast< unsigned char >((status_[i] & ~7) | iStatus);
+  }
+  delete[] packed;
+  if (values) {
+    CoinMemcpyN(values, numberColumns_, columnActivity_);
+    CoinMemcpyN(values + numberColumns_, numberRows_, dual_);
+    delete[] values;
+    memset(rowActivity_, 0, numberRows_ * sizeof(double));
+    times(1.0, columnActivity_, rowActivity_);
+    CoinMemcpyN(objective(), numberColumns_, reducedCost_);
+    transposeTimes(-1.0, dual_, reducedCost_);
+  } else {
+    // set values
+    int iColumn, iRow;
+    for (iRow = 0; iRow < numberRows_; iRow++) {
+      if (getRowStatus(iRow) == atLowerBound)
+        rowActivity_[iRow] = rowLower_[iRow];
+      else if (getRowStatus(iRow) == atUpperBound)
+        rowActivity_[iRow] = rowUpper_[iRow];
+    }
+    for (iColumn = 0; iColumn < numberColumns_; iColumn++) {
+      if (getColumnStatus(iColumn) == atLowerBound)
+        columnActivity_[iColumn] = columnLower_[iColumn];
+      else if (getColumnStatus(iColumn) == atUpperBound)
+        columnActivity_[iColumn] = columnUpper_[iColumn];
+    }
+  }
+  return status;
+}
 /* Creates dual of a problem if looks plausible
    (defaults will always create model)
    fractionRowRanges is fraction of rows allowed to have ranges
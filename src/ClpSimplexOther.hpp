@@ -216,8 +216,18 @@ public:
   int writeBasis(const char *filename,
     bool writeValues = false,
     int formatType = 0) const;
-  /// Read a basis from the given filename
+  /// Read a basis from the given filename (text or binary)
   int readBasis(const char *filename);
+  /** Write a basis in binary form (status packed four to a byte with
+      a fingerprint of matrix structure).  If writeValues then column
+      values and duals are also written.  Returns non-zero on I/O error */
+  int writeBasisBinary(const char *filename,
+    bool writeValues = false) const;
+  /** Read a binary basis.  Returns -1 on file error, -2 if basis is not
+      for this model (sizes or, if checkFingerprint, structure of matrix
+      differ), 0 if no values, 1 if values */
+  int readBasisBinary(const char *filename,
+    bool checkFingerprint = true);
   /** Creates dual of a problem if looks plausible
          (defaults will always create model)
          fractionRowRanges is fraction of rows allowed to have ranges
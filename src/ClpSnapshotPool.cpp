@@ -0,0 +1,389 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinPragma.hpp"
+#include "CoinHelperFunctions.hpp"
+#include "ClpSimplex.hpp"
+#include "ClpSnapshotPool.hpp"
+
+#include <cassert>
+#include <cstring>
+
+//#############################################################################
+// Constructors / Destructor / Assignment
+//#############################################################################
+
+ClpSnapshotPool::ClpSnapshotPool()
+  : baseBound_(NULL)
+  , baseStatus_(NULL)
+  , snapshot_(NULL)
+  , workIndex_(NULL)
+  , workValue_(NULL)
+  , numberRows_(0)
+  , numberColumns_(0)
+  , numberSnapshots_(0)
+  , maximumSnapshots_(50)
+  , useCount_(0)
+{
+}
+
+ClpSnapshotPool::ClpSnapshotPool(const ClpSimplex *model, int maximumSnapshots)
+  : baseBound_(NULL)
+  , baseStatus_(NULL)
+  , snapshot_(NULL)
+  , workIndex_(NULL)
+  , workValue_(NULL)
+  , numberRows_(0)
+  , numberColumns_(0)
+  , numberSnapshots_(0)
+  , maximumSnapshots_(CoinMax(1, maximumSnapshots))
+  , useCount_(0)
+{
+  setBase(model);
+}
+
+ClpSnapshotPool::ClpSnapshotPool(const ClpSnapshotPool &rhs)
+  : baseBound_(NULL)
+  , baseStatus_(NULL)
+  , snapshot_(NULL)
+  , workIndex_(NULL)
+  , workValue_(NULL)
+  , numberRows_(0)
+  , numberColumns_(0)
+  , numberSnapshots_(0)
+  , maximumSnapshots_(50)
+  , useCount_(0)
+{
+  gutsOfCopy(rhs);
+}
+
+ClpSnapshotPool &
+ClpSnapshotPool::operator=(const ClpSnapshotPool &rhs)
+{
+  if (this != &rhs) {
+    gutsOfDelete();
+    gutsOfCopy(rhs);
+  }
+  return *this;
+}
+
+ClpSnapshotPool::~ClpSnapshotPool()
+{
+  gutsOfDelete();
+}
+// Frees snapshot
+void ClpSnapshotPool::freeSnapshot(clpSnapshot &snapshot)
+{
+  delete[] snapshot.boundIndex;
+  delete[] snapshot.boundValue;
+  delete[] snapshot.statusIndex;
+  delete[] snapshot.statusValue;
+  snapshot.boundIndex = NULL;
+  snapshot.boundValue = NULL;
+  snapshot.statusIndex = NULL;
+  snapshot.statusValue = NULL;
+  snapshot.numberBounds = 0;
+  snapshot.numberStatus = 0;
+}
+// Frees everything
+void ClpSnapshotPool::gutsOfDelete()
+{
+  clear();
+  delete[] snapshot_;
+  delete[] baseBound_;
+  delete[] baseStatus_;
+  delete[] workIndex_;
+  delete[] workValue_;
+  snapshot_ = NULL;
+  baseBound_ = NULL;
+  baseStatus_ = NULL;
+  workIndex_ = NULL;
+  workValue_ = NULL;
+  numberRows_ = 0;
+  numberColumns_ = 0;
+}
+// Copies everything
+void ClpSnapshotPool::gutsOfCopy(const ClpSnapshotPool &rhs)
+{
+  numberRows_ = rhs.numberRows_;
+  numberColumns_ = rhs.numberColumns_;
+  maximumSnapshots_ = rhs.maximumSnapshots_;
+  useCount_ = rhs.useCount_;
+  int numberTotal = numberRows_ + numberColumns_;
+  baseBound_ = CoinCopyOfArray(rhs.baseBound_, 2 * numberTotal);
+  baseStatus_ = CoinCopyOfArray(rhs.baseStatus_, numberTotal);
+  if (baseBound_) {
+    workIndex_ = new int[3 * numberTotal];
+    workValue_ = new double[2 * numberTotal];
+  }
+  if (rhs.snapshot_) {
+    snapshot_ = new clpSnapshot[maximumSnapshots_];
+    numberSnapshots_ = rhs.numberSnapshots_;
+    for (int i = 0; i < numberSnapshots_; i++) {
+      const clpSnapshot &from = rhs.snapshot_[i];
+      clpSnapshot &to = snapshot_[i];
+      to.numberBounds = from.numberBounds;
+      to.numberStatus = from.numberStatus;
+      to.lastUsed = from.lastUsed;
+      to.boundIndex = CoinCopyOfArray(from.boundIndex, from.numberBounds);
+      to.boundValue = CoinCopyOfArray(from.boundValue, from.numberBounds);
+      to.statusIndex = CoinCopyOfArray(from.statusIndex, from.numberStatus);
+      to.statusValue = CoinCopyOfArray(from.statusValue, from.numberStatus);
+    }
+  }
+}
+// Deletes all snapshots (base is kept)
+void ClpSnapshotPool::clear()
+{
+  for (int i = 0; i < numberSnapshots_; i++)
+    freeSnapshot(snapshot_[i]);
+  numberSnapshots_ = 0;
+}
+// Sets maximum number of snapshots (deletes snapshots)
+void ClpSnapshotPool::setMaximumSnapshots(int value)
+{
+  clear();
+  delete[] snapshot_;
+  snapshot_ = NULL;
+  maximumSnapshots_ = CoinMax(1, value);
+  if (baseBound_)
+    snapshot_ = new clpSnapshot[maximumSnapshots_];
+}
+// Sets base from current bounds and basis of model (deletes snapshots)
+void ClpSnapshotPool::setBase(const ClpSimplex *model)
+{
+  gutsOfDelete();
+  numberRows_ = model->numberRows();
+  numberColumns_ = model->numberColumns();
+  int numberTotal = numberRows_ + numberColumns_;
+  baseBound_ = new double[2 * numberTotal];
+  baseStatus_ = new unsigned char[numberTotal];
+  // room for status differences after bounds
+  workIndex_ = new int[3 * numberTotal];
+  workValue_ = new double[2 * numberTotal];
+  const double *lower = model->columnLower();
+  const double *upper = model->columnUpper();
+  double *put = baseBound_;
+  for (int i = 0; i < numberColumns_; i++) {
+    *put++ = lower[i];
+    *put++ = upper[i];
+  }
+  lower = model->rowLower();
+  upper = model->rowUpper();
+  for (int i = 0; i < numberRows_; i++) {
+    *put++ = lower[i];
+    *put++ = upper[i];
+  }
+  const unsigned char *status = model->statusArray();
+  if (status) {
+    for (int i = 0; i < numberTotal; i++)
+      baseStatus_[i] = static_cast< unsigned char >(status[i] & 7);
+  } else {
+    // all slack
+    memset(baseStatus_, ClpSimplex::atLowerBound, numberColumns_);
+    memset(baseStatus_ + numberColumns_, ClpSimplex::basic, numberRows_);
+  }
+  snapshot_ = new clpSnapshot[maximumSnapshots_];
+}
+// Gets bounds of model which differ from base
+int ClpSnapshotPool::boundChanges(const ClpSimplex *model) const
+{
+  if (!baseBound_ || model->numberRows() != numberRows_
+    || model->numberColumns() != numberColumns_)
+    return -1;
+  int *index = workIndex_;
+  double *value = workValue_;
+  int number = 0;
+  const double *lower = model->columnLower();
+  const double *upper = model->columnUpper();
+  const double *base = baseBound_;
+  for (int i = 0; i < numberColumns_; i++) {
+    if (lower[i] != base[2 * i]) {
+      index[number] = 2 * i;
+      value[number++] = lower[i];
+    }
+    if (upper[i] != base[2 * i + 1]) {
+      index[number] = 2 * i + 1;
+      value[number++] = upper[i];
+    }
+  }
+  lower = model->rowLower();
+  upper = model->rowUpper();
+  base += 2 * numberColumns_;
+  int offset = 2 * numberColumns_;
+  for (int i = 0; i < numberRows_; i++) {
+    if (lower[i] != base[2 * i]) {
+      index[number] = offset + 2 * i;
+      value[number++] = lower[i];
+    }
+    if (upper[i] != base[2 * i + 1]) {
+      index[number] = offset + 2 * i + 1;
+      value[number++] = upper[i];
+    }
+  }
+  return number;
+}
+// Saves bounds and basis of model
+int ClpSnapshotPool::addSnapshot(const ClpSimplex *model)
+{
+  const unsigned char *status = model->statusArray();
+  if (!status)
+    return -1;
+  int numberBounds = boundChanges(model);
+  if (numberBounds < 0)
+    return -1;
+  int numberTotal = numberRows_ + numberColumns_;
+  const int *index = workIndex_;
+  const double *value = workValue_;
+  int *statusIndex = workIndex_ + numberBounds;
+  int numberStatus = 0;
+  for (int i = 0; i < numberTotal; i++) {
+    if ((status[i] & 7) != baseStatus_[i])
+      statusIndex[numberStatus++] = i;
+  }
+  // see if already there
+  int which = -1;
+  for (int i = 0; i < numberSnapshots_; i++) {
+    const clpSnapshot &snapshot = snapshot_[i];
+    if (snapshot.numberBounds == numberBounds
+      && snapshot.numberStatus == numberStatus
+      && !memcmp(snapshot.boundIndex, index, numberBounds * sizeof(int))
+      && !memcmp(snapshot.boundValue, value, numberBounds * sizeof(double))
+      && !memcmp(snapshot.statusIndex, statusIndex, numberStatus * sizeof(int))) {
+      int j;
+      for (j = 0; j < numberStatus; j++) {
+        if (snapshot.statusValue[j] != (status[statusIndex[j]] & 7))
+          break;
+      }
+      if (j == numberStatus) {
+        which = i;
+        break;
+      }
+    }
+  }
+  if (which < 0) {
+    if (numberSnapshots_ < maximumSnapshots_) {
+      which = numberSnapshots_++;
+    } else {
+      // replace least recently used
+      which = 0;
+      for (int i = 1; i < numberSnapshots_; i++) {
+        if (snapshot_[i].lastUsed < snapshot_[which].lastUsed)
+          which = i;
+      }
+      freeSnapshot(snapshot_[which]);
+    }
+    clpSnapshot &snapshot = snapshot_[which];
+    snapshot.numberBounds = numberBounds;
+    snapshot.numberStatus = numberStatus;
+    snapshot.boundIndex = CoinCopyOfArray(index, numberBounds);
+    snapshot.boundValue = CoinCopyOfArray(value, numberBounds);
+    snapshot.statusIndex = CoinCopyOfArray(statusIndex, numberStatus);
+    snapshot.statusValue = new unsigned char[numberStatus];
+    for (int j = 0; j < numberStatus; j++)
+      snapshot.statusValue[j] = static_cast< unsigned char >(status[statusIndex[j]] & 7);
+  }
+  snapshot_[which].lastUsed = useCount_++;
+  return which;
+}
+/* Returns snapshot whose bounds are closest to those of model.
+   Getting differences of model from base is linear in size but then
+   both sets of differences are sorted so a bound can only differ
+   between model and snapshot if it is in one of them. */
+int ClpSnapshotPool::closest(const ClpSimplex *model, int *distance) const
+{
+  int best = -1;
+  int bestDistance = COIN_INT_MAX;
+  if (numberSnapshots_) {
+    int numberBounds = boundChanges(model);
+    const int *index = workIndex_;
+    const double *value = workValue_;
+    for (int i = 0; i < numberSnapshots_ && numberBounds >= 0; i++) {
+      const clpSnapshot &snapshot = snapshot_[i];
+      const int *snapshotIndex = snapshot.boundIndex;
+      const double *snapshotValue = snapshot.boundValue;
+      int n = snapshot.numberBounds;
+      int thisDistance = 0;
+      int j = 0;
+      int k = 0;
+      while (j < numberBounds && k < n) {
+        if (index[j] == snapshotIndex[k]) {
+          if (value[j] != snapshotValue[k])
+            thisDistance++;
+          j++;
+          k++;
+        } else if (index[j] < snapshotIndex[k]) {
+          thisDistance++;
+          j++;
+        } else {
+          thisDistance++;
+          k++;
+        }
+      }
+      thisDistance += (numberBounds - j) + (n - k);
+      // ties go to most recently used
+      if (thisDistance < bestDistance
+        || (thisDistance == bestDistance && snapshot.lastUsed > snapshot_[best].lastUsed)) {
+        bestDistance = thisDistance;
+        best = i;
+      }
+    }
+  }
+  if (distance)
+    *distance = (best >= 0) ? bestDistance : -1;
+  return best;
+}
+// Puts basis of snapshot into model
+int ClpSnapshotPool::restoreBasis(int which, ClpSimplex *model)
+{
+  if (which < 0 || which >= numberSnapshots_
+    || model->numberRows() != numberRows_
+    || model->numberColumns() != numberColumns_)
+    return 1;
+  if (!model->statusExists())
+    model->createStatus();
+  unsigned char *status = model->statusArray();
+  int numberTotal = numberRows_ + numberColumns_;
+  for (int i = 0; i < numberTotal; i++)
+    status[i] = static_cast< unsigned char >((status[i] & ~7) | baseStatus_[i]);
+  const clpSnapshot &snapshot = snapshot_[which];
+  for (int j = 0; j < snapshot.numberStatus; j++) {
+    int i = snapshot.statusIndex[j];
+    status[i] = static_cast< unsigned char >((status[i] & ~7) | snapshot.statusValue[j]);
+  }
+  snapshot_[which].lastUsed = useCount_++;
+  return 0;
+}
+// Puts basis of closest snapshot into model
+int ClpSnapshotPool::setClosestBasis(ClpSimplex *model)
+{
+  int which = closest(model);
+  if (which >= 0)
+    restoreBasis(which, model);
+  return which;
+}
+// Number of bounds which differ from base in snapshot
+int ClpSnapshotPool::numberBoundChanges(int which) const
+{
+  assert(which >= 0 && which < numberSnapshots_);
+  return snapshot_[which].numberBounds;
+}
+// Number of statuses which differ from base in snapshot
+int ClpSnapshotPool::numberBasisChanges(int which) const
+{
+  assert(which >= 0 && which < numberSnapshots_);
+  return snapshot_[which].numberStatus;
+}
+// Bytes used by snapshots (not base)
+size_t ClpSnapshotPool::memoryUsed() const
+{
+  size_t bytes = maximumSnapshots_ * sizeof(clpSnapshot);
+  for (int i = 0; i < numberSnapshots_; i++) {
+    bytes += snapshot_[i].numberBounds * (sizeof(int) + sizeof(double));
+    bytes += snapshot_[i].numberStatus * (sizeof(int) + sizeof(unsigned char));
+  }
+  return bytes;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -0,0 +1,163 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpSnapshotPool_H
+#define ClpSnapshotPool_H
+
+#include "CoinPragma.hpp"
+#include "ClpConfig.h"
+
+#include <cstddef>
+
+class ClpSimplex;
+
+/** Pool of saved bases for warm starts of related problems.
+
+    markHotStart and makeBaseModel keep one saved state.  This keeps up
+    to maximumSnapshots() of them, each stored as differences from a base
+    (the bounds and basis of the model given to setBase).  So a snapshot
+    of a problem which has had a few bounds or rhs changed and a few
+    pivots done costs a few bytes per change, not a copy of every array.
+
+    For a new problem, closest() returns the snapshot whose column and
+    row bounds differ in fewest places (Hamming distance counting lower
+    and upper bounds separately) and setClosestBasis puts that basis
+    into model.  When the pool is full the snapshot used least recently
+    is replaced.
+
+    Cost - addSnapshot and closest first scan all bounds of model
+    against base, which is linear in rows plus columns.  Only comparing
+    with each snapshot is proportional to the number of differences.
+    Work arrays are allocated once in setBase so neither allocates
+    (apart from storing a new snapshot).  As they share work arrays
+    one pool must not be used by more than one thread at a time.
+
+    Typical use is
+    <pre>
+    ClpSnapshotPool pool(&model);
+    for each query {
+      change bounds of model
+      pool.setClosestBasis(&model);
+      model.dual();
+      pool.addSnapshot(&model);
+    }
+    </pre>
+*/
+class CLPLIB_EXPORT ClpSnapshotPool {
+
+public:
+  /**@name Constructors and destructor */
+  //@{
+  /// Default constructor
+  ClpSnapshotPool();
+  /// Uses current bounds and basis of model as base
+  explicit ClpSnapshotPool(const ClpSimplex *model, int maximumSnapshots = 50);
+  /// Copy constructor
+  ClpSnapshotPool(const ClpSnapshotPool &rhs);
+  /// Assignment operator
+  ClpSnapshotPool &operator=(const ClpSnapshotPool &rhs);
+  /// Destructor
+  ~ClpSnapshotPool();
+  //@}
+
+  /**@name Using pool */
+  //@{
+  /// Sets base from current bounds and basis of model (deletes snapshots)
+  void setBase(const ClpSimplex *model);
+  /** Saves bounds and basis of model.  Returns which snapshot or -1
+      if model has no basis or is not same size as base.  An identical
+      snapshot is not added again. */
+  int addSnapshot(const ClpSimplex *model);
+  /** Returns snapshot whose bounds are closest to those of model (or -1
+      if none).  If distance given then number of bounds which differ
+      is returned there. */
+  int closest(const ClpSimplex *model, int *distance = NULL) const;
+  /// Puts basis of snapshot into model - returns non-zero if not possible
+  int restoreBasis(int which, ClpSimplex *model);
+  /** Puts basis of closest snapshot into model.  Returns which snapshot
+      or -1 (when model is unchanged) */
+  int setClosestBasis(ClpSimplex *model);
+  /// Deletes all snapshots (base is kept)
+  void clear();
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Number of snapshots
+  inline int numberSnapshots() const
+  {
+    return numberSnapshots_;
+  }
+  /// Maximum number of snapshots
+  inline int maximumSnapshots() const
+  {
+    return maximumSnapshots_;
+  }
+  /// Sets maximum number of snapshots (deletes snapshots)
+  void setMaximumSnapshots(int value);
+  /// Number of bounds which differ from base in snapshot
+  int numberBoundChanges(int which) const;
+  /// Number of statuses which differ from base in snapshot
+  int numberBasisChanges(int which) const;
+  /// Bytes used by snapshots (not base)
+  size_t memoryUsed() const;
+  //@}
+
+private:
+  /// One snapshot - differences from base
+  typedef struct {
+    /// Which bounds differ - 2*sequence (+1 if upper)
+    int *boundIndex;
+    /// Values of those bounds
+    double *boundValue;
+    /// Which statuses differ
+    int *statusIndex;
+    /// Those statuses
+    unsigned char *statusValue;
+    int numberBounds;
+    int numberStatus;
+    /// When last added or used
+    int lastUsed;
+  } clpSnapshot;
+  /**@name Private methods */
+  //@{
+  /** Gets bounds of model which differ from base into workIndex_
+      and workValue_.  Returns number or -1 if wrong size */
+  int boundChanges(const ClpSimplex *model) const;
+  /// Frees snapshot
+  static void freeSnapshot(clpSnapshot &snapshot);
+  /// Frees everything
+  void gutsOfDelete();
+  /// Copies everything
+  void gutsOfCopy(const ClpSnapshotPool &rhs);
+  //@}
+
+  /**@name Data */
+  //@{
+  /// Base bounds (lower and upper for each column then row)
+  double *baseBound_;
+  /// Base status
+  unsigned char *baseStatus_;
+  /// Snapshots
+  clpSnapshot *snapshot_;
+  /// Work - bound (then status) differences (3*(rows+columns))
+  int *workIndex_;
+  /// Work - bound values (2*(rows+columns))
+  double *workValue_;
+  /// Number of rows in base
+  int numberRows_;
+  /// Number of columns in base
+  int numberColumns_;
+  /// Number of snapshots
+  int numberSnapshots_;
+  /// Maximum number of snapshots
+  int maximumSnapshots_;
+  /// Counter for least recently used
+  int useCount_;
+  //@}
+};
+
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
@@ -13,6 +13,7 @@
 #endif
 
 #include <math.h>
+#include <atomic>
 #ifdef _MSC_VER
 #include <windows.h> // for Sleep()
 #ifdef small
@@ -34,8 +35,10 @@
 #include "ClpInterior.hpp"
 #include "ClpCholeskyDense.hpp"
 #include "ClpCholeskyBase.hpp"
+#include "ClpCholeskyKKT.hpp"
 #include "ClpPlusMinusOneMatrix.hpp"
 #include "ClpNetworkMatrix.hpp"
+#include "ClpSimplexNetwork.hpp"
 #endif
 #include "ClpEventHandler.hpp"
 #include "ClpLinearObjective.hpp"
@@ -43,6 +46,7 @@
 #include "ClpPackedMatrix.hpp"
 #include "ClpMessage.hpp"
 #include "CoinTime.hpp"
+#include "ClpThreadPool.hpp"
 #if CLP_HAS_ABC
 #include "CoinAbcCommon.hpp"
 #endif
@@ -357,17 +361,35 @@ solveWithVolume(ClpSimplex *model, int numberPasses, int doIdiot)
   return 0;
 }
 #endif
-static ClpInterior *currentModel2 = NULL;
 #endif
 //#############################################################################
 // Allow for interrupts
-// But is this threadsafe ? (so switched off by option)
+/* Each solve in progress has its own slot so solves on different
+   threads share nothing (apart from claiming a slot).  The signal
+   handler only reads atomic pointers.  If all slots are in use that
+   solve just can not be interrupted. */
 
 #include "CoinSignal.hpp"
-static ClpSimplex *currentModel = NULL;
+#include <mutex>
+#define CLP_INTERRUPT_SLOTS 64
+namespace {
+struct ClpInterruptSlot {
+  std::atomic< bool > used;
+  std::atomic< ClpSimplex * > simplex;
+#ifndef SLIM_CLP
+  std::atomic< ClpInterior * > barrier;
+#endif
 #ifdef ABC_INHERIT
-static AbcSimplex *currentAbcModel = NULL;
+  std::atomic< AbcSimplex * > abcSimplex;
 #endif
+};
+}
+static ClpInterruptSlot interruptSlot[CLP_INTERRUPT_SLOTS];
+// Innermost solve on this thread (NULL if not interruptible)
+static thread_local ClpInterruptSlot *currentInterruptSlot = NULL;
+static std::mutex interruptMutex;
+static int numberInterruptSolves = 0;
+static CoinSighandler_t saveSignal = static_cast< CoinSighandler_t >(0);
 
 extern "C" {
 static void
@@ -376,19 +398,100 @@ static void
 #endif // _MSC_VER
   signal_handler(int /*whichSignal*/)
 {
-  if (currentModel != NULL)
-    currentModel->setMaximumIterations(0); // stop at next iterations
+  for (int i = 0; i < CLP_INTERRUPT_SLOTS; i++) {
+    if (!interruptSlot[i].used.load())
+      continue;
+    ClpSimplex *model = interruptSlot[i].simplex.load();
+    if (model != NULL)
+      model->setMaximumIterations(0); // stop at next iterations
 #ifdef ABC_INHERIT
-  if (currentAbcModel != NULL)
-    currentAbcModel->setMaximumIterations(0); // stop at next iterations
+    AbcSimplex *abcModel = interruptSlot[i].abcSimplex.load();
+    if (abcModel != NULL)
+      abcModel->setMaximumIterations(0); // stop at next iterations
 #endif
 #ifndef SLIM_CLP
-  if (currentModel2 != NULL)
-    currentModel2->setMaximumBarrierIterations(0); // stop at next iterations
+    ClpInterior *barrier = interruptSlot[i].barrier.load();
+    if (barrier != NULL)
+      barrier->setMaximumBarrierIterations(0); // stop at next iterations
 #endif
+  }
   return;
 }
 }
+namespace {
+/* Claims a slot for a solve and installs signal handler for first
+   solve.  Everything is undone on any return. */
+class ClpSolveInterrupt {
+public:
+  explicit ClpSolveInterrupt(bool interrupt)
+    : slot_(NULL)
+    , previous_(currentInterruptSlot)
+  {
+    if (!interrupt)
+      return;
+    for (int i = 0; i < CLP_INTERRUPT_SLOTS; i++) {
+      bool expected = false;
+      if (interruptSlot[i].used.compare_exchange_strong(expected, true)) {
+        slot_ = interruptSlot + i;
+        break;
+      }
+    }
+    if (slot_) {
+      std::lock_guard< std::mutex > lock(interruptMutex);
+      if (!numberInterruptSolves)
+        saveSignal = signal(SIGINT, signal_handler);
+      numberInterruptSolves++;
+    }
+    currentInterruptSlot = slot_;
+  }
+  ~ClpSolveInterrupt()
+  {
+    currentInterruptSlot = previous_;
+    if (slot_) {
+      slot_->simplex = NULL;
+#ifndef SLIM_CLP
+      slot_->barrier = NULL;
+#endif
+#ifdef ABC_INHERIT
+      slot_->abcSimplex = NULL;
+#endif
+      {
+        std::lock_guard< std::mutex > lock(interruptMutex);
+        numberInterruptSolves--;
+        if (!numberInterruptSolves)
+          signal(SIGINT, saveSignal);
+      }
+      slot_->used = false;
+    }
+  }
+
+private:
+  ClpSolveInterrupt(const ClpSolveInterrupt &);
+  ClpSolveInterrupt &operator=(const ClpSolveInterrupt &);
+  ClpInterruptSlot *slot_;
+  ClpInterruptSlot *previous_;
+};
+}
+// Model to stop on interrupt (for current solve on this thread)
+static inline void setInterruptModel(ClpSimplex *model)
+{
+  if (currentInterruptSlot)
+    currentInterruptSlot->simplex = model;
+}
+#ifndef SLIM_CLP
+static inline void setInterruptBarrier(ClpInterior *model)
+{
+  if (currentInterruptSlot)
+    currentInterruptSlot->barrier = model;
+}
+#endif
+#ifdef ABC_INHERIT
+static inline void setInterruptAbcModel(AbcSimplex *model)
+{
+  if (currentInterruptSlot)
+    currentInterruptSlot->abcSimplex = model;
+}
+#endif
 #if ABC_INSTRUMENT > 1
 int abcPricing[20];
 int abcPricingDense[20];
@@ -552,9 +655,11 @@ void instrument_print()
 }
 #endif
 #if ABC_PARALLEL == 2
-#ifndef FAKE_CILK
+#ifdef ABC_USE_CILK
 int number_cilk_workers = 0;
 #include <cilk/cilk_api.h>
+#else
+#include "ClpThreadPool.hpp"
 #endif
 #endif
 #ifdef ABC_INHERIT
@@ -579,7 +684,7 @@ ClpSimplex::dealWithAbc(int solveType, int startUp,
   } else {
     abcModel2 = new AbcSimplex(*this);
     if (interrupt)
-      currentAbcModel = abcModel2;
+      setInterruptAbcModel(abcModel2);
     //if (abcSimplex_) {
     // move factorization stuff
     abcModel2->factorization()->synchronize(this->factorization(), abcModel2);
@@ -643,9 +748,11 @@ ClpSimplex::dealWithAbc(int solveType, int startUp,
     if (numberCpu == 9) {
       numberCpu = 1;
 #if ABC_PARALLEL == 2
-#ifndef FAKE_CILK
+#ifdef ABC_USE_CILK
       if (number_cilk_workers > 1)
         numberCpu = CoinMin(2 * number_cilk_workers, 8);
+#else
+      numberCpu = CoinMin(ClpThreadPool::hardwareThreads(), 8);
 #endif
 #endif
     } else if (numberCpu == 10) {
@@ -656,16 +763,19 @@ ClpSimplex::dealWithAbc(int solveType, int startUp,
       if (abcModel2->getNumElements() < 5000)
         numberCpu = 1;
 #if ABC_PARALLEL == 2
-#ifndef FAKE_CILK
+#ifdef ABC_USE_CILK
       else if (number_cilk_workers > 1)
         numberCpu = CoinMin(2 * number_cilk_workers, 8);
+#else
+      else if (ClpThreadPool::hardwareThreads() > 1)
+        numberCpu = CoinMin(ClpThreadPool::hardwareThreads(), 8);
 #endif
 #endif
       else
         numberCpu = 1;
     } else {
 #if ABC_PARALLEL == 2
-#ifndef FAKE_CILK
+#ifdef ABC_USE_CILK
       char temp[3];
       sprintf(temp, "%d", numberCpu);
       __cilkrts_set_param("nworkers", temp);
@@ -678,7 +788,7 @@ ClpSimplex::dealWithAbc(int solveType, int startUp,
     char line[200];
 #if ABC_PARALLEL
 #if ABC_PARALLEL == 2
-#ifndef FAKE_CILK
+#ifdef ABC_USE_CILK
     if (!number_cilk_workers) {
       number_cilk_workers = __cilkrts_get_nworkers();
       sprintf(line, "%d cilk workers", number_cilk_workers);
@@ -831,6 +941,8 @@ ClpSimplex::dealWithAbc(int solveType, int startUp,
     moreSpecialOptions_ &= ~16384;
     //this->setNumberIterations(abcModel2->numberIterations()+this->numberIterations());
     if (!keepAbc) {
+      if (interrupt)
+        setInterruptAbcModel(NULL);
       delete abcModel2;
       abcModel2 = NULL;
     }
@@ -901,12 +1013,10 @@ int ClpSimplex::initialSolve(ClpSolve &options)
   }
   ClpSimplex *model2 = this;
   bool interrupt = (options.getSpecialOption(2) == 0);
-  CoinSighandler_t saveSignal = static_cast< CoinSighandler_t >(0);
-  if (interrupt) {
-    currentModel = model2;
-    // register signal handler
-    saveSignal = signal(SIGINT, signal_handler);
-  }
+  // registers signal handler (until return)
+  ClpSolveInterrupt interruptHandler(interrupt);
+  if (interrupt)
+    setInterruptModel(model2);
   // If no status array - set up basis
   if (!status_)
     allSlackBasis();
@@ -1240,7 +1350,7 @@ int ClpSimplex::initialSolve(ClpSolve &options)
   }
 #endif
   if (interrupt)
-    currentModel = model2;
+    setInterruptModel(model2);
   int saveMoreOptions = moreSpecialOptions_;
   // For below >0 overrides
   // 0 means no, -1 means maybe
@@ -1461,6 +1571,14 @@ int ClpSimplex::initialSolve(ClpSolve &options)
   bool plusMinus = false;
   CoinBigIndex numberElements = model2->getNumElements();
 #ifndef SLIM_CLP
+  if ((specialOptions_ & 0x04000000) != 0 && model2 != this) {
+    // presolve may have removed what stopped conversion on load
+    if (model2->convertMatrixStructure() == 2) {
+      doIdiot = 0;
+      if (doSprint < 0)
+        doSprint = 0;
+    }
+  }
 #ifndef NO_RTTI
   if (dynamic_cast< ClpNetworkMatrix * >(matrix_)) {
     // network - switch off stuff
@@ -1547,6 +1665,12 @@ int ClpSimplex::initialSolve(ClpSolve &options)
     // make sure model2 has correct value
     model2->setFactorizationFrequency(this->factorizationFrequency());
   }
+  // pure network - use network simplex if asked for
+  bool useNetwork = false;
+  if (method == ClpSolve::automatic && options.useNetwork() && !quadraticObj && static_cast< ClpSimplexNetwork * >(model2)->isNetwork()) {
+    useNetwork = true;
+    method = ClpSolve::useDual;
+  }
   if (method == ClpSolve::automatic) {
     if (doSprint == 0 && doIdiot == 0) {
       // off
@@ -1740,7 +1864,15 @@ int ClpSimplex::initialSolve(ClpSolve &options)
       method = ClpSolve::usePrimal; // switch off sprint
     }
   }
-  if (method == ClpSolve::useDual) {
+  if (useNetwork) {
+    model2->networkSolve();
+    time2 = CoinCpuTime();
+    timeCore = time2 - timeX;
+    handler_->message(CLP_INTERVAL_TIMING, messages_)
+      << "Network" << timeCore << time2 - time1
+      << CoinMessageEol;
+    timeX = time2;
+  } else if (method == ClpSolve::useDual) {
 #ifdef CLP_USEFUL_PRINTOUT
     debugInt[6] = 1;
 #endif
@@ -2345,7 +2477,7 @@ int ClpSimplex::initialSolve(ClpSolve &options)
 #ifdef ABC_INHERIT
           AbcSimplex *abcModel2 = new AbcSimplex(*model2);
           if (interrupt)
-            currentAbcModel = abcModel2;
+            setInterruptAbcModel(abcModel2);
           if (abcSimplex_) {
             // move factorization stuff
             abcModel2->factorization()->synchronize(model2->factorization(), abcModel2);
@@ -2365,6 +2497,8 @@ int ClpSimplex::initialSolve(ClpSolve &options)
           model2->setSpecialOptions(model2->specialOptions() & ~65536);
           //model2->dual();
           //model2->setNumberIterations(abcModel2->numberIterations()+model2->numberIterations());
+          if (interrupt)
+            setInterruptAbcModel(NULL);
           delete abcModel2;
 #endif
           memcpy(model2->objective(), saveObj, numberColumns * sizeof(double));
@@ -2841,7 +2975,7 @@ int ClpSimplex::initialSolve(ClpSolve &options)
       delete[] sumFixed;
       // Solve
       if (interrupt)
-        currentModel = &small;
+        setInterruptModel(&small);
       small.defaultFactorizationFrequency();
       if (emergencyMode) {
         // not much happening so big model
@@ -2948,6 +3082,9 @@ int ClpSimplex::initialSolve(ClpSolve &options)
         small.primal(1);
       }
       int smallIterations = small.numberIterations();
+      // small goes out of scope
+      if (interrupt)
+        setInterruptModel(model2);
       totalIterations += smallIterations;
       if (2 * smallIterations < CoinMin(numberRows, 1000) && iPass) {
         int oldNumber = smallNumberColumns;
@@ -3077,7 +3214,7 @@ int ClpSimplex::initialSolve(ClpSolve &options)
       }
     }
     if (interrupt)
-      currentModel = model2;
+      setInterruptModel(model2);
     for (i = 0; i < numberArtificials; i++)
       sort[i] = i + originalNumberColumns;
     model2->deleteColumns(numberArtificials, sort);
@@ -3140,7 +3277,7 @@ int ClpSimplex::initialSolve(ClpSolve &options)
 #endif
     barrier.eventHandler()->setSimplex(NULL);
     if (interrupt)
-      currentModel2 = &barrier;
+      setInterruptBarrier(&barrier);
     if (barrier.numberRows() + barrier.numberColumns() > 10000)
       barrier.setMaximumBarrierIterations(1000);
     int barrierOptions = options.getSpecialOption(4);
@@ -3148,12 +3285,18 @@ int ClpSimplex::initialSolve(ClpSolve &options)
     bool presolveInCrossover = false;
     bool scale = false;
     bool doKKT = false;
+    bool parallelKKT = false;
     bool forceFixing = false;
     int speed = 0;
     if (barrierOptions & 16) {
       barrierOptions &= ~16;
       doKKT = true;
     }
+    if (barrierOptions & 8192) {
+      barrierOptions &= ~8192;
+      doKKT = true;
+      parallelKKT = true;
+    }
     if (barrierOptions & (32 + 64 + 128)) {
       aggressiveGamma = (barrierOptions & (32 + 64 + 128)) >> 5;
       barrierOptions &= ~(32 + 64 + 128);
@@ -3189,6 +3332,10 @@ int ClpSimplex::initialSolve(ClpSolve &options)
         ClpCholeskyBase *cholesky = new ClpCholeskyBase(options.getExtraInfo(1));
         cholesky->setIntegerParameter(0, speed);
         barrier.setCholesky(cholesky);
+      } else if (parallelKKT) {
+        // regularized LDL' - subtrees done on threads
+        ClpCholeskyKKT *cholesky = new ClpCholeskyKKT();
+        barrier.setCholesky(cholesky);
       } else {
         ClpCholeskyBase *cholesky = new ClpCholeskyBase();
         cholesky->setKKT(true);
@@ -3458,6 +3605,8 @@ int ClpSimplex::initialSolve(ClpSolve &options)
 #endif
       }
     }
+    if (interrupt)
+      setInterruptBarrier(NULL);
 #ifdef BORROW
     int saveNumberIterations = barrier.numberIterations();
     barrier.returnModel(*model2);
@@ -3768,6 +3917,10 @@ int ClpSimplex::initialSolve(ClpSolve &options)
     delete pinfo;
     pinfo = NULL;
     factorization_->areaFactor(model2->factorization()->adjustedAreaFactor());
+#ifdef CLP_MULTIPLE_FACTORIZATIONS
+    if (factorization_->adaptiveSolves())
+      factorization_->copySolveStatistics(*model2->factorization());
+#endif
     time2 = CoinCpuTime();
     timePresolve += time2 - timeX;
     handler_->message(CLP_INTERVAL_TIMING, messages_)
@@ -3785,7 +3938,7 @@ int ClpSimplex::initialSolve(ClpSolve &options)
 #endif
     }
     if (interrupt)
-      currentModel = this;
+      setInterruptModel(this);
     // checkSolution(); already done by postSolve
     setLogLevel(saveLevel);
     int oldStatus = problemStatus_;
@@ -3906,8 +4059,6 @@ int ClpSimplex::initialSolve(ClpSolve &options)
   handler_->printing(timeIdiot != 0.0)
     << timeIdiot;
   handler_->message() << CoinMessageEol;
-  if (interrupt)
-    signal(SIGINT, saveSignal);
   perturbation_ = savePerturbation;
   scalingFlag_ = saveScaling;
   // If faking objective - put back correct one
@@ -3996,6 +4147,8 @@ ClpSolve::ClpSolve()
   independentOptions_[1] = 512;
   // Substitute up to 3
   independentOptions_[2] = 3;
+  bendersOptions_[0] = 0;
+  bendersOptions_[1] = 0;
 }
 // Constructor when you really know what you are doing
 ClpSolve::ClpSolve(SolveType method, PresolveType presolveType,
@@ -4014,6 +4167,8 @@ ClpSolve::ClpSolve(SolveType method, PresolveType presolveType,
   extraInfo_[6] = 0;
   for (i = 0; i < 3; i++)
     independentOptions_[i] = independentOptions[i];
+  bendersOptions_[0] = 0;
+  bendersOptions_[1] = 0;
 }
 
 // Copy constructor.
@@ -4029,6 +4184,8 @@ ClpSolve::ClpSolve(const ClpSolve &rhs)
     extraInfo_[i] = rhs.extraInfo_[i];
   for (i = 0; i < 3; i++)
     independentOptions_[i] = rhs.independentOptions_[i];
+  bendersOptions_[0] = rhs.bendersOptions_[0];
+  bendersOptions_[1] = rhs.bendersOptions_[1];
 }
 // Assignment operator. This copies the data
 ClpSolve &
@@ -4045,6 +4202,8 @@ ClpSolve::operator=(const ClpSolve &rhs)
       extraInfo_[i] = rhs.extraInfo_[i];
     for (i = 0; i < 3; i++)
       independentOptions_[i] = rhs.independentOptions_[i];
+    bendersOptions_[0] = rhs.bendersOptions_[0];
+    bendersOptions_[1] = rhs.bendersOptions_[1];
   }
   return *this;
 }
@@ -4654,6 +4813,13 @@ int ClpSimplexProgress::cycle(int in, int out, int wayIn, int wayOut)
 #include "CoinStructuredModel.hpp"
 // Solve using structure of model and maybe in parallel
 int ClpSimplex::solve(CoinStructuredModel *model)
+{
+  ClpSolve options;
+  options.setIndependentOption(2, 100);
+  return solve(model, options);
+}
+// Solve using structure of model and maybe in parallel
+int ClpSimplex::solve(CoinStructuredModel *model, const ClpSolve &userOptions)
 {
   // analyze structure
   int numberRowBlocks = model->numberRowBlocks();
@@ -4734,8 +4900,7 @@ int ClpSimplex::solve(CoinStructuredModel *model)
   delete[] columnCounts;
   delete[] blockInfo;
   // decide what to do
-  ClpSolve options;
-  options.setIndependentOption(2, 100);
+  ClpSolve options(userOptions);
   switch (decomposeType) {
     // No good
   case 0:
@@ -5116,6 +5281,37 @@ void *clp_parallelManager(void *stuff)
   }
 }
 #endif
+/* Solves one Dantzig-Wolfe sub problem (unless already solved) and puts
+   back objective.  Only touches subModel so may be run on a thread. */
+static void solveDWBlock(ClpSimplex *subModel, const double *saveObj,
+  bool alreadySolved, int iPass, double scaleFactor, int problemStatus)
+{
+  if (!alreadySolved) {
+    if (iPass)
+      subModel->primal();
+    else
+      subModel->dual();
+  }
+  int numberColumns2 = subModel->numberColumns();
+  double *objective2 = subModel->objective();
+  int i;
+  subModel->scaleObjective(scaleFactor);
+  if (!subModel->isProvenOptimal() && !subModel->isProvenDualInfeasible()) {
+    memset(objective2, 0, numberColumns2 * sizeof(double));
+    subModel->primal();
+    if (problemStatus == 0) {
+      for (i = 0; i < numberColumns2; i++)
+        objective2[i] = saveObj[i] - objective2[i];
+    } else {
+      for (i = 0; i < numberColumns2; i++)
+        objective2[i] = -objective2[i];
+    }
+    double scaleFactor2 = subModel->scaleObjective(-1.0e9);
+    subModel->primal(1);
+    subModel->scaleObjective(scaleFactor2);
+  }
+  memcpy(objective2, saveObj, numberColumns2 * sizeof(double));
+}
 // Solve using Dantzig-Wolfe decomposition and maybe in parallel
 int ClpSimplex::solveDW(CoinStructuredModel *model, ClpSolve &options)
 {
@@ -5402,6 +5598,12 @@ int ClpSimplex::solveDW(CoinStructuredModel *model, ClpSolve &options)
   //abcMaster.startThreads(numberCpu);
   //#define master abcMaster
 #endif
+  /* Sub problems are solved on threads if numberThreads() > 1.
+     Each block keeps its own model so is warm started next pass. */
+  ClpThreadPool *dwPool = NULL;
+  int numberDWThreads = CoinMin(numberThreads(), numberBlocks);
+  if (numberDWThreads > 1)
+    dwPool = new ClpThreadPool(numberDWThreads - 1);
   for (iPass = 0; iPass < maxPass; iPass++) {
     sprintf(generalPrint, "Start of pass %d", iPass);
     handler_->message(CLP_GENERAL, messages_)
@@ -5602,18 +5804,10 @@ int ClpSimplex::solveDW(CoinStructuredModel *model, ClpSolve &options)
       if (reducePrint)
         sub[iBlock].setLogLevel(0);
     }
+    // Each block has its own model so sub problems can be solved in parallel
+    bool subSolved = false;
 #if defined(ABC_INHERIT)
-    if (numberCpu < 2) {
-#endif
-      for (iBlock = 0; iBlock < numberBlocks; iBlock++) {
-        if (iPass) {
-          sub[iBlock].primal();
-        } else {
-          sub[iBlock].dual();
-        }
-      }
-#if defined(ABC_INHERIT)
-    } else {
+    if (numberCpu >= 2) {
       int iBlock = 0;
       while (iBlock < numberBlocks) {
         if (sub[iBlock].secondaryStatus() != 99 || true) {
@@ -5628,29 +5822,26 @@ int ClpSimplex::solveDW(CoinStructuredModel *model, ClpSolve &options)
         iBlock++;
       }
       threadInfo.waitAllTasks();
+      subSolved = true;
     }
 #endif
+    {
+      ClpTaskGroup tasks(dwPool);
+      for (iBlock = 0; iBlock < numberBlocks; iBlock++) {
+        ClpSimplex *subModel = sub + iBlock;
+        const double *saveObj = saveObj2[iBlock];
+        tasks.spawn([=]() {
+          solveDWBlock(subModel, saveObj, subSolved, iPass,
+            scaleFactor, problemStatus);
+        });
+      }
+      tasks.sync();
+    }
+    // Proposals are collected in block order so master is same for any number of threads
     for (iBlock = 0; iBlock < numberBlocks; iBlock++) {
       int numberColumns2 = sub[iBlock].numberColumns();
       double *saveObj = saveObj2[iBlock];
-      double *objective2 = sub[iBlock].objective();
       int i;
-      sub[iBlock].scaleObjective(scaleFactor);
-      if (!sub[iBlock].isProvenOptimal() && !sub[iBlock].isProvenDualInfeasible()) {
-        memset(objective2, 0, numberColumns2 * sizeof(double));
-        sub[iBlock].primal();
-        if (problemStatus == 0) {
-          for (int i = 0; i < numberColumns2; i++)
-            objective2[i] = saveObj[i] - objective2[i];
-        } else {
-          for (i = 0; i < numberColumns2; i++)
-            objective2[i] = -objective2[i];
-        }
-        double scaleFactor = sub[iBlock].scaleObjective(-1.0e9);
-        sub[iBlock].primal(1);
-        sub[iBlock].scaleObjective(scaleFactor);
-      }
-      memcpy(objective2, saveObj, numberColumns2 * sizeof(double));
       // get proposal
       if (sub[iBlock].numberIterations() || !iPass) {
         double objValue = 0.0;
@@ -5745,6 +5936,7 @@ int ClpSimplex::solveDW(CoinStructuredModel *model, ClpSolve &options)
       master.addColumns(numberProposals, NULL, NULL, objective,
         columnAdd, rowAdd, elementAdd);
   }
+  delete dwPool;
   sprintf(generalPrint, "Time at end of D-W %.2f seconds", CoinCpuTime() - time1);
   handler_->message(CLP_GENERAL, messages_)
     << generalPrint
@@ -5949,6 +6141,116 @@ static ClpSimplex *deBound(ClpSimplex *oldModel)
   delete[] change;
   return model;
 }
+/* Solves one Benders sub problem.  Only touches subModel and state so
+   may be run on a thread.  Returns 1 if still infeasible. */
+static int solveBendersBlock(ClpSimplex *subModel, int iBlock, int iPass,
+  int maxPass, int scalingFlag, double treatSubAsFeasible, int &state)
+{
+  int returnCode = 0;
+#ifdef TRY_NO_SCALING
+  subModel->scaling(0);
+#endif
+  //int ix=subModel->secondaryStatus();
+  int lastStatus = subModel->problemStatus();
+  // was do dual unless unbounded
+  double saveTolerance = subModel->primalTolerance();
+  if (lastStatus == 0 || !iPass) {
+    //if (lastStatus<2||!iPass) {
+    //subModel->dual();
+    subModel->primal();
+    if (!subModel->isProvenOptimal() && subModel->sumPrimalInfeasibilities() < treatSubAsFeasible) {
+      printf("Block %d was feasible now has small infeasibility %g\n", iBlock,
+        subModel->sumPrimalInfeasibilities());
+      subModel->setPrimalTolerance(CoinMin(treatSubAsFeasible, 1.0e-4));
+      subModel->setCurrentPrimalTolerance(CoinMin(treatSubAsFeasible, 1.0e-4));
+      subModel->primal();
+      subModel->setProblemStatus(0);
+      state |= 4; // force actions
+    }
+    if ((maxPass == 5000 && scalingFlag) || (maxPass == 4000 && !scalingFlag)) {
+      int n = subModel->numberIterations();
+      subModel->scaling(0);
+      subModel->primal();
+      subModel->setNumberIterations(n + subModel->numberIterations());
+      subModel->scaling(scalingFlag);
+    }
+  } else if (lastStatus == 1) {
+    // zero out objective
+    double saveScale = subModel->infeasibilityCost();
+    ClpObjective *saveObjective = subModel->objectiveAsObject();
+    int numberColumns = subModel->numberColumns();
+    ClpLinearObjective fake(NULL, numberColumns);
+    subModel->setObjectivePointer(&fake);
+    int saveOptions = subModel->specialOptions();
+    subModel->setSpecialOptions(saveOptions | 8192);
+    subModel->primal();
+    if ((maxPass == 5000 && scalingFlag) || (maxPass == 4000 && !scalingFlag)) {
+      int n = subModel->numberIterations();
+      subModel->scaling(0);
+      subModel->primal();
+      subModel->setNumberIterations(n + subModel->numberIterations());
+      subModel->scaling(scalingFlag);
+    }
+    subModel->setObjectivePointer(saveObjective);
+    subModel->setInfeasibilityCost(saveScale);
+    if (!subModel->isProvenOptimal() && subModel->sumPrimalInfeasibilities() < treatSubAsFeasible) {
+      printf("Block %d was infeasible now has small infeasibility %g\n", iBlock,
+        subModel->sumPrimalInfeasibilities());
+      subModel->setProblemStatus(0);
+      subModel->setPrimalTolerance(CoinMin(treatSubAsFeasible, 1.0e-4));
+      subModel->setCurrentPrimalTolerance(CoinMin(treatSubAsFeasible, 1.0e-4));
+    }
+    if (subModel->isProvenOptimal()) {
+      subModel->primal();
+      if ((maxPass == 5000 && scalingFlag) || (maxPass == 4000 && !scalingFlag)) {
+        int n = subModel->numberIterations();
+        subModel->scaling(0);
+        subModel->primal();
+        subModel->setNumberIterations(n + subModel->numberIterations());
+        subModel->scaling(scalingFlag);
+      }
+      if (!subModel->isProvenOptimal()) {
+        printf("Block %d infeasible on second go has small infeasibility %g\n", iBlock,
+          subModel->sumPrimalInfeasibilities());
+        subModel->setProblemStatus(0);
+      }
+      state |= 4; // force actions
+    } else {
+      printf("Block %d still infeasible - sum %g - %d iterations\n", iBlock,
+        subModel->sumPrimalInfeasibilities(),
+        subModel->numberIterations());
+      returnCode = 1;
+      if (!subModel->ray()) {
+        printf("Block %d has no ray!\n", iBlock);
+        subModel->primal();
+        assert(subModel->ray()); // otherwise declare optimal
+      }
+    }
+    subModel->setSpecialOptions(saveOptions);
+  } else {
+    subModel->primal();
+  }
+  subModel->setPrimalTolerance(saveTolerance);
+  subModel->setCurrentPrimalTolerance(saveTolerance);
+  if (!subModel->isProvenOptimal() && !subModel->isProvenPrimalInfeasible()) {
+    printf("!!!Block %d has bad status %d\n", iBlock, subModel->problemStatus());
+    subModel->primal(); // last go
+  }
+  //#define WRITE_ALL
+#ifdef WRITE_ALL
+  char name[20];
+  sprintf(name, "pass_%d_block_%d.mps", iPass, iBlock);
+  subModel->writeMps(name);
+  sprintf(name, "pass_%d_block_%d.bas", iPass, iBlock);
+  subModel->writeBasis(name, true);
+  if (subModel->problemStatus() == 1) {
+    subModel->readBasis(name);
+    subModel->primal();
+  }
+#endif
+  //assert (!subModel->numberIterations()||ix!=99);
+  return returnCode;
+}
 // Solve using Benders decomposition and maybe in parallel
 int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
 {
@@ -6384,6 +6686,28 @@ int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
   int numberSubInfeasible = 0;
   bool canSkipSubSolve = false;
   int numberProposals = 999;
+  /* Sub problems are solved on threads if numberThreads() > 1.
+     Each block keeps its own model so is warm started next pass. */
+  ClpThreadPool *bendersPool = NULL;
+  int numberBendersThreads = CoinMin(numberThreads(), numberBlocks);
+  if (numberBendersThreads > 1)
+    bendersPool = new ClpThreadPool(numberBendersThreads - 1);
+  int bendersCutType = options.bendersCutType();
+  int bendersAsynchronous = options.bendersAsynchronous();
+  // blocks not solved last pass (asynchronous)
+  char *waiting = new char[numberBlocks];
+  memset(waiting, 0, numberBlocks);
+  int numberWaiting = 0;
+  int *blockOrder = new int[numberBlocks];
+  int *subInfeasible = new int[numberBlocks];
+  // infeasibility of each cut - COIN_DBL_MAX if ray cut, -COIN_DBL_MAX if forced
+  double *cutInfeasibility = new double[numberBlocks];
+  // for aggregating cuts
+  double *aggregate = NULL;
+  if (bendersCutType == 1) {
+    aggregate = new double[numberMasterColumns + numberBlocks];
+    CoinZeroN(aggregate, numberMasterColumns + numberBlocks);
+  }
   for (iPass = 0; iPass < maxPass; iPass++) {
     sprintf(generalPrint, "Start of pass %d", iPass);
     handler_->message(CLP_GENERAL, messages_)
@@ -6531,7 +6855,7 @@ int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
     }
 #endif
     if (!masterStatus) {
-      if (masterModel.numberIterations() == 0 && iPass) {
+      if (masterModel.numberIterations() == 0 && iPass && !numberWaiting) {
         if ((!numberSubInfeasible && !numberProposals) || treatSubAsFeasible > 1.0e-2 || iPass > 5555)
           break; // finished
         if (!numberProposals && numberSubInfeasible) {
@@ -6728,7 +7052,7 @@ int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
           upper2[i] -= value;
       }
       bool canSkip = false;
-      if (canSkipSubSolve) {
+      if (canSkipSubSolve && !waiting[iBlock]) {
         canSkip = true;
         const double *rowSolution = sub[iBlock].primalRowSolution();
         for (int i = 0; i < numberRows2; i++) {
@@ -6811,112 +7135,56 @@ int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
 #ifdef ABC_INHERIT
     if (numberCpu < 2) {
 #endif
+      /* Sub problems each have own model so can be solved in parallel.
+         If asynchronous then only first numberWanted in order (waiting
+         ones go first) are solved and rest are left for next pass - so
+         same blocks are solved whatever the thread timing. */
       numberSubInfeasible = 0;
-      for (iBlock = 0; iBlock < numberBlocks; iBlock++) {
-#ifdef TRY_NO_SCALING
-        sub[iBlock].scaling(0);
-#endif
-        if (sub[iBlock].secondaryStatus() != 99 || false) {
-          //int ix=sub[iBlock].secondaryStatus();
-          int lastStatus = sub[iBlock].problemStatus();
-          // was do dual unless unbounded
-          double saveTolerance = sub[iBlock].primalTolerance();
-          if (lastStatus == 0 || !iPass) {
-            //if (lastStatus<2||!iPass) {
-            //sub[iBlock].dual();
-            sub[iBlock].primal();
-            if (!sub[iBlock].isProvenOptimal() && sub[iBlock].sumPrimalInfeasibilities() < treatSubAsFeasible) {
-              printf("Block %d was feasible now has small infeasibility %g\n", iBlock,
-                sub[iBlock].sumPrimalInfeasibilities());
-              sub[iBlock].setPrimalTolerance(CoinMin(treatSubAsFeasible, 1.0e-4));
-              sub[iBlock].setCurrentPrimalTolerance(CoinMin(treatSubAsFeasible, 1.0e-4));
-              sub[iBlock].primal();
-              sub[iBlock].setProblemStatus(0);
-              problemState[iBlock] |= 4; // force actions
-            }
-            if ((maxPass == 5000 && scalingFlag_) || (maxPass == 4000 && !scalingFlag_)) {
-              int n = sub[iBlock].numberIterations();
-              sub[iBlock].scaling(0);
-              sub[iBlock].primal();
-              sub[iBlock].setNumberIterations(n + sub[iBlock].numberIterations());
-              sub[iBlock].scaling(scalingFlag_);
-            }
-          } else if (lastStatus == 1) {
-            // zero out objective
-            double saveScale = sub[iBlock].infeasibilityCost();
-            ClpObjective *saveObjective = sub[iBlock].objectiveAsObject();
-            int numberColumns = sub[iBlock].numberColumns();
-            ClpLinearObjective fake(NULL, numberColumns);
-            sub[iBlock].setObjectivePointer(&fake);
-            int saveOptions = sub[iBlock].specialOptions();
-            sub[iBlock].setSpecialOptions(saveOptions | 8192);
-            sub[iBlock].primal();
-            if ((maxPass == 5000 && scalingFlag_) || (maxPass == 4000 && !scalingFlag_)) {
-              int n = sub[iBlock].numberIterations();
-              sub[iBlock].scaling(0);
-              sub[iBlock].primal();
-              sub[iBlock].setNumberIterations(n + sub[iBlock].numberIterations());
-              sub[iBlock].scaling(scalingFlag_);
-            }
-            sub[iBlock].setObjectivePointer(saveObjective);
-            sub[iBlock].setInfeasibilityCost(saveScale);
-            if (!sub[iBlock].isProvenOptimal() && sub[iBlock].sumPrimalInfeasibilities() < treatSubAsFeasible) {
-              printf("Block %d was infeasible now has small infeasibility %g\n", iBlock,
-                sub[iBlock].sumPrimalInfeasibilities());
-              sub[iBlock].setProblemStatus(0);
-              sub[iBlock].setPrimalTolerance(CoinMin(treatSubAsFeasible, 1.0e-4));
-              sub[iBlock].setCurrentPrimalTolerance(CoinMin(treatSubAsFeasible, 1.0e-4));
-            }
-            if (sub[iBlock].isProvenOptimal()) {
-              sub[iBlock].primal();
-              if ((maxPass == 5000 && scalingFlag_) || (maxPass == 4000 && !scalingFlag_)) {
-                int n = sub[iBlock].numberIterations();
-                sub[iBlock].scaling(0);
-                sub[iBlock].primal();
-                sub[iBlock].setNumberIterations(n + sub[iBlock].numberIterations());
-                sub[iBlock].scaling(scalingFlag_);
-              }
-              if (!sub[iBlock].isProvenOptimal()) {
-                printf("Block %d infeasible on second go has small infeasibility %g\n", iBlock,
-                  sub[iBlock].sumPrimalInfeasibilities());
-                sub[iBlock].setProblemStatus(0);
-              }
-              problemState[iBlock] |= 4; // force actions
-            } else {
-              printf("Block %d still infeasible - sum %g - %d iterations\n", iBlock,
-                sub[iBlock].sumPrimalInfeasibilities(),
-                sub[iBlock].numberIterations());
-              numberSubInfeasible++;
-              if (!sub[iBlock].ray()) {
-                printf("Block %d has no ray!\n", iBlock);
-                sub[iBlock].primal();
-                assert(sub[iBlock].ray()); // otherwise declare optimal
-              }
-            }
-            sub[iBlock].setSpecialOptions(saveOptions);
-          } else {
-            sub[iBlock].primal();
-          }
-          sub[iBlock].setPrimalTolerance(saveTolerance);
-          sub[iBlock].setCurrentPrimalTolerance(saveTolerance);
-          if (!sub[iBlock].isProvenOptimal() && !sub[iBlock].isProvenPrimalInfeasible()) {
-            printf("!!!Block %d has bad status %d\n", iBlock, sub[iBlock].problemStatus());
-            sub[iBlock].primal(); // last go
-          }
-          //#define WRITE_ALL
-#ifdef WRITE_ALL
-          char name[20];
-          sprintf(name, "pass_%d_block_%d.mps", iPass, iBlock);
-          sub[iBlock].writeMps(name);
-          sprintf(name, "pass_%d_block_%d.bas", iPass, iBlock);
-          sub[iBlock].writeBasis(name, true);
-          if (sub[iBlock].problemStatus() == 1) {
-            sub[iBlock].readBasis(name);
-            sub[iBlock].primal();
-          }
-#endif
-          //assert (!sub[iBlock].numberIterations()||ix!=99);
+      int numberToSolve = 0;
+      for (int k = 0; k < 2; k++) {
+        for (iBlock = 0; iBlock < numberBlocks; iBlock++) {
+          if (sub[iBlock].secondaryStatus() != 99 && waiting[iBlock] == 1 - k)
+            blockOrder[numberToSolve++] = iBlock;
+        }
+      }
+      int numberWanted = numberToSolve;
+      if (bendersAsynchronous > 0 && iPass)
+        numberWanted = CoinMin(bendersAsynchronous, numberToSolve);
+      for (int k = numberWanted; k < numberToSolve; k++) {
+        // leave for next pass
+        iBlock = blockOrder[k];
+        waiting[iBlock] = 1;
+        sub[iBlock].setSecondaryStatus(99);
+      }
+      {
+        ClpTaskGroup tasks(bendersPool);
+        for (int k = 0; k < numberWanted; k++) {
+          int jBlock = blockOrder[k];
+          ClpSimplex *subModel = sub + jBlock;
+          int *state = problemState + jBlock;
+          int *infeasible = subInfeasible + jBlock;
+          int scalingFlag = scalingFlag_;
+          waiting[jBlock] = 0;
+          tasks.spawn([=]() {
+            *infeasible = solveBendersBlock(subModel, jBlock, iPass, maxPass,
+              scalingFlag, treatSubAsFeasible, *state);
+          });
         }
+        tasks.sync();
+      }
+      numberWaiting = 0;
+      for (int k = 0; k < numberToSolve; k++) {
+        iBlock = blockOrder[k];
+        if (waiting[iBlock])
+          numberWaiting++;
+        else
+          numberSubInfeasible += subInfeasible[iBlock];
+      }
+      if (numberWaiting) {
+        sprintf(generalPrint, "%d sub problems left for next pass", numberWaiting);
+        handler_->message(CLP_GENERAL2, messages_)
+          << generalPrint
+          << CoinMessageEol;
       }
 #ifdef ABC_INHERIT
     } else {
@@ -7159,7 +7427,8 @@ int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
               infeas += primal[numberMasterColumns + iBlock] * scale;
               printf("** new infeas %g - scales to %g\n", infeas, infeas / scale);
             }
-            if (infeas < -1.0e-6 || (problemState[iBlock] & 4) != 0) {
+            // if aggregating then take all and see if sum cuts off
+            if (infeas < -1.0e-6 || (problemState[iBlock] & 4) != 0 || aggregate) {
               // take
               // double check infeasibility
               if (logLevel > 3)
@@ -7175,6 +7444,7 @@ int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
               if (logLevel > 1)
                 printf("Cut for block %d has %d elements\n", iBlock, number - 1 - start);
               blockPrint[numberProposals] = iBlock;
+              cutInfeasibility[numberProposals] = ((problemState[iBlock] & 4) != 0) ? -COIN_DBL_MAX : infeas;
               objective[numberProposals] = -objValue;
               rowAdd[++numberProposals] = number;
               when[numberRowsGenerated] = iPass;
@@ -7554,6 +7824,7 @@ int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
               if (logLevel > 1)
                 printf("Cut for block %d has %d elements (infeasibility)\n", iBlock, number - start);
               blockPrint[numberProposals] = iBlock;
+              cutInfeasibility[numberProposals] = COIN_DBL_MAX;
               // take
               objective[numberProposals] = objValue;
               rowAdd[++numberProposals] = number;
@@ -7567,7 +7838,77 @@ int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
       } else {
         //printf("Can skip\n");
       }
-      problemState[iBlock] &= ~4;
+      if (!waiting[iBlock])
+        problemState[iBlock] &= ~4;
+    }
+    if (aggregate) {
+      /* Single cut - add optimality cuts together (theta for each
+         block stays in).  Feasibility cuts are kept as they are. */
+      int numberOptimality = 0;
+      for (int i = 0; i < numberProposals; i++) {
+        if (cutInfeasibility[i] != COIN_DBL_MAX)
+          numberOptimality++;
+      }
+      if (numberOptimality) {
+        int firstRow = numberRowsGenerated - numberProposals;
+        int nKeep = 0;
+        int firstBlock = -1;
+        bool forced = false;
+        double sumInfeasibility = 0.0;
+        double rhs = 0.0;
+        CoinBigIndex put = 0;
+        CoinBigIndex start = 0;
+        for (int i = 0; i < numberProposals; i++) {
+          CoinBigIndex end = rowAdd[i + 1];
+          if (cutInfeasibility[i] != COIN_DBL_MAX) {
+            for (CoinBigIndex j = start; j < end; j++)
+              aggregate[indexColumnAdd[j]] += elementAdd[j];
+            rhs += objective[i];
+            if (cutInfeasibility[i] == -COIN_DBL_MAX)
+              forced = true;
+            else
+              sumInfeasibility += cutInfeasibility[i];
+            if (firstBlock < 0)
+              firstBlock = blockPrint[i];
+          } else {
+            // keep feasibility cut
+            for (CoinBigIndex j = start; j < end; j++) {
+              indexColumnAdd[put] = indexColumnAdd[j];
+              elementAdd[put++] = elementAdd[j];
+            }
+            objective[nKeep] = objective[i];
+            blockPrint[nKeep] = blockPrint[i];
+            when[firstRow + nKeep] = when[firstRow + i];
+            whichBlock[firstRow + nKeep] = whichBlock[firstRow + i];
+            rowAdd[++nKeep] = put;
+          }
+          start = end;
+        }
+        if (forced || sumInfeasibility < -1.0e-6) {
+          for (int i = 0; i < numberMasterColumns + numberBlocks; i++) {
+            double value = aggregate[i];
+            if (value) {
+              aggregate[i] = 0.0;
+              if (fabs(value) > 1.0e-12) {
+                indexColumnAdd[put] = i;
+                elementAdd[put++] = value;
+              }
+            }
+          }
+          objective[nKeep] = rhs;
+          blockPrint[nKeep] = firstBlock;
+          when[firstRow + nKeep] = iPass;
+          whichBlock[firstRow + nKeep] = firstBlock;
+          rowAdd[++nKeep] = put;
+        } else {
+          CoinZeroN(aggregate, numberMasterColumns + numberBlocks);
+        }
+        if (logLevel > 1)
+          printf("%d optimality cuts aggregated into %d\n", numberOptimality,
+            nKeep - (numberProposals - numberOptimality));
+        numberRowsGenerated -= numberProposals - nKeep;
+        numberProposals = nKeep;
+      }
     }
     if (deletePrimal)
       delete[] primal;
@@ -7752,6 +8093,12 @@ int ClpSimplex::solveBenders(CoinStructuredModel *model, ClpSolve &options)
         rowAdd, indexColumnAdd, elementAdd);
     }
   }
+  delete bendersPool;
+  delete[] waiting;
+  delete[] blockOrder;
+  delete[] subInfeasible;
+  delete[] cutInfeasibility;
+  delete[] aggregate;
   sprintf(generalPrint, "Time at end of Benders %.2f seconds", CoinCpuTime() - time1);
   handler_->message(CLP_GENERAL, messages_)
     << generalPrint
@@ -95,6 +95,7 @@ public:
        	   8 - bit set to do scaling
        	   16 - set to be aggressive with gamma/delta?
                       32 - Use KKT
+                      8192 - with KKT use ClpCholeskyKKT (regularized, threads)
          5 - for presolve
                       1 - switch off dual stuff
          6 - extra switches
@@ -252,6 +253,21 @@ public:
     else
       independentOptions_[1] |= 8192;
   }
+  /** Whether automatic method may use network simplex
+         (ClpSimplex::networkSolve) if model is a pure network.
+         Default is no.  Network simplex does not scale or call event handler.
+     */
+  inline bool useNetwork() const
+  {
+    return (independentOptions_[1] & 0x01000000) != 0;
+  }
+  inline void setUseNetwork(bool trueFalse)
+  {
+    if (trueFalse)
+      independentOptions_[1] |= 0x01000000;
+    else
+      independentOptions_[1] &= ~0x01000000;
+  }
   /// Set whole group
   inline int presolveActions() const
   {
@@ -278,6 +294,30 @@ public:
   {
     return independentOptions_[type];
   }
+  /** Benders cuts
+         0 - one optimality cut per block each pass (default)
+         1 - optimality cuts added together into one cut each pass
+     */
+  inline int bendersCutType() const
+  {
+    return bendersOptions_[0];
+  }
+  inline void setBendersCutType(int value)
+  {
+    bendersOptions_[0] = value;
+  }
+  /** Asynchronous Benders - if >0 master is solved again once this
+         many sub problems have been solved (others wait for next pass
+         and go first then, so result does not depend on threads).
+         0 (default) solves all sub problems each pass */
+  inline int bendersAsynchronous() const
+  {
+    return bendersOptions_[1];
+  }
+  inline void setBendersAsynchronous(int value)
+  {
+    bendersOptions_[1] = value;
+  }
   //@}
 
   ////////////////// data //////////////////
@@ -302,6 +342,8 @@ private:
 	 If Dantzig Wolfe/benders 0 is number blocks, 2 is #passes (notional)
      */
   int independentOptions_[3];
+  /// Benders options - 0 cut type, 1 number of sub problems before master
+  int bendersOptions_[2];
   //@}
 };
 
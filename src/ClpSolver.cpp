@@ -265,6 +265,7 @@ int ClpMain1(int argc, const char *argv[], AbcSimplex *models)
   int substitution = 3;
   int dualize = 3; // dualize if looks promising
   std::string exportBasisFile = "default.bas";
+  std::string binaryBasisFile = "default.bbas";
   std::string saveFile = "default.prob";
   std::string restoreFile = "default.prob";
   std::string solutionFile = "stdout";
@@ -274,6 +275,8 @@ int ClpMain1(int argc, const char *argv[], AbcSimplex *models)
   establishParams(parameters);
   parameters[whichParam(CLP_PARAM_ACTION_BASISIN, parameters)].setStringValue(importBasisFile);
   parameters[whichParam(CLP_PARAM_ACTION_BASISOUT, parameters)].setStringValue(exportBasisFile);
+  parameters[whichParam(CLP_PARAM_ACTION_SAVEBASIS, parameters)].setStringValue(binaryBasisFile);
+  parameters[whichParam(CLP_PARAM_ACTION_RESTOREBASIS, parameters)].setStringValue(binaryBasisFile);
   parameters[whichParam(CLP_PARAM_ACTION_PRINTMASK, parameters)].setStringValue(printMask);
   parameters[whichParam(CLP_PARAM_ACTION_DIRECTORY, parameters)].setStringValue(directory);
   parameters[whichParam(CLP_PARAM_ACTION_DIRSAMPLE, parameters)].setStringValue(dirSample);
@@ -1084,6 +1087,8 @@ int ClpMain1(int argc, const char *argv[], AbcSimplex *models)
               }
               if (doKKT)
                 barrierOptions |= 16;
+              if (doKKT == 2)
+                barrierOptions |= 8192; // parallel KKT
               if (gamma)
                 barrierOptions |= 32 * gamma;
               if (crossover == 3)
@@ -1113,9 +1118,15 @@ int ClpMain1(int argc, const char *argv[], AbcSimplex *models)
             if (smallCode != -1)
               model2->factorization()->setGoSmallThreshold(smallCode);
             model2->factorization()->goDenseOrSmall(model2->numberRows());
+            int adaptiveSolves = parameters[whichParam(CLP_PARAM_INT_ADAPTIVESOLVES, parameters)].intValue();
+            model2->factorization()->setAdaptiveSolves(adaptiveSolves);
 #endif
             try {
               status = model2->initialSolve(solveOptions);
+#ifdef CLP_MULTIPLE_FACTORIZATIONS
+              if (adaptiveSolves)
+                model2->factorization()->printSolveStatistics(model2);
+#endif
               if (usingAmpl) {
                 double value = model2->getObjValue() * model2->getObjSense();
                 char buf[300];
@@ -1832,6 +1843,54 @@ int ClpMain1(int argc, const char *argv[], AbcSimplex *models)
             std::cout << "** Current model not valid" << std::endl;
           }
           break;
+        case CLP_PARAM_ACTION_SAVEBASIS:
+        case CLP_PARAM_ACTION_RESTOREBASIS:
+          if (goodModels[iModel]) {
+            // get next field
+            field = CoinReadGetString(argc, argv);
+            if (field == "$") {
+              field = parameters[iParam].stringValue();
+            } else if (field == "EOL") {
+              parameters[iParam].printString();
+              break;
+            } else {
+              parameters[iParam].setStringValue(field);
+            }
+            std::string fileName;
+            if (field[0] == '/' || field[0] == '\\') {
+              fileName = field;
+            } else if (field[0] == '~') {
+              char *environVar = getenv("HOME");
+              if (environVar) {
+                std::string home(environVar);
+                field = field.erase(0, 1);
+                fileName = home + field;
+              } else {
+                fileName = field;
+              }
+            } else {
+              fileName = directory + field;
+            }
+            ClpSimplex *model2 = models + iModel;
+            if (type == CLP_PARAM_ACTION_SAVEBASIS) {
+              if (model2->writeBasisBinary(fileName.c_str(), outputFormat > 1))
+                std::cout << "Unable to write basis to " << fileName << std::endl;
+            } else {
+              int values = model2->readBasisBinary(fileName.c_str());
+              if (values == -2)
+                std::cout << "Basis in " << fileName << " is not for this model" << std::endl;
+              else if (values == 0)
+                basisHasValues = -1;
+              else if (values == 1)
+                basisHasValues = 1;
+            }
+            time2 = CoinCpuTime();
+            totalTime += time2 - time1;
+            time1 = time2;
+          } else {
+            std::cout << "** Current model not valid" << std::endl;
+          }
+          break;
         case CLP_PARAM_ACTION_PARAMETRICS:
           if (goodModels[iModel]) {
             // get next field
@@ -0,0 +1,203 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#include "CoinPragma.hpp"
+
+#include "ClpThreadPool.hpp"
+
+struct ClpThreadPool::Task {
+  /// What to do
+  std::function< void() > work;
+  /// 0 queued, 1 running, 2 finished
+  int status;
+};
+
+ClpThreadPool::ClpThreadPool(int numberThreads)
+  : stop_(false)
+{
+  startThreads(numberThreads);
+}
+
+ClpThreadPool::~ClpThreadPool()
+{
+  stopThreads();
+}
+
+void ClpThreadPool::startThreads(int numberThreads)
+{
+  stop_ = false;
+  workers_.reserve(numberThreads > 0 ? numberThreads : 0);
+  for (int i = 0; i < numberThreads; i++)
+    workers_.push_back(std::thread(&ClpThreadPool::workerLoop, this));
+}
+
+void ClpThreadPool::stopThreads()
+{
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    stop_ = true;
+  }
+  workToDo_.notify_all();
+  for (size_t i = 0; i < workers_.size(); i++)
+    workers_[i].join();
+  workers_.clear();
+  // anything left (only if no threads) is done here
+  std::unique_lock< std::mutex > lock(mutex_);
+  while (!queue_.empty()) {
+    Handle task = queue_.front();
+    queue_.pop_front();
+    runTask(lock, task);
+  }
+}
+
+void ClpThreadPool::setNumberThreads(int numberThreads)
+{
+  if (numberThreads == this->numberThreads())
+    return;
+  stopThreads();
+  startThreads(numberThreads);
+}
+
+int ClpThreadPool::hardwareThreads()
+{
+  unsigned int number = std::thread::hardware_concurrency();
+  return number ? static_cast< int >(number) : 1;
+}
+
+void ClpThreadPool::runTask(std::unique_lock< std::mutex > &lock, const Handle &task)
+{
+  task->status = 1;
+  lock.unlock();
+  task->work();
+  lock.lock();
+  task->status = 2;
+  // release anything captured as soon as possible
+  task->work = std::function< void() >();
+  workDone_.notify_all();
+}
+
+void ClpThreadPool::workerLoop()
+{
+  std::unique_lock< std::mutex > lock(mutex_);
+  while (true) {
+    while (!stop_ && queue_.empty())
+      workToDo_.wait(lock);
+    if (queue_.empty())
+      break; // stopping
+    Handle task = queue_.front();
+    queue_.pop_front();
+    runTask(lock, task);
+  }
+}
+
+ClpThreadPool::Handle
+ClpThreadPool::spawn(const std::function< void() > &work)
+{
+  Handle task(new Task);
+  task->work = work;
+  task->status = 0;
+  if (workers_.empty()) {
+    task->work();
+    task->work = std::function< void() >();
+    task->status = 2;
+    return task;
+  }
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    queue_.push_back(task);
+  }
+  workToDo_.notify_one();
+  return task;
+}
+
+bool ClpThreadPool::finished(const Handle &handle) const
+{
+  std::lock_guard< std::mutex > lock(mutex_);
+  return handle->status == 2;
+}
+
+void ClpThreadPool::wait(const Handle &handle)
+{
+  std::unique_lock< std::mutex > lock(mutex_);
+  while (handle->status != 2) {
+    if (handle->status == 0) {
+      // not started - do it ourselves
+      for (std::deque< Handle >::iterator it = queue_.begin(); it != queue_.end(); ++it) {
+        if (*it == handle) {
+          queue_.erase(it);
+          break;
+        }
+      }
+      runTask(lock, handle);
+    } else if (!queue_.empty()) {
+      // help while it runs elsewhere
+      Handle task = queue_.front();
+      queue_.pop_front();
+      runTask(lock, task);
+    } else {
+      workDone_.wait(lock);
+    }
+  }
+}
+
+void ClpThreadPool::parallelFor(int first, int last, int numberBlocks,
+  const BlockFunction &work)
+{
+  int number = last - first;
+  if (number <= 0)
+    return;
+  numberBlocks = numberBlocks < number ? numberBlocks : number;
+  if (numberBlocks < 1)
+    numberBlocks = 1;
+  // ranges do not depend on threads so results are repeatable
+  int chunk = (number + numberBlocks - 1) / numberBlocks;
+  std::vector< Handle > tasks;
+  tasks.reserve(numberBlocks);
+  for (int iBlock = 1; iBlock < numberBlocks; iBlock++) {
+    int start = first + iBlock * chunk;
+    int end = start + chunk < last ? start + chunk : last;
+    if (start >= end)
+      break;
+    tasks.push_back(spawn(std::bind(work, iBlock, start, end)));
+  }
+  work(0, first, first + chunk < last ? first + chunk : last);
+  for (size_t i = 0; i < tasks.size(); i++)
+    wait(tasks[i]);
+}
+
+ClpTaskGroup::ClpTaskGroup(ClpThreadPool *pool)
+  : pool_(pool)
+{
+  if (pool_ && !pool_->numberThreads())
+    pool_ = NULL;
+}
+
+ClpTaskGroup::~ClpTaskGroup()
+{
+  sync();
+}
+
+void ClpTaskGroup::spawn(const std::function< void() > &work)
+{
+  if (pool_)
+    tasks_.push_back(pool_->spawn(work));
+  else
+    work();
+}
+
+void ClpTaskGroup::sync()
+{
+  for (size_t i = 0; i < tasks_.size(); i++)
+    pool_->wait(tasks_[i]);
+  tasks_.clear();
+}
+
+ClpThreadPool *ClpPricingThreadPool()
+{
+  int number = ClpThreadPool::hardwareThreads();
+  static ClpThreadPool pool((number < 8 ? number : 8) - 1);
+  return &pool;
+}
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
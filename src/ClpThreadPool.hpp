@@ -0,0 +1,137 @@
+// Copyright (C) 2024, COIN-OR Foundation and others.  All Rights Reserved.
+// This code is licensed under the terms of the Eclipse Public License (EPL).
+
+#ifndef ClpThreadPool_H
+#define ClpThreadPool_H
+
+#include "CoinPragma.hpp"
+#include "ClpConfig.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** Persistent pool of worker threads.
+
+    Work is handed over with spawn which returns a handle that can be
+    waited on.  A thread which waits runs queued work itself while it
+    waits, so work which spawns more work can not deadlock the pool.
+    With zero threads all work is done inline by the caller, so code
+    can always go through a pool and choose parallelism at run time.
+*/
+class CLPLIB_EXPORT ClpThreadPool {
+
+public:
+  /// Work item as seen by pool (opaque to users)
+  struct Task;
+  /// Handle returned by spawn
+  typedef std::shared_ptr< Task > Handle;
+  /// Work over a block - arguments are block number, first and last+1
+  typedef std::function< void(int, int, int) > BlockFunction;
+
+  /**@name Constructors and destructor */
+  //@{
+  /// Constructor - numberThreads extra threads are started
+  explicit ClpThreadPool(int numberThreads = 0);
+  /// Destructor - waits for all work and stops threads
+  ~ClpThreadPool();
+  //@}
+
+  /**@name Work */
+  //@{
+  /// Queues work and returns handle (done at once if no threads)
+  Handle spawn(const std::function< void() > &work);
+  /// Waits for work to finish (running queued work meanwhile)
+  void wait(const Handle &handle);
+  /// Returns true if work finished
+  bool finished(const Handle &handle) const;
+  /** Splits first to last into numberBlocks ranges and does
+      work(iBlock,start,end) on each.  Caller does block 0 and
+      returns when all blocks are finished.  Ranges only depend on
+      first, last and numberBlocks so results can be deterministic. */
+  void parallelFor(int first, int last, int numberBlocks,
+    const BlockFunction &work);
+  //@}
+
+  /**@name Gets and sets */
+  //@{
+  /// Number of worker threads (not counting caller)
+  inline int numberThreads() const
+  {
+    return static_cast< int >(workers_.size());
+  }
+  /// Changes number of worker threads - must not be in use
+  void setNumberThreads(int numberThreads);
+  /// Number of hardware threads (at least 1)
+  static int hardwareThreads();
+  //@}
+
+private:
+  /// Not copyable
+  ClpThreadPool(const ClpThreadPool &);
+  ClpThreadPool &operator=(const ClpThreadPool &);
+  /// Starts threads
+  void startThreads(int numberThreads);
+  /// Stops all threads after finishing queued work
+  void stopThreads();
+  /// Loop run by each worker
+  void workerLoop();
+  /// Runs one task (mutex must be held and is held on return)
+  void runTask(std::unique_lock< std::mutex > &lock, const Handle &task);
+
+  /// Worker threads
+  std::vector< std::thread > workers_;
+  /// Queued work
+  std::deque< Handle > queue_;
+  /// Protects queue and task states
+  mutable std::mutex mutex_;
+  /// Signalled when work queued or stopping
+  std::condition_variable workToDo_;
+  /// Signalled when a task finishes
+  std::condition_variable workDone_;
+  /// True when threads should exit
+  bool stop_;
+};
+
+/** Group of tasks in the style of spawn/sync.
+
+    Spawned work goes to pool if there is one with threads, otherwise it
+    is done immediately.  Work must not outlive the group so sync is also
+    done by destructor.
+*/
+class CLPLIB_EXPORT ClpTaskGroup {
+
+public:
+  /// Constructor (pool may be NULL)
+  explicit ClpTaskGroup(ClpThreadPool *pool);
+  /// Destructor - does sync
+  ~ClpTaskGroup();
+  /// Spawn work
+  void spawn(const std::function< void() > &work);
+  /// Wait for all spawned work
+  void sync();
+
+private:
+  /// Not copyable
+  ClpTaskGroup(const ClpTaskGroup &);
+  ClpTaskGroup &operator=(const ClpTaskGroup &);
+  /// Pool (may be NULL)
+  ClpThreadPool *pool_;
+  /// Outstanding work
+  std::vector< ClpThreadPool::Handle > tasks_;
+};
+
+/** Pool shared by matrix pricing and, when parallelMode is set, the
+    dense factorization kernels of Abc (hardware threads less one, at
+    most 7).  Having one pool means pricing and dense LU never together
+    start more threads than the machine has.  Threads are started on
+    first use. */
+CLPLIB_EXPORT ClpThreadPool *ClpPricingThreadPool();
+#endif
+
+/* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
+*/
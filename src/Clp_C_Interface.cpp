@@ -12,20 +12,85 @@
 #include "CoinHelperFunctions.hpp"
 #include "ClpSimplex.hpp"
 #include "ClpInterior.hpp"
+#include "ClpPackedMatrix.hpp"
+#include "CoinBuild.hpp"
 #ifndef SLIM_CLP
 #include "Idiot.hpp"
 #endif
 
 class CMessageHandler;
+class CBorrowedMatrix;
 struct Clp_Simplex_s {
   ClpSimplex*      model_;
   CMessageHandler* handler_;
+  CBorrowedMatrix* borrowed_;
 };
 
 struct Clp_Solve_s {
   ClpSolve options;
 };
 
+struct Clp_Build_s {
+  CoinBuild build;
+  Clp_Build_s(int type)
+    : build(type)
+  {
+  }
+};
+
+/// Matrix using caller's arrays - these are never freed
+class CBorrowedMatrix : public CoinPackedMatrix {
+
+public:
+  CBorrowedMatrix(bool colOrdered, int minor, int major,
+    CoinBigIndex *start, int *index, double *value)
+  {
+    setExtraGap(0.0);
+    setExtraMajor(0.0);
+    int *length = NULL;
+    assignMatrix(colOrdered, minor, major, start[major],
+      value, index, start, length);
+  }
+  ~CBorrowedMatrix()
+  {
+    releaseArrays();
+  }
+  /// Forgets caller's arrays (lengths were created by assignMatrix)
+  void releaseArrays()
+  {
+    delete[] length_;
+    element_ = NULL;
+    index_ = NULL;
+    start_ = NULL;
+    length_ = NULL;
+    majorDim_ = 0;
+    minorDim_ = 0;
+    size_ = 0;
+    maxMajorDim_ = 0;
+    maxSize_ = 0;
+  }
+};
+
+/* If model is still using borrowed arrays then replaces them by a
+   private copy (or if problem is about to be replaced just forgets them) */
+static void releaseBorrowed(Clp_Simplex *model, bool keepMatrix)
+{
+  CBorrowedMatrix *borrowed = model->borrowed_;
+  if (borrowed) {
+    model->borrowed_ = NULL;
+    ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(model->model_->clpMatrix());
+    if (clpMatrix && clpMatrix->getPackedMatrix() == borrowed) {
+      if (keepMatrix) {
+        CoinPackedMatrix *matrix = new CoinPackedMatrix(*borrowed);
+        borrowed->releaseArrays();
+        model->model_->replaceMatrix(new ClpPackedMatrix(matrix), true);
+      } else {
+        borrowed->releaseArrays();
+      }
+    }
+  }
+}
+
 
 /// To allow call backs
 class CMessageHandler : public CoinMessageHandler {
@@ -225,12 +290,14 @@ Clp_newModel()
   Clp_Simplex *model = new Clp_Simplex;
   model->model_ = new ClpSimplex();
   model->handler_ = NULL;
+  model->borrowed_ = NULL;
   return model;
 }
 /* Destructor */
 void CLP_LINKAGE
 Clp_deleteModel(Clp_Simplex *model)
 {
+  releaseBorrowed(model, false);
   delete model->model_;
   delete model->handler_;
   delete model;
@@ -267,9 +334,99 @@ Clp_loadProblem(Clp_Simplex *model, const int numcols, const int numrows,
     printf("%s collb = %p, colub = %p, obj = %p, rowlb = %p, rowub = %p\n",
       prefix, reinterpret_cast< const void * >(collb), reinterpret_cast< const void * >(colub), reinterpret_cast< const void * >(obj), reinterpret_cast< const void * >(rowlb), reinterpret_cast< const void * >(rowub));
   }
+  releaseBorrowed(model, false);
   model->model_->loadProblem(numcols, numrows, start, index, value,
     collb, colub, obj, rowlb, rowub);
 }
+/* Loads a problem from arrays owned by caller - copying, adopting or
+   borrowing them */
+void CLP_LINKAGE
+Clp_assignProblem(Clp_Simplex *model, const int numcols, const int numrows,
+  int columnOrdered,
+  CoinBigIndex *start, int *index,
+  double *value,
+  double *collb, double *colub,
+  double *obj,
+  double *rowlb, double *rowub,
+  int ownership)
+{
+  releaseBorrowed(model, false);
+  int major = columnOrdered ? numcols : numrows;
+  int minor = columnOrdered ? numrows : numcols;
+  CoinPackedMatrix *matrix;
+  if (ownership == 1 && columnOrdered) {
+    // just take over
+    matrix = new CoinPackedMatrix();
+    matrix->setExtraGap(0.0);
+    matrix->setExtraMajor(0.0);
+    int *length = NULL;
+    matrix->assignMatrix(true, minor, major, start[major],
+      value, index, start, length);
+  } else {
+    CBorrowedMatrix *borrowed = new CBorrowedMatrix(columnOrdered != 0,
+      minor, major, start, index, value);
+    if (ownership == 2 && columnOrdered) {
+      matrix = borrowed;
+      model->borrowed_ = borrowed;
+    } else {
+      // one copy (transposed if row ordered)
+      matrix = new CoinPackedMatrix();
+      matrix->setExtraGap(0.0);
+      matrix->setExtraMajor(0.0);
+      if (columnOrdered)
+        matrix->copyOf(*borrowed);
+      else
+        matrix->reverseOrderedCopyOf(*borrowed);
+      delete borrowed;
+      if (ownership == 1) {
+        delete[] start;
+        delete[] index;
+        delete[] value;
+      }
+    }
+  }
+  if (ownership != 1) {
+    // rim arrays are always copied
+    collb = CoinCopyOfArray(collb, numcols);
+    colub = CoinCopyOfArray(colub, numcols);
+    obj = CoinCopyOfArray(obj, numcols);
+    rowlb = CoinCopyOfArray(rowlb, numrows);
+    rowub = CoinCopyOfArray(rowub, numrows);
+  }
+  model->model_->assignProblem(matrix, collb, colub, obj, rowlb, rowub);
+}
+/* Arrays which may be adopted by Clp_assignProblem */
+double *CLP_LINKAGE
+Clp_newDoubleArray(CoinBigIndex size)
+{
+  return new double[size];
+}
+int *CLP_LINKAGE
+Clp_newIntArray(int size)
+{
+  return new int[size];
+}
+CoinBigIndex *CLP_LINKAGE
+Clp_newBigIndexArray(CoinBigIndex size)
+{
+  return new CoinBigIndex[size];
+}
+/* Frees arrays which were not adopted */
+void CLP_LINKAGE
+Clp_deleteDoubleArray(double *array)
+{
+  delete[] array;
+}
+void CLP_LINKAGE
+Clp_deleteIntArray(int *array)
+{
+  delete[] array;
+}
+void CLP_LINKAGE
+Clp_deleteBigIndexArray(CoinBigIndex *array)
+{
+  delete[] array;
+}
 
 /* read quadratic part of the objective (the matrix part) */
 void CLP_LINKAGE
@@ -289,6 +446,7 @@ Clp_readMps(Clp_Simplex *model, const char *filename,
   int keepNames,
   int ignoreErrors)
 {
+  releaseBorrowed(model, false);
   return model->model_->readMps(filename, keepNames != 0, ignoreErrors != 0);
 }
 /* Write an MPS file to the given filename */
@@ -316,12 +474,14 @@ Clp_deleteIntegerInformation(Clp_Simplex *model)
 void CLP_LINKAGE
 Clp_resize(Clp_Simplex *model, int newNumberRows, int newNumberColumns)
 {
+  releaseBorrowed(model, true);
   model->model_->resize(newNumberRows, newNumberColumns);
 }
 /* Deletes rows */
 void CLP_LINKAGE
 Clp_deleteRows(Clp_Simplex *model, int number, const int *which)
 {
+  releaseBorrowed(model, true);
   model->model_->deleteRows(number, which);
 }
 /* Add rows */
@@ -331,6 +491,7 @@ Clp_addRows(Clp_Simplex *model, int number, const double *rowLower,
   const CoinBigIndex *rowStarts, const int *columns,
   const double *elements)
 {
+  releaseBorrowed(model, true);
   model->model_->addRows(number, rowLower, rowUpper, rowStarts, columns, elements);
 }
 
@@ -338,6 +499,7 @@ Clp_addRows(Clp_Simplex *model, int number, const double *rowLower,
 void CLP_LINKAGE
 Clp_deleteColumns(Clp_Simplex *model, int number, const int *which)
 {
+  releaseBorrowed(model, true);
   model->model_->deleteColumns(number, which);
 }
 /* Add columns */
@@ -348,6 +510,7 @@ Clp_addColumns(Clp_Simplex *model, int number, const double *columnLower,
   const CoinBigIndex *columnStarts, const int *rows,
   const double *elements)
 {
+  releaseBorrowed(model, true);
   model->model_->addColumns(number, columnLower, columnUpper, objective,
     columnStarts, rows, elements);
 }
@@ -386,6 +549,7 @@ void CLP_LINKAGE
 Clp_modifyCoefficient(Clp_Simplex *model, int row, int column, double newElement,
   int keepZero)
 {
+  releaseBorrowed(model, true);
   model->model_->modifyCoefficient(row, column, newElement, keepZero);
 }
 /* Drops names - makes lengthnames 0 and names empty */
@@ -416,6 +580,57 @@ Clp_copyNames(Clp_Simplex *model, const char *const *rowNamesIn,
   }
   model->model_->copyNames(rowNames, columnNames);
 }
+/* Staged building */
+Clp_Build *CLP_LINKAGE
+ClpBuild_new(int type)
+{
+  return new Clp_Build(type);
+}
+void CLP_LINKAGE
+ClpBuild_delete(Clp_Build *build)
+{
+  delete build;
+}
+void CLP_LINKAGE
+ClpBuild_addRow(Clp_Build *build, int numberInRow,
+  const int *columns, const double *elements,
+  double rowLower, double rowUpper)
+{
+  build->build.addRow(numberInRow, columns, elements, rowLower, rowUpper);
+}
+void CLP_LINKAGE
+ClpBuild_addColumn(Clp_Build *build, int numberInColumn,
+  const int *rows, const double *elements,
+  double columnLower, double columnUpper, double objective)
+{
+  build->build.addColumn(numberInColumn, rows, elements,
+    columnLower, columnUpper, objective);
+}
+int CLP_LINKAGE
+ClpBuild_numberRows(Clp_Build *build)
+{
+  return build->build.numberRows();
+}
+int CLP_LINKAGE
+ClpBuild_numberColumns(Clp_Build *build)
+{
+  return build->build.numberColumns();
+}
+/* Adds all rows (columns) in build to model */
+int CLP_LINKAGE
+Clp_addRowsFromBuild(Clp_Simplex *model, Clp_Build *build,
+  int checkDuplicates)
+{
+  releaseBorrowed(model, true);
+  return model->model_->addRows(build->build, false, checkDuplicates != 0);
+}
+int CLP_LINKAGE
+Clp_addColumnsFromBuild(Clp_Simplex *model, Clp_Build *build,
+  int checkDuplicates)
+{
+  releaseBorrowed(model, true);
+  return model->model_->addColumns(build->build, false, checkDuplicates != 0);
+}
 
 /* Underlying model */
 void* CLP_LINKAGE
@@ -760,19 +975,21 @@ void CLP_LINKAGE
 Clp_registerCallBack(Clp_Simplex *model,
   clp_callback userCallBack)
 {
-  // Will be copy of users one
+  // Will be copy of users one (copy before old one goes)
+  CMessageHandler *handler = new CMessageHandler(*(model->model_->messageHandler()));
+  handler->setCallBack(userCallBack);
+  handler->setModel(model);
+  model->model_->passInMessageHandler(handler);
   delete model->handler_;
-  model->handler_ = new CMessageHandler(*(model->model_->messageHandler()));
-  model->handler_->setCallBack(userCallBack);
-  model->handler_->setModel(model);
-  model->model_->passInMessageHandler(model->handler_);
+  model->handler_ = handler;
 }
-/* Unset Callback function */
+/* Unset Callback function.
+   Handler stays with model (it is still being used) but does no call back */
 void CLP_LINKAGE
 Clp_clearCallBack(Clp_Simplex *model)
 {
-  delete model->handler_;
-  model->handler_ = NULL;
+  if (model->handler_)
+    model->handler_->setCallBack(NULL);
 }
 /* Amount of print out:
    0 - none
@@ -1015,6 +1232,7 @@ Clp_saveModel(Clp_Simplex *model, const char *fileName)
 int CLP_LINKAGE
 Clp_restoreModel(Clp_Simplex *model, const char *fileName)
 {
+  releaseBorrowed(model, false);
   return model->model_->restoreModel(fileName);
 }
 
@@ -24,6 +24,9 @@ typedef struct Clp_Simplex_s Clp_Simplex;
 struct Clp_Solve_s;
 typedef struct Clp_Solve_s Clp_Solve;
 
+struct Clp_Build_s;
+typedef struct Clp_Build_s Clp_Build;
+
 /** typedef for user call back.
  *
  * The cvec are constructed so don't need to be const
@@ -35,6 +38,11 @@ typedef void(CLP_LINKAGE_CB *clp_callback)(Clp_Simplex *model, int msgno, int nd
 /** This is a first "C" interface to Clp.
     It has similarities to the OSL V3 interface
     and only has most common functions
+
+    Each Clp_Simplex (and Clp_Solve) is independent so different models
+    may be used on different threads at the same time.  A single model
+    must only be used by one thread at a time.  Call backs are made on the
+    thread doing the solve.
 */
 
 #ifdef __cplusplus
@@ -105,6 +113,44 @@ CLPLIB_EXPORT void CLP_LINKAGE Clp_loadProblem(Clp_Simplex *model, const int num
   const double *obj,
   const double *rowlb, const double *rowub);
 
+/** Loads a problem from arrays owned by caller.  If columnOrdered then
+    start (numcols+1 entries), index and value are column ordered (CSC),
+    otherwise start has numrows+1 entries and matrix is row ordered (CSR).
+    There must be no gaps.  Defaults for NULL rim arrays are as in
+    Clp_loadProblem.  ownership is
+    <ul>
+    <li> 0 - copy - nothing is kept (as Clp_loadProblem)
+    <li> 1 - adopt - all non NULL arrays must have come from
+         Clp_newDoubleArray etc.  Model takes them over and frees them
+         so caller must not use them afterwards.
+    <li> 2 - borrow - matrix arrays are used in place and must stay valid
+         until the model is deleted or its problem is replaced (by
+         Clp_loadProblem, Clp_readMps etc).  Clp never frees them but may
+         rearrange them (e.g. to drop zero elements).  Anything which
+         changes the matrix structure (Clp_addRows, Clp_deleteRows,
+         Clp_modifyCoefficient etc) first makes a private copy.
+         Rim arrays are copied.
+    </ul>
+    A row ordered matrix has to be transposed so is always copied once
+    (and freed afterwards if adopted).
+*/
+CLPLIB_EXPORT void CLP_LINKAGE Clp_assignProblem(Clp_Simplex *model, const int numcols, const int numrows,
+  int columnOrdered,
+  CoinBigIndex *start, int *index,
+  double *value,
+  double *collb, double *colub,
+  double *obj,
+  double *rowlb, double *rowub,
+  int ownership);
+/** Arrays which may be adopted by Clp_assignProblem */
+CLPLIB_EXPORT double *CLP_LINKAGE Clp_newDoubleArray(CoinBigIndex size);
+CLPLIB_EXPORT int *CLP_LINKAGE Clp_newIntArray(int size);
+CLPLIB_EXPORT CoinBigIndex *CLP_LINKAGE Clp_newBigIndexArray(CoinBigIndex size);
+/** Frees arrays from Clp_newDoubleArray etc which were not adopted */
+CLPLIB_EXPORT void CLP_LINKAGE Clp_deleteDoubleArray(double *array);
+CLPLIB_EXPORT void CLP_LINKAGE Clp_deleteIntArray(int *array);
+CLPLIB_EXPORT void CLP_LINKAGE Clp_deleteBigIndexArray(CoinBigIndex *array);
+
 /* read quadratic part of the objective (the matrix part) */
 CLPLIB_EXPORT void CLP_LINKAGE
 Clp_loadQuadraticObjective(Clp_Simplex *model,
@@ -166,6 +212,37 @@ CLPLIB_EXPORT void CLP_LINKAGE Clp_copyNames(Clp_Simplex *model, const char *con
   const char *const *columnNames);
 
 /*@}*/
+/**@name Staged building of rows or columns
+        A Clp_Build collects many rows (or columns) without touching the
+        model.  They are then added in one go so matrix is only extended
+        once (instead of once per Clp_addRows call).
+     */
+/*@{*/
+/** Constructor - type 0 is for rows, 1 for columns */
+CLPLIB_EXPORT Clp_Build *CLP_LINKAGE ClpBuild_new(int type);
+/** Destructor */
+CLPLIB_EXPORT void CLP_LINKAGE ClpBuild_delete(Clp_Build *build);
+/** Add a row (type 0 only) */
+CLPLIB_EXPORT void CLP_LINKAGE ClpBuild_addRow(Clp_Build *build, int numberInRow,
+  const int *columns, const double *elements,
+  double rowLower, double rowUpper);
+/** Add a column (type 1 only) */
+CLPLIB_EXPORT void CLP_LINKAGE ClpBuild_addColumn(Clp_Build *build, int numberInColumn,
+  const int *rows, const double *elements,
+  double columnLower, double columnUpper, double objective);
+/** Number of rows in build */
+CLPLIB_EXPORT int CLP_LINKAGE ClpBuild_numberRows(Clp_Build *build);
+/** Number of columns in build */
+CLPLIB_EXPORT int CLP_LINKAGE ClpBuild_numberColumns(Clp_Build *build);
+/** Adds all rows in build to model in one go.  Build is unchanged so
+    may be deleted or reused.  checkDuplicates is as in C++
+    addRows(const CoinBuild &).  Returns number of errors. */
+CLPLIB_EXPORT int CLP_LINKAGE Clp_addRowsFromBuild(Clp_Simplex *model, Clp_Build *build,
+  int checkDuplicates);
+/** Adds all columns in build to model - as Clp_addRowsFromBuild */
+CLPLIB_EXPORT int CLP_LINKAGE Clp_addColumnsFromBuild(Clp_Simplex *model, Clp_Build *build,
+  int checkDuplicates);
+/*@}*/
 /**@name gets and sets - you will find some synonyms at the end of this file */
 /*@{*/
 /** The underlying ClpSimplex model */
@@ -229,6 +229,18 @@ public:
   {
     denseThreshold_ = value;
   }
+  /// Gets density at which to go dense (0.0 means size dependent default)
+  inline double denseDensity() const
+  {
+    return denseDensity_;
+  }
+  /** Sets density at which to go dense.  If positive then go dense
+      when fraction of nonzeros in remaining matrix is at least this.
+      If 0.0 then use default which depends on size (1/1.5 to 1/3.5) */
+  virtual void setDenseDensity(double value)
+  {
+    denseDensity_ = value;
+  }
 #endif
   /// Returns maximum absolute value in factorization
   CoinSimplexDouble maximumCoefficient() const;
@@ -1176,6 +1188,8 @@ protected:
   mutable CoinSimplexInt numberFtranFTCounts_;
 #endif
 #if ABC_SMALL < 4
+  /// Density at which to go dense (0.0 size dependent)
+  double denseDensity_;
   /// Dense threshold (here to use double alignment)
   CoinSimplexInt denseThreshold_;
 #endif
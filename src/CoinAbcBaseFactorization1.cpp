@@ -21,6 +21,8 @@
 CoinAbcTypeFactorization::CoinAbcTypeFactorization()
   : CoinAbcAnyFactorization()
 {
+  // in case created before static initializers have run
+  CoinAbcChooseKernels();
   gutsOfInitialize(7);
 }
 
@@ -153,6 +155,7 @@ void CoinAbcTypeFactorization::gutsOfInitialize(CoinSimplexInt type)
 #if FACTORIZATION_STATISTICS
     denseThreshold_ = denseThresholdX;
 #endif
+    denseDensity_ = 0.0;
     //denseThreshold_=0; // temp (? ABC_PARALLEL)
 #endif
   }
@@ -454,6 +457,7 @@ void CoinAbcTypeFactorization::gutsOfCopy(const CoinAbcTypeFactorization &other)
 #if ABC_SMALL < 4
   numberDense_ = other.numberDense_;
   denseThreshold_ = other.denseThreshold_;
+  denseDensity_ = other.denseDensity_;
 #endif
   lengthAreaR_ = space;
   elementRAddress_ = elementL_.array() + lengthL_;
@@ -2420,7 +2424,9 @@ int CoinAbcTypeFactorization::wantToGoDense()
       //if (numberRowsLeft_==100)
       //printf("at 100 %d elements\n",totalElements_);
       CoinSimplexDouble ratio;
-      if (numberRowsLeft_ > 2000)
+      if (denseDensity_ > 0.0)
+        ratio = 1.0 / denseDensity_;
+      else if (numberRowsLeft_ > 2000)
         ratio = 3.5;
       else if (numberRowsLeft_ > 800)
         ratio = 2.75; //3.5;
@@ -28,6 +28,22 @@ typedef unsigned int CoinSimplexUnsignedInt;
 #else
 #define ABC_INLINE
 #endif
+/* Hot factorization kernels (scatter updates, dense blocks) can be
+   compiled for several vector widths in one binary.  The baseline
+   (SSE2 on x86_64) versions are always there and AVX2 and AVX-512
+   versions are chosen at startup if cpu has them (CoinAbcKernelLevel).
+   Not done if vector width was fixed at compile time with AVX2. */
+#ifndef ABC_CPU_DISPATCH
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__INTEL_COMPILER) && !defined(AVX2) && COIN_BIG_DOUBLE != 1
+#define ABC_CPU_DISPATCH 1
+#else
+#define ABC_CPU_DISPATCH 0
+#endif
+#endif
+#if ABC_CPU_DISPATCH
+#define ABC_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define ABC_TARGET_AVX512 __attribute__((target("avx512f,avx2,fma")))
+#endif
 #ifndef ABC_PARALLEL
 #ifdef HAS_CILK
 #define ABC_PARALLEL 2
@@ -37,7 +53,10 @@ typedef unsigned int CoinSimplexUnsignedInt;
 #endif
 #if ABC_PARALLEL == 2
 //#define EARLY_FACTORIZE
-#ifndef FAKE_CILK
+/* Overlapped steps of dual go through ClpThreadPool.
+   Cilk is only used for finer grained spawns if compiler has it. */
+#if defined(HAS_CILK) && !defined(FAKE_CILK)
+#define ABC_USE_CILK
 #include <cilk/cilk.h>
 #else
 #define cilk_for for
@@ -79,6 +79,11 @@ int CoinAbcDgetrf(int m, int n, double *a, int lda, int *ipiv
   int parallelMode
 #endif
 );
+/// Panel width used by CoinAbcDgetrf on large matrices
+int CoinAbcDensePanel();
+/** Sets panel width (rounded down to multiple of BLOCKING8).
+    BLOCKING8 or less means factorize a strip at a time */
+void CoinAbcSetDensePanel(int width);
 void CoinAbcDgetrs(char trans, int m, long double *a, long double *work);
 int CoinAbcDgetrf(int m, int n, long double *a, int lda, int *ipiv
 #if ABC_PARALLEL == 2
@@ -163,6 +163,8 @@ public:
   virtual int *permuteBack() const;
   /// Sees whether to go sparse
   virtual void goSparse() {}
+  /// Sets density at which to go dense (only used by CoinAbcFactorization)
+  virtual void setDenseDensity(double /*value*/) {}
 #ifndef NDEBUG
   virtual inline void checkMarkArrays() const
   {
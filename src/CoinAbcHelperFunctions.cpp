@@ -1619,6 +1619,73 @@ scatterUpdate AbcScatterHighAdd[] = {
   &CoinAbcScatterUpdate4NPlus2Add,
   &CoinAbcScatterUpdate4NPlus3Add
 };
+#if ABC_CPU_DISPATCH
+// Subtract versions (used by factorization) for wider vectors
+#undef OPERATION
+#undef functionName
+#undef SCATTER_ATTRIBUTE
+#define SCATTER_ATTRIBUTE ABC_TARGET_AVX2
+#define ABC_SCATTER_WIDTH 4
+#define OPERATION -=
+#define functionName(zname) CoinAbc##zname##SubtractAvx2
+#include "CoinAbcHelperFunctions.hpp"
+#undef OPERATION
+#undef functionName
+#undef SCATTER_ATTRIBUTE
+#undef ABC_SCATTER_WIDTH
+#define SCATTER_ATTRIBUTE ABC_TARGET_AVX512
+#define ABC_SCATTER_WIDTH 8
+#define OPERATION -=
+#define functionName(zname) CoinAbc##zname##SubtractAvx512
+#include "CoinAbcHelperFunctions.hpp"
+#undef SCATTER_ATTRIBUTE
+#undef ABC_SCATTER_WIDTH
+#define SCATTER_ATTRIBUTE
+// by level - baseline, AVX2, AVX-512
+static scatterUpdate abcScatterLowSubtractLevel[3][9] = {
+  { &CoinAbcScatterUpdate0,
+    &CoinAbcScatterUpdate1Subtract,
+    &CoinAbcScatterUpdate2Subtract,
+    &CoinAbcScatterUpdate3Subtract,
+    &CoinAbcScatterUpdate4Subtract,
+    &CoinAbcScatterUpdate5Subtract,
+    &CoinAbcScatterUpdate6Subtract,
+    &CoinAbcScatterUpdate7Subtract,
+    &CoinAbcScatterUpdate8Subtract },
+  { &CoinAbcScatterUpdate0,
+    &CoinAbcScatterUpdate1SubtractAvx2,
+    &CoinAbcScatterUpdate2SubtractAvx2,
+    &CoinAbcScatterUpdate3SubtractAvx2,
+    &CoinAbcScatterUpdate4SubtractAvx2,
+    &CoinAbcScatterUpdate5SubtractAvx2,
+    &CoinAbcScatterUpdate6SubtractAvx2,
+    &CoinAbcScatterUpdate7SubtractAvx2,
+    &CoinAbcScatterUpdate8SubtractAvx2 },
+  { &CoinAbcScatterUpdate0,
+    &CoinAbcScatterUpdate1SubtractAvx512,
+    &CoinAbcScatterUpdate2SubtractAvx512,
+    &CoinAbcScatterUpdate3SubtractAvx512,
+    &CoinAbcScatterUpdate4SubtractAvx512,
+    &CoinAbcScatterUpdate5SubtractAvx512,
+    &CoinAbcScatterUpdate6SubtractAvx512,
+    &CoinAbcScatterUpdate7SubtractAvx512,
+    &CoinAbcScatterUpdate8SubtractAvx512 }
+};
+static scatterUpdate abcScatterHighSubtractLevel[3][4] = {
+  { &CoinAbcScatterUpdate4NSubtract,
+    &CoinAbcScatterUpdate4NPlus1Subtract,
+    &CoinAbcScatterUpdate4NPlus2Subtract,
+    &CoinAbcScatterUpdate4NPlus3Subtract },
+  { &CoinAbcScatterUpdate4NSubtractAvx2,
+    &CoinAbcScatterUpdate4NPlus1SubtractAvx2,
+    &CoinAbcScatterUpdate4NPlus2SubtractAvx2,
+    &CoinAbcScatterUpdate4NPlus3SubtractAvx2 },
+  { &CoinAbcScatterUpdate4NSubtractAvx512,
+    &CoinAbcScatterUpdate4NPlus1SubtractAvx512,
+    &CoinAbcScatterUpdate4NPlus2SubtractAvx512,
+    &CoinAbcScatterUpdate4NPlus3SubtractAvx512 }
+};
+#endif
 #endif
 #include "CoinPragma.hpp"
 
@@ -1630,6 +1697,9 @@ scatterUpdate AbcScatterHighAdd[] = {
 #include <stdio.h>
 #include <iostream>
 #include "CoinAbcCommonFactorization.hpp"
+#if ABC_PARALLEL == 2 && !defined(ABC_USE_CILK)
+#include "ClpThreadPool.hpp"
+#endif
 #if 1
 #if AVX2 == 1
 #include "emmintrin.h"
@@ -1655,6 +1725,122 @@ scatterUpdate AbcScatterHighAdd[] = {
 #define BLOCKING1 8 // factorization strip
 #define BLOCKING2 8 // dgemm recursive
 #define BLOCKING3 32 // dgemm parallel
+// c -= a*b for one BLOCKING8 by BLOCKING8 block
+static void CoinAbcDgemm8(double *COIN_RESTRICT a, double *COIN_RESTRICT b,
+  double *COIN_RESTRICT c)
+{
+  double *COIN_RESTRICT aBase2 = a;
+  double *COIN_RESTRICT bBase2 = b;
+  double *COIN_RESTRICT cBase2 = c;
+  for (int j = 0; j < BLOCKING8; j++) {
+    double *COIN_RESTRICT aBase = aBase2;
+#if AVX2 != 2
+#if 1
+    double c0 = cBase2[0];
+    double c1 = cBase2[1];
+    double c2 = cBase2[2];
+    double c3 = cBase2[3];
+    double c4 = cBase2[4];
+    double c5 = cBase2[5];
+    double c6 = cBase2[6];
+    double c7 = cBase2[7];
+    for (int l = 0; l < BLOCKING8; l++) {
+      double bValue = bBase2[l];
+      if (bValue) {
+        c0 -= bValue * aBase[0];
+        c1 -= bValue * aBase[1];
+        c2 -= bValue * aBase[2];
+        c3 -= bValue * aBase[3];
+        c4 -= bValue * aBase[4];
+        c5 -= bValue * aBase[5];
+        c6 -= bValue * aBase[6];
+        c7 -= bValue * aBase[7];
+      }
+      aBase += BLOCKING8;
+    }
+    cBase2[0] = c0;
+    cBase2[1] = c1;
+    cBase2[2] = c2;
+    cBase2[3] = c3;
+    cBase2[4] = c4;
+    cBase2[5] = c5;
+    cBase2[6] = c6;
+    cBase2[7] = c7;
+#else
+    for (int l = 0; l < BLOCKING8; l++) {
+      double bValue = bBase2[l];
+      if (bValue) {
+        for (int i = 0; i < BLOCKING8; i++) {
+          cBase2[i] -= bValue * aBase[i];
+        }
+      }
+      aBase += BLOCKING8;
+    }
+#endif
+#else
+    //__m256d c0=_mm256_load_pd(cBase2);
+    __m256d c0 = *reinterpret_cast< __m256d * >(cBase2);
+    //__m256d c1=_mm256_load_pd(cBase2+4);
+    __m256d c1 = *reinterpret_cast< __m256d * >(cBase2 + 4);
+    for (int l = 0; l < BLOCKING8; l++) {
+      //__m256d bb = _mm256_broadcast_sd(bBase2+l);
+      __m256d bb = static_cast< __m256d >(__builtin_ia32_vbroadcastsd256(bBase2 + l));
+      //__m256d a0 = _mm256_load_pd(aBase);
+      __m256d a0 = *reinterpret_cast< __m256d * >(aBase);
+      //__m256d a1 = _mm256_load_pd(aBase+4);
+      __m256d a1 = *reinterpret_cast< __m256d * >(aBase + 4);
+      c0 -= bb * a0;
+      c1 -= bb * a1;
+      aBase += BLOCKING8;
+    }
+    //_mm256_store_pd (cBase2, c0);
+    *reinterpret_cast< __m256d * >(cBase2) = c0;
+    //_mm256_store_pd (cBase2+4, c1);
+    *reinterpret_cast< __m256d * >(cBase2 + 4) = c1;
+#endif
+    bBase2 += BLOCKING8;
+    cBase2 += BLOCKING8;
+  }
+}
+#if ABC_CPU_DISPATCH && BLOCKING8 == 8
+ABC_TARGET_AVX2 static void CoinAbcDgemm8Avx2(double *COIN_RESTRICT a, double *COIN_RESTRICT b,
+  double *COIN_RESTRICT c)
+{
+  for (int j = 0; j < BLOCKING8; j++) {
+    const double *COIN_RESTRICT aBase = a;
+    __m256d c0 = _mm256_loadu_pd(c);
+    __m256d c1 = _mm256_loadu_pd(c + 4);
+    for (int l = 0; l < BLOCKING8; l++) {
+      __m256d bb = _mm256_broadcast_sd(b + l);
+      c0 = _mm256_fnmadd_pd(bb, _mm256_loadu_pd(aBase), c0);
+      c1 = _mm256_fnmadd_pd(bb, _mm256_loadu_pd(aBase + 4), c1);
+      aBase += BLOCKING8;
+    }
+    _mm256_storeu_pd(c, c0);
+    _mm256_storeu_pd(c + 4, c1);
+    b += BLOCKING8;
+    c += BLOCKING8;
+  }
+}
+ABC_TARGET_AVX512 static void CoinAbcDgemm8Avx512(double *COIN_RESTRICT a, double *COIN_RESTRICT b,
+  double *COIN_RESTRICT c)
+{
+  // columns of a kept in registers
+  __m512d aa[BLOCKING8];
+  for (int l = 0; l < BLOCKING8; l++)
+    aa[l] = _mm512_loadu_pd(a + l * BLOCKING8);
+  for (int j = 0; j < BLOCKING8; j++) {
+    __m512d c0 = _mm512_loadu_pd(c);
+    for (int l = 0; l < BLOCKING8; l++)
+      c0 = _mm512_fnmadd_pd(_mm512_set1_pd(b[l]), aa[l], c0);
+    _mm512_storeu_pd(c, c0);
+    b += BLOCKING8;
+    c += BLOCKING8;
+  }
+}
+#endif
+typedef void (*dgemm8Kernel)(double *COIN_RESTRICT, double *COIN_RESTRICT, double *COIN_RESTRICT);
+static dgemm8Kernel abcDgemm8 = CoinAbcDgemm8;
 void CoinAbcDgemm(int m, int n, int k, double *COIN_RESTRICT a, int lda,
   double *COIN_RESTRICT b, double *COIN_RESTRICT c
 #if ABC_PARALLEL == 2
@@ -1667,81 +1853,12 @@ void CoinAbcDgemm(int m, int n, int k, double *COIN_RESTRICT a, int lda,
   /* entry for column j and row i (when multiple of BLOCKING8)
      is at aBlocked+j*m+i*BLOCKING8
   */
-  // k is always smallish
+  // k is smallish (BLOCKING8 or width of panel in dense factorization)
   if (m <= BLOCKING8 && n <= BLOCKING8) {
-    assert(m == BLOCKING8 && n == BLOCKING8 && k == BLOCKING8);
-    double *COIN_RESTRICT aBase2 = a;
-    double *COIN_RESTRICT bBase2 = b;
-    double *COIN_RESTRICT cBase2 = c;
-    for (int j = 0; j < BLOCKING8; j++) {
-      double *COIN_RESTRICT aBase = aBase2;
-#if AVX2 != 2
-#if 1
-      double c0 = cBase2[0];
-      double c1 = cBase2[1];
-      double c2 = cBase2[2];
-      double c3 = cBase2[3];
-      double c4 = cBase2[4];
-      double c5 = cBase2[5];
-      double c6 = cBase2[6];
-      double c7 = cBase2[7];
-      for (int l = 0; l < BLOCKING8; l++) {
-        double bValue = bBase2[l];
-        if (bValue) {
-          c0 -= bValue * aBase[0];
-          c1 -= bValue * aBase[1];
-          c2 -= bValue * aBase[2];
-          c3 -= bValue * aBase[3];
-          c4 -= bValue * aBase[4];
-          c5 -= bValue * aBase[5];
-          c6 -= bValue * aBase[6];
-          c7 -= bValue * aBase[7];
-        }
-        aBase += BLOCKING8;
-      }
-      cBase2[0] = c0;
-      cBase2[1] = c1;
-      cBase2[2] = c2;
-      cBase2[3] = c3;
-      cBase2[4] = c4;
-      cBase2[5] = c5;
-      cBase2[6] = c6;
-      cBase2[7] = c7;
-#else
-      for (int l = 0; l < BLOCKING8; l++) {
-        double bValue = bBase2[l];
-        if (bValue) {
-          for (int i = 0; i < BLOCKING8; i++) {
-            cBase2[i] -= bValue * aBase[i];
-          }
-        }
-        aBase += BLOCKING8;
-      }
-#endif
-#else
-      //__m256d c0=_mm256_load_pd(cBase2);
-      __m256d c0 = *reinterpret_cast< __m256d * >(cBase2);
-      //__m256d c1=_mm256_load_pd(cBase2+4);
-      __m256d c1 = *reinterpret_cast< __m256d * >(cBase2 + 4);
-      for (int l = 0; l < BLOCKING8; l++) {
-        //__m256d bb = _mm256_broadcast_sd(bBase2+l);
-        __m256d bb = static_cast< __m256d >(__builtin_ia32_vbroadcastsd256(bBase2 + l));
-        //__m256d a0 = _mm256_load_pd(aBase);
-        __m256d a0 = *reinterpret_cast< __m256d * >(aBase);
-        //__m256d a1 = _mm256_load_pd(aBase+4);
-        __m256d a1 = *reinterpret_cast< __m256d * >(aBase + 4);
-        c0 -= bb * a0;
-        c1 -= bb * a1;
-        aBase += BLOCKING8;
-      }
-      //_mm256_store_pd (cBase2, c0);
-      *reinterpret_cast< __m256d * >(cBase2) = c0;
-      //_mm256_store_pd (cBase2+4, c1);
-      *reinterpret_cast< __m256d * >(cBase2 + 4) = c1;
-#endif
-      bBase2 += BLOCKING8;
-      cBase2 += BLOCKING8;
-    }
+    assert(m == BLOCKING8 && n == BLOCKING8);
+    // c stays in cache while each BLOCKING8 of k is done
+    for (int kk = 0; kk < k; kk += BLOCKING8)
+      abcDgemm8(a + kk * lda, b + kk * BLOCKING8, c);
   } else if (m > n) {
     // make sure mNew1 multiple of BLOCKING8
 #if BLOCKING8 == 8
@@ -1774,10 +1891,17 @@ void CoinAbcDgemm(int m, int n, int k, double *COIN_RESTRICT a, int lda,
 #if ABC_PARALLEL == 2
     } else {
       //printf("splitMa mNew1 %d\n",mNew1);
+#ifdef ABC_USE_CILK
       cilk_spawn CoinAbcDgemm(mNew1, n, k, a, lda, b, c, ONWARD);
       //printf("splitMb mNew1 %d\n",mNew1);
       CoinAbcDgemm(m - mNew1, n, k, a + mNew1 * BLOCKING8, lda, b, c + mNew1 * BLOCKING8, ONWARD);
       cilk_sync;
+#else
+      ClpTaskGroup tasks(ClpPricingThreadPool());
+      tasks.spawn([=] { CoinAbcDgemm(mNew1, n, k, a, lda, b, c, ONWARD); });
+      CoinAbcDgemm(m - mNew1, n, k, a + mNew1 * BLOCKING8, lda, b, c + mNew1 * BLOCKING8, ONWARD);
+      tasks.sync();
+#endif
     }
 #endif
   } else {
@@ -1812,10 +1936,17 @@ void CoinAbcDgemm(int m, int n, int k, double *COIN_RESTRICT a, int lda,
 #if ABC_PARALLEL == 2
     } else {
       //printf("splitNa nNew1 %d\n",nNew1);
+#ifdef ABC_USE_CILK
       cilk_spawn CoinAbcDgemm(m, nNew1, k, a, lda, b, c, ONWARD);
       //printf("splitNb nNew1 %d\n",nNew1);
       CoinAbcDgemm(m, n - nNew1, k, a, lda, b + lda * nNew1, c + lda * nNew1, ONWARD);
       cilk_sync;
+#else
+      ClpTaskGroup tasks(ClpPricingThreadPool());
+      tasks.spawn([=] { CoinAbcDgemm(m, nNew1, k, a, lda, b, c, ONWARD); });
+      CoinAbcDgemm(m, n - nNew1, k, a, lda, b + lda * nNew1, c + lda * nNew1, ONWARD);
+      tasks.sync();
+#endif
     }
 #endif
   }
@@ -1988,39 +2119,77 @@ void CoinAbcDgemm(int m, int n, int k, long double *COIN_RESTRICT a, int lda,
   }
 }
 #endif
-#if 0
-// From Intel site
-// get AVX intrinsics
-#include <immintrin.h>  
-// get CPUID capability  
-//#include <intrin.h>
-#define cpuid(func, ax, bx, cx, dx)                             \
-  __asm__ __volatile__("cpuid"                                  \
-                       : "=a"(ax), "=b"(bx), "=c"(cx), "=d"(dx) \
-                       : "a"(func));  
-// written for clarity, not conciseness
-#define OSXSAVEFlag (1UL << 27)
-#define AVXFlag ((1UL << 28) | OSXSAVEFlag)
-#define VAESFlag ((1UL << 25) | AVXFlag | OSXSAVEFlag)
-#define FMAFlag ((1UL << 12) | AVXFlag | OSXSAVEFlag)
-#define CLMULFlag ((1UL << 1) | AVXFlag | OSXSAVEFlag)  
-   
-bool DetectFeature(unsigned int feature)  
-{  
-  int CPUInfo[4]; //, InfoType=1, ECX = 1;  
-  //__cpuidex(CPUInfo, 1, 1);       // read the desired CPUID format  
-  cpuid(1,CPUInfo[0],CPUInfo[1],CPUInfo[2],CPUInfo[3]);
-  unsigned int ECX = CPUInfo[2];  // the output of CPUID in the ECX register.   
-  if ((ECX & feature) != feature) // Missing feature   
-    return false;
-#if 0
-  long int val = _xgetbv(0);       // read XFEATURE_ENABLED_MASK register  
-  if ((val&6) != 6)               // check OS has enabled both XMM and YMM support.  
-    return false;
-#endif
-  return true;  
+static int abcKernelLevel = 0;
+static int abcFindCpuLevel()
+{
+#if ABC_CPU_DISPATCH
+  // checks OS has enabled wide registers as well as cpuid bits
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f"))
+    return 2;
+  else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return 1;
+#endif
+  return 0;
+}
+// Best level this cpu (and build) can do
+int CoinAbcCpuLevel()
+{
+  // local static so cpu is only looked at once (thread safe)
+  static const int cpuLevel = abcFindCpuLevel();
+  return cpuLevel;
 }
+// Fills tables for level
+static void abcSetKernels(int level)
+{
+#if ABC_CPU_DISPATCH
+#if INLINE_SCATTER
+  CoinAbcMemcpy(AbcScatterLowSubtract, abcScatterLowSubtractLevel[level], 9);
+  CoinAbcMemcpy(AbcScatterHighSubtract, abcScatterHighSubtractLevel[level], 4);
+#endif
+#if BLOCKING8 == 8
+  if (level == 2)
+    abcDgemm8 = CoinAbcDgemm8Avx512;
+  else if (level == 1)
+    abcDgemm8 = CoinAbcDgemm8Avx2;
+  else
+    abcDgemm8 = CoinAbcDgemm8;
+#endif
 #endif
+  abcKernelLevel = level;
+}
+static int abcChooseKernels()
+{
+  abcSetKernels(CoinAbcCpuLevel());
+  return abcKernelLevel;
+}
+// Chooses kernels for this cpu - only first call does anything
+void CoinAbcChooseKernels()
+{
+  // local static so tables are filled once even if threads race here
+  static const int chosenLevel = abcChooseKernels();
+  (void)chosenLevel;
+}
+// Level of kernels in use
+int CoinAbcKernelLevel()
+{
+  CoinAbcChooseKernels();
+  return abcKernelLevel;
+}
+// Forces kernels - level is capped by CoinAbcCpuLevel
+void CoinAbcSetKernelLevel(int level)
+{
+  CoinAbcChooseKernels();
+  abcSetKernels(CoinMax(0, CoinMin(level, CoinAbcCpuLevel())));
+}
+// choose at startup (before any threads)
+static class CoinAbcChooseKernelsAtStart {
+public:
+  CoinAbcChooseKernelsAtStart()
+  {
+    CoinAbcChooseKernels();
+  }
+} abcChooseKernelsAtStart;
 
 /* vi: softtabstop=2 shiftwidth=2 expandtab tabstop=2
 */
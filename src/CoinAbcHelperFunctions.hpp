@@ -36,6 +36,9 @@
 #elif AVX2 == 3
 #include "avx2intrin.h"
 #endif
+#if ABC_CPU_DISPATCH
+#include <immintrin.h>
+#endif
 //#define __AVX__ 1
 //#define __AVX2__ 1
 /**
@@ -802,8 +805,73 @@ void CoinAbcMemmoveAndZero(double *array, double *arrayFrom, int size);
 int CoinAbcCompact(int numberSections, int alreadyDone, double *array, const int *starts, const int *lengths);
 /// This compacts several sections (returns number)
 int CoinAbcCompact(int numberSections, int alreadyDone, int *array, const int *starts, const int *lengths);
+/**@name Runtime choice of kernels.
+   Levels are 0 baseline, 1 AVX2, 2 AVX-512.  Only the subtract scatter
+   update tables used by the factorization (AbcScatterLowSubtract and
+   AbcScatterHighSubtract) and the 8x8 block of CoinAbcDgemm are
+   switched.  The Add scatter tables, inner products and copy/set
+   helpers are compiled once for the build target.
+
+   Tables are filled once for this cpu, by a static initializer when
+   library is loaded or by first factorization if that is earlier.  A
+   factorization keeps the pointers it was built with.
+   CoinAbcSetKernelLevel is for testing and tuning and must not be
+   called while another thread is factorizing.
+*/
+//@{
+/// Best level this cpu (and build) can do
+int CoinAbcCpuLevel();
+/// Chooses kernels for this cpu (only first call does anything, thread safe)
+void CoinAbcChooseKernels();
+/// Level of kernels in use (CoinAbcCpuLevel unless forced)
+int CoinAbcKernelLevel();
+/// Forces kernels - level is capped by CoinAbcCpuLevel
+void CoinAbcSetKernelLevel(int level);
+//@}
 #endif
 #if ABC_CREATE_SCATTER_FUNCTION
+#if ABC_SCATTER_WIDTH
+/* Does full vectors of a 4N part with gather (and scatter if AVX-512).
+   Indices in a column are distinct so scatter is safe.
+   Advances element and thisColumn and returns number done. */
+static inline SCATTER_ATTRIBUTE int functionName(ScatterUpdateVector)(int nFull,
+  CoinFactorizationDouble multiplier,
+  const CoinFactorizationDouble *COIN_RESTRICT &element,
+  const int *COIN_RESTRICT &thisColumn,
+  CoinFactorizationDouble *COIN_RESTRICT region)
+{
+  int j = 0;
+#if ABC_SCATTER_WIDTH == 8
+  __m512d bb = _mm512_set1_pd(multiplier);
+  for (; j + 8 <= nFull; j += 8) {
+    __m256i indices = _mm256_loadu_si256(reinterpret_cast< const __m256i * >(thisColumn));
+    __m512d values = _mm512_i32gather_pd(indices, region, 8);
+    __m512d a = _mm512_loadu_pd(element) * bb;
+    values OPERATION a;
+    _mm512_i32scatter_pd(region, indices, values, 8);
+    element += 8;
+    thisColumn += 8;
+  }
+#else
+  __m256d bb = _mm256_set1_pd(multiplier);
+  double temp[4];
+  for (; j + 4 <= nFull; j += 4) {
+    __m128i indices = _mm_loadu_si128(reinterpret_cast< const __m128i * >(thisColumn));
+    __m256d values = _mm256_i32gather_pd(region, indices, 8);
+    __m256d a = _mm256_loadu_pd(element) * bb;
+    values OPERATION a;
+    _mm256_storeu_pd(temp, values);
+    region[thisColumn[0]] = temp[0];
+    region[thisColumn[1]] = temp[1];
+    region[thisColumn[2]] = temp[2];
+    region[thisColumn[3]] = temp[3];
+    element += 4;
+    thisColumn += 4;
+  }
+#endif
+  return j;
+}
+#endif
 SCATTER_ATTRIBUTE void functionName(ScatterUpdate1)(int numberIn, CoinFactorizationDouble multiplier,
   const CoinFactorizationDouble *COIN_RESTRICT element,
   CoinFactorizationDouble *COIN_RESTRICT region)
@@ -1309,7 +1377,11 @@ SCATTER_ATTRIBUTE void functionName(ScatterUpdate4N)(int numberIn, CoinFactoriza
 #if AVX2 == 1
   double temp[4];
 #endif
-  for (int j = 0; j < nFull; j += NEW_CHUNK_SIZE) {
+  int jStart = 0;
+#if ABC_SCATTER_WIDTH
+  jStart = functionName(ScatterUpdateVector)(nFull, multiplier, element, thisColumn, region);
+#endif
+  for (int j = jStart; j < nFull; j += NEW_CHUNK_SIZE) {
     coin_prefetch_const(element + 16);
     coin_prefetch_const(thisColumn + 32);
 #if NEW_CHUNK_SIZE == 2
@@ -1378,7 +1450,11 @@ SCATTER_ATTRIBUTE void functionName(ScatterUpdate4NPlus1)(int numberIn, CoinFact
 #if AVX2 == 1
   double temp[4];
 #endif
-  for (int j = 0; j < nFull; j += NEW_CHUNK_SIZE) {
+  int jStart = 0;
+#if ABC_SCATTER_WIDTH
+  jStart = functionName(ScatterUpdateVector)(nFull, multiplier, element, thisColumn, region);
+#endif
+  for (int j = jStart; j < nFull; j += NEW_CHUNK_SIZE) {
     coin_prefetch_const(element + 16);
     coin_prefetch_const(thisColumn + 32);
 #if NEW_CHUNK_SIZE == 2
@@ -1451,7 +1527,11 @@ SCATTER_ATTRIBUTE void functionName(ScatterUpdate4NPlus2)(int numberIn, CoinFact
 #if AVX2 == 1
   double temp[4];
 #endif
-  for (int j = 0; j < nFull; j += NEW_CHUNK_SIZE) {
+  int jStart = 0;
+#if ABC_SCATTER_WIDTH
+  jStart = functionName(ScatterUpdateVector)(nFull, multiplier, element, thisColumn, region);
+#endif
+  for (int j = jStart; j < nFull; j += NEW_CHUNK_SIZE) {
     coin_prefetch_const(element + 16);
     coin_prefetch_const(thisColumn + 32);
 #if NEW_CHUNK_SIZE == 2
@@ -1530,7 +1610,11 @@ SCATTER_ATTRIBUTE void functionName(ScatterUpdate4NPlus3)(int numberIn, CoinFact
 #if AVX2 == 1
   double temp[4];
 #endif
-  for (int j = 0; j < nFull; j += NEW_CHUNK_SIZE) {
+  int jStart = 0;
+#if ABC_SCATTER_WIDTH
+  jStart = functionName(ScatterUpdateVector)(nFull, multiplier, element, thisColumn, region);
+#endif
+  for (int j = jStart; j < nFull; j += NEW_CHUNK_SIZE) {
     coin_prefetch_const(element + 16);
     coin_prefetch_const(thisColumn + 32);
 #if NEW_CHUNK_SIZE == 2
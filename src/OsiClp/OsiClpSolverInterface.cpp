@@ -4678,19 +4678,17 @@ void OsiClpSolverInterface::assignProblem(CoinPackedMatrix *&matrix,
 {
   modelPtr_->whatsChanged_ = 0;
   // Get rid of integer information (modelPtr will get rid of its copy)
-  loadProblem(*matrix, collb, colub, obj, rowlb, rowub);
-  delete matrix;
-  matrix = NULL;
-  delete[] collb;
-  collb = NULL;
-  delete[] colub;
-  colub = NULL;
-  delete[] obj;
-  obj = NULL;
-  delete[] rowlb;
-  rowlb = NULL;
-  delete[] rowub;
-  rowub = NULL;
+  delete[] integerInformation_;
+  integerInformation_ = NULL;
+  // model takes over matrix and arrays (no copy)
+  modelPtr_->assignProblem(matrix, collb, colub, obj, rowlb, rowub);
+  linearObjective_ = modelPtr_->objective();
+  freeCachedResults();
+  basis_ = CoinWarmStartBasis();
+  if (ws_) {
+    delete ws_;
+    ws_ = 0;
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -4752,17 +4750,16 @@ void OsiClpSolverInterface::assignProblem(CoinPackedMatrix *&matrix,
   char *&rowsen, double *&rowrhs,
   double *&rowrng)
 {
-  modelPtr_->whatsChanged_ = 0;
-  // Get rid of integer information (modelPtr will get rid of its copy)
-  loadProblem(*matrix, collb, colub, obj, rowsen, rowrhs, rowrng);
-  delete matrix;
-  matrix = NULL;
-  delete[] collb;
-  collb = NULL;
-  delete[] colub;
-  colub = NULL;
-  delete[] obj;
-  obj = NULL;
+  int numrows = matrix->getNumRows();
+  double *rowlb = new double[numrows];
+  double *rowub = new double[numrows];
+  for (int i = numrows - 1; i >= 0; --i) {
+    char sense = rowsen ? rowsen[i] : 'G';
+    double rhs = rowrhs ? rowrhs[i] : 0.0;
+    double range = rowrng ? rowrng[i] : 0.0;
+    convertSenseToBound(sense, rhs, range, rowlb[i], rowub[i]);
+  }
+  assignProblem(matrix, collb, colub, obj, rowlb, rowub);
   delete[] rowsen;
   rowsen = NULL;
   delete[] rowrhs;
@@ -4952,6 +4949,22 @@ int OsiClpSolverInterface::writeBasisNative(const char *filename) const
 {
   return modelPtr_->writeBasis(filename,true,2);
 }
+int OsiClpSolverInterface::writeBasisNative(const char *filename, bool binary) const
+{
+  if (binary)
+    return modelPtr_->writeBasisBinary(filename, true);
+  else
+    return modelPtr_->writeBasis(filename, true, 2);
+}
+int OsiClpSolverInterface::readBasisNative(const char *filename)
+{
+  int returnCode = modelPtr_->readBasis(filename);
+  if (returnCode >= 0) {
+    modelPtr_->whatsChanged_ &= 0xffff;
+    basis_ = getBasis(modelPtr_);
+  }
+  return returnCode;
+}
 
 //#############################################################################
 // CLP specific public interfaces
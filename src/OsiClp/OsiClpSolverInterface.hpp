@@ -1001,7 +1001,15 @@ public:
     const char **rowNames, const char **columnNames,
     int formatType = 0, int numberAcross = 2,
     double objSense = 0.0) const;
+  /// Write basis (with values) as text file
   virtual int writeBasisNative(const char *filename) const;
+  /** Write basis - if binary then in compact binary form (see
+      ClpSimplex::writeBasisBinary) which is much faster for large models */
+  int writeBasisNative(const char *filename, bool binary) const;
+  /** Read basis written by writeBasisNative (text or binary) and make it
+      the warm start.  Returns -1 on file error, -2 if not for this model,
+      0 if no values, 1 if values */
+  int readBasisNative(const char *filename);
   /// Read file in LP format (with names)
   virtual int readLp(const char *filename, const double epsilon = 1e-5);
   /** Write the problem into an Lp file of the given filename.
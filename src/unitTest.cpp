@@ -15,6 +15,8 @@
 #include <cfloat>
 #include <string>
 #include <iostream>
+#include <vector>
+#include <thread>
 
 #include "CoinMpsIO.hpp"
 #include "CoinPackedMatrix.hpp"
@@ -23,9 +25,14 @@
 #include "CoinHelperFunctions.hpp"
 #include "CoinTime.hpp"
 #include "CoinFloatEqual.hpp"
+#include "CoinFileIO.hpp"
+#include "CoinIndexedVector.hpp"
+#include "CoinSignal.hpp"
 
 #if CLP_HAS_ABC
 #include "CoinAbcCommon.hpp"
+#include "CoinAbcCommonFactorization.hpp"
+#include "CoinAbcHelperFunctions.hpp"
 #endif
 #ifdef ABC_INHERIT
 #include "CoinAbcFactorization.hpp"
@@ -35,16 +42,24 @@
 #include "ClpSimplexOther.hpp"
 #include "ClpSimplexNonlinear.hpp"
 #include "ClpInterior.hpp"
+#include "ClpCholeskyKKT.hpp"
+#include "ClpSnapshotPool.hpp"
+#include "ClpMpsReader.hpp"
+#include "ClpBlockStructure.hpp"
 #include "ClpLinearObjective.hpp"
+#include "ClpQuadraticObjective.hpp"
 #include "ClpDualRowSteepest.hpp"
 #include "ClpDualRowDantzig.hpp"
 #include "ClpPrimalColumnSteepest.hpp"
 #include "ClpPrimalColumnDantzig.hpp"
 #include "ClpParameters.hpp"
 #include "ClpNetworkMatrix.hpp"
+#include "ClpDynamicMatrix.hpp"
+#include "ClpDynamicExampleMatrix.hpp"
 #include "ClpPlusMinusOneMatrix.hpp"
 #include "MyMessageHandler.hpp"
 #include "MyEventHandler.hpp"
+#include "Clp_C_Interface.h"
 
 #include "ClpPresolve.hpp"
 #include "Idiot.hpp"
@@ -1402,6 +1417,124 @@ static void testingMessage(const char *const msg)
   //     <<endl <<msg <<endl;
 }
 
+// Result of one solve for threaded tests
+typedef struct {
+  int status;
+  int iterations;
+  double objective;
+  int messages;
+} ThreadSolveResult;
+
+// C call back - counts messages through user pointer
+extern "C" {
+static void CLP_LINKAGE_CB countMessages(Clp_Simplex *model, int /*messageNumber*/,
+  int /*nDouble*/, const double * /*vDouble*/,
+  int /*nInt*/, const int * /*vInt*/,
+  int /*nString*/, char ** /*vString*/)
+{
+  int *count = reinterpret_cast< int * >(Clp_getUserPointer(model));
+  (*count)++;
+}
+}
+
+/* Solve with "C" interface (odd) or ClpSimplex::initialSolve (even).
+   Both leave interrupt handling on so each solve claims a slot. */
+static void threadSolve(const std::string &fileName, int way,
+  ThreadSolveResult *result)
+{
+  result->status = -1;
+  result->iterations = 0;
+  result->objective = 0.0;
+  result->messages = 0;
+  if ((way & 1) != 0) {
+    Clp_Simplex *model = Clp_newModel();
+    Clp_setLogLevel(model, 0);
+    if (!Clp_readMps(model, fileName.c_str(), 1, 0)) {
+      Clp_setUserPointer(model, &result->messages);
+      Clp_registerCallBack(model, countMessages);
+      Clp_setLogLevel(model, 1);
+      Clp_initialSolve(model);
+      result->status = Clp_status(model);
+      result->iterations = Clp_numberIterations(model);
+      result->objective = Clp_objectiveValue(model);
+      Clp_clearCallBack(model);
+    }
+    Clp_deleteModel(model);
+  } else {
+    ClpSimplex model;
+    model.setLogLevel(0);
+    if (!model.readMps(fileName.c_str(), true, false)) {
+      ClpSolve options;
+      assert(options.getSpecialOption(2) == 0);
+      model.initialSolve(options);
+      result->status = model.status();
+      result->iterations = model.numberIterations();
+      result->objective = model.objectiveValue();
+    }
+  }
+}
+
+/* Loads model with a random banded matrix - each column has perColumn
+   elements in consecutive rows from a random start row.
+   elementType 0 - elements 1.0e-4 to 1.0e4, rows <= 1, every 97th column fixed
+               1 - elements +1, -1, +1 .. (so can be +- 1 matrix), rows <= 1 to 5
+               2 - elements and costs -1.0 to 1.0, rows -1 to 1 */
+static void randomBandedModel(ClpSimplex &model, int numberRows, int numberColumns,
+  int perColumn, int seed, int elementType)
+{
+  CoinBigIndex *start = new CoinBigIndex[numberColumns + 1];
+  int *row = new int[perColumn * numberColumns];
+  double *element = new double[perColumn * numberColumns];
+  double *columnLower = new double[numberColumns];
+  double *columnUpper = new double[numberColumns];
+  double *objective = new double[numberColumns];
+  double *rowLower = new double[numberRows];
+  double *rowUpper = new double[numberRows];
+  CoinThreadRandom random(seed);
+  CoinBigIndex numberElements = 0;
+  start[0] = 0;
+  for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+    int iRow = static_cast< int >(random.randomDouble() * (numberRows - perColumn));
+    for (int k = 0; k < perColumn; k++) {
+      double value;
+      if (elementType == 0)
+        value = pow(10.0, 8.0 * random.randomDouble() - 4.0);
+      else if (elementType == 1)
+        value = (k & 1) ? -1.0 : 1.0;
+      else
+        value = 2.0 * random.randomDouble() - 1.0;
+      row[numberElements] = iRow + k;
+      element[numberElements++] = value;
+    }
+    start[iColumn + 1] = numberElements;
+    columnLower[iColumn] = 0.0;
+    if (elementType == 0) {
+      columnUpper[iColumn] = (iColumn % 97) ? 10.0 : 0.0;
+      objective[iColumn] = random.randomDouble();
+    } else if (elementType == 1) {
+      columnUpper[iColumn] = 1.0;
+      objective[iColumn] = -random.randomDouble();
+    } else {
+      columnUpper[iColumn] = 1.0;
+      objective[iColumn] = 2.0 * random.randomDouble() - 1.0;
+    }
+  }
+  for (int iRow = 0; iRow < numberRows; iRow++) {
+    rowLower[iRow] = (elementType == 2) ? -1.0 : -COIN_DBL_MAX;
+    rowUpper[iRow] = (elementType == 1) ? 1.0 + (iRow % 5) : 1.0;
+  }
+  model.loadProblem(numberColumns, numberRows, start, row, element,
+    columnLower, columnUpper, objective, rowLower, rowUpper);
+  delete[] start;
+  delete[] row;
+  delete[] element;
+  delete[] columnLower;
+  delete[] columnUpper;
+  delete[] objective;
+  delete[] rowLower;
+  delete[] rowUpper;
+}
+
 //--------------------------------------------------------------------------
 // test factorization methods and simplex method and simple barrier
 void ClpSimplexUnitTest(const std::string &dirSample)
@@ -1528,6 +1661,604 @@ void ClpSimplexUnitTest(const std::string &dirSample)
       rowLower, rowUpper, rowObjective);
     solution.primal();
   }
+  // Mps reader on its own (plain and gzipped) should give same as CoinMpsIO.
+  // Tiny chunks so with threads edges fall inside integer markers and
+  // inside runs of records of a column.
+  {
+    const char *sampleName[3] = { "exmip1", "p0033", "brandy" };
+    int threads[6] = { 1, 2, 3, 5, 8, 13 };
+    for (int iFile = 0; iFile < 3; iFile++) {
+      CoinMpsIO m;
+      m.messageHandler()->setLogLevel(0);
+      std::string fn = dirSample + sampleName[iFile];
+      if (m.readMps(fn.c_str(), "mps") != 0) {
+        std::cerr << "Error reading " << sampleName[iFile]
+                  << " from sample data. Skipping test." << std::endl;
+        continue;
+      }
+      fn += ".mps";
+      std::string gzName = "test_reader.mps";
+      bool doGzip = CoinFileInput::haveGzipSupport()
+        && m.writeMps(gzName.c_str(), 1) == 0;
+      gzName += ".gz";
+      const CoinPackedMatrix *matrix = m.getMatrixByCol();
+      int numberRows = m.getNumRows();
+      int numberColumns = m.getNumCols();
+      for (int iPass = 0; iPass < 12; iPass++) {
+        // plain and gzipped, without and with threads
+        bool gzipped = iPass >= 6;
+        if (gzipped && !doGzip)
+          break;
+        ClpMpsReader reader;
+        reader.setNumberThreads(threads[iPass % 6]);
+        reader.setChunkSize(64);
+        int status = reader.readMps(gzipped ? gzName.c_str() : fn.c_str(), true);
+        assert(!status);
+        assert(reader.numberRows() == numberRows);
+        assert(reader.numberColumns() == numberColumns);
+        assert(reader.numberElements() == matrix->getNumElements());
+        for (int i = 0; i < numberRows; i++)
+          assert(reader.rowNames()[i] == m.rowName(i));
+        for (int i = 0; i < numberColumns; i++)
+          assert(reader.columnNames()[i] == m.columnName(i));
+        ClpModel model;
+        reader.loadIntoModel(model);
+        const CoinPackedMatrix *readMatrix = model.matrix();
+        for (int i = 0; i <= numberColumns; i++)
+          assert(readMatrix->getVectorStarts()[i] == matrix->getVectorStarts()[i]);
+        for (int i = 0; i < numberColumns; i++)
+          assert(readMatrix->getVectorLengths()[i] == matrix->getVectorLengths()[i]);
+        for (CoinBigIndex j = 0; j < matrix->getNumElements(); j++) {
+          assert(readMatrix->getIndices()[j] == matrix->getIndices()[j]);
+          assert(readMatrix->getElements()[j] == matrix->getElements()[j]);
+        }
+        for (int i = 0; i < numberRows; i++) {
+          assert(model.rowLower()[i] == m.getRowLower()[i]);
+          assert(model.rowUpper()[i] == m.getRowUpper()[i]);
+        }
+        for (int i = 0; i < numberColumns; i++) {
+          assert(model.columnLower()[i] == m.getColLower()[i]);
+          assert(model.columnUpper()[i] == m.getColUpper()[i]);
+          assert(model.objective()[i] == m.getObjCoefficients()[i]);
+          assert(model.isInteger(i) == m.isInteger(i));
+        }
+      }
+      if (doGzip)
+        remove(gzName.c_str());
+    }
+  }
+  // Threaded mps reader (used if numberThreads > 1) should give same model.
+  // Only checks hand over to model - file is one chunk at default size so
+  // splitting is tested above.
+  {
+    std::string fn = dirSample + "exmip1.mps";
+    ClpSimplex serial;
+    if (serial.readMps(fn.c_str(), true) == 0) {
+      ClpSimplex threaded;
+      threaded.setNumberThreads(2);
+      int status = threaded.readMps(fn.c_str(), true);
+      assert(!status);
+      int numberRows = serial.numberRows();
+      int numberColumns = serial.numberColumns();
+      assert(threaded.numberRows() == numberRows);
+      assert(threaded.numberColumns() == numberColumns);
+      assert(threaded.getNumElements() == serial.getNumElements());
+      int i;
+      for (i = 0; i < numberRows; i++) {
+        assert(threaded.rowLower()[i] == serial.rowLower()[i]);
+        assert(threaded.rowUpper()[i] == serial.rowUpper()[i]);
+        assert(threaded.getRowName(i) == serial.getRowName(i));
+      }
+      for (i = 0; i < numberColumns; i++) {
+        assert(threaded.columnLower()[i] == serial.columnLower()[i]);
+        assert(threaded.columnUpper()[i] == serial.columnUpper()[i]);
+        assert(threaded.objective()[i] == serial.objective()[i]);
+        assert(threaded.isInteger(i) == serial.isInteger(i));
+        assert(threaded.getColumnName(i) == serial.getColumnName(i));
+      }
+      serial.dual();
+      threaded.dual();
+      assert(eq(threaded.objectiveValue(), serial.objectiveValue()));
+    } else {
+      std::cerr << "Error reading exmip1 from sample data. Skipping test." << std::endl;
+    }
+  }
+  // Binary basis should restart at optimum
+  {
+    std::string fn = dirSample + "exmip1.mps";
+    ClpSimplex model;
+    if (model.readMps(fn.c_str()) == 0) {
+      model.dual();
+      int numberRows = model.numberRows();
+      int numberColumns = model.numberColumns();
+      int status = model.writeBasisBinary("test.bbas", true);
+      assert(!status);
+      ClpSimplex same;
+      same.readMps(fn.c_str());
+      status = same.readBasisBinary("test.bbas");
+      assert(status == 1);
+      // readBasis should see it is binary
+      ClpSimplex fresh;
+      fresh.readMps(fn.c_str());
+      status = fresh.readBasis("test.bbas");
+      assert(status == 1);
+      int i;
+      for (i = 0; i < numberColumns; i++)
+        assert((fresh.getColumnStatus(i) == ClpSimplex::basic) == (model.getColumnStatus(i) == ClpSimplex::basic));
+      for (i = 0; i < numberRows; i++)
+        assert((fresh.getRowStatus(i) == ClpSimplex::basic) == (model.getRowStatus(i) == ClpSimplex::basic));
+      fresh.dual();
+      assert(!fresh.numberIterations());
+      assert(eq(fresh.objectiveValue(), model.objectiveValue()));
+      // not for a different matrix
+      fresh.matrix()->modifyCoefficient(0, 0, 0.0, true);
+      status = fresh.readBasisBinary("test.bbas");
+      assert(status == -2);
+      remove("test.bbas");
+    } else {
+      std::cerr << "Error reading exmip1 from sample data. Skipping test." << std::endl;
+    }
+  }
+  // Scaling on threads should give exactly same scales as serial
+  {
+    int numberRows = 40000;
+    int numberColumns = 50000;
+    ClpSimplex base;
+    randomBandedModel(base, numberRows, numberColumns, 3, 987654, 0);
+    for (int mode = 1; mode <= 4; mode++) {
+      ClpSimplex serial(base);
+      serial.setNumberThreads(1);
+      serial.scaling(mode);
+      int serialReturn = serial.clpMatrix()->scale(&serial);
+      ClpSimplex threaded(base);
+      threaded.setNumberThreads(4);
+      threaded.scaling(mode);
+      int threadedReturn = threaded.clpMatrix()->scale(&threaded);
+      assert(serialReturn == threadedReturn);
+      if (!serialReturn) {
+        const double *rowScale = serial.rowScale();
+        const double *columnScale = serial.columnScale();
+        assert(rowScale && columnScale);
+        assert(threaded.rowScale() && threaded.columnScale());
+        for (int iRow = 0; iRow < numberRows; iRow++)
+          assert(threaded.rowScale()[iRow] == rowScale[iRow]);
+        for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+          assert(threaded.columnScale()[iColumn] == columnScale[iColumn]);
+      }
+    }
+  }
+  // +- 1 matrix priced on threads should give exactly same as serial
+  {
+    int numberRows = 1000;
+    int numberColumns = 50000;
+    ClpSimplex model;
+    randomBandedModel(model, numberRows, numberColumns, 3, 24680, 1);
+    model.replaceMatrix(new ClpPlusMinusOneMatrix(*model.matrix()), true);
+    CoinThreadRandom random(13579);
+    // pi with every row so pricing is by column (packed and not)
+    for (int iPass = 0; iPass < 2; iPass++) {
+      bool packed = iPass != 0;
+      CoinIndexedVector pi;
+      pi.reserve(numberRows);
+      for (int iRow = 0; iRow < numberRows; iRow++) {
+        double value = random.randomDouble() - 0.5;
+        if (packed) {
+          pi.denseVector()[iRow] = value;
+          pi.getIndices()[iRow] = iRow;
+        } else {
+          pi.insert(iRow, value);
+        }
+      }
+      if (packed) {
+        pi.setNumElements(numberRows);
+        pi.setPackedMode(true);
+      }
+      CoinIndexedVector spare[2];
+      CoinIndexedVector result[2];
+      for (int iThread = 0; iThread < 2; iThread++) {
+        spare[iThread].reserve(numberRows);
+        result[iThread].reserve(numberColumns);
+        model.setNumberThreads(iThread ? 4 : 1);
+        model.clpMatrix()->transposeTimes(&model, -1.0, &pi, spare + iThread, result + iThread);
+      }
+      int numberNonZero = result[0].getNumElements();
+      assert(result[1].getNumElements() == numberNonZero);
+      assert(result[1].packedMode() == result[0].packedMode());
+      for (int i = 0; i < numberNonZero; i++) {
+        int iColumn = result[0].getIndices()[i];
+        assert(result[1].getIndices()[i] == iColumn);
+        int k = result[0].packedMode() ? i : iColumn;
+        assert(result[1].denseVector()[k] == result[0].denseVector()[k]);
+      }
+    }
+    // and same dual solve
+    double objectiveValue[2];
+    int numberIterations[2];
+    for (int iThread = 0; iThread < 2; iThread++) {
+      ClpSimplex solve(model);
+      solve.setLogLevel(0);
+      solve.setNumberThreads(iThread ? 4 : 1);
+      solve.dual();
+      assert(!solve.status());
+      objectiveValue[iThread] = solve.objectiveValue();
+      numberIterations[iThread] = solve.numberIterations();
+    }
+    assert(objectiveValue[1] == objectiveValue[0]);
+    assert(numberIterations[1] == numberIterations[0]);
+  }
+  // Concurrent solves (C and C++) each with own interrupt slot
+  {
+    std::string fn = dirSample + "p0033";
+    ThreadSolveResult serial[2];
+    threadSolve(fn, 0, serial);
+    threadSolve(fn, 1, serial + 1);
+    if (serial[0].status < 0 || serial[1].status < 0) {
+      std::cerr << "Error reading p0033 from sample data. Skipping test." << std::endl;
+    } else {
+      assert(serial[1].messages > 0);
+      // handler must be put back when last solve finishes
+      CoinSighandler_t saveSignal = signal(SIGINT, SIG_IGN);
+      // more solves than slots at once
+      const int numberSolves = 80;
+      for (int iRepeat = 0; iRepeat < 2; iRepeat++) {
+        std::vector< ThreadSolveResult > result(numberSolves);
+        std::vector< std::thread > threads;
+        for (int i = 0; i < numberSolves; i++)
+          threads.push_back(std::thread(threadSolve, fn, i, &result[i]));
+        for (int i = 0; i < numberSolves; i++)
+          threads[i].join();
+        for (int i = 0; i < numberSolves; i++) {
+          const ThreadSolveResult &expected = serial[i & 1];
+          assert(result[i].status == expected.status);
+          assert(result[i].iterations == expected.iterations);
+          assert(result[i].objective == expected.objective);
+          assert(result[i].messages == expected.messages);
+        }
+      }
+      CoinSighandler_t current = signal(SIGINT, saveSignal);
+      assert(current == SIG_IGN);
+    }
+  }
+  // "C" assignProblem - borrowed arrays must survive changes to model
+  {
+    ClpSimplex base;
+    randomBandedModel(base, 20, 30, 3, 97531, 2);
+    int numberRows = base.numberRows();
+    int numberColumns = base.numberColumns();
+    const CoinPackedMatrix *matrix = base.matrix();
+    // caller's arrays (no gaps)
+    std::vector< CoinBigIndex > start(1, 0);
+    std::vector< int > index;
+    std::vector< double > value;
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      CoinBigIndex j = matrix->getVectorStarts()[iColumn];
+      for (int k = 0; k < matrix->getVectorLengths()[iColumn]; k++) {
+        index.push_back(matrix->getIndices()[j + k]);
+        value.push_back(matrix->getElements()[j + k]);
+      }
+      start.push_back(static_cast< CoinBigIndex >(index.size()));
+    }
+    std::vector< double > columnLower(base.columnLower(), base.columnLower() + numberColumns);
+    std::vector< double > columnUpper(base.columnUpper(), base.columnUpper() + numberColumns);
+    std::vector< double > objective(base.objective(), base.objective() + numberColumns);
+    std::vector< double > rowLower(base.rowLower(), base.rowLower() + numberRows);
+    std::vector< double > rowUpper(base.rowUpper(), base.rowUpper() + numberRows);
+    std::vector< CoinBigIndex > saveStart(start);
+    std::vector< int > saveIndex(index);
+    std::vector< double > saveValue(value);
+    Clp_Simplex *copy = Clp_newModel();
+    Clp_Simplex *borrow = Clp_newModel();
+    Clp_setLogLevel(copy, 0);
+    Clp_setLogLevel(borrow, 0);
+    Clp_assignProblem(copy, numberColumns, numberRows, 1, &start[0], &index[0],
+      &value[0], &columnLower[0], &columnUpper[0], &objective[0],
+      &rowLower[0], &rowUpper[0], 0);
+    assert(Clp_getElements(copy) != &value[0]);
+    Clp_assignProblem(borrow, numberColumns, numberRows, 1, &start[0], &index[0],
+      &value[0], &columnLower[0], &columnUpper[0], &objective[0],
+      &rowLower[0], &rowUpper[0], 2);
+    assert(Clp_getElements(borrow) == &value[0]);
+    Clp_dual(copy, 0);
+    Clp_dual(borrow, 0);
+    assert(!Clp_status(copy) && !Clp_status(borrow));
+    double objectiveValue = Clp_objectiveValue(copy);
+    assert(eq(Clp_objectiveValue(borrow), objectiveValue));
+    // structural changes make private copy first
+    int which[1] = { 0 };
+    Clp_deleteRows(copy, 1, which);
+    Clp_deleteRows(borrow, 1, which);
+    assert(Clp_getElements(borrow) != &value[0]);
+    CoinBigIndex newStart[2] = { 0, 2 };
+    int newRow[2] = { 0, 1 };
+    double newElement[2] = { 1.0, -1.0 };
+    double newLower = 0.0;
+    double newUpper = 1.0;
+    double newObjective = -1.0;
+    Clp_addColumns(copy, 1, &newLower, &newUpper, &newObjective,
+      newStart, newRow, newElement);
+    Clp_addColumns(borrow, 1, &newLower, &newUpper, &newObjective,
+      newStart, newRow, newElement);
+    Clp_dual(copy, 0);
+    Clp_dual(borrow, 0);
+    assert(Clp_status(borrow) == Clp_status(copy));
+    assert(eq(Clp_objectiveValue(borrow), Clp_objectiveValue(copy)));
+    Clp_deleteModel(borrow);
+    Clp_deleteModel(copy);
+    assert(start == saveStart);
+    assert(index == saveIndex);
+    assert(value == saveValue);
+    // adopted arrays are used in place and freed with model
+    CoinBigIndex numberElements = start[numberColumns];
+    CoinBigIndex *adoptStart = Clp_newBigIndexArray(numberColumns + 1);
+    int *adoptIndex = Clp_newIntArray(numberElements);
+    double *adoptValue = Clp_newDoubleArray(numberElements);
+    double *adoptColumnLower = Clp_newDoubleArray(numberColumns);
+    double *adoptColumnUpper = Clp_newDoubleArray(numberColumns);
+    double *adoptObjective = Clp_newDoubleArray(numberColumns);
+    double *adoptRowLower = Clp_newDoubleArray(numberRows);
+    double *adoptRowUpper = Clp_newDoubleArray(numberRows);
+    CoinCopyN(&start[0], numberColumns + 1, adoptStart);
+    CoinCopyN(&index[0], numberElements, adoptIndex);
+    CoinCopyN(&value[0], numberElements, adoptValue);
+    CoinCopyN(&columnLower[0], numberColumns, adoptColumnLower);
+    CoinCopyN(&columnUpper[0], numberColumns, adoptColumnUpper);
+    CoinCopyN(&objective[0], numberColumns, adoptObjective);
+    CoinCopyN(&rowLower[0], numberRows, adoptRowLower);
+    CoinCopyN(&rowUpper[0], numberRows, adoptRowUpper);
+    Clp_Simplex *adopt = Clp_newModel();
+    Clp_setLogLevel(adopt, 0);
+    Clp_assignProblem(adopt, numberColumns, numberRows, 1, adoptStart, adoptIndex,
+      adoptValue, adoptColumnLower, adoptColumnUpper, adoptObjective,
+      adoptRowLower, adoptRowUpper, 1);
+    assert(Clp_getVectorStarts(adopt) == adoptStart);
+    assert(Clp_getIndices(adopt) == adoptIndex);
+    assert(Clp_getElements(adopt) == adoptValue);
+    assert(Clp_columnLower(adopt) == adoptColumnLower);
+    assert(Clp_objective(adopt) == adoptObjective);
+    assert(Clp_rowLower(adopt) == adoptRowLower);
+    Clp_dual(adopt, 0);
+    assert(!Clp_status(adopt));
+    assert(eq(Clp_objectiveValue(adopt), objectiveValue));
+    // frees all eight arrays (leak checkers would complain otherwise)
+    Clp_deleteModel(adopt);
+  }
+#if defined(ABC_INHERIT) && ABC_PARALLEL == 2
+  // Abc dual with overlapped steps on thread pool should match serial
+  {
+    CoinMpsIO m;
+    std::string fn = dirSample + "brandy";
+    if (m.readMps(fn.c_str(), "mps") == 0) {
+      double objective[2];
+      for (int iPass = 0; iPass < 2; iPass++) {
+        ClpSimplex model;
+        model.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+          m.getObjCoefficients(),
+          m.getRowLower(), m.getRowUpper());
+        model.setLogLevel(0);
+        // number of cpus is in abcState - 4 gives parallelMode 3
+        model.setAbcState(iPass ? 4 : 1);
+        ClpSolve solveOptions;
+        solveOptions.setSolveType(ClpSolve::useDual);
+        solveOptions.setPresolveType(ClpSolve::presolveOff);
+        model.initialSolve(solveOptions);
+        assert(!model.status());
+        objective[iPass] = model.objectiveValue();
+      }
+      assert(eq(objective[1], objective[0]));
+    } else {
+      std::cerr << "Error reading brandy from sample data. Skipping test." << std::endl;
+    }
+  }
+  // Abc dual with column blocks priced on threads (and rebalanced on
+  // measured times every 200 iterations) should match serial
+  {
+    ClpSimplex base;
+    randomBandedModel(base, 600, 6000, 5, 1357911, 2);
+    double objectiveValue[2];
+    int numberIterations = 0;
+    for (int iPass = 0; iPass < 2; iPass++) {
+      ClpSimplex model(base);
+      model.setLogLevel(0);
+      model.setAbcState(iPass ? 4 : 1);
+      ClpSolve solveOptions;
+      solveOptions.setSolveType(ClpSolve::useDual);
+      solveOptions.setPresolveType(ClpSolve::presolveOff);
+      model.initialSolve(solveOptions);
+      assert(!model.status());
+      objectiveValue[iPass] = model.objectiveValue();
+      if (iPass)
+        numberIterations = model.numberIterations();
+    }
+    assert(eq(objectiveValue[1], objectiveValue[0]));
+    if (numberIterations < 200)
+      std::cerr << "Threaded Abc dual only took " << numberIterations
+                << " iterations so blocks were not rebalanced" << std::endl;
+  }
+#endif
+  // Snapshot pool should find basis for same bounds
+  {
+    std::string fn = dirSample + "exmip1.mps";
+    ClpSimplex model;
+    if (model.readMps(fn.c_str()) == 0) {
+      model.dual();
+      ClpSnapshotPool pool(&model, 2);
+      int numberRows = model.numberRows();
+      double *saveLower = CoinCopyOfArray(model.rowLower(), numberRows);
+      double *saveUpper = CoinCopyOfArray(model.rowUpper(), numberRows);
+      int k;
+      for (k = 0; k < 3; k++) {
+        // relax one row
+        model.setRowLower(k, saveLower[k] - 1.0);
+        model.setRowUpper(k, saveUpper[k] + 1.0);
+        model.dual();
+        int which = pool.addSnapshot(&model);
+        assert(which >= 0);
+        model.setRowLower(k, saveLower[k]);
+        model.setRowUpper(k, saveUpper[k]);
+      }
+      // only room for two
+      assert(pool.numberSnapshots() == 2);
+      model.setRowLower(2, saveLower[2] - 1.0);
+      model.setRowUpper(2, saveUpper[2] + 1.0);
+      model.allSlackBasis(true);
+      int distance;
+      int which = pool.closest(&model, &distance);
+      assert(which >= 0 && !distance);
+      assert(pool.setClosestBasis(&model) == which);
+      model.dual();
+      assert(!model.numberIterations());
+      delete[] saveLower;
+      delete[] saveUpper;
+    }
+  }
+  // Shared clone should use same matrix until one is changed
+  {
+    std::string fn = dirSample + "exmip1.mps";
+    ClpSimplex model;
+    if (model.readMps(fn.c_str()) == 0) {
+      model.dual();
+      double objectiveValue = model.objectiveValue();
+      ClpSimplex *fork = model.sharedClone();
+      ClpPackedMatrix *clpMatrix = dynamic_cast< ClpPackedMatrix * >(model.clpMatrix());
+      assert(clpMatrix && clpMatrix->shareCount() == 2);
+      assert(fork->matrix() == model.matrix());
+      fork->setColumnUpper(0, 0.0);
+      fork->dual();
+      // solving does not copy matrix
+      assert(clpMatrix->shareCount() == 2);
+      assert(fork->matrix() == model.matrix());
+      double value = model.matrix()->getCoefficient(0, 0);
+      fork->modifyCoefficient(0, 0, 2.0 * value);
+      assert(clpMatrix->shareCount() == 1);
+      assert(fork->matrix() != model.matrix());
+      assert(model.matrix()->getCoefficient(0, 0) == value);
+      assert(fork->matrix()->getCoefficient(0, 0) == 2.0 * value);
+      delete fork;
+      model.dual();
+      assert(!model.numberIterations());
+      assert(eq(model.objectiveValue(), objectiveValue));
+    }
+  }
+  // Dynamic matrix takes over matrix of a shared clone
+  {
+    // machines with overtime, jobs are sets with one column each
+    int numberMachines = 3;
+    int numberJobs = 6;
+    CoinBigIndex start[] = { 0, 1, 2, 3 };
+    int row[] = { 0, 1, 2 };
+    double element[] = { -1.0, -1.0, -1.0 };
+    double objective[] = { 50.0, 50.0, 50.0 };
+    double rowUpper[] = { 4.0, 4.0, 4.0 };
+    ClpSimplex model;
+    model.loadProblem(numberMachines, numberMachines, start, row, element,
+      NULL, NULL, objective, NULL, rowUpper);
+    CoinBigIndex starts[] = { 0, 1, 2, 3, 4, 5, 6 };
+    int jobRow[] = { 0, 1, 2, 0, 1, 2 };
+    double work[] = { 3.0, 2.0, 5.0, 1.0, 4.0, 2.0 };
+    double cost[] = { 10.0, 12.0, 7.0, 9.0, 3.0, 8.0 };
+    double lower[] = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+    double upper[] = { 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+    double objectiveValue[2];
+    for (int iPass = 0; iPass < 2; iPass++) {
+      // first deep copy then shared clone
+      ClpSimplex *fork = iPass ? model.sharedClone() : new ClpSimplex(model);
+      ClpDynamicMatrix *newMatrix = new ClpDynamicMatrix(fork, numberJobs,
+        numberJobs, starts, lower, upper, starts, jobRow, work, cost);
+      fork->replaceMatrix(newMatrix, true);
+      newMatrix->switchOffCheck();
+      fork->setSpecialOptions(4);
+      fork->scaling(0);
+      fork->setLogLevel(0);
+      fork->primal();
+      assert(!fork->status());
+      objectiveValue[iPass] = fork->objectiveValue();
+      delete fork;
+      // original is untouched
+      assert(model.matrix()->getNumCols() == numberMachines);
+      assert(model.matrix()->getNumRows() == numberMachines);
+      assert(model.getNumElements() == numberMachines);
+    }
+    assert(eq(objectiveValue[0], objectiveValue[1]));
+    model.dual();
+    assert(!model.status());
+  }
+  // Pool of dynamic example matrix has to grow while solving
+  {
+    // machines with overtime, jobs are sets with several options
+    int numberMachines = 3;
+    int numberJobs = 8;
+    int numberOptions = 3;
+    int numberColumns = numberJobs * numberOptions;
+    CoinBigIndex *starts = new CoinBigIndex[numberJobs + 1];
+    CoinBigIndex *startColumn = new CoinBigIndex[numberColumns + 1];
+    int *machine = new int[numberColumns];
+    double *work = new double[numberColumns];
+    double *cost = new double[numberColumns];
+    double *lower = new double[numberJobs];
+    double *upper = new double[numberJobs];
+    int i;
+    for (i = 0; i < numberColumns; i++) {
+      startColumn[i] = i;
+      machine[i] = (i + i / numberOptions) % numberMachines;
+      work[i] = 1.0 + ((7 * i) % 5);
+      cost[i] = 20.0 - 2.0 * work[i] + ((3 * i) % 7);
+    }
+    startColumn[numberColumns] = numberColumns;
+    for (i = 0; i <= numberJobs; i++)
+      starts[i] = i * numberOptions;
+    for (i = 0; i < numberJobs; i++) {
+      lower[i] = 1.0;
+      upper[i] = 1.0;
+    }
+    CoinBigIndex start[] = { 0, 1, 2, 3 };
+    int row[] = { 0, 1, 2 };
+    double element[] = { -1.0, -1.0, -1.0 };
+    double objective[] = { 50.0, 50.0, 50.0 };
+    double rowUpper[] = { 5.0, 5.0, 5.0 };
+    // full model has job rows after machine rows
+    ClpSimplex full;
+    full.loadProblem(numberMachines, numberMachines, start, row, element,
+      NULL, NULL, objective, NULL, rowUpper);
+    for (i = 0; i < numberJobs; i++)
+      full.addRow(0, NULL, NULL, 1.0, 1.0);
+    for (i = 0; i < numberColumns; i++) {
+      int rows[2];
+      double elements[2];
+      rows[0] = machine[i];
+      elements[0] = work[i];
+      rows[1] = numberMachines + i / numberOptions;
+      elements[1] = 1.0;
+      full.addColumn(2, rows, elements, 0.0, COIN_DBL_MAX, cost[i]);
+    }
+    full.setLogLevel(0);
+    full.dual();
+    assert(!full.status());
+    ClpSimplex model;
+    model.loadProblem(numberMachines, numberMachines, start, row, element,
+      NULL, NULL, objective, NULL, rowUpper);
+    ClpDynamicExampleMatrix *newMatrix = new ClpDynamicExampleMatrix(&model,
+      numberJobs, numberColumns, starts, lower, upper, startColumn,
+      machine, work, cost);
+    model.replaceMatrix(newMatrix, true);
+    newMatrix->switchOffCheck();
+    // no spare room so first new column makes pool grow
+    newMatrix->setPoolSize(newMatrix->numberGubColumns(), 0);
+    int maximumColumns = newMatrix->maximumGubColumns();
+    model.setSpecialOptions(4);
+    model.scaling(0);
+    model.setLogLevel(0);
+    model.primal();
+    assert(!model.status());
+    assert(newMatrix->maximumGubColumns() > maximumColumns);
+    assert(eq(model.objectiveValue(), full.objectiveValue()));
+    delete[] starts;
+    delete[] startColumn;
+    delete[] machine;
+    delete[] work;
+    delete[] cost;
+    delete[] lower;
+    delete[] upper;
+  }
 #ifndef COIN_NO_CLP_MESSAGE
   {
     CoinMpsIO m;
@@ -1975,6 +2706,28 @@ void ClpSimplexUnitTest(const std::string &dirSample)
         CoinDisjointCopyN(m.getObjCoefficients(), numberColumns, objective);
         solution.dual();
       }
+      // scale factors from one solve used on model with same structure
+      {
+        ClpSimplex first;
+        first.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+          m.getObjCoefficients(),
+          m.getRowLower(), m.getRowUpper());
+        first.dual();
+        ClpScaleFactors *factors = first.exportScaling();
+        assert(factors);
+        ClpSimplex second;
+        second.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+          m.getObjCoefficients(),
+          m.getRowLower(), m.getRowUpper());
+        assert(factors->matches(second.numberRows(), second.matrix()));
+        second.importScaling(factors);
+        delete factors;
+        second.dual();
+        CoinRelFltEq eq(1.0e-8);
+        assert(eq(second.objectiveValue(), first.objectiveValue()));
+        for (int iRow = 0; iRow < second.numberRows(); iRow++)
+          assert(second.rowScale()[iRow] == first.rowScale()[iRow]);
+      }
     } else {
       std::cerr << "Error reading afiro from sample data. Skipping test." << std::endl;
     }
@@ -2056,6 +2809,146 @@ void ClpSimplexUnitTest(const std::string &dirSample)
       std::cerr << "Error reading brandy from sample data. Skipping test." << std::endl;
     }
   }
+#ifdef CLP_MULTIPLE_FACTORIZATIONS
+  // statistics of solves by type (adaptive solves)
+  {
+    CoinMpsIO m;
+    std::string fn = dirSample + "brandy";
+    if (m.readMps(fn.c_str(), "mps") == 0) {
+      double objective[3];
+      for (int level = 0; level < 3; level++) {
+        ClpSimplex solution;
+        solution.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+          m.getObjCoefficients(),
+          m.getRowLower(), m.getRowUpper());
+        solution.setLogLevel(0);
+        solution.factorization()->setAdaptiveSolves(level);
+        solution.dual();
+        assert(!solution.status());
+        objective[level] = solution.objectiveValue();
+        const ClpFactorization *factorization = solution.factorization();
+        // FTRAN of column, FTRAN of weights in updateTwoColumnsFT and BTRAN of row
+        for (int type = 0; type < 3; type++) {
+          const ClpSolveStatistics &stats = factorization->solveStatistics(type);
+          if (level) {
+            assert(stats.numberSolves > 0);
+            assert(stats.count > 0.0 && stats.count <= stats.numberSolves);
+          } else {
+            assert(!stats.numberSolves);
+          }
+        }
+        assert(eq(objective[level], objective[0]));
+      }
+    } else {
+      std::cerr << "Error reading brandy from sample data. Skipping test." << std::endl;
+    }
+  }
+#endif
+#if CLP_HAS_ABC
+  // dense LU in panels must give same factors as a strip at a time
+  {
+    int panel = CoinAbcDensePanel();
+    int n = 4 * panel + 3 * BLOCKING8;
+    double *blocked = new double[n * n];
+    double *strips = new double[n * n];
+    int *ipivBlocked = new int[n];
+    int *ipivStrips = new int[n];
+    CoinThreadRandom random(1234567);
+    for (int i = 0; i < n * n; i++)
+      blocked[i] = random.randomDouble() - 0.5;
+    CoinMemcpyN(blocked, n * n, strips);
+    int returnBlocked = CoinAbcDgetrf(n, n, blocked, n, ipivBlocked
+#if ABC_PARALLEL == 2
+      ,
+      0
+#endif
+    );
+    CoinAbcSetDensePanel(BLOCKING8);
+    int returnStrips = CoinAbcDgetrf(n, n, strips, n, ipivStrips
+#if ABC_PARALLEL == 2
+      ,
+      0
+#endif
+    );
+    CoinAbcSetDensePanel(panel);
+    assert(!returnBlocked && !returnStrips);
+    for (int i = 0; i < n; i++)
+      assert(ipivBlocked[i] == ipivStrips[i]);
+    for (int i = 0; i < n * n; i++)
+      assert(fabs(blocked[i] - strips[i]) < 1.0e-9 * (1.0 + fabs(strips[i])));
+    delete[] blocked;
+    delete[] strips;
+    delete[] ipivBlocked;
+    delete[] ipivStrips;
+  }
+  // each kernel level this cpu can do must give same factors and solution
+  {
+    int saveLevel = CoinAbcKernelLevel();
+    assert(saveLevel == CoinAbcCpuLevel());
+    int n = 4 * CoinAbcDensePanel() + 3 * BLOCKING8;
+    double *base = new double[n * n];
+    double *factor = new double[n * n];
+    double *baseFactor = new double[n * n];
+    int *ipiv = new int[n];
+    int *baseIpiv = new int[n];
+    CoinThreadRandom random(7654321);
+    for (int i = 0; i < n * n; i++)
+      base[i] = random.randomDouble() - 0.5;
+#ifdef ABC_INHERIT
+    CoinMpsIO m;
+    std::string fn = dirSample + "brandy";
+    bool gotModel = m.readMps(fn.c_str(), "mps") == 0;
+    double baseObjective = 0.0;
+#endif
+    for (int level = 0; level <= CoinAbcCpuLevel(); level++) {
+      CoinAbcSetKernelLevel(level);
+      assert(CoinAbcKernelLevel() == level);
+      CoinMemcpyN(base, n * n, factor);
+      int returnCode = CoinAbcDgetrf(n, n, factor, n, ipiv
+#if ABC_PARALLEL == 2
+        ,
+        0
+#endif
+      );
+      assert(!returnCode);
+      if (!level) {
+        CoinMemcpyN(factor, n * n, baseFactor);
+        CoinMemcpyN(ipiv, n, baseIpiv);
+      } else {
+        for (int i = 0; i < n; i++)
+          assert(ipiv[i] == baseIpiv[i]);
+        for (int i = 0; i < n * n; i++)
+          assert(fabs(factor[i] - baseFactor[i]) < 1.0e-9 * (1.0 + fabs(baseFactor[i])));
+      }
+#ifdef ABC_INHERIT
+      if (gotModel) {
+        // Abc dual uses scatter tables
+        ClpSimplex model;
+        model.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+          m.getObjCoefficients(),
+          m.getRowLower(), m.getRowUpper());
+        model.setLogLevel(0);
+        model.setAbcState(1);
+        ClpSolve solveOptions;
+        solveOptions.setSolveType(ClpSolve::useDual);
+        solveOptions.setPresolveType(ClpSolve::presolveOff);
+        model.initialSolve(solveOptions);
+        assert(!model.status());
+        if (!level)
+          baseObjective = model.objectiveValue();
+        else
+          assert(eq(model.objectiveValue(), baseObjective));
+      }
+#endif
+    }
+    CoinAbcSetKernelLevel(saveLevel);
+    delete[] base;
+    delete[] factor;
+    delete[] baseFactor;
+    delete[] ipiv;
+    delete[] baseIpiv;
+  }
+#endif
   // test infeasible
   {
     CoinMpsIO m;
@@ -2340,6 +3233,18 @@ void ClpSimplexUnitTest(const std::string &dirSample)
         m.getObjCoefficients(),
         m.getRowLower(), m.getRowUpper());
       solution.primalDual();
+      // again with implicit scaling - matrix must come back unchanged
+      ClpInterior solution2;
+      solution2.loadProblem(*m.getMatrixByCol(), m.getColLower(), m.getColUpper(),
+        m.getObjCoefficients(),
+        m.getRowLower(), m.getRowUpper());
+      solution2.setSpecialOptions(solution2.specialOptions() | 0x10000000);
+      solution2.primalDual();
+      assert(fabs(solution.objectiveValue() - solution2.objectiveValue()) < 1.0e-7 * (1.0 + fabs(solution.objectiveValue())));
+      const double *element = solution2.matrix()->getElements();
+      const double *original = m.getMatrixByCol()->getElements();
+      for (CoinBigIndex i = 0; i < m.getMatrixByCol()->getNumElements(); i++)
+        assert(element[i] == original[i]);
     } else {
       std::cerr << "Error reading exmip1 from sample data. Skipping test." << std::endl;
     }
@@ -2515,6 +3420,80 @@ void ClpSimplexUnitTest(const std::string &dirSample)
       time1 = CoinCpuTime();
       model.dual();
       std::cout << "Network problem, ClpNetworkMatrix took " << CoinCpuTime() - time1 << " seconds" << std::endl;
+      double objectiveValue = model.objectiveValue();
+      model.createStatus();
+      time1 = CoinCpuTime();
+      model.networkSolve();
+      std::cout << "Network problem, network simplex took " << CoinCpuTime() - time1 << " seconds" << std::endl;
+      assert(!model.status());
+      assert(fabs(model.objectiveValue() - objectiveValue) < 1.0e-5 * (1.0 + fabs(objectiveValue)));
+      {
+        // check primal and dual solutions
+        const double *solution = model.primalColumnSolution();
+        const double *rowActivity = model.primalRowSolution();
+        const double *dual = model.dualRowSolution();
+        const double *dj = model.dualColumnSolution();
+        double *activity = new double[numberRows];
+        CoinZeroN(activity, numberRows);
+        for (i = 0; i < numberColumns; i++) {
+          double value = solution[i];
+          assert(value >= lowerColumn[i] - 1.0e-7 && value <= upperColumn[i] + 1.0e-7);
+          activity[head[i]] -= value;
+          activity[tail[i]] += value;
+          double djValue = objective[i] + dual[head[i]] - dual[tail[i]];
+          assert(fabs(djValue - dj[i]) < 1.0e-5 * (1.0 + fabs(djValue)));
+          if (value > lowerColumn[i] + 1.0e-7)
+            assert(dj[i] < 1.0e-5);
+          if (value < upperColumn[i] - 1.0e-7)
+            assert(dj[i] > -1.0e-5);
+        }
+        for (i = 0; i < numberRows; i++) {
+          assert(fabs(activity[i] - rowActivity[i]) < 1.0e-7);
+          assert(activity[i] >= lower[i] - 1.0e-7 && activity[i] <= upper[i] + 1.0e-7);
+        }
+        delete[] activity;
+      }
+      // network simplex is only used by initialSolve if asked for
+      {
+        ClpSolve solveOptions;
+        solveOptions.setPresolveType(ClpSolve::presolveOff);
+        model.createStatus();
+        model.initialSolve(solveOptions);
+        assert(!model.status());
+        assert(fabs(model.objectiveValue() - objectiveValue) < 1.0e-5 * (1.0 + fabs(objectiveValue)));
+        solveOptions.setUseNetwork(true);
+        model.createStatus();
+        model.initialSolve(solveOptions);
+        assert(!model.status());
+        assert(fabs(model.objectiveValue() - objectiveValue) < 1.0e-5 * (1.0 + fabs(objectiveValue)));
+      }
+      // and let load find network structure
+      model.setSpecialOptions(model.specialOptions() | 0x04000000);
+      model.loadProblem(matrix,
+        lowerColumn, upperColumn, objective,
+        lower, upper);
+      assert(model.clpMatrix()->type() == 11);
+      model.createStatus();
+      model.dual();
+      assert(fabs(model.objectiveValue() - objectiveValue) < 1.0e-5 * (1.0 + fabs(objectiveValue)));
+      model.setSpecialOptions(model.specialOptions() & ~0x04000000);
+      // and let model take over arrays - keeping just one copy of matrix
+      {
+        CoinPackedMatrix *assigned = new CoinPackedMatrix(matrix);
+        double *collb = CoinCopyOfArray(lowerColumn, numberColumns);
+        double *colub = CoinCopyOfArray(upperColumn, numberColumns);
+        double *obj = CoinCopyOfArray(objective, numberColumns);
+        double *rowlb = CoinCopyOfArray(lower, numberRows);
+        double *rowub = CoinCopyOfArray(upper, numberRows);
+        model.setSpecialOptions(model.specialOptions() | 0x08000000);
+        model.assignProblem(assigned, collb, colub, obj, rowlb, rowub);
+        assert(!assigned && !collb && !colub && !obj && !rowlb && !rowub);
+        model.createStatus();
+        model.dual();
+        assert(!model.rowCopy());
+        assert(fabs(model.objectiveValue() - objectiveValue) < 1.0e-5 * (1.0 + fabs(objectiveValue)));
+        model.setSpecialOptions(model.specialOptions() & ~0x08000000);
+      }
       delete[] lower;
       delete[] upper;
       delete[] head;
@@ -2649,10 +3628,115 @@ void ClpSimplexUnitTest(const std::string &dirSample)
       model.allSlackBasis();
       model.primal();
       //printSol(model);
+      // and barrier with regularized KKT factorization (two threads)
+      {
+        ClpInterior barrier;
+        barrier.borrowModel(model);
+        barrier.setNumberThreads(2);
+        barrier.setCholesky(new ClpCholeskyKKT());
+        barrier.primalDual();
+        assert(barrier.status() == 0);
+        assert(eq(barrier.objectiveValue(), -400.92));
+        barrier.returnModel(model);
+      }
+      model.primal();
+      assert(eq(model.getObjValue(), -400.92));
     } else {
       std::cerr << "Error reading share2qp from sample data. Skipping test." << std::endl;
     }
   }
+  // quadratic objective - gradient updated incrementally must match full product
+  {
+    const int numberColumns = 8;
+    // tridiagonal Hessian in half (lower triangle) storage
+    CoinBigIndex start[numberColumns + 1];
+    int column[2 * numberColumns];
+    double element[2 * numberColumns];
+    double linear[numberColumns];
+    double hessian[numberColumns][numberColumns];
+    memset(hessian, 0, sizeof(hessian));
+    CoinBigIndex numberElements = 0;
+    int i, j;
+    for (i = 0; i < numberColumns; i++) {
+      start[i] = numberElements;
+      column[numberElements] = i;
+      element[numberElements++] = 2.0 + i;
+      hessian[i][i] = 2.0 + i;
+      if (i + 1 < numberColumns) {
+        column[numberElements] = i + 1;
+        element[numberElements++] = -1.0 + 0.1 * i;
+        hessian[i][i + 1] = -1.0 + 0.1 * i;
+        hessian[i + 1][i] = -1.0 + 0.1 * i;
+      }
+      linear[i] = 1.0 - 0.25 * i;
+    }
+    start[numberColumns] = numberElements;
+    ClpQuadraticObjective half(linear, numberColumns, start, column, element);
+    ClpQuadraticObjective full(half, 1);
+    // back to half storage
+    ClpQuadraticObjective halfAgain(full, -1);
+    ClpQuadraticObjective noIncremental(half);
+    noIncremental.setIncrementalGradient(false);
+    assert(!half.fullMatrix() && full.fullMatrix() && !halfAgain.fullMatrix());
+    assert(full.quadraticObjective()->getNumElements() == 2 * numberElements - numberColumns);
+    assert(halfAgain.quadraticObjective()->getNumElements() == numberElements);
+    assert(!half.diagonalHessian() && !halfAgain.diagonalHessian());
+    ClpQuadraticObjective *objectives[4] = { &half, &full, &halfAgain, &noIncremental };
+    double solution[numberColumns];
+    double check[numberColumns];
+    for (i = 0; i < numberColumns; i++)
+      solution[i] = 0.5 * i;
+    // one value changes each step - more steps than between full products
+    for (int iStep = 0; iStep < 120; iStep++) {
+      if (iStep)
+        solution[(3 * iStep) % numberColumns] += 0.1 * ((iStep % 5) - 2);
+      double checkOffset = 0.0;
+      for (i = 0; i < numberColumns; i++) {
+        double value = 0.0;
+        for (j = 0; j < numberColumns; j++)
+          value += hessian[i][j] * solution[j];
+        checkOffset += 0.5 * value * solution[i];
+        check[i] = linear[i] + value;
+      }
+      for (int k = 0; k < 4; k++) {
+        double offset;
+        const double *gradient = objectives[k]->gradient(NULL, solution, offset, true);
+        for (i = 0; i < numberColumns; i++)
+          assert(fabs(gradient[i] - check[i]) < 1.0e-10 * (1.0 + fabs(check[i])));
+        assert(fabs(offset - checkOffset) < 1.0e-10 * (1.0 + fabs(checkOffset)));
+      }
+    }
+    // diagonal Hessian on a small QP - min sum (x-t)**2 with sum x = 1
+    double target[4] = { 0.6, 0.4, 0.3, -0.4 };
+    for (i = 0; i < 4; i++) {
+      start[i] = i;
+      column[i] = i;
+      element[i] = 2.0;
+      linear[i] = -2.0 * target[i];
+    }
+    start[4] = 4;
+    int rowIndex[4] = { 0, 0, 0, 0 };
+    double rowElement[4] = { 1.0, 1.0, 1.0, 1.0 };
+    CoinBigIndex columnStart[5] = { 0, 1, 2, 3, 4 };
+    double one = 1.0;
+    ClpSimplex model;
+    model.loadProblem(4, 1, columnStart, rowIndex, rowElement,
+      NULL, NULL, linear, &one, &one);
+    model.loadQuadraticObjective(4, start, column, element);
+    model.setLogLevel(0);
+    ClpQuadraticObjective *quadratic = dynamic_cast< ClpQuadraticObjective * >(model.objectiveAsObject());
+    assert(quadratic && quadratic->diagonalHessian());
+    double offset;
+    const double *gradient = quadratic->gradient(NULL, target, offset, true);
+    for (i = 0; i < 4; i++)
+      assert(fabs(gradient[i]) < 1.0e-12);
+    model.primal();
+    assert(!model.status());
+    assert(eq(model.objectiveValue(), -0.58));
+    const double *x = model.primalColumnSolution();
+    assert(fabs(x[0] - 0.5) < 1.0e-6 && fabs(x[1] - 0.3) < 1.0e-6);
+    assert(fabs(x[2] - 0.2) < 1.0e-6 && fabs(x[3]) < 1.0e-6);
+  }
   if (0) {
     CoinMpsIO m;
     std::string fn = "./beale";
@@ -2799,6 +3883,120 @@ void ClpSimplexUnitTest(const std::string &dirSample)
     fullModel.dropNames();
     fullModel.writeMps("test2.mps");
   }
+  // Find blocks in flat model and solve by decomposition (as blockDetect)
+  {
+    // three blocks of 10 rows and columns joined by one row
+    int numberBlocks = 3;
+    int numberRows = 10 * numberBlocks + 1;
+    int numberColumns = 10 * numberBlocks;
+    ClpSimplex model;
+    model.resize(numberRows, 0);
+    for (int iRow = 0; iRow < numberRows - 1; iRow++)
+      model.setRowBounds(iRow, -COIN_DBL_MAX, 4.0 + (iRow % 3));
+    model.setRowBounds(numberRows - 1, -COIN_DBL_MAX, 50.0);
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++) {
+      int iBlock = iColumn / 10;
+      int i = iColumn % 10;
+      // in rows i-1 and i of block and linking row
+      int row[3] = { 10 * iBlock + ((i + 9) % 10), 10 * iBlock + i, numberRows - 1 };
+      double element[3] = { 1.0, 1.0 + 0.1 * i, 1.0 };
+      model.addColumn(3, row, element, 0.0, 10.0, -1.0 - 0.01 * iColumn);
+    }
+    model.setLogLevel(0);
+    ClpBlockStructure structure;
+    // so linking row does not hold blocks together
+    structure.setMaximumNetSize(20);
+    int numberFound = structure.findStructure(&model, 1);
+    assert(numberFound == numberBlocks);
+    assert(structure.numberLinkingRows() == 1);
+    assert(structure.linkingRows()[0] == numberRows - 1);
+    assert(!structure.numberLinkingColumns());
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+      assert(structure.columnBlock()[iColumn] == structure.columnBlock()[10 * (iColumn / 10)]);
+    CoinStructuredModel structured;
+    assert(structure.createStructuredModel(&model, structured) == numberBlocks);
+    ClpSimplex solver;
+    solver.setLogLevel(0);
+    solver.solve(&structured);
+    model.dual();
+    assert(!model.status());
+    assert(eq(solver.objectiveValue(), model.objectiveValue()));
+    // one block is no structure - everything in master
+    numberFound = structure.findStructure(&model, 1, 1);
+    assert(!numberFound && !structure.numberBlocks());
+    assert(structure.numberLinkingRows() == numberRows);
+    assert(structure.numberLinkingColumns() == numberColumns);
+    for (int iRow = 0; iRow < numberRows; iRow++)
+      assert(structure.rowBlock()[iRow] == -1);
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+      assert(structure.columnBlock()[iColumn] == -1);
+    // no cut allowed so partition finds one block - must be reset
+    ClpBlockStructure whole;
+    whole.setMaximumCutFraction(0.0);
+    numberFound = whole.findStructure(&model, 1);
+    assert(!numberFound);
+    assert(whole.numberLinkingRows() == numberRows);
+    for (int iRow = 0; iRow < numberRows; iRow++)
+      assert(whole.rowBlock()[iRow] == -1);
+    for (int iColumn = 0; iColumn < numberColumns; iColumn++)
+      assert(whole.columnBlock()[iColumn] == -1);
+  }
+  // Benders (threaded, single cut and asynchronous) should match serial
+  {
+    // three blocks of 10 rows and columns with two linking columns
+    int numberBlocks = 3;
+    int numberRows = 10 * numberBlocks + 1;
+    int numberColumns = 10 * numberBlocks + 2;
+    ClpSimplex model;
+    model.resize(numberRows, 0);
+    for (int iRow = 0; iRow < numberRows - 1; iRow++)
+      model.setRowBounds(iRow, 2.0 + (iRow % 3), COIN_DBL_MAX);
+    for (int iColumn = 0; iColumn < numberColumns - 2; iColumn++) {
+      int iBlock = iColumn / 10;
+      int i = iColumn % 10;
+      int row[2] = { 10 * iBlock + ((i + 9) % 10), 10 * iBlock + i };
+      double element[2] = { 1.0, 1.0 + 0.1 * i };
+      model.addColumn(2, row, element, 0.0, 10.0, 2.0 + 0.01 * iColumn);
+    }
+    // linking columns in every block row and master row
+    for (int j = 0; j < 2; j++) {
+      int row[16];
+      double element[16];
+      int n = 0;
+      for (int iRow = j; iRow < numberRows - 1; iRow += 2) {
+        row[n] = iRow;
+        element[n++] = 1.0;
+      }
+      row[n] = numberRows - 1;
+      element[n++] = 1.0;
+      model.addColumn(n, row, element, 0.0, 10.0, 1.0 + j);
+    }
+    model.setRowBounds(numberRows - 1, -COIN_DBL_MAX, 12.0);
+    model.setLogLevel(0);
+    ClpBlockStructure structure;
+    structure.setMaximumNetSize(10);
+    int numberFound = structure.findStructure(&model, 2);
+    assert(numberFound == numberBlocks);
+    assert(structure.numberLinkingRows() == 1);
+    assert(structure.numberLinkingColumns() == 2);
+    model.dual();
+    assert(!model.status());
+    // threads, cut type, asynchronous
+    int which[5][3] = { { 1, 0, 0 }, { 4, 0, 0 }, { 4, 1, 0 }, { 4, 0, 1 }, { 1, 0, 1 } };
+    for (int i = 0; i < 5; i++) {
+      CoinStructuredModel structured;
+      assert(structure.createStructuredModel(&model, structured) == numberBlocks);
+      ClpSimplex solver;
+      solver.setLogLevel(0);
+      solver.setNumberThreads(which[i][0]);
+      ClpSolve options;
+      options.setIndependentOption(2, 100);
+      options.setBendersCutType(which[i][1]);
+      options.setBendersAsynchronous(which[i][2]);
+      solver.solve(&structured, options);
+      assert(eq(solver.objectiveValue(), model.objectiveValue()));
+    }
+  }
 #endif
 }
 